@@ -516,10 +516,11 @@ public:
     return 0;
   }
 
-  /// Create increment contents of target by 1 for Instrumentation
+  /// Create increment contents of target by 1 for Instrumentation. Unless
+  /// \p IsAtomic is set, increments racing from other threads may be lost.
   virtual InstructionListType
   createInstrIncMemory(const MCSymbol *Target, MCContext *Ctx, bool IsLeaf,
-                       unsigned CodePointerSize) const {
+                       unsigned CodePointerSize, bool IsAtomic) const {
     llvm_unreachable("not implemented");
     return InstructionListType();
   }
@@ -506,8 +506,12 @@ Error IdenticalCodeFolding::runOnFunctions(BinaryContext &BC) {
     if (!opts::NoThreads)
       ThPool = &ParallelUtilities::getThreadPool();
 
-    // Fold identical functions within a single congruent bucket
-    auto processSingleBucket = [&](std::set<BinaryFunction *> &Candidates) {
+    // Find the sets of identical functions within a single congruent bucket.
+    // This only compares functions, so buckets are processed in parallel.
+    // Folding is done afterwards, so that the comparisons do not depend on
+    // the functions folded concurrently in other buckets.
+    auto findTwins = [&](std::set<BinaryFunction *> &Candidates,
+                         std::vector<std::vector<BinaryFunction *>> &Found) {
       Timer T("folding single congruent list", "folding single congruent list");
       LLVM_DEBUG(T.startTimer());
 
@@ -523,58 +527,86 @@ Error IdenticalCodeFolding::runOnFunctions(BinaryContext &BC) {
         if (Twins.size() < 2)
           continue;
 
-        // Fold functions. Keep the order consistent across invocations with
-        // different options.
+        // Keep the order consistent across invocations with different
+        // options.
         llvm::stable_sort(
             Twins, [](const BinaryFunction *A, const BinaryFunction *B) {
               return A->getFunctionNumber() < B->getFunctionNumber();
             });
-
-        BinaryFunction *ParentBF = Twins[0];
-        if (!ParentBF->hasFunctionsFoldedInto())
-          NumCalled += ParentBF->getKnownExecutionCount();
-        for (unsigned I = 1; I < Twins.size(); ++I) {
-          BinaryFunction *ChildBF = Twins[I];
-          LLVM_DEBUG(dbgs() << "BOLT-DEBUG: folding " << *ChildBF << " into "
-                            << *ParentBF << '\n');
-
-          // Remove child function from the list of candidates.
-          auto FI = Candidates.find(ChildBF);
-          assert(FI != Candidates.end() &&
-                 "function expected to be in the set");
-          Candidates.erase(FI);
-
-          // Fold the function and remove from the list of processed functions.
-          BytesSavedEstimate += ChildBF->getSize();
-          if (!ChildBF->hasFunctionsFoldedInto())
-            NumCalled += ChildBF->getKnownExecutionCount();
-          BC.foldFunction(*ChildBF, *ParentBF);
-
-          ++NumFoldedLastIteration;
-
-          if (ParentBF->hasJumpTables())
-            ++NumJTFunctionsFolded;
-        }
+        Found.emplace_back(std::move(Twins));
       }
 
       LLVM_DEBUG(T.stopTimer());
     };
 
     // Create a task for each congruent bucket
-    for (auto &Entry : CongruentBuckets) {
-      std::set<BinaryFunction *> &Bucket = Entry.second;
-      if (Bucket.size() < 2)
-        continue;
-
+    std::vector<std::set<BinaryFunction *> *> Buckets;
+    for (auto &Entry : CongruentBuckets)
+      if (Entry.second.size() >= 2)
+        Buckets.push_back(&Entry.second);
+    std::vector<std::vector<std::vector<BinaryFunction *>>> TwinsByBucket(
+        Buckets.size());
+    for (size_t I = 0, E = Buckets.size(); I != E; ++I) {
       if (opts::NoThreads)
-        processSingleBucket(Bucket);
+        findTwins(*Buckets[I], TwinsByBucket[I]);
       else
-        ThPool->async(processSingleBucket, std::ref(Bucket));
+        ThPool->async(findTwins, std::ref(*Buckets[I]),
+                      std::ref(TwinsByBucket[I]));
     }
 
     if (!opts::NoThreads)
       ThPool->wait();
 
+    // Fold in function order, so that the result does not depend on the
+    // order of the buckets.
+    std::vector<std::pair<std::set<BinaryFunction *> *,
+                          std::vector<BinaryFunction *> *>>
+        Folds;
+    for (size_t I = 0, E = Buckets.size(); I != E; ++I)
+      for (std::vector<BinaryFunction *> &Twins : TwinsByBucket[I])
+        Folds.emplace_back(Buckets[I], &Twins);
+    llvm::sort(Folds, [](const auto &A, const auto &B) {
+      return A.second->front()->getFunctionNumber() <
+             B.second->front()->getFunctionNumber();
+    });
+
+    for (auto [Candidates, Twins] : Folds) {
+      BinaryFunction *ParentBF = Twins->front();
+      if (!ParentBF->hasFunctionsFoldedInto())
+        NumCalled += ParentBF->getKnownExecutionCount();
+      for (unsigned I = 1; I < Twins->size(); ++I) {
+        BinaryFunction *ChildBF = (*Twins)[I];
+        LLVM_DEBUG(dbgs() << "BOLT-DEBUG: folding " << *ChildBF << " into "
+                          << *ParentBF << '\n');
+
+        // Remove child function from the list of candidates.
+        auto FI = Candidates->find(ChildBF);
+        assert(FI != Candidates->end() &&
+               "function expected to be in the set");
+        Candidates->erase(FI);
+
+        // Fold the function and remove from the list of processed functions.
+        BytesSavedEstimate += ChildBF->getSize();
+        if (!ChildBF->hasFunctionsFoldedInto())
+          NumCalled += ChildBF->getKnownExecutionCount();
+        BC.foldFunction(*ChildBF, *ParentBF);
+
+        ++NumFoldedLastIteration;
+
+        if (ParentBF->hasJumpTables())
+          ++NumJTFunctionsFolded;
+      }
+    }
+
+    // A bucket with less than two candidates left can't fold anything in the
+    // next iterations.
+    for (auto I = CongruentBuckets.begin(); I != CongruentBuckets.end();) {
+      if (I->second.size() < 2)
+        I = CongruentBuckets.erase(I);
+      else
+        ++I;
+    }
+
     LLVM_DEBUG(SinglePass.stopTimer());
   };
   if (opts::ICF == ICFLevel::Safe)
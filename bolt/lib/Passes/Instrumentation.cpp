@@ -71,6 +71,13 @@ cl::opt<bool> InstrumentationWaitForks(
              "(use with instrumentation-sleep-time option)"),
     cl::init(false), cl::Optional, cl::cat(BoltInstrCategory));
 
+cl::opt<bool> InstrumentationNonAtomicCounters(
+    "instrumentation-nonatomic-counters",
+    cl::desc("increment counters with plain instead of atomic instructions. "
+             "This is much cheaper in multi-threaded programs, but increments "
+             "racing from other threads may be lost (default: false)"),
+    cl::init(false), cl::Optional, cl::cat(BoltInstrCategory));
+
 cl::opt<bool>
     InstrumentHotOnly("instrument-hot-only",
                       cl::desc("only insert instrumentation on hot functions "
@@ -263,8 +270,9 @@ Instrumentation::createInstrumentationSnippet(BinaryContext &BC, bool IsLeaf) {
   auto L = BC.scopeLock();
   MCSymbol *Label = BC.Ctx->createNamedTempSymbol("InstrEntry");
   Summary->Counters.emplace_back(Label);
-  return BC.MIB->createInstrIncMemory(Label, BC.Ctx.get(), IsLeaf,
-                                      BC.AsmInfo->getCodePointerSize());
+  return BC.MIB->createInstrIncMemory(
+      Label, BC.Ctx.get(), IsLeaf, BC.AsmInfo->getCodePointerSize(),
+      /*IsAtomic=*/!opts::InstrumentationNonAtomicCounters);
 }
 
 // Helper instruction sequence insertion function
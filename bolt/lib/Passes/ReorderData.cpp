@@ -16,6 +16,7 @@
 // - estimate temporal locality by looking at CFG?
 
 #include "bolt/Passes/ReorderData.h"
+#include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/MapVector.h"
 #include <algorithm>
 
@@ -100,6 +101,19 @@ namespace {
 
 static constexpr uint16_t MinAlignment = 16;
 
+// Used to estimate how well hot data objects share cache lines.
+static constexpr uint64_t CacheLineSize = 64;
+
+// Add the cache lines spanned by [Start, Start + Size) to Lines.
+void addCacheLines(DenseSet<uint64_t> &Lines, uint64_t Start, uint64_t Size) {
+  if (!Size)
+    return;
+  for (uint64_t Line = Start / CacheLineSize,
+                End = (Start + Size - 1) / CacheLineSize;
+       Line <= End; ++Line)
+    Lines.insert(Line);
+}
+
 bool isSupported(const BinarySection &BS) { return BS.isData() && !BS.isTLS(); }
 
 bool filterSymbol(const BinaryData *BD) {
@@ -338,6 +352,9 @@ void ReorderData::setSectionOrder(BinaryContext &BC,
   unsigned NumReordered = 0;
   uint64_t Offset = 0;
   uint64_t Count = 0;
+  // Cache lines touched by the sampled objects, before and after reordering.
+  // The new section is assumed to start on a cache line.
+  DenseSet<uint64_t> OldHotLines, NewHotLines;
 
   // Get the total count just for stats
   uint64_t TotalCount = 0;
@@ -389,6 +406,11 @@ void ReorderData::setSectionOrder(BinaryContext &BC,
       }
     }
 
+    if (Begin->second) {
+      addCacheLines(OldHotLines, BD->getAddress(), BD->getSize());
+      addCacheLines(NewHotLines, Offset, BD->getSize());
+    }
+
     Offset += BD->getSize();
     Count += Begin->second;
     NewOrder.push_back(BD);
@@ -399,6 +421,10 @@ void ReorderData::setSectionOrder(BinaryContext &BC,
   BC.outs() << "BOLT-INFO: reorder-data: " << Count << "/" << TotalCount
             << format(" (%.1f%%)", 100.0 * Count / TotalCount) << " events, "
             << Offset << " hot bytes\n";
+  if (!OldHotLines.empty())
+    BC.outs() << "BOLT-INFO: reorder-data: sampled objects span "
+              << NewHotLines.size() << " cache lines (" << OldHotLines.size()
+              << " before reordering)\n";
 }
 
 bool ReorderData::markUnmoveableSymbols(BinaryContext &BC,
@@ -18,6 +18,7 @@
 #include "llvm/Demangle/Demangle.h"
 #include "llvm/MC/MCPseudoProbe.h"
 #include "llvm/Support/CommandLine.h"
+#include "llvm/Support/Format.h"
 
 using namespace llvm;
 
@@ -867,15 +868,32 @@ Error YAMLProfileReader::readProfile(BinaryContext &BC) {
   NormalizeByInsnCount = usesEvent("cycles") || usesEvent("instructions");
   NormalizeByCalls = usesEvent("branches");
   uint64_t NumUnused = 0;
+  // Execution counts of the matched and unmatched function profiles, to tell
+  // how much of the profile weight is lost when the binary changed.
+  uint64_t MatchedExecCount = 0;
+  uint64_t UnmatchedExecCount = 0;
   for (yaml::bolt::BinaryFunctionProfile &YamlBF : YamlBP.Functions) {
-    if (BinaryFunction *BF = YamlProfileToFunction.lookup(YamlBF.Id))
+    if (BinaryFunction *BF = YamlProfileToFunction.lookup(YamlBF.Id)) {
       parseFunctionProfile(*BF, YamlBF);
-    else
+      MatchedExecCount += YamlBF.ExecCount;
+    } else {
       ++NumUnused;
+      UnmatchedExecCount += YamlBF.ExecCount;
+    }
   }
 
   BC.setNumUnusedProfiledObjects(NumUnused);
 
+  if (opts::Verbosity >= 1) {
+    const uint64_t TotalExecCount = MatchedExecCount + UnmatchedExecCount;
+    outs() << "BOLT-INFO: matched profile weight " << MatchedExecCount
+           << " out of " << TotalExecCount;
+    if (TotalExecCount)
+      outs() << format(" (%.1f%%)", 100.0 * MatchedExecCount / TotalExecCount);
+    outs() << ", unmatched " << UnmatchedExecCount << " in " << NumUnused
+           << " functions\n";
+  }
+
   if (opts::Lite &&
       (opts::MatchProfileWithFunctionHash || opts::MatchWithCallGraph)) {
     for (BinaryFunction *BF : BC.getAllBinaryFunctions())
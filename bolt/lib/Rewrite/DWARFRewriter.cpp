@@ -766,6 +766,10 @@ void DWARFRewriter::updateDebugInfo() {
     ThreadPool.wait();
     for (std::unique_ptr<DIEBuilder> &DWODIEBuilderPtr : DWODIEBuildersByCU)
       DWODIEBuilderPtr->updateDebugNamesTable();
+    // The DWO units of this batch have been written out. Release their DIEs
+    // before the batch's skeleton units are updated, so that both are not
+    // in memory at the same time.
+    DWODIEBuildersByCU.clear();
     for (DWARFUnit *CU : DIEBlder.getProcessedCUs())
       processMainBinaryCU(*CU, DIEBlder);
     finalizeCompileUnits(DIEBlder, *Streamer, OffsetMap,
@@ -4029,6 +4029,20 @@ void RewriteInstance::updateOutputValues(const BOLTLinker &Linker) {
 
   for (BinaryFunction *Function : BC->getAllBinaryFunctions())
     Function->updateOutputValues(Linker);
+
+  // Report the size of the hot part of the profiled functions. This is the
+  // code that -hot-text groups and -hugify remaps, so it tells how many huge
+  // pages the profile needs.
+  if (opts::HotText) {
+    uint64_t HotTextSize = 0;
+    for (const BinaryFunction *Function : BC->getAllBinaryFunctions())
+      if (Function->isEmitted() && Function->getKnownExecutionCount())
+        HotTextSize += Function->getOutputSize();
+    BC->outs() << "BOLT-INFO: hot text is " << HotTextSize
+               << " bytes, spanning "
+               << divideCeil(HotTextSize, BC->PageAlign) << " page(s) of 0x"
+               << Twine::utohexstr(BC->PageAlign) << " bytes\n";
+  }
 }
 
 void RewriteInstance::patchELFPHDRTable() {
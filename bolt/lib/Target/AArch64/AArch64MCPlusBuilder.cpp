@@ -121,8 +121,27 @@ static void createMovz(MCInst &Inst, MCPhysReg Reg, uint64_t Imm) {
   Inst.addOperand(MCOperand::createImm(0));
 }
 
-static InstructionListType createIncMemory(MCPhysReg RegTo, MCPhysReg RegTmp) {
+static void createAddImm(MCInst &Inst, MCPhysReg Reg, uint64_t Imm) {
+  Inst.clear();
+  Inst.setOpcode(AArch64::ADDXri);
+  Inst.addOperand(MCOperand::createReg(Reg));
+  Inst.addOperand(MCOperand::createReg(Reg));
+  Inst.addOperand(MCOperand::createImm(Imm));
+  Inst.addOperand(MCOperand::createImm(0));
+}
+
+static InstructionListType createIncMemory(MCPhysReg RegTo, MCPhysReg RegTmp,
+                                           bool IsAtomic) {
   InstructionListType Insts;
+  if (!IsAtomic) {
+    Insts.emplace_back();
+    loadReg(Insts.back(), RegTmp, RegTo);
+    Insts.emplace_back();
+    createAddImm(Insts.back(), RegTmp, 1);
+    Insts.emplace_back();
+    storeReg(Insts.back(), RegTmp, RegTo);
+    return Insts;
+  }
   Insts.emplace_back();
   createMovz(Insts.back(), RegTmp, 1);
   Insts.emplace_back();
@@ -2074,9 +2093,9 @@ public:
 
   InstructionListType
   createInstrIncMemory(const MCSymbol *Target, MCContext *Ctx, bool IsLeaf,
-                       unsigned CodePointerSize) const override {
+                       unsigned CodePointerSize, bool IsAtomic) const override {
     unsigned int I = 0;
-    InstructionListType Instrs(IsLeaf ? 12 : 10);
+    InstructionListType Instrs((IsLeaf ? 12 : 10) + (IsAtomic ? 0 : 1));
 
     if (IsLeaf)
       createStackPointerIncrement(Instrs[I++], 128);
@@ -2087,8 +2106,9 @@ public:
     std::copy(Addr.begin(), Addr.end(), Instrs.begin() + I);
     I += Addr.size();
     storeReg(Instrs[I++], AArch64::X2, AArch64::SP);
-    InstructionListType Insts = createIncMemory(AArch64::X0, AArch64::X2);
-    assert(Insts.size() == 2 && "Invalid Insts size");
+    InstructionListType Insts =
+        createIncMemory(AArch64::X0, AArch64::X2, IsAtomic);
+    assert(Insts.size() == (IsAtomic ? 2u : 3u) && "Invalid Insts size");
     std::copy(Insts.begin(), Insts.end(), Instrs.begin() + I);
     I += Insts.size();
     loadReg(Instrs[I++], AArch64::X2, AArch64::SP);
@@ -443,15 +443,15 @@ int main(int argc, char **argv) {
       mergeProfileHeaders(MergedHeader, BP.Header);
     }
 
-    // Do the function merge.
+    // Do the function merge. Profiles seen for the first time are moved
+    // rather than copied, so that a large input is not kept twice in memory
+    // while it is merged.
     for (BinaryFunctionProfile &BF : BP.Functions) {
-      if (!MergedBFs.count(BF.Name)) {
-        MergedBFs.insert(std::make_pair(BF.Name, BF));
-        continue;
-      }
-
-      BinaryFunctionProfile &MergedBF = MergedBFs.find(BF.Name)->second;
-      mergeFunctionProfile(MergedBF, std::move(BF));
+      auto [It, Inserted] = MergedBFs.try_emplace(BF.Name);
+      if (Inserted)
+        It->second = std::move(BF);
+      else
+        mergeFunctionProfile(It->second, std::move(BF));
     }
   }
 
@@ -19,10 +19,12 @@
 #include "ClangTidyDiagnosticConsumer.h"
 #include "ClangTidyModuleRegistry.h"
 #include "ClangTidyProfiling.h"
+#include "ClangTidyResultCache.h"
 #include "ExpandModularHeadersPPCallbacks.h"
 #include "clang-tidy-config.h"
 #include "clang/AST/ASTConsumer.h"
 #include "clang/ASTMatchers/ASTMatchFinder.h"
+#include "clang/Basic/Version.h"
 #include "clang/Format/Format.h"
 #include "clang/Frontend/ASTConsumers.h"
 #include "clang/Frontend/CompilerInstance.h"
@@ -524,15 +526,25 @@ getCheckOptions(const ClangTidyOptions &Options,
   return Factory.getCheckOptions();
 }
 
-std::vector<ClangTidyError>
-runClangTidy(clang::tidy::ClangTidyContext &Context,
-             const CompilationDatabase &Compilations,
-             ArrayRef<std::string> InputFiles,
-             llvm::IntrusiveRefCntPtr<llvm::vfs::OverlayFileSystem> BaseFS,
-             bool ApplyAnyFix, bool EnableCheckProfile,
-             llvm::StringRef StoreCheckProfile) {
+/// Runs the checks on \p InputFiles.
+///
+/// If \p Dependencies is not null, it is filled with the files read by the
+/// last translation unit, and the files it looked up but didn't find.
+static std::vector<ClangTidyError>
+runClangTidyOnFiles(ClangTidyContext &Context,
+                    const CompilationDatabase &Compilations,
+                    ArrayRef<std::string> InputFiles,
+                    IntrusiveRefCntPtr<llvm::vfs::OverlayFileSystem> BaseFS,
+                    bool ApplyAnyFix,
+                    std::vector<ResultCacheDependency> *Dependencies) {
+  // Record the files that weren't found, as creating one of them may change
+  // how includes and __has_include resolve.
+  llvm::StringSet<> MissingFiles;
+  IntrusiveRefCntPtr<llvm::vfs::FileSystem> ToolFS = BaseFS;
+  if (Dependencies)
+    ToolFS = ClangTidyResultCache::recordMissingFiles(ToolFS, MissingFiles);
   ClangTool Tool(Compilations, InputFiles,
-                 std::make_shared<PCHContainerOperations>(), BaseFS);
+                 std::make_shared<PCHContainerOperations>(), ToolFS);
 
   // Add extra arguments passed by the clang-tidy command-line.
   ArgumentsAdjuster PerFileExtraArgumentsInserter =
@@ -554,8 +566,6 @@ runClangTidy(clang::tidy::ClangTidyContext &Context,
 
   Tool.appendArgumentsAdjuster(PerFileExtraArgumentsInserter);
   Tool.appendArgumentsAdjuster(getStripPluginsAdjuster());
-  Context.setEnableProfiling(EnableCheckProfile);
-  Context.setProfileStoragePrefix(StoreCheckProfile);
 
   ClangTidyDiagnosticConsumer DiagConsumer(Context, nullptr, true, ApplyAnyFix);
   DiagnosticsEngine DE(new DiagnosticIDs(), new DiagnosticOptions(),
@@ -566,10 +576,14 @@ runClangTidy(clang::tidy::ClangTidyContext &Context,
   class ActionFactory : public FrontendActionFactory {
   public:
     ActionFactory(ClangTidyContext &Context,
-                  IntrusiveRefCntPtr<llvm::vfs::OverlayFileSystem> BaseFS)
-        : ConsumerFactory(Context, std::move(BaseFS)) {}
+                  IntrusiveRefCntPtr<llvm::vfs::OverlayFileSystem> BaseFS,
+                  std::vector<ResultCacheDependency> *Dependencies,
+                  const llvm::StringSet<> &MissingFiles)
+        : ConsumerFactory(Context, std::move(BaseFS)),
+          Dependencies(Dependencies), MissingFiles(MissingFiles) {}
     std::unique_ptr<FrontendAction> create() override {
-      return std::make_unique<Action>(&ConsumerFactory);
+      return std::make_unique<Action>(&ConsumerFactory, Dependencies,
+                                      MissingFiles);
     }
 
     bool runInvocation(std::shared_ptr<CompilerInvocation> Invocation,
@@ -585,24 +599,122 @@ runClangTidy(clang::tidy::ClangTidyContext &Context,
   private:
     class Action : public ASTFrontendAction {
     public:
-      Action(ClangTidyASTConsumerFactory *Factory) : Factory(Factory) {}
+      Action(ClangTidyASTConsumerFactory *Factory,
+             std::vector<ResultCacheDependency> *Dependencies,
+             const llvm::StringSet<> &MissingFiles)
+          : Factory(Factory), Dependencies(Dependencies),
+            MissingFiles(MissingFiles) {}
       std::unique_ptr<ASTConsumer> CreateASTConsumer(CompilerInstance &Compiler,
                                                      StringRef File) override {
         return Factory->createASTConsumer(Compiler, File);
       }
 
+      void EndSourceFileAction() override {
+        if (Dependencies)
+          *Dependencies = ClangTidyResultCache::collectDependencies(
+              getCompilerInstance().getSourceManager(), MissingFiles);
+      }
+
     private:
       ClangTidyASTConsumerFactory *Factory;
+      std::vector<ResultCacheDependency> *Dependencies;
+      const llvm::StringSet<> &MissingFiles;
     };
 
     ClangTidyASTConsumerFactory ConsumerFactory;
+    std::vector<ResultCacheDependency> *Dependencies;
+    const llvm::StringSet<> &MissingFiles;
   };
 
-  ActionFactory Factory(Context, std::move(BaseFS));
+  ActionFactory Factory(Context, std::move(BaseFS), Dependencies,
+                        MissingFiles);
   Tool.run(&Factory);
   return DiagConsumer.take();
 }
 
+/// Returns everything besides the contents of the files it reads that the
+/// diagnostics of \p File depend on.
+static std::string getResultCacheKeyData(const ClangTidyContext &Context,
+                                         const CompilationDatabase &Compilations,
+                                         StringRef File, bool ApplyAnyFix) {
+  std::string Data;
+  llvm::raw_string_ostream OS(Data);
+  OS << getClangToolFullVersion("clang-tidy") << '\0' << File << '\0'
+     << ApplyAnyFix << Context.canEnableAnalyzerAlphaCheckers()
+     << Context.canEnableModuleHeadersParsing() << '\0';
+  for (const CompileCommand &Command : Compilations.getCompileCommands(File)) {
+    OS << Command.Directory << '\0';
+    for (const std::string &Arg : Command.CommandLine)
+      OS << Arg << '\0';
+  }
+  for (const FileFilter &Filter : Context.getGlobalOptions().LineFilter) {
+    OS << Filter.Name << '\0';
+    for (const FileFilter::LineRange &Range : Filter.LineRanges)
+      OS << Range.first << '-' << Range.second << '\0';
+  }
+  OS << configurationAsText(Context.getOptionsForFile(File));
+  return Data;
+}
+
+std::vector<ClangTidyError>
+runClangTidy(clang::tidy::ClangTidyContext &Context,
+             const CompilationDatabase &Compilations,
+             ArrayRef<std::string> InputFiles,
+             llvm::IntrusiveRefCntPtr<llvm::vfs::OverlayFileSystem> BaseFS,
+             bool ApplyAnyFix, bool EnableCheckProfile,
+             llvm::StringRef StoreCheckProfile, llvm::StringRef CacheDirectory) {
+  Context.setEnableProfiling(EnableCheckProfile);
+  Context.setProfileStoragePrefix(StoreCheckProfile);
+
+  // Profiles can't be replayed, so don't use the cache when collecting them.
+  if (CacheDirectory.empty() || EnableCheckProfile)
+    return runClangTidyOnFiles(Context, Compilations, InputFiles,
+                               std::move(BaseFS), ApplyAnyFix,
+                               /*Dependencies=*/nullptr);
+
+  // Run each translation unit on its own, so that its diagnostics and the
+  // files it read can be recorded.
+  ClangTidyResultCache Cache(CacheDirectory);
+  std::vector<ClangTidyError> Errors;
+  for (const std::string &File : InputFiles) {
+    std::string Key = ClangTidyResultCache::computeKey(
+        getResultCacheKeyData(Context, Compilations, File, ApplyAnyFix));
+    ClangTidyStats Stats;
+    if (Cache.lookup(Key, *BaseFS, Errors, Stats)) {
+      Context.addStats(Stats);
+      continue;
+    }
+
+    ClangTidyStats Before = Context.getStats();
+    std::vector<ResultCacheDependency> Dependencies;
+    std::vector<ClangTidyError> FileErrors =
+        runClangTidyOnFiles(Context, Compilations, File, BaseFS, ApplyAnyFix,
+                            &Dependencies);
+    const ClangTidyStats &After = Context.getStats();
+    Stats.ErrorsDisplayed = After.ErrorsDisplayed - Before.ErrorsDisplayed;
+    Stats.ErrorsIgnoredCheckFilter =
+        After.ErrorsIgnoredCheckFilter - Before.ErrorsIgnoredCheckFilter;
+    Stats.ErrorsIgnoredNOLINT =
+        After.ErrorsIgnoredNOLINT - Before.ErrorsIgnoredNOLINT;
+    Stats.ErrorsIgnoredNonUserCode =
+        After.ErrorsIgnoredNonUserCode - Before.ErrorsIgnoredNonUserCode;
+    Stats.ErrorsIgnoredLineFilter =
+        After.ErrorsIgnoredLineFilter - Before.ErrorsIgnoredLineFilter;
+
+    // A compiler error may go away without any of the files read changing,
+    // e.g. when a missing header is added.
+    bool HasCompilerErrors = llvm::any_of(FileErrors, [](const auto &Error) {
+      return Error.DiagLevel == ClangTidyError::Error &&
+             !Error.IsWarningAsError;
+    });
+    if (!HasCompilerErrors && !Dependencies.empty())
+      Cache.store(Key, Dependencies, FileErrors, Stats);
+    llvm::append_range(Errors, std::move(FileErrors));
+  }
+  removeDuplicateErrors(Errors);
+  return Errors;
+}
+
 void handleErrors(llvm::ArrayRef<ClangTidyError> Errors,
                   ClangTidyContext &Context, FixBehaviour Fix,
                   unsigned &WarningsAsErrorsCount,
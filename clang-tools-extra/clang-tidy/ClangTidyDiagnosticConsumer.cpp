@@ -257,6 +257,14 @@ const ClangTidyGlobalOptions &ClangTidyContext::getGlobalOptions() const {
   return OptionsProvider->getGlobalOptions();
 }
 
+void ClangTidyContext::addStats(const ClangTidyStats &Other) {
+  Stats.ErrorsDisplayed += Other.ErrorsDisplayed;
+  Stats.ErrorsIgnoredCheckFilter += Other.ErrorsIgnoredCheckFilter;
+  Stats.ErrorsIgnoredNOLINT += Other.ErrorsIgnoredNOLINT;
+  Stats.ErrorsIgnoredNonUserCode += Other.ErrorsIgnoredNonUserCode;
+  Stats.ErrorsIgnoredLineFilter += Other.ErrorsIgnoredLineFilter;
+}
+
 const ClangTidyOptions &ClangTidyContext::getOptions() const {
   return CurrentOptions;
 }
@@ -745,12 +753,16 @@ struct EqualClangTidyError {
 };
 } // end anonymous namespace
 
-std::vector<ClangTidyError> ClangTidyDiagnosticConsumer::take() {
-  finalizeLastError();
-
+void clang::tidy::removeDuplicateErrors(std::vector<ClangTidyError> &Errors) {
   llvm::stable_sort(Errors, LessClangTidyError());
   Errors.erase(std::unique(Errors.begin(), Errors.end(), EqualClangTidyError()),
                Errors.end());
+}
+
+std::vector<ClangTidyError> ClangTidyDiagnosticConsumer::take() {
+  finalizeLastError();
+
+  removeDuplicateErrors(Errors);
   if (RemoveIncompatibleErrors)
     removeIncompatibleErrors();
   return std::move(Errors);
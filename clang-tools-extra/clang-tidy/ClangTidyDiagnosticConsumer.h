@@ -43,6 +43,10 @@ struct ClangTidyError : tooling::Diagnostic {
   std::vector<std::string> EnabledDiagnosticAliases;
 };
 
+/// Sorts \p Errors and removes the duplicates among them, such as the ones
+/// reported in a header included by several translation units.
+void removeDuplicateErrors(std::vector<ClangTidyError> &Errors);
+
 /// Contains displayed and ignored diagnostic counters for a ClangTidy run.
 struct ClangTidyStats {
   unsigned ErrorsDisplayed = 0;
@@ -177,6 +181,10 @@ public:
   /// counters.
   const ClangTidyStats &getStats() const { return Stats; }
 
+  /// Adds \p Other, the counters of a translation unit whose diagnostics were
+  /// not collected through this context, to \c getStats().
+  void addStats(const ClangTidyStats &Other);
+
   /// Control profile collection in clang-tidy.
   void setEnableProfiling(bool Profile);
   bool getEnableProfiling() const { return Profile; }
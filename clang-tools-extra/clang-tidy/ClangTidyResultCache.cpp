@@ -0,0 +1,232 @@
+//===--- ClangTidyResultCache.cpp - clang-tidy ------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "ClangTidyResultCache.h"
+#include "clang/Basic/FileManager.h"
+#include "clang/Basic/SourceManager.h"
+#include "clang/Tooling/DiagnosticsYaml.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/SHA256.h"
+#include "llvm/Support/VirtualFileSystem.h"
+#include "llvm/Support/YAMLTraits.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Support/xxhash.h"
+
+namespace clang::tidy {
+namespace {
+
+struct CachedError {
+  tooling::Diagnostic Diag;
+  bool IsWarningAsError = false;
+  std::vector<std::string> EnabledDiagnosticAliases;
+};
+
+struct CacheEntry {
+  std::vector<ResultCacheDependency> Dependencies;
+  ClangTidyStats Stats;
+  std::vector<CachedError> Errors;
+};
+
+} // namespace
+} // namespace clang::tidy
+
+LLVM_YAML_IS_SEQUENCE_VECTOR(clang::tidy::ResultCacheDependency)
+LLVM_YAML_IS_SEQUENCE_VECTOR(clang::tidy::CachedError)
+
+namespace llvm::yaml {
+
+template <> struct MappingTraits<clang::tidy::ResultCacheDependency> {
+  static void mapping(IO &IO, clang::tidy::ResultCacheDependency &Dep) {
+    IO.mapRequired("Path", Dep.Path);
+    IO.mapOptional("Hash", Dep.Hash, 0u);
+    IO.mapOptional("Exists", Dep.Exists, true);
+  }
+};
+
+template <> struct MappingTraits<clang::tidy::ClangTidyStats> {
+  static void mapping(IO &IO, clang::tidy::ClangTidyStats &Stats) {
+    IO.mapOptional("ErrorsDisplayed", Stats.ErrorsDisplayed, 0u);
+    IO.mapOptional("ErrorsIgnoredCheckFilter", Stats.ErrorsIgnoredCheckFilter,
+                   0u);
+    IO.mapOptional("ErrorsIgnoredNOLINT", Stats.ErrorsIgnoredNOLINT, 0u);
+    IO.mapOptional("ErrorsIgnoredNonUserCode", Stats.ErrorsIgnoredNonUserCode,
+                   0u);
+    IO.mapOptional("ErrorsIgnoredLineFilter", Stats.ErrorsIgnoredLineFilter,
+                   0u);
+  }
+};
+
+template <> struct MappingTraits<clang::tidy::CachedError> {
+  static void mapping(IO &IO, clang::tidy::CachedError &Error) {
+    IO.mapRequired("Diagnostic", Error.Diag);
+    IO.mapOptional("IsWarningAsError", Error.IsWarningAsError, false);
+    IO.mapOptional("EnabledDiagnosticAliases", Error.EnabledDiagnosticAliases);
+  }
+};
+
+template <> struct MappingTraits<clang::tidy::CacheEntry> {
+  static void mapping(IO &IO, clang::tidy::CacheEntry &Entry) {
+    IO.mapRequired("Dependencies", Entry.Dependencies);
+    IO.mapRequired("Stats", Entry.Stats);
+    IO.mapRequired("Errors", Entry.Errors);
+  }
+};
+
+} // namespace llvm::yaml
+
+namespace clang::tidy {
+
+static uint64_t hashContents(StringRef Contents) {
+  return llvm::xxh3_64bits(Contents);
+}
+
+std::string ClangTidyResultCache::computeKey(StringRef KeyData) {
+  return llvm::toHex(llvm::SHA256::hash(llvm::arrayRefFromStringRef(KeyData)),
+                     /*LowerCase=*/true);
+}
+
+llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem>
+ClangTidyResultCache::recordMissingFiles(
+    llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> FS,
+    llvm::StringSet<> &MissingFiles) {
+  class RecordingFS : public llvm::vfs::ProxyFileSystem {
+  public:
+    RecordingFS(llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> FS,
+                llvm::StringSet<> &MissingFiles)
+        : ProxyFileSystem(std::move(FS)), MissingFiles(MissingFiles) {}
+
+    llvm::ErrorOr<std::unique_ptr<llvm::vfs::File>>
+    openFileForRead(const llvm::Twine &Path) override {
+      auto File = getUnderlyingFS().openFileForRead(Path);
+      if (!File)
+        record(Path, File.getError());
+      return File;
+    }
+
+    llvm::ErrorOr<llvm::vfs::Status> status(const llvm::Twine &Path) override {
+      auto S = getUnderlyingFS().status(Path);
+      if (!S)
+        record(Path, S.getError());
+      return S;
+    }
+
+    bool exists(const llvm::Twine &Path) override { return bool(status(Path)); }
+
+  private:
+    void record(const llvm::Twine &Path, std::error_code EC) {
+      if (EC != std::errc::no_such_file_or_directory)
+        return;
+      llvm::SmallString<256> AbsPath;
+      Path.toVector(AbsPath);
+      if (makeAbsolute(AbsPath))
+        return;
+      llvm::sys::path::remove_dots(AbsPath, /*remove_dot_dot=*/true);
+      MissingFiles.insert(AbsPath);
+    }
+
+    llvm::StringSet<> &MissingFiles;
+  };
+  return llvm::makeIntrusiveRefCnt<RecordingFS>(std::move(FS), MissingFiles);
+}
+
+std::vector<ResultCacheDependency>
+ClangTidyResultCache::collectDependencies(
+    const SourceManager &SM, const llvm::StringSet<> &MissingFiles) {
+  std::vector<ResultCacheDependency> Deps;
+  for (auto It = SM.fileinfo_begin(), E = SM.fileinfo_end(); It != E; ++It) {
+    // Files that were only looked up, but never read, can't change the
+    // results.
+    std::optional<StringRef> Contents = It->second->getBufferDataIfLoaded();
+    if (!Contents)
+      continue;
+    llvm::SmallString<256> Path(It->first.getName());
+    SM.getFileManager().makeAbsolutePath(Path);
+    llvm::sys::path::remove_dots(Path, /*remove_dot_dot=*/true);
+    Deps.push_back({std::string(Path), hashContents(*Contents)});
+  }
+  for (const auto &Missing : MissingFiles)
+    Deps.push_back({Missing.getKey().str(), 0, /*Exists=*/false});
+  llvm::sort(Deps, [](const ResultCacheDependency &LHS,
+                      const ResultCacheDependency &RHS) {
+    return LHS.Path < RHS.Path;
+  });
+  return Deps;
+}
+
+std::string ClangTidyResultCache::getEntryPath(StringRef Key) const {
+  llvm::SmallString<256> Path(Directory);
+  llvm::sys::path::append(Path, Key + ".yaml");
+  return std::string(Path);
+}
+
+bool ClangTidyResultCache::lookup(StringRef Key, llvm::vfs::FileSystem &FS,
+                                  std::vector<ClangTidyError> &Errors,
+                                  ClangTidyStats &Stats) const {
+  llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> Buffer =
+      llvm::MemoryBuffer::getFile(getEntryPath(Key), /*IsText=*/true);
+  if (!Buffer)
+    return false;
+
+  CacheEntry Entry;
+  llvm::yaml::Input Input((*Buffer)->getBuffer());
+  Input >> Entry;
+  if (Input.error())
+    return false;
+
+  for (const ResultCacheDependency &Dep : Entry.Dependencies) {
+    if (!Dep.Exists) {
+      if (FS.exists(Dep.Path))
+        return false;
+      continue;
+    }
+    llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> Contents =
+        FS.getBufferForFile(Dep.Path);
+    if (!Contents || hashContents((*Contents)->getBuffer()) != Dep.Hash)
+      return false;
+  }
+
+  for (CachedError &Cached : Entry.Errors) {
+    ClangTidyError Error(Cached.Diag.DiagnosticName, Cached.Diag.DiagLevel,
+                         Cached.Diag.BuildDirectory, Cached.IsWarningAsError);
+    static_cast<tooling::Diagnostic &>(Error) = std::move(Cached.Diag);
+    Error.EnabledDiagnosticAliases = std::move(Cached.EnabledDiagnosticAliases);
+    Errors.push_back(std::move(Error));
+  }
+  Stats = Entry.Stats;
+  return true;
+}
+
+void ClangTidyResultCache::store(StringRef Key,
+                                 ArrayRef<ResultCacheDependency> Deps,
+                                 ArrayRef<ClangTidyError> Errors,
+                                 const ClangTidyStats &Stats) const {
+  CacheEntry Entry;
+  Entry.Dependencies.assign(Deps.begin(), Deps.end());
+  Entry.Stats = Stats;
+  for (const ClangTidyError &Error : Errors)
+    Entry.Errors.push_back(
+        {Error, Error.IsWarningAsError, Error.EnabledDiagnosticAliases});
+
+  if (llvm::sys::fs::create_directories(Directory))
+    return;
+  // writeToOutput() goes through a temporary file, so concurrent runs never
+  // observe a partially written entry.
+  llvm::consumeError(
+      llvm::writeToOutput(getEntryPath(Key), [&](llvm::raw_ostream &OS) {
+        llvm::yaml::Output Output(OS);
+        Output << Entry;
+        return llvm::Error::success();
+      }));
+}
+
+} // namespace clang::tidy
@@ -0,0 +1,94 @@
+//===--- ClangTidyResultCache.h - clang-tidy --------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_CLANG_TOOLS_EXTRA_CLANG_TIDY_CLANGTIDYRESULTCACHE_H
+#define LLVM_CLANG_TOOLS_EXTRA_CLANG_TIDY_CLANGTIDYRESULTCACHE_H
+
+#include "ClangTidyDiagnosticConsumer.h"
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/IntrusiveRefCntPtr.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/ADT/StringSet.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace llvm::vfs {
+class FileSystem;
+} // namespace llvm::vfs
+
+namespace clang {
+
+class SourceManager;
+
+namespace tidy {
+
+/// A file whose contents the diagnostics of a translation unit depend on, or
+/// a file it looked up but didn't find.
+struct ResultCacheDependency {
+  std::string Path;
+  /// The hash of the contents of the file, if it exists.
+  uint64_t Hash = 0;
+  /// Whether the file was found. Creating a file that wasn't found, such as a
+  /// header shadowing one later in the include path, can change the results.
+  bool Exists = true;
+};
+
+/// An on-disk cache of the diagnostics emitted for translation units.
+///
+/// An entry is stored under a key that covers everything known before the
+/// translation unit is parsed: the tool version, the compile command and the
+/// effective configuration. It records the files the translation unit read,
+/// with a hash of their contents, and the files it looked up without finding
+/// them. The entry is only used if none of the files read changed, and none
+/// of the missing files has been created, since.
+class ClangTidyResultCache {
+public:
+  explicit ClangTidyResultCache(llvm::StringRef Directory)
+      : Directory(Directory) {}
+
+  /// Returns the key of an entry, computed from \p KeyData.
+  static std::string computeKey(llvm::StringRef KeyData);
+
+  /// Returns a file system forwarding to \p FS, that adds the absolute paths
+  /// it is asked about but doesn't find to \p MissingFiles.
+  static llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem>
+  recordMissingFiles(llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> FS,
+                     llvm::StringSet<> &MissingFiles);
+
+  /// Returns the files read by the translation unit of \p SM, with the hash
+  /// of the contents it saw, and the \p MissingFiles it looked up.
+  static std::vector<ResultCacheDependency>
+  collectDependencies(const SourceManager &SM,
+                      const llvm::StringSet<> &MissingFiles);
+
+  /// Looks up the entry for \p Key.
+  ///
+  /// \returns \c false if there is no entry or some of its dependencies, as
+  /// read through \p FS, changed. Otherwise, appends the recorded diagnostics
+  /// to \p Errors and sets \p Stats to the recorded counters.
+  bool lookup(llvm::StringRef Key, llvm::vfs::FileSystem &FS,
+              std::vector<ClangTidyError> &Errors, ClangTidyStats &Stats) const;
+
+  /// Stores the outcome of a translation unit under \p Key.
+  ///
+  /// Failures to write the entry are ignored, the next run will simply miss.
+  void store(llvm::StringRef Key, llvm::ArrayRef<ResultCacheDependency> Deps,
+             llvm::ArrayRef<ClangTidyError> Errors,
+             const ClangTidyStats &Stats) const;
+
+private:
+  std::string getEntryPath(llvm::StringRef Key) const;
+
+  std::string Directory;
+};
+
+} // namespace tidy
+} // namespace clang
+
+#endif // LLVM_CLANG_TOOLS_EXTRA_CLANG_TIDY_CLANGTIDYRESULTCACHE_H
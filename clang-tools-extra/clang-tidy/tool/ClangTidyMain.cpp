@@ -275,6 +275,18 @@ these per-TU profiles are instead stored as JSON.
                                               cl::value_desc("prefix"),
                                               cl::cat(ClangTidyCategory));
 
+static cl::opt<std::string> CacheDir("cache-dir", desc(R"(
+Directory to store the diagnostics of each
+translation unit in. A translation unit is not
+analyzed again as long as its compile command,
+the configuration and the contents of the
+files it reads don't change; its stored
+diagnostics are reported instead. Ignored with
+-enable-check-profile.
+)"),
+                                     cl::value_desc("directory"),
+                                     cl::cat(ClangTidyCategory));
+
 /// This option allows enabling the experimental alpha checkers from the static
 /// analyzer. This option is set to false and not visible in help, because it is
 /// highly not recommended for users.
@@ -712,7 +724,7 @@ int clangTidyMain(int argc, const char **argv) {
                            EnableModuleHeadersParsing);
   std::vector<ClangTidyError> Errors =
       runClangTidy(Context, OptionsParser->getCompilations(), PathList, BaseFS,
-                   FixNotes, EnableCheckProfile, ProfilePrefix);
+                   FixNotes, EnableCheckProfile, ProfilePrefix, CacheDir);
   bool FoundErrors = llvm::any_of(Errors, [](const ClangTidyError &E) {
     return E.DiagLevel == ClangTidyError::Error;
   });
@@ -218,6 +218,7 @@ public:
     if (Handler != Server.Handlers.NotificationHandlers.end()) {
       Handler->second(std::move(Params));
       Server.maybeExportMemoryProfile();
+      Server.maybeEnforceMemoryBudget();
       Server.maybeCleanupMemory();
     } else if (!Server.Server) {
       elog("Notification {0} before initialization", Method);
@@ -236,9 +237,14 @@ public:
     WithContext WithCancel(cancelableRequestContext(ID));
     trace::Span Tracer(Method, LSPLatency);
     SPAN_ATTACH(Tracer, "Params", Params);
-    ReplyOnce Reply(ID, Method, &Server, Tracer.Args);
     log("<-- {0}({1})", Method, ID);
     auto Handler = Server.Handlers.MethodHandlers.find(Method);
+    // Histograms are only created for known methods, and only on this thread.
+    // Replies may arrive on any thread, and record into them without locking.
+    LatencyHistogram *Latency = nullptr;
+    if (Handler != Server.Handlers.MethodHandlers.end())
+      Latency = &Server.RequestLatency[Method];
+    ReplyOnce Reply(ID, Method, &Server, Tracer.Args, Latency);
     if (Handler != Server.Handlers.MethodHandlers.end()) {
       Handler->second(std::move(Params), std::move(Reply));
     } else if (!Server.Server) {
@@ -332,18 +338,21 @@ private:
     std::string Method;
     ClangdLSPServer *Server; // Null when moved-from.
     llvm::json::Object *TraceArgs;
+    LatencyHistogram *Latency;
 
   public:
     ReplyOnce(const llvm::json::Value &ID, llvm::StringRef Method,
-              ClangdLSPServer *Server, llvm::json::Object *TraceArgs)
+              ClangdLSPServer *Server, llvm::json::Object *TraceArgs,
+              LatencyHistogram *Latency = nullptr)
         : Start(std::chrono::steady_clock::now()), ID(ID), Method(Method),
-          Server(Server), TraceArgs(TraceArgs) {
+          Server(Server), TraceArgs(TraceArgs), Latency(Latency) {
       assert(Server);
     }
     ReplyOnce(ReplyOnce &&Other)
         : Replied(Other.Replied.load()), Start(Other.Start),
           ID(std::move(Other.ID)), Method(std::move(Other.Method)),
-          Server(Other.Server), TraceArgs(Other.TraceArgs) {
+          Server(Other.Server), TraceArgs(Other.TraceArgs),
+          Latency(Other.Latency) {
       Other.Server = nullptr;
     }
     ReplyOnce &operator=(ReplyOnce &&) = delete;
@@ -373,6 +382,8 @@ private:
         return;
       }
       auto Duration = std::chrono::steady_clock::now() - Start;
+      if (Latency)
+        Latency->record(Duration);
       if (Reply) {
         log("--> reply:{0}({1}) {2:ms}", Method, ID, Duration);
         if (TraceArgs)
@@ -560,14 +571,22 @@ void ClangdLSPServer::onInitialize(const InitializeParams &Params,
   }
   auto Mangler = CommandMangler::detect();
   Mangler.SystemIncludeExtractor =
-      getSystemIncludeExtractor(llvm::ArrayRef(Opts.QueryDriverGlobs));
+      getSystemIncludeExtractor(llvm::ArrayRef(Opts.QueryDriverGlobs),
+                                Opts.QueryDriverCacheDir);
   if (Opts.ResourceDir)
     Mangler.ResourceDir = *Opts.ResourceDir;
   CDB.emplace(BaseCDB.get(), Params.initializationOptions.fallbackFlags,
               std::move(Mangler));
 
   if (Opts.EnableExperimentalModulesSupport) {
-    ModulesManager.emplace(*CDB);
+    // Module files are kept in {CACHE_DIR}/clangd/module_files, e.g.
+    // "~/.cache/clangd/module_files", and shared with later sessions.
+    llvm::SmallString<256> ModuleFilesDir;
+    if (llvm::sys::path::cache_directory(ModuleFilesDir))
+      llvm::sys::path::append(ModuleFilesDir, "clangd", "module_files");
+    else
+      ModuleFilesDir.clear();
+    ModulesManager.emplace(*CDB, ModuleFilesDir);
     Opts.ModulesManager = &*ModulesManager;
   }
 
@@ -611,7 +630,7 @@ void ClangdLSPServer::onInitialize(const InitializeParams &Params,
       {"semanticTokensProvider",
        llvm::json::Object{
            {"full", llvm::json::Object{{"delta", true}}},
-           {"range", false},
+           {"range", true},
            {"legend",
             llvm::json::Object{{"tokenTypes", semanticTokenTypes()},
                                {"tokenModifiers", semanticTokenModifiers()}}},
@@ -641,6 +660,7 @@ void ClangdLSPServer::onInitialize(const InitializeParams &Params,
       // extension we really have support for the standardized one as well.
       {"standardTypeHierarchyProvider", true}, // clangd extension
       {"memoryUsageProvider", true},           // clangd extension
+      {"requestLatencyProvider", true},        // clangd extension
       {"compilationDatabase",                  // clangd extension
        llvm::json::Object{{"automaticReload", true}}},
       {"inactiveRegionsProvider", true}, // clangd extension
@@ -1451,6 +1471,27 @@ void ClangdLSPServer::maybeExportMemoryProfile() {
   record(MT, "clangd_lsp_server", MemoryUsage);
 }
 
+void ClangdLSPServer::maybeEnforceMemoryBudget() {
+  if (!Opts.MemoryBudget || !Server || !ShouldCheckMemoryBudget())
+    return;
+
+  static constexpr trace::Metric MemoryReleased(
+      "memory_budget_released", trace::Metric::Distribution);
+  trace::Span Tracer("EnforceMemoryBudget");
+  MemoryTree MT;
+  profile(MT);
+  size_t Total = MT.total();
+  if (Total <= Opts.MemoryBudget)
+    return;
+  size_t Released = Server->releaseMemory(Total - Opts.MemoryBudget);
+  MemoryReleased.record(Released);
+  log("Memory usage {0}MB exceeds budget of {1}MB, released {2}MB",
+      Total >> 20, Opts.MemoryBudget >> 20, Released >> 20);
+  // Hand the freed pages back to the OS without waiting for the next period.
+  if (Released && Opts.MemoryCleanup)
+    Opts.MemoryCleanup();
+}
+
 void ClangdLSPServer::maybeCleanupMemory() {
   if (!Opts.MemoryCleanup || !ShouldCleanupMemory())
     return;
@@ -1626,6 +1667,23 @@ void ClangdLSPServer::onSemanticTokensDelta(
       });
 }
 
+void ClangdLSPServer::onSemanticTokensRange(
+    const SemanticTokensRangeParams &Params, Callback<SemanticTokens> CB) {
+  auto File = Params.textDocument.uri.file();
+  Server->semanticHighlights(
+      File, Params.range,
+      [CB(std::move(CB)), Code(Server->getDraft(File))](
+          llvm::Expected<std::vector<HighlightingToken>> HT) mutable {
+        if (!HT)
+          return CB(HT.takeError());
+        // Range results don't participate in delta requests, so they don't
+        // get a resultId.
+        SemanticTokens Result;
+        Result.tokens = toSemanticTokens(*HT, *Code);
+        CB(std::move(Result));
+      });
+}
+
 void ClangdLSPServer::onMemoryUsage(const NoParams &,
                                     Callback<MemoryTree> Reply) {
   llvm::BumpPtrAllocator DetailAlloc;
@@ -1634,6 +1692,14 @@ void ClangdLSPServer::onMemoryUsage(const NoParams &,
   Reply(std::move(MT));
 }
 
+void ClangdLSPServer::onRequestLatency(const NoParams &,
+                                       Callback<llvm::json::Value> Reply) {
+  llvm::json::Object Result;
+  for (const auto &Entry : RequestLatency)
+    Result[Entry.first()] = Entry.second.toJSON();
+  Reply(std::move(Result));
+}
+
 void ClangdLSPServer::onAST(const ASTParams &Params,
                             Callback<std::optional<ASTNode>> CB) {
   Server->getAST(Params.textDocument.uri.file(), Params.range, std::move(CB));
@@ -1645,6 +1711,7 @@ ClangdLSPServer::ClangdLSPServer(Transport &Transp, const ThreadsafeFS &TFS,
                     /*Delay=*/std::chrono::minutes(1)),
       ShouldCleanupMemory(/*Period=*/std::chrono::minutes(1),
                           /*Delay=*/std::chrono::minutes(1)),
+      ShouldCheckMemoryBudget(/*Period=*/std::chrono::seconds(10)),
       BackgroundContext(Context::current().clone()), Transp(Transp),
       MsgHandler(new MessageHandler(*this)), TFS(TFS),
       SupportedSymbolKinds(defaultSymbolKinds()),
@@ -1705,9 +1772,11 @@ void ClangdLSPServer::bindMethods(LSPBinder &Bind,
   Bind.method("textDocument/documentLink", this, &ClangdLSPServer::onDocumentLink);
   Bind.method("textDocument/semanticTokens/full", this, &ClangdLSPServer::onSemanticTokens);
   Bind.method("textDocument/semanticTokens/full/delta", this, &ClangdLSPServer::onSemanticTokensDelta);
+  Bind.method("textDocument/semanticTokens/range", this, &ClangdLSPServer::onSemanticTokensRange);
   Bind.method("clangd/inlayHints", this, &ClangdLSPServer::onClangdInlayHints);
   Bind.method("textDocument/inlayHint", this, &ClangdLSPServer::onInlayHint);
   Bind.method("$/memoryUsage", this, &ClangdLSPServer::onMemoryUsage);
+  Bind.method("$/requestLatency", this, &ClangdLSPServer::onRequestLatency);
   Bind.method("textDocument/foldingRange", this, &ClangdLSPServer::onFoldingRange);
   Bind.command(ApplyFixCommand, this, &ClangdLSPServer::onCommandApplyEdit);
   Bind.command(ApplyTweakCommand, this, &ClangdLSPServer::onCommandApplyTweak);
@@ -16,6 +16,7 @@
 #include "Protocol.h"
 #include "Transport.h"
 #include "support/Context.h"
+#include "support/Histogram.h"
 #include "support/MemoryTree.h"
 #include "support/Path.h"
 #include "support/Threading.h"
@@ -50,6 +51,9 @@ public:
     /// If set, periodically called to release memory.
     /// Consider malloc_trim(3)
     std::function<void()> MemoryCleanup = nullptr;
+    /// If nonzero, caches that can be rebuilt on demand are released whenever
+    /// the usage reported by profile() exceeds this many bytes.
+    size_t MemoryBudget = 0;
 
     /// Per-feature options. Generally ClangdServer lets these vary
     /// per-request, but LSP allows limited/no customizations.
@@ -175,9 +179,14 @@ private:
   void onSemanticTokens(const SemanticTokensParams &, Callback<SemanticTokens>);
   void onSemanticTokensDelta(const SemanticTokensDeltaParams &,
                              Callback<SemanticTokensOrDelta>);
+  void onSemanticTokensRange(const SemanticTokensRangeParams &,
+                             Callback<SemanticTokens>);
   /// This is a clangd extension. Provides a json tree representing memory usage
   /// hierarchy.
   void onMemoryUsage(const NoParams &, Callback<MemoryTree>);
+  /// This is a clangd extension. Summarizes the latency of each LSP method
+  /// handled so far, from receiving the request to sending the reply.
+  void onRequestLatency(const NoParams &, Callback<llvm::json::Value>);
   void onCommand(const ExecuteCommandParams &, Callback<llvm::json::Value>);
 
   /// Implement commands.
@@ -228,6 +237,11 @@ private:
   void maybeCleanupMemory();
   PeriodicThrottler ShouldCleanupMemory;
 
+  /// Measures memory usage and releases caches if it exceeds
+  /// Opts.MemoryBudget. Runs on the main thread, at most every few seconds.
+  void maybeEnforceMemoryBudget();
+  PeriodicThrottler ShouldCheckMemoryBudget;
+
   /// Since initialization of CDBs and ClangdServer is done lazily, the
   /// following context captures the one used while creating ClangdLSPServer and
   /// passes it to above mentioned object instances to make sure they share the
@@ -279,6 +293,9 @@ private:
   void notify(StringRef Method, llvm::json::Value Params) override;
 
   LSPBinder::RawHandlers Handlers;
+  /// Latency of calls, keyed by method. Only accessed on the main thread, but
+  /// the histograms themselves are written to when replying, on any thread.
+  llvm::StringMap<LatencyHistogram> RequestLatency;
 
   const ThreadsafeFS &TFS;
   /// Options used for diagnostics.
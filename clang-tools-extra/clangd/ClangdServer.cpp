@@ -460,6 +460,10 @@ void ClangdServer::codeComplete(PathRef File, Position Pos,
     CodeCompleteResult Result = clangd::codeComplete(
         File, Pos, IP->Preamble, ParseInput, CodeCompleteOpts,
         SpecFuzzyFind ? &*SpecFuzzyFind : nullptr);
+    // Completion skips its later phases once cancelled, the (partial) result
+    // must not be reported as if it was complete.
+    if (auto Reason = isCancelled())
+      return CB(llvm::make_error<CancelledError>(Reason));
     {
       clang::clangd::trace::Span Tracer("Completion results callback");
       CB(std::move(Result));
@@ -1049,8 +1053,14 @@ void ClangdServer::documentLinks(PathRef File,
 
 void ClangdServer::semanticHighlights(
     PathRef File, Callback<std::vector<HighlightingToken>> CB) {
+  semanticHighlights(File, std::nullopt, std::move(CB));
+}
 
-  auto Action = [CB = std::move(CB),
+void ClangdServer::semanticHighlights(
+    PathRef File, std::optional<Range> Restrict,
+    Callback<std::vector<HighlightingToken>> CB) {
+
+  auto Action = [CB = std::move(CB), Restrict,
                  PublishInactiveRegions = PublishInactiveRegions](
                     llvm::Expected<InputsAndAST> InpAST) mutable {
     if (!InpAST)
@@ -1058,7 +1068,8 @@ void ClangdServer::semanticHighlights(
     // Include inactive regions in semantic highlighting tokens only if the
     // client doesn't support a dedicated protocol for being informed about
     // them.
-    CB(clangd::getSemanticHighlightings(InpAST->AST, !PublishInactiveRegions));
+    CB(clangd::getSemanticHighlightings(InpAST->AST, !PublishInactiveRegions,
+                                        Restrict));
   };
   WorkScheduler->runWithAST("SemanticHighlights", File, std::move(Action),
                             Transient);
@@ -1123,6 +1134,10 @@ llvm::StringMap<TUScheduler::FileStats> ClangdServer::fileStats() const {
   return WorkScheduler->fileStats();
 }
 
+std::size_t ClangdServer::releaseMemory(std::size_t Bytes) {
+  return WorkScheduler->evictIdleASTs(Bytes);
+}
+
 [[nodiscard]] bool
 ClangdServer::blockUntilIdleForTest(std::optional<double> TimeoutSeconds) {
   // Order is important here: we don't want to block on A and then B,
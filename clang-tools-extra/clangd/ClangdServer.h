@@ -175,6 +175,9 @@ public:
     /// Clangd will execute compiler drivers matching one of these globs to
     /// fetch system include path.
     std::vector<std::string> QueryDriverGlobs;
+    /// If not empty, the results of querying drivers are cached in this
+    /// directory across clangd runs.
+    std::string QueryDriverCacheDir;
 
     // Whether the client supports folding only complete lines.
     bool LineFoldingOnly = false;
@@ -424,9 +427,15 @@ public:
   /// Get all document links in a file.
   void documentLinks(PathRef File, Callback<std::vector<DocumentLink>> CB);
 
+  /// Get all semantic highlighting tokens of a file.
   void semanticHighlights(PathRef File,
                           Callback<std::vector<HighlightingToken>>);
 
+  /// Get the semantic highlighting tokens of a file. If \p Restrict is set,
+  /// only tokens intersecting it are computed.
+  void semanticHighlights(PathRef File, std::optional<Range> Restrict,
+                          Callback<std::vector<HighlightingToken>>);
+
   /// Describe the AST subtree for a piece of code.
   void getAST(PathRef File, std::optional<Range> R,
               Callback<std::optional<ASTNode>> CB);
@@ -469,6 +478,11 @@ public:
   /// Builds a nested representation of memory used by components.
   void profile(MemoryTree &MT) const;
 
+  /// Releases caches that can be recomputed on demand (currently idle ASTs)
+  /// until at least \p Bytes have been freed or nothing is left to release.
+  /// Returns the number of bytes released.
+  std::size_t releaseMemory(std::size_t Bytes);
+
 private:
   FeatureModuleSet *FeatureModules;
   const GlobalCompilationDatabase &CDB;
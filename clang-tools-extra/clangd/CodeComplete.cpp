@@ -36,6 +36,7 @@
 #include "index/Index.h"
 #include "index/Symbol.h"
 #include "index/SymbolOrigin.h"
+#include "support/Cancellation.h"
 #include "support/Logger.h"
 #include "support/Markup.h"
 #include "support/Threading.h"
@@ -1787,7 +1788,12 @@ public:
     AccessibleScopes = QueryScopes;
     ScopeProximity.emplace(QueryScopes);
 
+    // Don't bother querying and scoring if the request is no longer wanted.
+    if (isCancelled())
+      return CodeCompleteResult();
     SymbolSlab IndexResults = Opts.Index ? queryIndex() : SymbolSlab();
+    if (isCancelled())
+      return CodeCompleteResult();
 
     CodeCompleteResult Output = toCodeCompleteResult(mergeResults(
         /*SemaResults=*/{}, IndexResults, IdentifierResults));
@@ -1852,9 +1858,15 @@ private:
     //        explicitly request symbols corresponding to Sema results.
     //        We can use their signals even if the index can't suggest them.
     // We must copy index results to preserve them, but there are at most Limit.
+    // Parsing up to the completion point may have taken a while, skip the
+    // index query and scoring if the request was cancelled meanwhile.
+    if (isCancelled())
+      return CodeCompleteResult();
     auto IndexResults = (Opts.Index && allowIndex(Recorder->CCContext))
                             ? queryIndex()
                             : SymbolSlab();
+    if (isCancelled())
+      return CodeCompleteResult();
     trace::Span Tracer("Populate CodeCompleteResult");
     // Merge Sema and Index results, score them, and pick the winners.
     auto Top =
@@ -29,6 +29,7 @@
 #include "llvm/Support/Path.h"
 #include "llvm/Support/Program.h"
 #include <iterator>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <vector>
@@ -196,16 +197,13 @@ CommandMangler CommandMangler::detect() {
 
 CommandMangler CommandMangler::forTests() { return CommandMangler(); }
 
-void CommandMangler::operator()(tooling::CompileCommand &Command,
-                                llvm::StringRef File) const {
-  std::vector<std::string> &Cmd = Command.CommandLine;
-  trace::Span S("AdjustCompileFlags");
-  // Most of the modifications below assumes the Cmd starts with a driver name.
-  // We might consider injecting a generic driver name like "cc" or "c++", but
-  // a Cmd missing the driver is probably rare enough in practice and erroneous.
-  if (Cmd.empty())
-    return;
+namespace {
+// Bounds the memory used to remember normalized commands.
+constexpr size_t MaxNormalizedCommands = 1024;
 
+// Strips the inputs from \p Cmd and makes it compile \p File instead, adjusting
+// the flags if the command was for a file of a different type.
+void normalizeInputs(std::vector<std::string> &Cmd, llvm::StringRef File) {
   auto &OptTable = clang::driver::getDriverOptTable();
   // OriginalArgs needs to outlive ArgList.
   llvm::SmallVector<const char *, 16> OriginalArgs;
@@ -294,6 +292,43 @@ void CommandMangler::operator()(tooling::CompileCommand &Command,
            Cmd[Cmd.size() - 2] == "--" &&
            "TransferCommand should produce a command ending in -- filename");
   }
+}
+} // namespace
+
+void CommandMangler::operator()(tooling::CompileCommand &Command,
+                                llvm::StringRef File) const {
+  std::vector<std::string> &Cmd = Command.CommandLine;
+  trace::Span S("AdjustCompileFlags");
+  // Most of the modifications below assumes the Cmd starts with a driver name.
+  // We might consider injecting a generic driver name like "cc" or "c++", but
+  // a Cmd missing the driver is probably rare enough in practice and erroneous.
+  if (Cmd.empty())
+    return;
+
+  // Normalizing inputs requires parsing the whole command line, and is
+  // requested again for open files on every edit. It doesn't depend on config,
+  // so remember the results for recently seen commands.
+  std::string CacheKey = File.str();
+  for (const auto &Arg : Cmd) {
+    CacheKey += '\0';
+    CacheKey += Arg;
+  }
+  bool Cached = false;
+  {
+    std::lock_guard<std::mutex> Lock(NormalizedCommands->Mu);
+    auto It = NormalizedCommands->Commands.find(CacheKey);
+    if (It != NormalizedCommands->Commands.end()) {
+      Cmd = It->second;
+      Cached = true;
+    }
+  }
+  if (!Cached) {
+    normalizeInputs(Cmd, File);
+    std::lock_guard<std::mutex> Lock(NormalizedCommands->Mu);
+    if (NormalizedCommands->Commands.size() >= MaxNormalizedCommands)
+      NormalizedCommands->Commands.clear();
+    NormalizedCommands->Commands.try_emplace(CacheKey, Cmd);
+  }
 
   for (auto &Edit : Config::current().CompileFlags.Edits)
     Edit(Cmd);
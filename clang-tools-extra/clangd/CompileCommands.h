@@ -14,6 +14,8 @@
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Support/CommandLine.h"
 #include <deque>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <vector>
@@ -53,6 +55,14 @@ struct CommandMangler {
 private:
   Memoize<llvm::StringMap<std::string>> ResolvedDrivers;
   Memoize<llvm::StringMap<std::string>> ResolvedDriversNoFollow;
+  // Commands with their inputs normalized, keyed by target file and original
+  // command. Shared by copies of the mangler.
+  struct NormalizedCommandCache {
+    std::mutex Mu;
+    llvm::StringMap<std::vector<std::string>> Commands;
+  };
+  std::shared_ptr<NormalizedCommandCache> NormalizedCommands =
+      std::make_shared<NormalizedCommandCache>();
 };
 
 // Removes args from a command-line in a semantically-aware way.
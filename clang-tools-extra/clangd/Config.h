@@ -105,6 +105,9 @@ struct Config {
       std::string Checks;
       llvm::StringMap<std::string> CheckOptions;
       FastCheckPolicy FastCheckFilter = FastCheckPolicy::Strict;
+      /// Checks that took longer than this (in milliseconds) to run on a file
+      /// are disabled for the rest of the session. 0 means no budget.
+      uint32_t CheckTimeBudget = 0;
     } ClangTidy;
 
     IncludesPolicy UnusedIncludes = IncludesPolicy::Strict;
@@ -612,6 +612,11 @@ struct FragmentCompiler {
         Out.Apply.push_back([Val](const Params &, Config &C) {
           C.Diagnostics.ClangTidy.FastCheckFilter = *Val;
         });
+    if (F.CheckTimeBudget)
+      Out.Apply.push_back(
+          [Value(**F.CheckTimeBudget)](const Params &, Config &C) {
+            C.Diagnostics.ClangTidy.CheckTimeBudget = Value;
+          });
   }
 
   void compile(Fragment::DiagnosticsBlock::IncludesBlock &&F) {
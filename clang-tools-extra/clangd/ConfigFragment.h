@@ -289,6 +289,11 @@ struct Fragment {
       ///   Loose: Run checks unless they are known to be slow.
       ///   None: Run checks regardless of their speed.
       std::optional<Located<std::string>> FastCheckFilter;
+
+      /// Time budget for a single check on a single file, in milliseconds.
+      /// Checks exceeding it are not run again until clangd restarts.
+      /// Only the AST matching part of each check is timed.
+      std::optional<Located<uint32_t>> CheckTimeBudget;
     };
     ClangTidyBlock ClangTidy;
   };
@@ -167,6 +167,10 @@ private:
       if (auto FastCheckFilter = scalarValue(N, "FastCheckFilter"))
         F.FastCheckFilter = *FastCheckFilter;
     });
+    Dict.handle("CheckTimeBudget", [&](Node &N) {
+      if (auto Value = uint32Value(N, "CheckTimeBudget"))
+        F.CheckTimeBudget = *Value;
+    });
     Dict.parse(N);
   }
 
@@ -122,12 +122,6 @@ getWorkspaceSymbols(llvm::StringRef Query, int Limit,
     if (AnyScope && !approximateScopeMatch(Scope, ReqScope))
       return;
 
-    auto Loc = symbolToLocation(Sym, HintPath);
-    if (!Loc) {
-      log("Workspace symbols: {0}", Loc.takeError());
-      return;
-    }
-
     SymbolQualitySignals Quality;
     Quality.merge(Sym);
     SymbolRelevanceSignals Relevance;
@@ -148,6 +142,16 @@ getWorkspaceSymbols(llvm::StringRef Query, int Limit,
     auto Score = evaluateSymbolAndRelevance(QualScore, RelScore);
     dlog("FindSymbols: {0}{1} = {2}\n{3}{4}\n", Sym.Scope, Sym.Name, Score,
          Quality, Relevance);
+    // Most candidates of short queries don't make the cut, don't bother
+    // resolving their locations.
+    if (Top.full() && Score < Top.worst().first)
+      return;
+
+    auto Loc = symbolToLocation(Sym, HintPath);
+    if (!Loc) {
+      log("Workspace symbols: {0}", Loc.takeError());
+      return;
+    }
 
     SymbolInformation Info;
     Info.name = (Sym.Name + Sym.TemplateSpecializationArgs).str();
@@ -177,10 +177,13 @@ private:
 /// Extracts system include search path from drivers matching QueryDriverGlobs
 /// and adds them to the compile flags.
 /// Returns null when \p QueryDriverGlobs is empty.
+/// If \p CacheDir is not empty, the results are also persisted there and
+/// reused across runs until the driver binary changes.
 using SystemIncludeExtractorFn = llvm::unique_function<void(
     tooling::CompileCommand &, llvm::StringRef) const>;
 SystemIncludeExtractorFn
-getSystemIncludeExtractor(llvm::ArrayRef<std::string> QueryDriverGlobs);
+getSystemIncludeExtractor(llvm::ArrayRef<std::string> QueryDriverGlobs,
+                          llvm::StringRef CacheDir = "");
 
 /// Wraps another compilation database, and supports overriding the commands
 /// using an in-memory mapping.
@@ -14,6 +14,12 @@
 #include "clang/Serialization/ASTReader.h"
 #include "clang/Serialization/InMemoryModuleCache.h"
 #include "llvm/ADT/ScopeExit.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Support/LockFileManager.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/Process.h"
+#include "llvm/Support/xxhash.h"
+#include <chrono>
 #include <queue>
 
 namespace clang {
@@ -32,9 +38,6 @@ namespace {
 //
 // \param MainFile is used to get the root of the project from global
 // compilation database.
-//
-// TODO: Move these module fils out of the temporary directory if the module
-// files are persistent.
 llvm::SmallString<256> getUniqueModuleFilesPath(PathRef MainFile) {
   llvm::SmallString<128> HashedPrefix = llvm::sys::path::filename(MainFile);
   // There might be multiple files with the same name in a project. So appending
@@ -61,6 +64,84 @@ llvm::SmallString<256> getUniqueModuleFilesPath(PathRef MainFile) {
   return Result;
 }
 
+// Persistent module files that haven't been built or reused for this long are
+// removed when a clangd session starts.
+constexpr std::chrono::hours PersistentModuleFilesExpiry(24 * 7);
+
+// Create a path to store module files that persists across clangd sessions:
+//
+//   {ROOT}/{module-unit-name}-{hash}/.
+//
+// {ROOT} is the directory passed to ModulesBuilder. The hash covers the module
+// unit and its compile command, so that the same module built with different
+// flags doesn't collide. Whether an existing module file is still valid is
+// checked against the contents of its inputs before reusing it.
+std::optional<llvm::SmallString<256>>
+getPersistentModuleFilesPath(llvm::StringRef Root, PathRef ModuleUnitFile,
+                             const tooling::CompileCommand &Cmd) {
+  llvm::SmallString<256> Result(Root);
+
+  // llvm::hash_value isn't stable across processes, use a stable hash.
+  std::string Key = ModuleUnitFile.str();
+  Key += '\0';
+  Key += Cmd.Directory;
+  for (const std::string &Arg : Cmd.CommandLine) {
+    Key += '\0';
+    Key += Arg;
+  }
+  llvm::SmallString<128> HashedPrefix =
+      llvm::sys::path::filename(ModuleUnitFile);
+  HashedPrefix += "-";
+  HashedPrefix += llvm::utohexstr(llvm::xxh3_64bits(Key));
+  llvm::sys::path::append(Result, HashedPrefix);
+
+  if (llvm::sys::fs::create_directories(Result))
+    return std::nullopt;
+  return Result;
+}
+
+// Remove the directories of persistent module files in which nothing has been
+// modified for longer than PersistentModuleFilesExpiry. Reusing a module file
+// updates its modification time, see touchModuleFile().
+void prunePersistentModuleFiles(llvm::StringRef Root) {
+  auto Expiry = std::chrono::system_clock::now() - PersistentModuleFilesExpiry;
+  std::error_code EC;
+  for (llvm::sys::fs::directory_iterator It(Root, EC), End; !EC && It != End;
+       It.increment(EC)) {
+    if (It->type() != llvm::sys::fs::file_type::directory_file)
+      continue;
+    llvm::ErrorOr<llvm::sys::fs::basic_file_status> DirStatus = It->status();
+    if (!DirStatus)
+      continue;
+    auto LastUsed = DirStatus->getLastModificationTime();
+    std::error_code FileEC;
+    for (llvm::sys::fs::directory_iterator File(It->path(), FileEC);
+         !FileEC && File != End; File.increment(FileEC))
+      if (auto FileStatus = File->status())
+        LastUsed = std::max(LastUsed, FileStatus->getLastModificationTime());
+    if (LastUsed >= Expiry)
+      continue;
+    if (std::error_code RemoveEC =
+            llvm::sys::fs::remove_directories(It->path()))
+      vlog("Failed to remove stale module files {0}: {1}", It->path(),
+           RemoveEC.message());
+    else
+      log("Removed stale module files {0}", It->path());
+  }
+}
+
+// Mark a persistent module file as used, so that it isn't pruned.
+void touchModuleFile(PathRef ModuleFilePath) {
+  int FD;
+  if (llvm::sys::fs::openFileForWrite(ModuleFilePath, FD,
+                                      llvm::sys::fs::CD_OpenExisting,
+                                      llvm::sys::fs::OF_Append))
+    return;
+  llvm::sys::fs::setLastAccessAndModificationTime(
+      FD, std::chrono::system_clock::now());
+  llvm::sys::Process::SafelyCloseFileDescriptor(FD);
+}
+
 // Get a unique module file path under \param ModuleFilesPrefix.
 std::string getModuleFilePath(llvm::StringRef ModuleName,
                               PathRef ModuleFilesPrefix) {
@@ -96,8 +177,11 @@ public:
 };
 
 struct ModuleFile {
-  ModuleFile(StringRef ModuleName, PathRef ModuleFilePath)
-      : ModuleName(ModuleName.str()), ModuleFilePath(ModuleFilePath.str()) {}
+  /// Persistent module files are left on disk when this is destroyed.
+  ModuleFile(StringRef ModuleName, PathRef ModuleFilePath,
+             bool Persistent = false)
+      : ModuleName(ModuleName.str()), ModuleFilePath(ModuleFilePath.str()),
+        Persistent(Persistent) {}
 
   ModuleFile() = delete;
 
@@ -107,7 +191,8 @@ struct ModuleFile {
   // The move constructor is needed for llvm::SmallVector.
   ModuleFile(ModuleFile &&Other)
       : ModuleName(std::move(Other.ModuleName)),
-        ModuleFilePath(std::move(Other.ModuleFilePath)) {
+        ModuleFilePath(std::move(Other.ModuleFilePath)),
+        Persistent(Other.Persistent) {
     Other.ModuleName.clear();
     Other.ModuleFilePath.clear();
   }
@@ -122,7 +207,7 @@ struct ModuleFile {
   }
 
   ~ModuleFile() {
-    if (!ModuleFilePath.empty())
+    if (!ModuleFilePath.empty() && !Persistent)
       llvm::sys::fs::remove(ModuleFilePath);
   }
 
@@ -133,6 +218,7 @@ struct ModuleFile {
 private:
   std::string ModuleName;
   std::string ModuleFilePath;
+  bool Persistent;
 };
 
 // ReusablePrerequisiteModules - stands for PrerequisiteModules for which all
@@ -243,26 +329,13 @@ bool IsModuleFilesUpToDate(
       });
 }
 
-/// Build a module file for module with `ModuleName`. The information of built
-/// module file are stored in \param BuiltModuleFiles.
-llvm::Expected<ModuleFile>
-buildModuleFile(llvm::StringRef ModuleName, PathRef ModuleUnitFileName,
-                const GlobalCompilationDatabase &CDB, const ThreadsafeFS &TFS,
-                const ReusablePrerequisiteModules &BuiltModuleFiles) {
-  // Try cheap operation earlier to boil-out cheaply if there are problems.
-  auto Cmd = CDB.getCompileCommand(ModuleUnitFileName);
-  if (!Cmd)
-    return llvm::createStringError(
-        llvm::formatv("No compile command for {0}", ModuleUnitFileName));
-
-  llvm::SmallString<256> ModuleFilesPrefix =
-      getUniqueModuleFilesPath(ModuleUnitFileName);
-
-  Cmd->Output = getModuleFilePath(ModuleName, ModuleFilesPrefix);
-
+/// Compile the module unit \param Cmd into the module file at `Cmd.Output`.
+llvm::Error
+compileModuleFile(tooling::CompileCommand Cmd, const ThreadsafeFS &TFS,
+                  const ReusablePrerequisiteModules &BuiltModuleFiles) {
   ParseInputs Inputs;
   Inputs.TFS = &TFS;
-  Inputs.CompileCommand = std::move(*Cmd);
+  Inputs.CompileCommand = std::move(Cmd);
 
   IgnoreDiagnostics IgnoreDiags;
   auto CI = buildCompilerInvocation(Inputs, IgnoreDiags);
@@ -298,7 +371,86 @@ buildModuleFile(llvm::StringRef ModuleName, PathRef ModuleUnitFileName,
   if (Clang->getDiagnostics().hasErrorOccurred())
     return llvm::createStringError("Compilation failed");
 
-  return ModuleFile{ModuleName, Inputs.CompileCommand.Output};
+  return llvm::Error::success();
+}
+
+// Other clangd instances may have an existing persistent module file mapped, so
+// it is never rewritten in place. The new module file is built into a temporary
+// file next to it and renamed over it.
+llvm::Error compilePersistentModuleFile(
+    tooling::CompileCommand Cmd, const ThreadsafeFS &TFS,
+    const ReusablePrerequisiteModules &BuiltModuleFiles) {
+  std::string Output = std::move(Cmd.Output);
+  llvm::SmallString<256> TempOutput;
+  llvm::sys::fs::createUniquePath(Output + "-%%%%%%%%.tmp", TempOutput,
+                                  /*MakeAbsolute=*/false);
+  Cmd.Output = std::string(TempOutput);
+  llvm::Error Err = compileModuleFile(std::move(Cmd), TFS, BuiltModuleFiles);
+  if (!Err)
+    if (std::error_code EC = llvm::sys::fs::rename(TempOutput, Output))
+      Err = llvm::createStringError(
+          EC, llvm::formatv("Failed to rename {0} to {1}", TempOutput, Output));
+  if (Err)
+    llvm::sys::fs::remove(TempOutput);
+  return Err;
+}
+
+/// Build a module file for module with `ModuleName`. The information of built
+/// module file are stored in \param BuiltModuleFiles.
+llvm::Expected<ModuleFile>
+buildModuleFile(llvm::StringRef ModuleName, PathRef ModuleUnitFileName,
+                const GlobalCompilationDatabase &CDB, const ThreadsafeFS &TFS,
+                const ReusablePrerequisiteModules &BuiltModuleFiles,
+                llvm::StringRef PersistentModuleFilesDir) {
+  // Try cheap operation earlier to boil-out cheaply if there are problems.
+  auto Cmd = CDB.getCompileCommand(ModuleUnitFileName);
+  if (!Cmd)
+    return llvm::createStringError(
+        llvm::formatv("No compile command for {0}", ModuleUnitFileName));
+
+  std::optional<llvm::SmallString<256>> PersistentPrefix;
+  if (!PersistentModuleFilesDir.empty())
+    PersistentPrefix = getPersistentModuleFilesPath(PersistentModuleFilesDir,
+                                                    ModuleUnitFileName, *Cmd);
+  if (!PersistentPrefix) {
+    Cmd->Output = getModuleFilePath(
+        ModuleName, getUniqueModuleFilesPath(ModuleUnitFileName));
+    if (llvm::Error Err = compileModuleFile(*Cmd, TFS, BuiltModuleFiles))
+      return std::move(Err);
+    return ModuleFile{ModuleName, Cmd->Output};
+  }
+
+  Cmd->Output = getModuleFilePath(ModuleName, *PersistentPrefix);
+  auto IsUpToDate = [&] {
+    return llvm::sys::fs::exists(Cmd->Output) &&
+           IsModuleFileUpToDate(Cmd->Output, BuiltModuleFiles,
+                                TFS.view(std::nullopt));
+  };
+  // Other clangd instances may be building the same module file. Take a lock
+  // so that only one of them does, the others reuse the result.
+  while (!IsUpToDate()) {
+    llvm::LockFileManager Lock(Cmd->Output);
+    switch (Lock) {
+    case llvm::LockFileManager::LFS_Error:
+      // Locks are only an optimization, build the module file anyway.
+      vlog("Failed to lock module file {0}: {1}", Cmd->Output,
+           Lock.getErrorMessage());
+      Lock.unsafeRemoveLockFile();
+      [[fallthrough]];
+    case llvm::LockFileManager::LFS_Owned:
+      if (llvm::Error Err =
+              compilePersistentModuleFile(*Cmd, TFS, BuiltModuleFiles))
+        return std::move(Err);
+      return ModuleFile{ModuleName, Cmd->Output, /*Persistent=*/true};
+    case llvm::LockFileManager::LFS_Shared:
+      break;
+    }
+    if (Lock.waitForUnlock() == llvm::LockFileManager::Res_Timeout)
+      Lock.unsafeRemoveLockFile();
+  }
+  log("Reusing existing module file {0}", Cmd->Output);
+  touchModuleFile(Cmd->Output);
+  return ModuleFile{ModuleName, Cmd->Output, /*Persistent=*/true};
 }
 
 bool ReusablePrerequisiteModules::canReuse(
@@ -384,7 +536,9 @@ llvm::SmallVector<StringRef> getAllRequiredModules(ProjectModules &MDB,
 
 class ModulesBuilder::ModulesBuilderImpl {
 public:
-  ModulesBuilderImpl(const GlobalCompilationDatabase &CDB) : Cache(CDB) {}
+  ModulesBuilderImpl(const GlobalCompilationDatabase &CDB,
+                     llvm::StringRef PersistentModuleFilesDir)
+      : Cache(CDB), PersistentModuleFilesDir(PersistentModuleFilesDir) {}
 
   const GlobalCompilationDatabase &getCDB() const { return Cache.getCDB(); }
 
@@ -395,6 +549,7 @@ public:
 
 private:
   ModuleFileCache Cache;
+  std::string PersistentModuleFilesDir;
 };
 
 llvm::Error ModulesBuilder::ModulesBuilderImpl::getOrBuildModuleFile(
@@ -432,8 +587,9 @@ llvm::Error ModulesBuilder::ModulesBuilderImpl::getOrBuildModuleFile(
       Cache.remove(ReqModuleName);
     }
 
-    llvm::Expected<ModuleFile> MF = buildModuleFile(
-        ModuleName, ModuleUnitFileName, getCDB(), TFS, BuiltModuleFiles);
+    llvm::Expected<ModuleFile> MF =
+        buildModuleFile(ModuleName, ModuleUnitFileName, getCDB(), TFS,
+                        BuiltModuleFiles, PersistentModuleFilesDir);
     if (llvm::Error Err = MF.takeError())
       return Err;
 
@@ -473,8 +629,11 @@ ModulesBuilder::buildPrerequisiteModulesFor(PathRef File,
   return std::move(RequiredModules);
 }
 
-ModulesBuilder::ModulesBuilder(const GlobalCompilationDatabase &CDB) {
-  Impl = std::make_unique<ModulesBuilderImpl>(CDB);
+ModulesBuilder::ModulesBuilder(const GlobalCompilationDatabase &CDB,
+                               llvm::StringRef PersistentModuleFilesDir) {
+  if (!PersistentModuleFilesDir.empty())
+    prunePersistentModuleFiles(PersistentModuleFilesDir);
+  Impl = std::make_unique<ModulesBuilderImpl>(CDB, PersistentModuleFilesDir);
 }
 
 ModulesBuilder::~ModulesBuilder() {}
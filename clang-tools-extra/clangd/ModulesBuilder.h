@@ -85,7 +85,14 @@ public:
 /// different versions and different source files.
 class ModulesBuilder {
 public:
-  ModulesBuilder(const GlobalCompilationDatabase &CDB);
+  /// If \p PersistentModuleFilesDir is not empty, module files are kept there
+  /// and reused by later sessions and other clangd instances, as long as their
+  /// inputs are unchanged. Module files there that haven't been built or
+  /// reused for a week are removed when a ModulesBuilder is created. Otherwise
+  /// they are built into a temporary directory and removed when no longer
+  /// used.
+  ModulesBuilder(const GlobalCompilationDatabase &CDB,
+                 llvm::StringRef PersistentModuleFilesDir = "");
   ~ModulesBuilder();
 
   ModulesBuilder(const ModulesBuilder &) = delete;
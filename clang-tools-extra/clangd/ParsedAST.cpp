@@ -63,10 +63,13 @@
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/STLFunctionalExtras.h"
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Support/Error.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Timer.h"
 #include <cassert>
+#include <chrono>
 #include <cstddef>
 #include <iterator>
 #include <memory>
@@ -387,14 +390,19 @@ std::vector<Diag> getIncludeCleanerDiags(ParsedAST &AST, llvm::StringRef Code,
 
 tidy::ClangTidyCheckFactories
 filterFastTidyChecks(const tidy::ClangTidyCheckFactories &All,
-                     Config::FastCheckPolicy Policy) {
-  if (Policy == Config::FastCheckPolicy::None)
+                     Config::FastCheckPolicy Policy,
+                     std::chrono::milliseconds Budget) {
+  if (Policy == Config::FastCheckPolicy::None && Budget.count() == 0)
     return All;
   bool AllowUnknown = Policy == Config::FastCheckPolicy::Loose;
   tidy::ClangTidyCheckFactories Fast;
   for (const auto &Factory : All) {
-    if (isFastTidyCheck(Factory.getKey()).value_or(AllowUnknown))
-      Fast.registerCheckFactory(Factory.first(), Factory.second);
+    if (Policy != Config::FastCheckPolicy::None &&
+        !isFastTidyCheck(Factory.getKey()).value_or(AllowUnknown))
+      continue;
+    if (Budget.count() && slowestTidyCheckTime(Factory.getKey()) > Budget)
+      continue;
+    Fast.registerCheckFactory(Factory.first(), Factory.second);
   }
   return Fast;
 }
@@ -536,7 +544,13 @@ ParsedAST::build(llvm::StringRef Filename, const ParseInputs &Inputs,
   //    ancestors outside this scope).
   // In practice almost all checks work well without modifications.
   std::vector<std::unique_ptr<tidy::ClangTidyCheck>> CTChecks;
-  ast_matchers::MatchFinder CTFinder;
+  // With a time budget, each check's matchers are timed to find slow ones.
+  std::chrono::milliseconds CTBudget(Cfg.Diagnostics.ClangTidy.CheckTimeBudget);
+  llvm::StringMap<llvm::TimeRecord> CTTimes;
+  ast_matchers::MatchFinder::MatchFinderOptions CTFinderOpts;
+  if (CTBudget.count())
+    CTFinderOpts.CheckProfiling.emplace(CTTimes);
+  ast_matchers::MatchFinder CTFinder(std::move(CTFinderOpts));
   std::optional<tidy::ClangTidyContext> CTContext;
   // Must outlive FixIncludes.
   auto BuildDir = VFS->getCurrentWorkingDirectory();
@@ -553,7 +567,7 @@ ParsedAST::build(llvm::StringRef Filename, const ParseInputs &Inputs,
       return CTFactories;
     }();
     tidy::ClangTidyCheckFactories FastFactories = filterFastTidyChecks(
-        *AllCTFactories, Cfg.Diagnostics.ClangTidy.FastCheckFilter);
+        *AllCTFactories, Cfg.Diagnostics.ClangTidy.FastCheckFilter, CTBudget);
     CTContext.emplace(std::make_unique<tidy::DefaultOptionsProvider>(
         tidy::ClangTidyGlobalOptions(), ClangTidyOpts));
     CTContext->setDiagnosticsEngine(&Clang->getDiagnostics());
@@ -733,6 +747,14 @@ ParsedAST::build(llvm::StringRef Filename, const ParseInputs &Inputs,
     trace::Span Tracer("ClangTidyMatch");
     CTFinder.matchAST(Clang->getASTContext());
   }
+  for (const auto &Entry : CTTimes) {
+    std::chrono::milliseconds Time(
+        static_cast<int64_t>(Entry.second.getWallTime() * 1000));
+    if (recordTidyCheckTime(Entry.first(), Time) <= CTBudget && Time > CTBudget)
+      log("Disabling clang-tidy check {0}: it took {1}ms on {2}, the budget is "
+          "{3}ms",
+          Entry.first(), Time.count(), Filename, CTBudget.count());
+  }
 
   // XXX: This is messy: clang-tidy checks flush some diagnostics at EOF.
   // However Action->EndSourceFile() would destroy the ASTContext!
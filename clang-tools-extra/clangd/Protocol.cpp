@@ -1306,6 +1306,13 @@ bool fromJSON(const llvm::json::Value &Params, SemanticTokensParams &R,
   return O && O.map("textDocument", R.textDocument);
 }
 
+bool fromJSON(const llvm::json::Value &Params, SemanticTokensRangeParams &R,
+              llvm::json::Path P) {
+  llvm::json::ObjectMapper O(Params, P);
+  return O && O.map("textDocument", R.textDocument) &&
+         O.map("range", R.range);
+}
+
 bool fromJSON(const llvm::json::Value &Params, SemanticTokensDeltaParams &R,
               llvm::json::Path P) {
   llvm::json::ObjectMapper O(Params, P);
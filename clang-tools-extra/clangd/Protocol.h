@@ -1873,6 +1873,17 @@ struct SemanticTokensParams {
 bool fromJSON(const llvm::json::Value &, SemanticTokensParams &,
               llvm::json::Path);
 
+/// Body of textDocument/semanticTokens/range request.
+/// Requests the semantic tokens of part of a document.
+struct SemanticTokensRangeParams {
+  /// The text document.
+  TextDocumentIdentifier textDocument;
+  /// The range the semantic tokens are requested for.
+  Range range;
+};
+bool fromJSON(const llvm::json::Value &, SemanticTokensRangeParams &,
+              llvm::json::Path);
+
 /// Body of textDocument/semanticTokens/full/delta request.
 /// Requests the changes in semantic tokens since a previous response.
 struct SemanticTokensDeltaParams {
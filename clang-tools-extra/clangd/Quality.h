@@ -212,6 +212,14 @@ public:
     return Dropped;
   }
 
+  // Whether the set holds N candidates, so that new ones must beat worst().
+  bool full() const { return Heap.size() >= N; }
+  // Returns the candidate that would be dropped first.
+  const value_type &worst() const {
+    assert(!Heap.empty());
+    return Heap.front();
+  }
+
   // Returns candidates from best to worst.
   std::vector<value_type> items() && {
     std::sort_heap(Heap.begin(), Heap.end(), Greater);
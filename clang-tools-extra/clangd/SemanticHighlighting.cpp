@@ -1148,62 +1148,78 @@ private:
 } // namespace
 
 std::vector<HighlightingToken>
-getSemanticHighlightings(ParsedAST &AST, bool IncludeInactiveRegionTokens) {
+getSemanticHighlightings(ParsedAST &AST, bool IncludeInactiveRegionTokens,
+                         std::optional<Range> Restrict) {
   auto &C = AST.getASTContext();
   HighlightingFilter Filter = HighlightingFilter::fromCurrentConfig();
   if (!IncludeInactiveRegionTokens)
     Filter.disableKind(HighlightingKind::InactiveCode);
   // Add highlightings for AST nodes.
   HighlightingsBuilder Builder(AST, Filter);
-  // Highlight 'decltype' and 'auto' as their underlying types.
-  CollectExtraHighlightings(Builder).TraverseAST(C);
-  // Highlight all decls and references coming from the AST.
-  findExplicitReferences(
-      C,
-      [&](ReferenceLoc R) {
-        for (const NamedDecl *Decl : R.Targets) {
-          if (!canHighlightName(Decl->getDeclName()))
-            continue;
-          auto Kind = kindForDecl(Decl, AST.getHeuristicResolver());
-          if (!Kind)
-            continue;
-          auto &Tok = Builder.addToken(R.NameLoc, *Kind);
-
-          // The attribute tests don't want to look at the template.
-          if (auto *TD = dyn_cast<TemplateDecl>(Decl)) {
-            if (auto *Templated = TD->getTemplatedDecl())
-              Decl = Templated;
-          }
-          if (auto Mod = scopeModifier(Decl))
-            Tok.addModifier(*Mod);
-          if (isConst(Decl))
-            Tok.addModifier(HighlightingModifier::Readonly);
-          if (isStatic(Decl))
-            Tok.addModifier(HighlightingModifier::Static);
-          if (isAbstract(Decl))
-            Tok.addModifier(HighlightingModifier::Abstract);
-          if (isVirtual(Decl))
-            Tok.addModifier(HighlightingModifier::Virtual);
-          if (isDependent(Decl))
-            Tok.addModifier(HighlightingModifier::DependentName);
-          if (isDefaultLibrary(Decl))
-            Tok.addModifier(HighlightingModifier::DefaultLibrary);
-          if (Decl->isDeprecated())
-            Tok.addModifier(HighlightingModifier::Deprecated);
-          if (isa<CXXConstructorDecl>(Decl))
-            Tok.addModifier(HighlightingModifier::ConstructorOrDestructor);
-          if (R.IsDecl) {
-            // Do not treat an UnresolvedUsingValueDecl as a declaration.
-            // It's more common to think of it as a reference to the
-            // underlying declaration.
-            if (!isa<UnresolvedUsingValueDecl>(Decl))
-              Tok.addModifier(HighlightingModifier::Declaration);
-            if (isUniqueDefinition(Decl))
-              Tok.addModifier(HighlightingModifier::Definition);
-          }
-        }
-      },
-      AST.getHeuristicResolver());
+  auto AddReference = [&](ReferenceLoc R) {
+    for (const NamedDecl *Decl : R.Targets) {
+      if (!canHighlightName(Decl->getDeclName()))
+        continue;
+      auto Kind = kindForDecl(Decl, AST.getHeuristicResolver());
+      if (!Kind)
+        continue;
+      auto &Tok = Builder.addToken(R.NameLoc, *Kind);
+
+      // The attribute tests don't want to look at the template.
+      if (auto *TD = dyn_cast<TemplateDecl>(Decl)) {
+        if (auto *Templated = TD->getTemplatedDecl())
+          Decl = Templated;
+      }
+      if (auto Mod = scopeModifier(Decl))
+        Tok.addModifier(*Mod);
+      if (isConst(Decl))
+        Tok.addModifier(HighlightingModifier::Readonly);
+      if (isStatic(Decl))
+        Tok.addModifier(HighlightingModifier::Static);
+      if (isAbstract(Decl))
+        Tok.addModifier(HighlightingModifier::Abstract);
+      if (isVirtual(Decl))
+        Tok.addModifier(HighlightingModifier::Virtual);
+      if (isDependent(Decl))
+        Tok.addModifier(HighlightingModifier::DependentName);
+      if (isDefaultLibrary(Decl))
+        Tok.addModifier(HighlightingModifier::DefaultLibrary);
+      if (Decl->isDeprecated())
+        Tok.addModifier(HighlightingModifier::Deprecated);
+      if (isa<CXXConstructorDecl>(Decl))
+        Tok.addModifier(HighlightingModifier::ConstructorOrDestructor);
+      if (R.IsDecl) {
+        // Do not treat an UnresolvedUsingValueDecl as a declaration.
+        // It's more common to think of it as a reference to the
+        // underlying declaration.
+        if (!isa<UnresolvedUsingValueDecl>(Decl))
+          Tok.addModifier(HighlightingModifier::Declaration);
+        if (isUniqueDefinition(Decl))
+          Tok.addModifier(HighlightingModifier::Definition);
+      }
+    }
+  };
+  if (!Restrict) {
+    // Highlight 'decltype' and 'auto' as their underlying types.
+    CollectExtraHighlightings(Builder).TraverseAST(C);
+    // Highlight all decls and references coming from the AST.
+    findExplicitReferences(C, AddReference, AST.getHeuristicResolver());
+  } else {
+    // Same as above, but only for the top-level decls that may contain tokens
+    // in the range.
+    const auto &SM = AST.getSourceManager();
+    for (Decl *D : AST.getLocalTopLevelDecls()) {
+      if (auto FileRange = toHalfOpenFileRange(
+              SM, AST.getLangOpts(),
+              CharSourceRange::getTokenRange(D->getSourceRange()))) {
+        Range DeclRange = halfOpenToRange(SM, *FileRange);
+        if (DeclRange.end < Restrict->start || Restrict->end < DeclRange.start)
+          continue;
+      }
+      CollectExtraHighlightings(Builder).TraverseDecl(D);
+      findExplicitReferences(D, AddReference, AST.getHeuristicResolver());
+    }
+  }
   // Add highlightings for macro references.
   auto AddMacro = [&](const MacroOccurrence &M) {
     auto &T = Builder.addToken(M.toRange(C.getSourceManager()),
@@ -1218,7 +1234,12 @@ getSemanticHighlightings(ParsedAST &AST, bool IncludeInactiveRegionTokens) {
   for (const auto &M : AST.getMacros().UnknownMacros)
     AddMacro(M);
 
-  return std::move(Builder).collect(AST);
+  auto Result = std::move(Builder).collect(AST);
+  if (Restrict)
+    llvm::erase_if(Result, [&](const HighlightingToken &T) {
+      return T.R.end <= Restrict->start || Restrict->end <= T.R.start;
+    });
+  return Result;
 }
 
 llvm::raw_ostream &operator<<(llvm::raw_ostream &OS, HighlightingKind K) {
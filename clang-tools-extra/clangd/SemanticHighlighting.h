@@ -23,6 +23,7 @@
 #include "Protocol.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Support/raw_ostream.h"
+#include <optional>
 
 namespace clang {
 namespace clangd {
@@ -111,8 +112,12 @@ bool operator<(const HighlightingToken &L, const HighlightingToken &R);
 
 // Returns all HighlightingTokens from an AST. Only generates highlights for the
 // main AST.
+// If \p Restrict is set, only returns tokens intersecting it. This is cheaper
+// than filtering the full result, as only top-level declarations overlapping
+// the range are traversed.
 std::vector<HighlightingToken>
-getSemanticHighlightings(ParsedAST &AST, bool IncludeInactiveRegionTokens);
+getSemanticHighlightings(ParsedAST &AST, bool IncludeInactiveRegionTokens,
+                         std::optional<Range> Restrict = std::nullopt);
 
 std::vector<SemanticToken> toSemanticTokens(llvm::ArrayRef<HighlightingToken>,
                                             llvm::StringRef Code);
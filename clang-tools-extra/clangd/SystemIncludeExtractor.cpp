@@ -53,12 +53,15 @@
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/JSON.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
+#include "llvm/Support/Process.h"
 #include "llvm/Support/Program.h"
 #include "llvm/Support/Regex.h"
 #include "llvm/Support/ScopedPrinter.h"
 #include "llvm/Support/raw_ostream.h"
+#include "llvm/Support/xxhash.h"
 #include <cassert>
 #include <cstddef>
 #include <iterator>
@@ -357,9 +360,88 @@ std::optional<std::string> run(llvm::ArrayRef<llvm::StringRef> Argv,
   return BufOrError.get().get()->getBuffer().str();
 }
 
+// Query results can also be cached on disk under \p CacheDir, as running
+// drivers is slow and a project may use many toolchains. The driver binary is
+// identified by its path, size and modification time, so replacing it
+// invalidates the cache.
+std::optional<std::string> getCachedDriverInfoPath(llvm::StringRef CacheDir,
+                                                   llvm::StringRef Driver,
+                                                   const DriverArgs &Args) {
+  if (CacheDir.empty())
+    return std::nullopt;
+  llvm::sys::fs::file_status Status;
+  if (llvm::sys::fs::status(Driver, Status))
+    return std::nullopt;
+  llvm::SmallString<256> Path(CacheDir);
+
+  std::string Key = Driver.str();
+  Key += '\0';
+  Key += std::to_string(Status.getSize());
+  Key += '\0';
+  Key += std::to_string(
+      Status.getLastModificationTime().time_since_epoch().count());
+  for (llvm::StringRef Arg : Args.render()) {
+    Key += '\0';
+    Key += Arg;
+  }
+  // Drivers also add include paths from the environment.
+  for (const char *Var : {"CPATH", "C_INCLUDE_PATH", "CPLUS_INCLUDE_PATH",
+                          "OBJC_INCLUDE_PATH", "OBJCPLUS_INCLUDE_PATH"}) {
+    Key += '\0';
+    if (auto Value = llvm::sys::Process::GetEnv(Var))
+      Key += *Value;
+  }
+  llvm::sys::path::append(Path, llvm::utohexstr(llvm::xxh3_64bits(Key)) +
+                                    ".json");
+  return Path.str().str();
+}
+
+std::optional<DriverInfo> readCachedDriverInfo(llvm::StringRef Path) {
+  auto Buf = llvm::MemoryBuffer::getFile(Path);
+  if (!Buf)
+    return std::nullopt;
+  auto JSON = llvm::json::parse((*Buf)->getBuffer());
+  if (!JSON) {
+    elog("System include extraction: invalid cache {0}: {1}", Path,
+         JSON.takeError());
+    return std::nullopt;
+  }
+  const auto *Obj = JSON->getAsObject();
+  const auto *Includes = Obj ? Obj->getArray("includes") : nullptr;
+  auto Target = Obj ? Obj->getString("target") : std::nullopt;
+  if (!Includes || !Target)
+    return std::nullopt;
+  DriverInfo Info;
+  Info.Target = Target->str();
+  for (const auto &Include : *Includes) {
+    auto S = Include.getAsString();
+    if (!S)
+      return std::nullopt;
+    Info.SystemIncludes.push_back(S->str());
+  }
+  return Info;
+}
+
+void writeCachedDriverInfo(llvm::StringRef Path, const DriverInfo &Info) {
+  llvm::sys::fs::create_directories(llvm::sys::path::parent_path(Path));
+  llvm::json::Object Obj{
+      {"includes", Info.SystemIncludes},
+      {"target", Info.Target},
+  };
+  // The output is written to a temporary file and renamed, so that concurrent
+  // readers never see a partial file.
+  if (auto Err = llvm::writeToOutput(Path, [&](llvm::raw_ostream &OS) {
+        OS << llvm::json::Value(std::move(Obj));
+        return llvm::Error::success();
+      }))
+    elog("System include extraction: failed to write cache {0}: {1}", Path,
+         std::move(Err));
+}
+
 std::optional<DriverInfo>
 extractSystemIncludesAndTarget(const DriverArgs &InputArgs,
-                               const llvm::Regex &QueryDriverRegex) {
+                               const llvm::Regex &QueryDriverRegex,
+                               llvm::StringRef CacheDir) {
   trace::Span Tracer("Extract system includes and target");
 
   std::string Driver = InputArgs.Driver;
@@ -389,6 +471,16 @@ extractSystemIncludesAndTarget(const DriverArgs &InputArgs,
     return std::nullopt;
   }
 
+  std::optional<std::string> CachePath =
+      getCachedDriverInfoPath(CacheDir, Driver, InputArgs);
+  if (CachePath) {
+    if (auto Cached = readCachedDriverInfo(*CachePath)) {
+      vlog("System include extraction: using cached results for {0} from {1}",
+           Driver, *CachePath);
+      return Cached;
+    }
+  }
+
   llvm::SmallVector<llvm::StringRef> Args = {Driver, "-E", "-v"};
   Args.append(InputArgs.render());
   // Input needs to go after Lang flags.
@@ -422,6 +514,8 @@ extractSystemIncludesAndTarget(const DriverArgs &InputArgs,
   log("System includes extractor: successfully executed {0}\n\tgot includes: "
       "\"{1}\"\n\tgot target: \"{2}\"",
       Driver, llvm::join(Info->SystemIncludes, ", "), Info->Target);
+  if (CachePath)
+    writeCachedDriverInfo(*CachePath, *Info);
   return Info;
 }
 
@@ -506,8 +600,10 @@ llvm::Regex convertGlobsToRegex(llvm::ArrayRef<std::string> Globs) {
 /// compilation database.
 class SystemIncludeExtractor {
 public:
-  SystemIncludeExtractor(llvm::ArrayRef<std::string> QueryDriverGlobs)
-      : QueryDriverRegex(convertGlobsToRegex(QueryDriverGlobs)) {}
+  SystemIncludeExtractor(llvm::ArrayRef<std::string> QueryDriverGlobs,
+                         llvm::StringRef CacheDir)
+      : QueryDriverRegex(convertGlobsToRegex(QueryDriverGlobs)),
+        CacheDir(CacheDir) {}
 
   void operator()(tooling::CompileCommand &Cmd, llvm::StringRef File) const {
     if (Cmd.CommandLine.empty())
@@ -517,7 +613,8 @@ public:
     if (Args.Lang.empty())
       return;
     if (auto Info = QueriedDrivers.get(Args, [&] {
-          return extractSystemIncludesAndTarget(Args, QueryDriverRegex);
+          return extractSystemIncludesAndTarget(Args, QueryDriverRegex,
+                                                CacheDir);
         })) {
       setTarget(addSystemIncludes(Cmd, Info->SystemIncludes), Info->Target);
     }
@@ -527,14 +624,16 @@ private:
   // Caches includes extracted from a driver. Key is driver:lang.
   Memoize<llvm::DenseMap<DriverArgs, std::optional<DriverInfo>>> QueriedDrivers;
   llvm::Regex QueryDriverRegex;
+  std::string CacheDir;
 };
 } // namespace
 
 SystemIncludeExtractorFn
-getSystemIncludeExtractor(llvm::ArrayRef<std::string> QueryDriverGlobs) {
+getSystemIncludeExtractor(llvm::ArrayRef<std::string> QueryDriverGlobs,
+                          llvm::StringRef CacheDir) {
   if (QueryDriverGlobs.empty())
     return nullptr;
-  return SystemIncludeExtractor(QueryDriverGlobs);
+  return SystemIncludeExtractor(QueryDriverGlobs, CacheDir);
 }
 
 } // namespace clang::clangd
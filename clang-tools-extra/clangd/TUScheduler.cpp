@@ -66,6 +66,7 @@
 #include "clang/Basic/Stack.h"
 #include "clang/Frontend/CompilerInvocation.h"
 #include "clang/Tooling/CompilationDatabase.h"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/FunctionExtras.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/ScopeExit.h"
@@ -79,6 +80,7 @@
 #include "llvm/Support/Path.h"
 #include "llvm/Support/Threading.h"
 #include "llvm/Support/raw_ostream.h"
+#include "llvm/Support/xxhash.h"
 #include <algorithm>
 #include <atomic>
 #include <chrono>
@@ -133,6 +135,22 @@ void reportPreambleBuild(const PreambleBuildStats &Stats,
   PreambleSerializedSize.record(Stats.SerializedSize);
 }
 
+// Returns the size of the region of After that differs from Before, i.e. what
+// remains after stripping the longest common prefix and suffix.
+size_t editedBytes(llvm::StringRef Before, llvm::StringRef After) {
+  size_t Prefix = 0, Limit = std::min(Before.size(), After.size());
+  while (Prefix < Limit && Before[Prefix] == After[Prefix])
+    ++Prefix;
+  Before = Before.drop_front(Prefix);
+  After = After.drop_front(Prefix);
+  size_t Suffix = 0;
+  Limit -= Prefix;
+  while (Suffix < Limit &&
+         Before[Before.size() - 1 - Suffix] == After[After.size() - 1 - Suffix])
+    ++Suffix;
+  return After.size() - Suffix;
+}
+
 class ASTWorker;
 } // namespace
 
@@ -152,33 +170,71 @@ class TUScheduler::ASTCache {
 public:
   using Key = const ASTWorker *;
 
-  ASTCache(unsigned MaxRetainedASTs) : MaxRetainedASTs(MaxRetainedASTs) {}
+  ASTCache(const ASTRetentionPolicy &Policy)
+      : MaxRetainedASTs(Policy.MaxRetainedASTs),
+        MaxRetainedBytes(Policy.MaxRetainedBytes) {}
 
   /// Returns result of getUsedBytes() for the AST cached by \p K.
   /// If no AST is cached, 0 is returned.
   std::size_t getUsedBytes(Key K) {
     std::lock_guard<std::mutex> Lock(Mut);
     auto It = findByKey(K);
-    if (It == LRU.end() || !It->second)
+    if (It == LRU.end())
       return 0;
-    return It->second->getUsedBytes();
+    return It->UsedBytes;
   }
 
-  /// Store the value in the pool, possibly removing the last used AST.
+  /// Store the value in the pool, possibly removing the least recently used
+  /// ASTs to stay within the retention policy.
   /// The value should not be in the pool when this function is called.
   void put(Key K, std::unique_ptr<ParsedAST> V) {
+    static constexpr trace::Metric ASTCacheEvictions(
+        "ast_cache_evictions", trace::Metric::Counter, "reason");
+    // Computing the size walks the AST's allocators, do it outside the lock.
+    std::size_t Bytes = V ? V->getUsedBytes() : 0;
+    std::vector<std::unique_ptr<ParsedAST>> ForCleanup;
     std::unique_lock<std::mutex> Lock(Mut);
     assert(findByKey(K) == LRU.end());
 
-    LRU.insert(LRU.begin(), {K, std::move(V)});
-    if (LRU.size() <= MaxRetainedASTs)
-      return;
-    // We're past the limit, remove the last element.
-    std::unique_ptr<ParsedAST> ForCleanup = std::move(LRU.back().second);
-    LRU.pop_back();
-    // Run the expensive destructor outside the lock.
+    LRU.insert(LRU.begin(), {K, std::move(V), Bytes});
+    TotalBytes += Bytes;
+    while (!LRU.empty()) {
+      if (LRU.size() > MaxRetainedASTs)
+        ASTCacheEvictions.record(1, "count");
+      else if (LRU.size() > 1 && MaxRetainedBytes &&
+               TotalBytes > MaxRetainedBytes)
+        ASTCacheEvictions.record(1, "bytes");
+      else
+        break;
+      // We're past the limit, remove the last element.
+      TotalBytes -= LRU.back().UsedBytes;
+      ForCleanup.push_back(std::move(LRU.back().AST));
+      LRU.pop_back();
+    }
+    // Run the expensive destructors outside the lock.
     Lock.unlock();
-    ForCleanup.reset();
+    ForCleanup.clear();
+  }
+
+  /// Removes the least recently used ASTs until at least \p Bytes have been
+  /// released or the cache is empty. Returns the number of bytes released.
+  std::size_t evict(std::size_t Bytes) {
+    static constexpr trace::Metric ASTCacheEvictions(
+        "ast_cache_evictions", trace::Metric::Counter, "reason");
+    std::vector<std::unique_ptr<ParsedAST>> ForCleanup;
+    std::size_t Released = 0;
+    std::unique_lock<std::mutex> Lock(Mut);
+    while (!LRU.empty() && Released < Bytes) {
+      ASTCacheEvictions.record(1, "memory_budget");
+      Released += LRU.back().UsedBytes;
+      TotalBytes -= LRU.back().UsedBytes;
+      ForCleanup.push_back(std::move(LRU.back().AST));
+      LRU.pop_back();
+    }
+    // Run the expensive destructors outside the lock.
+    Lock.unlock();
+    ForCleanup.clear();
+    return Released;
   }
 
   /// Returns the cached value for \p K, or std::nullopt if the value is not in
@@ -197,7 +253,8 @@ public:
     }
     if (AccessMetric)
       AccessMetric->record(1, "hit");
-    std::unique_ptr<ParsedAST> V = std::move(Existing->second);
+    std::unique_ptr<ParsedAST> V = std::move(Existing->AST);
+    TotalBytes -= Existing->UsedBytes;
     LRU.erase(Existing);
     // GCC 4.8 fails to compile `return V;`, as it tries to call the copy
     // constructor of unique_ptr, so we call the move ctor explicitly to avoid
@@ -206,17 +263,24 @@ public:
   }
 
 private:
-  using KVPair = std::pair<Key, std::unique_ptr<ParsedAST>>;
+  struct Entry {
+    Key K;
+    std::unique_ptr<ParsedAST> AST;
+    /// Size of AST, computed when it was put into the cache.
+    std::size_t UsedBytes;
+  };
 
-  std::vector<KVPair>::iterator findByKey(Key K) {
-    return llvm::find_if(LRU, [K](const KVPair &P) { return P.first == K; });
+  std::vector<Entry>::iterator findByKey(Key K) {
+    return llvm::find_if(LRU, [K](const Entry &E) { return E.K == K; });
   }
 
   std::mutex Mut;
   unsigned MaxRetainedASTs;
+  std::size_t MaxRetainedBytes;
   /// Items sorted in LRU order, i.e. first item is the most recently accessed
   /// one.
-  std::vector<KVPair> LRU; /* GUARDED_BY(Mut) */
+  std::vector<Entry> LRU; /* GUARDED_BY(Mut) */
+  std::size_t TotalBytes = 0; /* GUARDED_BY(Mut) */
 };
 
 /// A map from header files to an opened "proxy" file that includes them.
@@ -343,6 +407,69 @@ public:
   }
 };
 
+/// Measures how often open files build equivalent preambles: the same
+/// preamble text, working directory and flags other than the main file. These
+/// are the builds a shared preamble store could avoid, whereas preambles are
+/// currently built and kept per file.
+///
+/// Only the latest preamble of each live worker is tracked, so the size is
+/// bounded by the number of open files. Entries are keyed by worker rather
+/// than by file name, as a closed file's worker may still be shutting down when
+/// the file is reopened. All methods are threadsafe.
+class TUScheduler::PreambleSharingTracker {
+  std::mutex Mu;
+  /// Number of workers whose latest preamble has the given key.
+  llvm::DenseMap<uint64_t, unsigned> WorkersByKey;
+  llvm::DenseMap<const void *, uint64_t> KeyByWorker;
+
+  static uint64_t preambleKey(PathRef FileName, const ParseInputs &Inputs,
+                              const PreambleData &Preamble) {
+    std::string Key =
+        Inputs.Contents.substr(0, Preamble.Preamble.getBounds().Size);
+    Key.push_back('\0');
+    Key += Inputs.CompileCommand.Directory;
+    for (llvm::StringRef Arg : Inputs.CompileCommand.CommandLine) {
+      if (Arg == Inputs.CompileCommand.Filename || Arg == FileName)
+        continue;
+      Key.push_back('\0');
+      Key += Arg;
+    }
+    return llvm::xxh3_64bits(Key);
+  }
+
+  void removeLocked(const void *Worker) {
+    auto It = KeyByWorker.find(Worker);
+    if (It == KeyByWorker.end())
+      return;
+    auto Count = WorkersByKey.find(It->second);
+    if (--Count->second == 0)
+      WorkersByKey.erase(Count);
+    KeyByWorker.erase(It);
+  }
+
+public:
+  /// Records a preamble that \p Worker built for \p FileName, replacing its
+  /// previous one, in the preamble_build_sharing metric.
+  void update(const void *Worker, PathRef FileName, const ParseInputs &Inputs,
+              const PreambleData &Preamble) {
+    static constexpr trace::Metric PreambleBuildSharing(
+        "preamble_build_sharing", trace::Metric::Counter, "result");
+    uint64_t Key = preambleKey(FileName, Inputs, Preamble);
+    std::lock_guard<std::mutex> Lock(Mu);
+    removeLocked(Worker);
+    unsigned &Count = WorkersByKey[Key];
+    PreambleBuildSharing.record(1, Count ? "shareable" : "unique");
+    ++Count;
+    KeyByWorker[Worker] = Key;
+  }
+
+  /// Forgets the preamble of a worker that is shutting down.
+  void remove(const void *Worker) {
+    std::lock_guard<std::mutex> Lock(Mu);
+    removeLocked(Worker);
+  }
+};
+
 namespace {
 
 bool isReliable(const tooling::CompileCommand &Cmd) {
@@ -431,11 +558,12 @@ public:
                  bool StorePreambleInMemory, bool RunSync,
                  PreambleThrottler *Throttler, SynchronizedTUStatus &Status,
                  TUScheduler::HeaderIncluderCache &HeaderIncluders,
+                 TUScheduler::PreambleSharingTracker &PreambleSharing,
                  ASTWorker &AW)
       : FileName(FileName), Callbacks(Callbacks),
         StoreInMemory(StorePreambleInMemory), RunSync(RunSync),
         Throttler(Throttler), Status(Status), ASTPeer(AW),
-        HeaderIncluders(HeaderIncluders) {}
+        HeaderIncluders(HeaderIncluders), PreambleSharing(PreambleSharing) {}
 
   /// It isn't guaranteed that each requested version will be built. If there
   /// are multiple update requests while building a preamble, only the last one
@@ -589,6 +717,7 @@ private:
   SynchronizedTUStatus &Status;
   ASTWorker &ASTPeer;
   TUScheduler::HeaderIncluderCache &HeaderIncluders;
+  TUScheduler::PreambleSharingTracker &PreambleSharing;
 };
 
 class ASTWorkerHandle;
@@ -608,6 +737,7 @@ class ASTWorker {
   ASTWorker(PathRef FileName, const GlobalCompilationDatabase &CDB,
             TUScheduler::ASTCache &LRUCache,
             TUScheduler::HeaderIncluderCache &HeaderIncluders,
+            TUScheduler::PreambleSharingTracker &PreambleSharing,
             Semaphore &Barrier, bool RunSync, const TUScheduler::Options &Opts,
             ParsingCallbacks &Callbacks);
 
@@ -621,6 +751,7 @@ public:
   create(PathRef FileName, const GlobalCompilationDatabase &CDB,
          TUScheduler::ASTCache &IdleASTs,
          TUScheduler::HeaderIncluderCache &HeaderIncluders,
+         TUScheduler::PreambleSharingTracker &PreambleSharing,
          AsyncTaskRunner *Tasks, Semaphore &Barrier,
          const TUScheduler::Options &Opts, ParsingCallbacks &Callbacks);
   ~ASTWorker();
@@ -713,6 +844,7 @@ private:
   /// Handles retention of ASTs.
   TUScheduler::ASTCache &IdleASTs;
   TUScheduler::HeaderIncluderCache &HeaderIncluders;
+  TUScheduler::PreambleSharingTracker &PreambleSharing;
   const bool RunSync;
   /// Time to wait after an update to see whether another update obsoletes it.
   const DebouncePolicy UpdateDebounce;
@@ -815,12 +947,13 @@ ASTWorkerHandle
 ASTWorker::create(PathRef FileName, const GlobalCompilationDatabase &CDB,
                   TUScheduler::ASTCache &IdleASTs,
                   TUScheduler::HeaderIncluderCache &HeaderIncluders,
+                  TUScheduler::PreambleSharingTracker &PreambleSharing,
                   AsyncTaskRunner *Tasks, Semaphore &Barrier,
                   const TUScheduler::Options &Opts,
                   ParsingCallbacks &Callbacks) {
-  std::shared_ptr<ASTWorker> Worker(
-      new ASTWorker(FileName, CDB, IdleASTs, HeaderIncluders, Barrier,
-                    /*RunSync=*/!Tasks, Opts, Callbacks));
+  std::shared_ptr<ASTWorker> Worker(new ASTWorker(
+      FileName, CDB, IdleASTs, HeaderIncluders, PreambleSharing, Barrier,
+      /*RunSync=*/!Tasks, Opts, Callbacks));
   if (Tasks) {
     Tasks->runAsync("ASTWorker:" + llvm::sys::path::filename(FileName),
                     [Worker]() { Worker->run(); });
@@ -834,15 +967,18 @@ ASTWorker::create(PathRef FileName, const GlobalCompilationDatabase &CDB,
 ASTWorker::ASTWorker(PathRef FileName, const GlobalCompilationDatabase &CDB,
                      TUScheduler::ASTCache &LRUCache,
                      TUScheduler::HeaderIncluderCache &HeaderIncluders,
+                     TUScheduler::PreambleSharingTracker &PreambleSharing,
                      Semaphore &Barrier, bool RunSync,
                      const TUScheduler::Options &Opts,
                      ParsingCallbacks &Callbacks)
-    : IdleASTs(LRUCache), HeaderIncluders(HeaderIncluders), RunSync(RunSync),
+    : IdleASTs(LRUCache), HeaderIncluders(HeaderIncluders),
+      PreambleSharing(PreambleSharing), RunSync(RunSync),
       UpdateDebounce(Opts.UpdateDebounce), FileName(FileName),
       ContextProvider(Opts.ContextProvider), CDB(CDB), Callbacks(Callbacks),
       Barrier(Barrier), Done(false), Status(FileName, Callbacks),
       PreamblePeer(FileName, Callbacks, Opts.StorePreamblesInMemory, RunSync,
-                   Opts.PreambleThrottler, Status, HeaderIncluders, *this) {
+                   Opts.PreambleThrottler, Status, HeaderIncluders,
+                   PreambleSharing, *this) {
   // Set a fallback command because compile command can be accessed before
   // `Inputs` is initialized. Other fields are only used after initialization
   // from client inputs.
@@ -852,6 +988,8 @@ ASTWorker::ASTWorker(PathRef FileName, const GlobalCompilationDatabase &CDB,
 ASTWorker::~ASTWorker() {
   // Make sure we remove the cached AST, if any.
   IdleASTs.take(this);
+  // The preamble thread has finished, so this can't race with its updates.
+  PreambleSharing.remove(this);
 #ifndef NDEBUG
   std::lock_guard<std::mutex> Lock(Mutex);
   assert(Done && "handle was not destroyed");
@@ -898,6 +1036,12 @@ void ASTWorker::update(ParseInputs Inputs, WantDiagnostics WantDiags,
       IdleASTs.take(this);
       RanASTCallback = false;
     }
+    // Tracks how local main-file edits are, i.e. how much of the AST rebuild
+    // could in principle be avoided by reusing unchanged declarations.
+    static constexpr trace::Metric ASTEditBytes("ast_edit_bytes",
+                                                trace::Metric::Distribution);
+    if (FileInputs.Contents != Inputs.Contents && !FileInputs.Contents.empty())
+      ASTEditBytes.record(editedBytes(FileInputs.Contents, Inputs.Contents));
 
     // Update current inputs so that subsequent reads can see them.
     {
@@ -1097,6 +1241,7 @@ void PreambleThread::build(Request Req) {
   if (!LatestBuild)
     return;
   reportPreambleBuild(Stats, IsFirstPreamble);
+  PreambleSharing.update(&ASTPeer, FileName, Inputs, *LatestBuild);
   if (isReliable(LatestBuild->CompileCommand))
     HeaderIncluders.update(FileName, LatestBuild->Includes.allHeaders());
 }
@@ -1635,9 +1780,9 @@ TUScheduler::TUScheduler(const GlobalCompilationDatabase &CDB,
       Callbacks(Callbacks ? std::move(Callbacks)
                           : std::make_unique<ParsingCallbacks>()),
       Barrier(Opts.AsyncThreadsCount), QuickRunBarrier(Opts.AsyncThreadsCount),
-      IdleASTs(
-          std::make_unique<ASTCache>(Opts.RetentionPolicy.MaxRetainedASTs)),
-      HeaderIncluders(std::make_unique<HeaderIncluderCache>()) {
+      IdleASTs(std::make_unique<ASTCache>(Opts.RetentionPolicy)),
+      HeaderIncluders(std::make_unique<HeaderIncluderCache>()),
+      PreambleSharing(std::make_unique<PreambleSharingTracker>()) {
   // Avoid null checks everywhere.
   if (!Opts.ContextProvider) {
     this->Opts.ContextProvider = [](llvm::StringRef) {
@@ -1679,7 +1824,7 @@ bool TUScheduler::update(PathRef File, ParseInputs Inputs,
   if (!FD) {
     // Create a new worker to process the AST-related tasks.
     ASTWorkerHandle Worker = ASTWorker::create(
-        File, CDB, *IdleASTs, *HeaderIncluders,
+        File, CDB, *IdleASTs, *HeaderIncluders, *PreambleSharing,
         WorkerThreads ? &*WorkerThreads : nullptr, Barrier, Opts, *Callbacks);
     FD = std::unique_ptr<FileData>(
         new FileData{Inputs.Contents, std::move(Worker)});
@@ -1823,6 +1968,10 @@ llvm::StringMap<TUScheduler::FileStats> TUScheduler::fileStats() const {
   return Result;
 }
 
+std::size_t TUScheduler::evictIdleASTs(std::size_t Bytes) {
+  return IdleASTs->evict(Bytes);
+}
+
 std::vector<Path> TUScheduler::getFilesWithCachedAST() const {
   std::vector<Path> Result;
   for (auto &&PathAndFile : Files) {
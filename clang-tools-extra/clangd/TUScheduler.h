@@ -64,6 +64,10 @@ struct ASTRetentionPolicy {
   /// Maximum number of ASTs to be retained in memory when there are no pending
   /// requests for them.
   unsigned MaxRetainedASTs = 3;
+  /// Maximum total size (as reported by ParsedAST::getUsedBytes()) of ASTs
+  /// retained in memory. The most recently used AST is always kept.
+  /// Zero means no limit.
+  size_t MaxRetainedBytes = 0;
 };
 
 /// Clangd may wait after an update to see if another one comes along.
@@ -260,6 +264,11 @@ public:
   /// contain files that currently run something over their AST.
   std::vector<Path> getFilesWithCachedAST() const;
 
+  /// Drops idle ASTs, least recently used first, until at least \p Bytes have
+  /// been released or no idle ASTs remain. They are rebuilt on next use.
+  /// Returns the number of bytes released.
+  std::size_t evictIdleASTs(std::size_t Bytes);
+
   /// Schedule an update for \p File.
   /// The compile command in \p Inputs is ignored; worker queries CDB to get
   /// the actual compile command.
@@ -348,6 +357,8 @@ public:
   class ASTCache;
   /// Tracks headers included by open files, to get known-good compile commands.
   class HeaderIncluderCache;
+  /// Tracks equivalent preambles across open files, for metrics.
+  class PreambleSharingTracker;
 
   // The file being built/processed in the current thread. This is a hack in
   // order to get the file name into the index implementations. Do not depend on
@@ -371,6 +382,7 @@ private:
   llvm::StringMap<std::unique_ptr<FileData>> Files;
   std::unique_ptr<ASTCache> IdleASTs;
   std::unique_ptr<HeaderIncluderCache> HeaderIncluders;
+  std::unique_ptr<PreambleSharingTracker> PreambleSharing;
   // std::nullopt when running tasks synchronously and non-std::nullopt when
   // running tasks asynchronously.
   std::optional<AsyncTaskRunner> PreambleTasks;
@@ -21,7 +21,9 @@
 #include "llvm/Support/Allocator.h"
 #include "llvm/Support/Process.h"
 #include "llvm/Support/SourceMgr.h"
+#include <algorithm>
 #include <memory>
+#include <mutex>
 #include <optional>
 
 namespace clang {
@@ -329,5 +331,32 @@ std::optional<bool> isFastTidyCheck(llvm::StringRef Check) {
   return std::nullopt;
 }
 
+namespace {
+struct TidyCheckTimes {
+  std::mutex Mu;
+  llvm::StringMap<std::chrono::milliseconds> Slowest;
+};
+TidyCheckTimes &tidyCheckTimes() {
+  static auto &Times = *new TidyCheckTimes;
+  return Times;
+}
+} // namespace
+
+std::chrono::milliseconds recordTidyCheckTime(llvm::StringRef Check,
+                                              std::chrono::milliseconds Time) {
+  auto &Times = tidyCheckTimes();
+  std::lock_guard<std::mutex> Lock(Times.Mu);
+  auto &Slowest = Times.Slowest[Check];
+  auto Previous = Slowest;
+  Slowest = std::max(Slowest, Time);
+  return Previous;
+}
+
+std::chrono::milliseconds slowestTidyCheckTime(llvm::StringRef Check) {
+  auto &Times = tidyCheckTimes();
+  std::lock_guard<std::mutex> Lock(Times.Mu);
+  return Times.Slowest.lookup(Check);
+}
+
 } // namespace clangd
 } // namespace clang
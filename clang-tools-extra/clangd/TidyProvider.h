@@ -13,6 +13,7 @@
 #include "support/ThreadsafeFS.h"
 #include "llvm/ADT/FunctionExtras.h"
 #include "llvm/ADT/StringRef.h"
+#include <chrono>
 
 namespace clang {
 namespace clangd {
@@ -64,6 +65,13 @@ bool isRegisteredTidyCheck(llvm::StringRef Check);
 /// By default, only fast checks will run in clangd.
 std::optional<bool> isFastTidyCheck(llvm::StringRef Check);
 
+/// Records that \p Check took \p Time to run on some file.
+/// Returns the longest time previously recorded for the check.
+std::chrono::milliseconds recordTidyCheckTime(llvm::StringRef Check,
+                                              std::chrono::milliseconds Time);
+/// Returns the longest time recorded for \p Check on any file, this session.
+std::chrono::milliseconds slowestTidyCheckTime(llvm::StringRef Check);
+
 } // namespace clangd
 } // namespace clang
 
@@ -1772,22 +1772,45 @@ symbolToCallHierarchyItem(const Symbol &S, PathRef TUPath) {
   return Result;
 }
 
+// Resolves the hierarchy breadth-first, with a single relations request per
+// level rather than per type, as each request may be a remote round-trip.
 static void fillSubTypes(const SymbolID &ID,
                          std::vector<TypeHierarchyItem> &SubTypes,
                          const SymbolIndex *Index, int Levels, PathRef TUPath) {
-  RelationsRequest Req;
-  Req.Subjects.insert(ID);
-  Req.Predicate = RelationKind::BaseOf;
-  Index->relations(Req, [&](const SymbolID &Subject, const Symbol &Object) {
-    if (std::optional<TypeHierarchyItem> ChildSym =
-            symbolToTypeHierarchyItem(Object, TUPath)) {
-      if (Levels > 1) {
-        ChildSym->children.emplace();
-        fillSubTypes(Object.ID, *ChildSym->children, Index, Levels - 1, TUPath);
-      }
-      SubTypes.emplace_back(std::move(*ChildSym));
-    }
-  });
+  // Maps each type on the current level to the lists receiving its subtypes.
+  // A type may appear several times in the hierarchy, e.g. under both bases
+  // of a diamond.
+  using LevelMap = llvm::DenseMap<
+      SymbolID, llvm::SmallVector<std::vector<TypeHierarchyItem> *, 1>>;
+  LevelMap Level;
+  Level[ID].push_back(&SubTypes);
+  for (; Levels > 0 && !Level.empty(); --Levels) {
+    RelationsRequest Req;
+    for (const auto &Entry : Level)
+      Req.Subjects.insert(Entry.first);
+    Req.Predicate = RelationKind::BaseOf;
+    Index->relations(Req, [&](const SymbolID &Subject, const Symbol &Object) {
+      auto It = Level.find(Subject);
+      if (It == Level.end())
+        return;
+      if (std::optional<TypeHierarchyItem> ChildSym =
+              symbolToTypeHierarchyItem(Object, TUPath))
+        for (auto *Out : It->second)
+          Out->push_back(*ChildSym);
+    });
+    if (Levels == 1)
+      break;
+    // The lists of this level are complete, so pointers to their elements'
+    // children stay valid while the next level is filled.
+    LevelMap Next;
+    for (const auto &Entry : Level)
+      for (auto *Out : Entry.second)
+        for (TypeHierarchyItem &Child : *Out) {
+          Child.children.emplace();
+          Next[Child.data.symbolID].push_back(&*Child.children);
+        }
+    Level = std::move(Next);
+  }
 }
 
 using RecursionProtectionSet = llvm::SmallSet<const CXXRecordDecl *, 4>;
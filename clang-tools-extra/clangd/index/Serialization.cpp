@@ -209,8 +209,11 @@ public:
   }
 };
 
+// The strings in the table are not copied: they point either into the input
+// buffer (if the table was stored uncompressed) or into the decompressed
+// storage owned by this struct. Callers copy what they keep (e.g. into slabs).
 struct StringTableIn {
-  llvm::BumpPtrAllocator Arena;
+  llvm::SmallVector<uint8_t, 0> Storage;
   std::vector<llvm::StringRef> Strings;
 };
 
@@ -220,8 +223,8 @@ llvm::Expected<StringTableIn> readStringTable(llvm::StringRef Data) {
   if (R.err())
     return error("Truncated string table");
 
+  StringTableIn Table;
   llvm::StringRef Uncompressed;
-  llvm::SmallVector<uint8_t, 0> UncompressedStorage;
   if (UncompressedSize == 0) // No compression
     Uncompressed = R.rest();
   else if (llvm::compression::zlib::isAvailable()) {
@@ -235,25 +238,22 @@ llvm::Expected<StringTableIn> readStringTable(llvm::StringRef Data) {
                    R.rest().size(), UncompressedSize);
 
     if (llvm::Error E = llvm::compression::zlib::decompress(
-            llvm::arrayRefFromStringRef(R.rest()), UncompressedStorage,
+            llvm::arrayRefFromStringRef(R.rest()), Table.Storage,
             UncompressedSize))
       return std::move(E);
-    Uncompressed = toStringRef(UncompressedStorage);
+    Uncompressed = toStringRef(Table.Storage);
   } else
     return error("Compressed string table, but zlib is unavailable");
 
-  StringTableIn Table;
-  llvm::StringSaver Saver(Table.Arena);
-  R = Reader(Uncompressed);
+  // Each string takes at least its terminator, so this bounds the count.
+  Table.Strings.reserve(Uncompressed.count('\0'));
   for (Reader R(Uncompressed); !R.eof();) {
     auto Len = R.rest().find(0);
     if (Len == llvm::StringRef::npos)
       return error("Bad string table: not null terminated");
-    Table.Strings.push_back(Saver.save(R.consume(Len)));
+    Table.Strings.push_back(R.consume(Len));
     R.consume8();
   }
-  if (R.err())
-    return error("Truncated string table");
   return std::move(Table);
 }
 
@@ -16,12 +16,15 @@
 #include "index/dex/Token.h"
 #include "index/dex/Trigram.h"
 #include "support/Logger.h"
+#include "support/Threading.h"
 #include "support/Trace.h"
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringSet.h"
+#include "llvm/Support/MathExtras.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/ScopedPrinter.h"
+#include "llvm/Support/Threading.h"
 #include <algorithm>
 #include <optional>
 #include <queue>
@@ -82,6 +85,18 @@ public:
       TypeDocs[Sym.Type].push_back(D);
   }
 
+  // Append the documents added to Other, which must all be greater than the
+  // ones added to this builder, so that the posting lists stay sorted.
+  void merge(IndexBuilder &&Other) {
+    for (auto &E : Other.TrigramDocs)
+      append(TrigramDocs[E.first], E.second);
+    append(RestrictedCCDocs, Other.RestrictedCCDocs);
+    append(TypeDocs, Other.TypeDocs);
+    append(ScopeDocs, Other.ScopeDocs);
+    append(ProximityDocs, Other.ProximityDocs);
+    Other = IndexBuilder();
+  }
+
   // Assemble the final compressed posting lists for the added symbols.
   llvm::DenseMap<Token, PostingList> build() && {
     llvm::DenseMap<Token, PostingList> Result(/*InitialReserve=*/
@@ -117,8 +132,27 @@ public:
                          std::move(RestrictedCCDocs));
     return Result;
   }
+
+private:
+  static void append(std::vector<DocID> &To, std::vector<DocID> &From) {
+    assert((To.empty() || From.empty() || To.back() < From.front()) &&
+           "Merged builders must cover increasing DocID ranges");
+    if (To.empty())
+      To = std::move(From);
+    else
+      To.insert(To.end(), From.begin(), From.end());
+  }
+  static void append(llvm::StringMap<std::vector<DocID>> &To,
+                     llvm::StringMap<std::vector<DocID>> &From) {
+    for (auto &E : From)
+      append(To[E.first()], E.second);
+  }
 };
 
+// Symbols are tokenized in parallel shards only if each gets at least this
+// many, as spawning threads doesn't pay off for small (e.g. per-file) indexes.
+constexpr size_t MinSymbolsPerShard = 1 << 15;
+
 } // namespace
 
 void Dex::buildIndex(bool SupportContainedRefs) {
@@ -143,11 +177,31 @@ void Dex::buildIndex(bool SupportContainedRefs) {
     Symbols[I] = ScoredSymbols[I].second;
   }
 
-  // Build posting lists for symbols.
-  IndexBuilder Builder;
-  for (DocID SymbolRank = 0; SymbolRank < Symbols.size(); ++SymbolRank)
-    Builder.add(*Symbols[SymbolRank], SymbolRank);
-  InvertedIndex = std::move(Builder).build();
+  // Build posting lists for symbols. Large indexes are split into contiguous
+  // ranges of ranks which are tokenized concurrently, then merged in order.
+  size_t NumShards = std::min<size_t>(
+      llvm::heavyweight_hardware_concurrency().compute_thread_count(),
+      Symbols.size() / MinSymbolsPerShard);
+  std::vector<IndexBuilder> Shards(std::max<size_t>(NumShards, 1));
+  if (Shards.size() == 1) {
+    for (DocID SymbolRank = 0; SymbolRank < Symbols.size(); ++SymbolRank)
+      Shards.front().add(*Symbols[SymbolRank], SymbolRank);
+  } else {
+    trace::Span Tracer("DexShardedBuild");
+    SPAN_ATTACH(Tracer, "shards", static_cast<int>(Shards.size()));
+    size_t ShardSize = llvm::divideCeil(Symbols.size(), Shards.size());
+    AsyncTaskRunner Tasks;
+    for (size_t I = 0; I < Shards.size(); ++I)
+      Tasks.runAsync("dex-build:" + llvm::Twine(I), [&, I] {
+        DocID End = std::min(Symbols.size(), (I + 1) * ShardSize);
+        for (DocID SymbolRank = I * ShardSize; SymbolRank < End; ++SymbolRank)
+          Shards[I].add(*Symbols[SymbolRank], SymbolRank);
+      });
+    Tasks.wait();
+    for (size_t I = 1; I < Shards.size(); ++I)
+      Shards.front().merge(std::move(Shards[I]));
+  }
+  InvertedIndex = std::move(Shards.front()).build();
 
   // If the containedRefs() operation is supported, build the RevRefs
   // data structure used to implement it.
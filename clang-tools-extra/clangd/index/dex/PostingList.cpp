@@ -9,8 +9,9 @@
 #include "PostingList.h"
 #include "index/dex/Iterator.h"
 #include "index/dex/Token.h"
+#include "llvm/Support/Compiler.h"
 #include "llvm/Support/MathExtras.h"
-#include <optional>
+#include <algorithm>
 
 namespace clang {
 namespace clangd {
@@ -98,12 +99,25 @@ private:
   }
 
   /// Advances CurrentChunk to the chunk which might contain ID.
+  ///
+  /// Intersections usually advance to a nearby DocID, so this gallops forward
+  /// (checking chunks 1, 2, 4, ... ahead) to bound the range that contains ID
+  /// and only binary searches inside it, instead of over all remaining chunks.
   void advanceToChunk(DocID ID) {
     if ((CurrentChunk != Chunks.end() - 1) &&
         ((CurrentChunk + 1)->Head <= ID)) {
-      CurrentChunk =
-          std::partition_point(CurrentChunk + 1, Chunks.end(),
-                               [&](const Chunk &C) { return C.Head < ID; });
+      // Chunks before Low all have Head < ID (or are CurrentChunk), the chunk
+      // at High (if any) has Head >= ID.
+      size_t Low = CurrentChunk - Chunks.begin() + 1;
+      size_t High = Low + 1;
+      for (size_t Step = 1; High < Chunks.size() && Chunks[High].Head < ID;
+           Step *= 2) {
+        Low = High;
+        High = std::min(Low + Step, Chunks.size());
+      }
+      CurrentChunk = std::partition_point(
+          Chunks.begin() + Low, Chunks.begin() + High,
+          [&](const Chunk &C) { return C.Head < ID; });
       --CurrentChunk;
       DecompressedChunk = CurrentChunk->decompress();
       CurrentID = DecompressedChunk.begin();
@@ -181,38 +195,33 @@ std::vector<Chunk> encodeStream(llvm::ArrayRef<DocID> Documents) {
   return std::vector<Chunk>(Result); // no move, shrink-to-fit
 }
 
-/// Reads variable length DocID from the buffer and updates the buffer size. If
-/// the stream is terminated, return std::nullopt.
-std::optional<DocID> readVByte(llvm::ArrayRef<uint8_t> &Bytes) {
-  if (Bytes.front() == 0 || Bytes.empty())
-    return std::nullopt;
-  DocID Result = 0;
-  bool HasNextByte = true;
-  for (size_t Length = 0; HasNextByte && !Bytes.empty(); ++Length) {
-    assert(Length <= 5 && "Malformed VByte encoding sequence.");
-    // Write meaningful bits to the correct place in the document decoding.
-    Result |= (Bytes.front() & 0x7f) << (BitsPerEncodingByte * Length);
-    if ((Bytes.front() & 0x80) == 0)
-      HasNextByte = false;
-    Bytes = Bytes.drop_front();
-  }
-  return Result;
-}
-
 } // namespace
 
 llvm::SmallVector<DocID, Chunk::PayloadSize + 1> Chunk::decompress() const {
   llvm::SmallVector<DocID, Chunk::PayloadSize + 1> Result{Head};
-  llvm::ArrayRef<uint8_t> Bytes(Payload);
-  DocID Delta;
-  for (DocID Current = Head; !Bytes.empty(); Current += Delta) {
-    auto MaybeDelta = readVByte(Bytes);
-    if (!MaybeDelta)
-      break;
-    Delta = *MaybeDelta;
-    Result.push_back(Current + Delta);
+  DocID Current = Head;
+  // A zero byte terminates the stream: no encoding starts with one, as deltas
+  // are never zero and non-final bytes have the continuation bit set.
+  for (size_t I = 0; I < PayloadSize && Payload[I] != 0;) {
+    // Most deltas in dense posting lists fit in a single byte, so handle that
+    // without entering the general loop.
+    DocID Delta = Payload[I++];
+    if (LLVM_UNLIKELY(Delta & 0x80)) {
+      Delta &= 0x7f;
+      for (size_t Shift = BitsPerEncodingByte; I < PayloadSize;
+           Shift += BitsPerEncodingByte) {
+        assert(Shift < 5 * BitsPerEncodingByte &&
+               "Malformed VByte encoding sequence.");
+        uint8_t Byte = Payload[I++];
+        Delta |= static_cast<DocID>(Byte & 0x7f) << Shift;
+        if ((Byte & 0x80) == 0)
+          break;
+      }
+    }
+    Current += Delta;
+    Result.push_back(Current);
   }
-  return llvm::SmallVector<DocID, Chunk::PayloadSize + 1>{Result};
+  return Result;
 }
 
 PostingList::PostingList(llvm::ArrayRef<DocID> Documents)
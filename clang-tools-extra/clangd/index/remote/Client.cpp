@@ -16,12 +16,17 @@
 #include "support/Logger.h"
 #include "support/Trace.h"
 #include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Support/Error.h"
 
 #include <atomic>
 #include <chrono>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
 
 namespace clang {
 namespace clangd {
@@ -44,6 +49,62 @@ llvm::StringRef toString(const grpc_connectivity_state &State) {
   llvm_unreachable("Not a valid grpc_connectivity_state.");
 }
 
+// Remembers recent responses, keyed by the serialized request.
+// The same queries are often repeated within a short time (e.g. code completion
+// while typing, or hover followed by go-to-definition). Entries expire quickly,
+// as the server may reload its index at any time.
+class ResponseCache {
+public:
+  struct Entry {
+    // Serialized stream_result messages, in the order they were received.
+    std::vector<std::string> Results;
+    bool HasMore = false;
+    std::chrono::steady_clock::time_point Time;
+  };
+
+  std::optional<Entry> get(llvm::StringRef Key) {
+    std::lock_guard<std::mutex> Lock(Mu);
+    auto It = Entries.find(Key);
+    if (It == Entries.end())
+      return std::nullopt;
+    if (std::chrono::steady_clock::now() - It->second.Time > MaxAge) {
+      Entries.erase(It);
+      return std::nullopt;
+    }
+    return It->second;
+  }
+
+  void put(std::string Key, Entry E) {
+    size_t Bytes = Key.size();
+    for (const auto &Result : E.Results)
+      Bytes += Result.size();
+    if (Bytes > MaxEntryBytes)
+      return;
+    E.Time = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> Lock(Mu);
+    if (Entries.size() >= MaxEntries) {
+      auto Now = E.Time;
+      for (auto It = Entries.begin(); It != Entries.end();) {
+        auto Next = std::next(It);
+        if (Now - It->second.Time > MaxAge)
+          Entries.erase(It);
+        It = Next;
+      }
+      if (Entries.size() >= MaxEntries)
+        Entries.clear();
+    }
+    Entries[Key] = std::move(E);
+  }
+
+private:
+  static constexpr size_t MaxEntries = 64;
+  static constexpr size_t MaxEntryBytes = 1 << 20;
+  static constexpr std::chrono::seconds MaxAge = std::chrono::seconds(10);
+
+  std::mutex Mu;
+  llvm::StringMap<Entry> Entries;
+};
+
 class IndexClient : public clangd::SymbolIndex {
   void updateConnectionStatus() const {
     auto NewStatus = Channel->GetState(/*try_to_connect=*/false);
@@ -71,6 +132,29 @@ class IndexClient : public clangd::SymbolIndex {
     trace::Span Tracer(RequestT::descriptor()->name());
     const auto RPCRequest = ProtobufMarshaller->toProtobuf(Request);
     SPAN_ATTACH(Tracer, "Request", RPCRequest.DebugString());
+    std::string CacheKey = RequestT::descriptor()->name();
+    CacheKey += '\0';
+    CacheKey += RPCRequest.SerializeAsString();
+    if (auto Cached = Cache.get(CacheKey)) {
+      SPAN_ATTACH(Tracer, "Cached", true);
+      for (const std::string &Serialized : Cached->Results) {
+        ReplyT Reply;
+        if (!Reply.mutable_stream_result()->ParseFromString(Serialized)) {
+          elog("Failed to parse cached {0}", ReplyT::descriptor()->name());
+          continue;
+        }
+        auto Response = ProtobufMarshaller->fromProtobuf(Reply.stream_result());
+        if (!Response) {
+          elog("Cached invalid {0}: {1}. Reason: {2}",
+               ReplyT::descriptor()->name(),
+               Reply.stream_result().DebugString(), Response.takeError());
+          continue;
+        }
+        Callback(*Response);
+      }
+      return Cached->HasMore;
+    }
+    ResponseCache::Entry ToCache;
     grpc::ClientContext Context;
     Context.AddMetadata("version", versionString());
     Context.AddMetadata("features", featureString());
@@ -90,6 +174,7 @@ class IndexClient : public clangd::SymbolIndex {
         HasMore = Reply.final_result().has_more();
         continue;
       }
+      ToCache.Results.push_back(Reply.stream_result().SerializeAsString());
       auto Response = ProtobufMarshaller->fromProtobuf(Reply.stream_result());
       if (!Response) {
         elog("Received invalid {0}: {1}. Reason: {2}",
@@ -106,10 +191,16 @@ class IndexClient : public clangd::SymbolIndex {
                       .count();
     vlog("Remote index [{0}]: {1} => {2} results in {3}ms.", ServerAddress,
          RequestT::descriptor()->name(), Successful, Millis);
-    SPAN_ATTACH(Tracer, "Status", Reader->Finish().ok());
+    grpc::Status Status = Reader->Finish();
+    SPAN_ATTACH(Tracer, "Status", Status.ok());
     SPAN_ATTACH(Tracer, "Successful", Successful);
     SPAN_ATTACH(Tracer, "Failed to parse", FailedToParse);
     updateConnectionStatus();
+    // Broken streams are not cached, so that the request is retried.
+    if (Status.ok()) {
+      ToCache.HasMore = HasMore;
+      Cache.put(std::move(CacheKey), std::move(ToCache));
+    }
     return HasMore;
   }
 
@@ -185,6 +276,7 @@ private:
   std::unique_ptr<Marshaller> ProtobufMarshaller;
   // Each request will be terminated if it takes too long.
   std::chrono::milliseconds DeadlineWaitingTime;
+  mutable ResponseCache Cache;
 };
 
 } // namespace
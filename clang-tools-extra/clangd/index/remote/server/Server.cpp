@@ -111,6 +111,11 @@ llvm::cl::opt<size_t> LimitResults(
                    "single request. Limit is to keep the server from being "
                    "DOS'd. Defaults to 10000."));
 
+llvm::cl::opt<bool> CompressResponses(
+    "compress-responses", llvm::cl::init(false),
+    llvm::cl::desc("Compress responses with gzip. Symbols and references "
+                   "compress well, which matters for clients on slow links."));
+
 static Key<grpc::ServerContext *> CurrentRequest;
 
 class RemoteIndexServer final : public v1::SymbolIndex::Service {
@@ -468,6 +473,8 @@ void runServerAndWait(clangd::SymbolIndex &Index, llvm::StringRef ServerAddress,
                            grpc::InsecureServerCredentials());
   Builder.AddChannelArgument(GRPC_ARG_MAX_CONNECTION_IDLE_MS,
                              IdleTimeoutSeconds * 1000);
+  if (CompressResponses)
+    Builder.SetDefaultCompressionAlgorithm(GRPC_COMPRESS_GZIP);
   Builder.RegisterService(&Service);
   Builder.RegisterService(&Monitor);
   std::unique_ptr<grpc::Server> Server(Builder.BuildAndStart());
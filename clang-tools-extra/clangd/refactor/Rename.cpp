@@ -14,6 +14,7 @@
 #include "SourceCode.h"
 #include "index/SymbolCollector.h"
 #include "support/Logger.h"
+#include "support/Threading.h"
 #include "support/Trace.h"
 #include "clang/AST/ASTContext.h"
 #include "clang/AST/ASTTypeTraits.h"
@@ -33,6 +34,9 @@
 #include "llvm/Support/Error.h"
 #include "llvm/Support/FormatVariadic.h"
 #include "llvm/Support/JSON.h"
+#include "llvm/Support/MathExtras.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Threading.h"
 #include <algorithm>
 #include <optional>
 
@@ -860,6 +864,9 @@ void insertTransitiveOverrides(SymbolID Base, llvm::DenseSet<SymbolID> &IDs,
   }
 }
 
+// Renaming fewer files than this per thread isn't worth the overhead.
+constexpr size_t MinFilesPerRenameShard = 16;
+
 // Return all rename occurrences (using the index) outside of the main file,
 // grouped by the absolute file path.
 llvm::Expected<llvm::StringMap<std::vector<Range>>>
@@ -926,46 +933,92 @@ renameOutsideFile(const NamedDecl &RenameDecl, llvm::StringRef MainFilePath,
                                                   Index, MaxLimitFiles);
   if (!AffectedFiles)
     return AffectedFiles.takeError();
-  FileEdits Results;
+
+  std::string RenameIdentifier = RenameDecl.getNameAsString();
+  std::optional<Selector> Selector = std::nullopt;
+  llvm::SmallVector<llvm::StringRef, 8> NewNames;
+  if (const auto *MD = dyn_cast<ObjCMethodDecl>(&RenameDecl)) {
+    RenameIdentifier = MD->getSelector().getNameForSlot(0).str();
+    if (MD->getSelector().getNumArgs() > 1)
+      Selector = MD->getSelector();
+  }
+  NewName.split(NewNames, ":");
+  const LangOptions &LangOpts = RenameDecl.getASTContext().getLangOpts();
+
+  // Re-lexing each file to adjust the indexed ranges dominates the cost of
+  // renaming widely used symbols, so it is done in parallel. The files are
+  // read upfront, as the VFS isn't required to be thread-safe.
+  struct AffectedFile {
+    llvm::StringRef Path;
+    std::unique_ptr<llvm::MemoryBuffer> Buffer;
+    std::vector<Range> Occurrences;
+    std::optional<Edit> Result;
+    std::string Error;
+  };
+  std::vector<AffectedFile> Files;
+  Files.reserve(AffectedFiles->size());
   for (auto &FileAndOccurrences : *AffectedFiles) {
     llvm::StringRef FilePath = FileAndOccurrences.first();
-
     auto ExpBuffer = FS.getBufferForFile(FilePath);
     if (!ExpBuffer) {
       elog("Fail to read file content: Fail to open file {0}: {1}", FilePath,
            ExpBuffer.getError().message());
       continue;
     }
-    std::string RenameIdentifier = RenameDecl.getNameAsString();
-    std::optional<Selector> Selector = std::nullopt;
-    llvm::SmallVector<llvm::StringRef, 8> NewNames;
-    if (const auto *MD = dyn_cast<ObjCMethodDecl>(&RenameDecl)) {
-      RenameIdentifier = MD->getSelector().getNameForSlot(0).str();
-      if (MD->getSelector().getNumArgs() > 1)
-        Selector = MD->getSelector();
-    }
-    NewName.split(NewNames, ":");
+    Files.push_back({FilePath, std::move(*ExpBuffer),
+                     std::move(FileAndOccurrences.second), std::nullopt, ""});
+  }
 
-    auto AffectedFileCode = (*ExpBuffer)->getBuffer();
+  auto RenameInFile = [&](AffectedFile &File) {
+    auto AffectedFileCode = File.Buffer->getBuffer();
     auto RenameRanges =
         adjustRenameRanges(AffectedFileCode, RenameIdentifier,
-                           std::move(FileAndOccurrences.second),
-                           RenameDecl.getASTContext().getLangOpts(), Selector);
+                           std::move(File.Occurrences), LangOpts, Selector);
     if (!RenameRanges) {
       // Our heuristics fails to adjust rename ranges to the current state of
       // the file, it is most likely the index is stale, so we give up the
       // entire rename.
-      return error("Index results don't match the content of file {0} "
-                   "(the index may be stale)",
-                   FilePath);
+      File.Error = llvm::formatv("Index results don't match the content of "
+                                 "file {0} (the index may be stale)",
+                                 File.Path)
+                       .str();
+      return;
     }
     auto RenameEdit =
-        buildRenameEdit(FilePath, AffectedFileCode, *RenameRanges, NewNames);
-    if (!RenameEdit)
-      return error("failed to rename in file {0}: {1}", FilePath,
-                   RenameEdit.takeError());
-    if (!RenameEdit->Replacements.empty())
-      Results.insert({FilePath, std::move(*RenameEdit)});
+        buildRenameEdit(File.Path, AffectedFileCode, *RenameRanges, NewNames);
+    if (!RenameEdit) {
+      File.Error = llvm::formatv("failed to rename in file {0}: {1}",
+                                 File.Path,
+                                 llvm::toString(RenameEdit.takeError()))
+                       .str();
+      return;
+    }
+    File.Result = std::move(*RenameEdit);
+  };
+  size_t NumShards = std::min<size_t>(
+      llvm::heavyweight_hardware_concurrency().compute_thread_count(),
+      Files.size() / MinFilesPerRenameShard);
+  if (NumShards <= 1) {
+    for (auto &File : Files)
+      RenameInFile(File);
+  } else {
+    size_t ShardSize = llvm::divideCeil(Files.size(), NumShards);
+    AsyncTaskRunner Tasks;
+    for (size_t I = 0; I < NumShards; ++I)
+      Tasks.runAsync("rename:" + llvm::Twine(I), [&, I] {
+        size_t End = std::min(Files.size(), (I + 1) * ShardSize);
+        for (size_t F = I * ShardSize; F < End; ++F)
+          RenameInFile(Files[F]);
+      });
+    Tasks.wait();
+  }
+
+  FileEdits Results;
+  for (auto &File : Files) {
+    if (!File.Error.empty())
+      return error(std::move(File.Error));
+    if (!File.Result->Replacements.empty())
+      Results.insert({File.Path, std::move(*File.Result)});
   }
   return Results;
 }
@@ -0,0 +1,72 @@
+//===--- Histogram.cpp - Always-on latency histograms ------------*- C++-*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "support/Histogram.h"
+#include "llvm/Support/MathExtras.h"
+#include <algorithm>
+#include <cmath>
+
+namespace clang {
+namespace clangd {
+
+void LatencyHistogram::record(std::chrono::steady_clock::duration D) {
+  uint64_t Micros = std::max<int64_t>(
+      0, std::chrono::duration_cast<std::chrono::microseconds>(D).count());
+  unsigned Bucket = std::min<unsigned>(
+      Micros == 0 ? 0 : llvm::Log2_64(Micros) + 1, NumBuckets - 1);
+  Buckets[Bucket].fetch_add(1, std::memory_order_relaxed);
+  uint64_t Max = MaxMicros.load(std::memory_order_relaxed);
+  while (Micros > Max &&
+         !MaxMicros.compare_exchange_weak(Max, Micros,
+                                          std::memory_order_relaxed))
+    ;
+}
+
+uint64_t LatencyHistogram::count() const {
+  uint64_t Total = 0;
+  for (const auto &B : Buckets)
+    Total += B.load(std::memory_order_relaxed);
+  return Total;
+}
+
+std::chrono::microseconds LatencyHistogram::quantile(double Q) const {
+  uint64_t Counts[NumBuckets];
+  uint64_t Total = 0;
+  for (unsigned I = 0; I < NumBuckets; ++I)
+    Total += Counts[I] = Buckets[I].load(std::memory_order_relaxed);
+  if (Total == 0)
+    return std::chrono::microseconds(0);
+  uint64_t Rank = std::max<uint64_t>(
+      1, static_cast<uint64_t>(std::ceil(std::clamp(Q, 0.0, 1.0) * Total)));
+  uint64_t Seen = 0;
+  for (unsigned I = 0; I < NumBuckets; ++I) {
+    Seen += Counts[I];
+    // The last bucket is unbounded, the maximum is the best estimate there.
+    if (Seen >= Rank)
+      return I + 1 == NumBuckets
+                 ? max()
+                 : std::min(max(), std::chrono::microseconds(1ull << I));
+  }
+  return max();
+}
+
+llvm::json::Value LatencyHistogram::toJSON() const {
+  auto Millis = [](std::chrono::microseconds D) {
+    return static_cast<double>(D.count()) / 1000;
+  };
+  return llvm::json::Object{
+      {"count", static_cast<int64_t>(count())},
+      {"p50", Millis(quantile(0.5))},
+      {"p90", Millis(quantile(0.9))},
+      {"p99", Millis(quantile(0.99))},
+      {"max", Millis(max())},
+  };
+}
+
+} // namespace clangd
+} // namespace clang
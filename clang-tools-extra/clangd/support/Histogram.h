@@ -0,0 +1,57 @@
+//===--- Histogram.h - Always-on latency histograms --------------*- C++-*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// trace::Metric only records values when a tracer is installed, which is rare
+// outside of development. LatencyHistogram is cheap enough to keep enabled all
+// the time, so that a running server can report where its time is going.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_CLANG_TOOLS_EXTRA_CLANGD_SUPPORT_HISTOGRAM_H
+#define LLVM_CLANG_TOOLS_EXTRA_CLANGD_SUPPORT_HISTOGRAM_H
+
+#include "llvm/Support/JSON.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace clang {
+namespace clangd {
+
+/// A histogram of durations with power-of-two buckets.
+/// record() is lock-free and may be called concurrently from any thread.
+/// Readers observe a recent, but not necessarily consistent, snapshot.
+class LatencyHistogram {
+public:
+  void record(std::chrono::steady_clock::duration D);
+
+  /// Total number of recorded durations.
+  uint64_t count() const;
+  /// Largest recorded duration.
+  std::chrono::microseconds max() const {
+    return std::chrono::microseconds(MaxMicros.load(std::memory_order_relaxed));
+  }
+  /// Approximates the \p Q quantile (0 <= Q <= 1) by the upper bound of the
+  /// bucket it falls in. Returns zero if nothing was recorded.
+  std::chrono::microseconds quantile(double Q) const;
+
+  /// Summarizes the histogram as {count, p50, p90, p99, max} in milliseconds.
+  llvm::json::Value toJSON() const;
+
+private:
+  // Bucket 0 counts durations below 1us, bucket I counts [2^(I-1), 2^I) us.
+  // The last bucket also counts everything longer (~9 minutes and up).
+  static constexpr unsigned NumBuckets = 30;
+  std::atomic<uint64_t> Buckets[NumBuckets] = {};
+  std::atomic<uint64_t> MaxMicros = {0};
+};
+
+} // namespace clangd
+} // namespace clang
+
+#endif
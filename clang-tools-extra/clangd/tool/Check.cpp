@@ -175,7 +175,8 @@ public:
         std::make_unique<DirectoryBasedGlobalCompilationDatabase>(CDBOpts);
     auto Mangler = CommandMangler::detect();
     Mangler.SystemIncludeExtractor =
-        getSystemIncludeExtractor(llvm::ArrayRef(Opts.QueryDriverGlobs));
+        getSystemIncludeExtractor(llvm::ArrayRef(Opts.QueryDriverGlobs),
+                                  Opts.QueryDriverCacheDir);
     if (Opts.ResourceDir)
       Mangler.ResourceDir = *Opts.ResourceDir;
     CDB = std::make_unique<OverlayCDB>(
@@ -144,6 +144,14 @@ list<std::string> QueryDriverGlobs{
     CommaSeparated,
 };
 
+opt<bool> QueryDriverCache{
+    "query-driver-cache",
+    cat(CompileCommands),
+    desc("Cache the system includes extracted with --query-driver on disk, "
+         "under the user cache directory, and reuse them across runs"),
+    init(false),
+};
+
 // FIXME: Flags are the wrong mechanism for user preferences.
 // We should probably read a dotfile or similar.
 opt<bool> AllScopesCompletion{
@@ -513,6 +521,15 @@ opt<bool> PreambleParseForwardingFunctions{
     init(ParseOptions().PreambleParseForwardingFunctions),
 };
 
+opt<unsigned> MemoryBudget{
+    "memory-budget",
+    cat(Misc),
+    desc("When clangd's estimated memory usage exceeds this many megabytes, "
+         "drop caches that can be rebuilt on demand, such as idle ASTs. "
+         "0 means no limit."),
+    init(0),
+};
+
 #if defined(__GLIBC__) && CLANGD_MALLOC_TRIM
 opt<bool> EnableMallocTrim{
     "malloc-trim",
@@ -934,6 +951,7 @@ clangd accepts flags on the commandline, and in the CLANGD_FLAGS environment var
   Opts.StaticIndex = PAI.get();
   Opts.AsyncThreadsCount = WorkerThreadsCount;
   Opts.MemoryCleanup = getMemoryCleanupFunction();
+  Opts.MemoryBudget = static_cast<size_t>(MemoryBudget) * 1024 * 1024;
 
   Opts.CodeComplete.IncludeIneligibleResults = IncludeIneligibleResults;
   Opts.CodeComplete.Limit = LimitResults;
@@ -993,6 +1011,16 @@ clangd accepts flags on the commandline, and in the CLANGD_FLAGS environment var
   Opts.PreambleParseForwardingFunctions = PreambleParseForwardingFunctions;
   Opts.ImportInsertions = ImportInsertions;
   Opts.QueryDriverGlobs = std::move(QueryDriverGlobs);
+  if (QueryDriverCache) {
+    llvm::SmallString<256> CacheDir;
+    if (llvm::sys::path::cache_directory(CacheDir)) {
+      llvm::sys::path::append(CacheDir, "clangd", "query-driver");
+      Opts.QueryDriverCacheDir = std::string(CacheDir);
+    } else {
+      elog("Couldn't determine the user cache directory, --query-driver-cache "
+           "is ignored");
+    }
+  }
   Opts.TweakFilter = [&](const Tweak &T) {
     if (T.hidden() && !HiddenFeatures)
       return false;
@@ -196,6 +196,20 @@ TEST_F(LSPTest, RecordsLatencies) {
   EXPECT_THAT(Tracer.takeMetric("lsp_latency", MethodName), testing::SizeIs(1));
 }
 
+TEST_F(LSPTest, RequestLatencyExtension) {
+  auto &Client = start();
+  llvm::consumeError(Client.call("textDocument/hover", {}).take().takeError());
+  auto Latency = Client.call("$/requestLatency", {}).takeValue();
+  const auto *Hover = Latency.getAsObject()->getObject("textDocument/hover");
+  ASSERT_TRUE(Hover);
+  EXPECT_EQ(Hover->getInteger("count"), 1);
+  EXPECT_TRUE(Hover->getNumber("p99"));
+  // Unknown methods are not tracked.
+  llvm::consumeError(Client.call("no/such/method", {}).take().takeError());
+  Latency = Client.call("$/requestLatency", {}).takeValue();
+  EXPECT_FALSE(Latency.getAsObject()->getObject("no/such/method"));
+}
+
 // clang-tidy's renames are converted to clangd's internal rename functionality,
 // see clangd#1589 and clangd#741
 TEST_F(LSPTest, ClangTidyRename) {
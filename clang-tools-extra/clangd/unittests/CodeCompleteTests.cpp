@@ -24,6 +24,7 @@
 #include "index/Index.h"
 #include "index/MemIndex.h"
 #include "index/SymbolOrigin.h"
+#include "support/Cancellation.h"
 #include "support/Threading.h"
 #include "clang/Sema/CodeCompleteConsumer.h"
 #include "clang/Tooling/CompilationDatabase.h"
@@ -239,6 +240,16 @@ TEST(DecisionForestRankingModel, DecisionForestScorerCallbackTest) {
   EXPECT_NE(Results.Completions[0].Score.ExcludingName, MagicNumber);
 }
 
+TEST(CompletionTest, Cancelled) {
+  auto Task = cancelableTask();
+  WithContext Cancelable(std::move(Task.first));
+  Task.second();
+  auto Results = completions("int abcdef; int x = abc^;", {var("abcxyz")});
+  EXPECT_THAT(Results.Completions, IsEmpty());
+  Results = completionsNoCompile("int abcdef; int x = abc^;", {var("abcxyz")});
+  EXPECT_THAT(Results.Completions, IsEmpty());
+}
+
 TEST(CompletionTest, Limit) {
   clangd::CodeCompleteOptions Opts;
   Opts.Limit = 2;
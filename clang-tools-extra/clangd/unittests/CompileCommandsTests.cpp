@@ -210,6 +210,27 @@ TEST(CommandMangler, ConfigEdits) {
               ElementsAre(_, "--driver-mode=g++", "--hello", "--", "FOO.CC"));
 }
 
+TEST(CommandMangler, ConfigEditsAppliedToRepeatedCommands) {
+  auto Mangler = CommandMangler::forTests();
+  auto MangleWithFlag = [&](std::string Flag) {
+    tooling::CompileCommand Cmd;
+    Cmd.CommandLine = {"clang++", "foo.cc"};
+    Config Cfg;
+    Cfg.CompileFlags.Edits.push_back([Flag](std::vector<std::string> &Argv) {
+      Argv = tooling::getInsertArgumentAdjuster(Flag.c_str())(Argv, "");
+    });
+    WithContextValue WithConfig(Config::Key, std::move(Cfg));
+    Mangler(Cmd, "foo.cc");
+    return Cmd.CommandLine;
+  };
+  // The second command is the same, but only the config-independent part of
+  // mangling may be reused.
+  EXPECT_THAT(MangleWithFlag("-DA"),
+              ElementsAre(_, "--driver-mode=g++", "-DA", "--", "foo.cc"));
+  EXPECT_THAT(MangleWithFlag("-DB"),
+              ElementsAre(_, "--driver-mode=g++", "-DB", "--", "foo.cc"));
+}
+
 static std::string strip(llvm::StringRef Arg, llvm::StringRef Argv) {
   llvm::SmallVector<llvm::StringRef> Parts;
   llvm::SplitString(Argv, Parts);
@@ -340,6 +340,12 @@ TEST_F(ConfigCompileTests, DiagnosticSuppression) {
   EXPECT_THAT(Conf.Diagnostics.Suppress, IsEmpty());
 }
 
+TEST_F(ConfigCompileTests, TidyCheckTimeBudget) {
+  Frag.Diagnostics.ClangTidy.CheckTimeBudget.emplace(250);
+  EXPECT_TRUE(compileAndApply());
+  EXPECT_EQ(Conf.Diagnostics.ClangTidy.CheckTimeBudget, 250U);
+}
+
 TEST_F(ConfigCompileTests, Tidy) {
   auto &Tidy = Frag.Diagnostics.ClangTidy;
   Tidy.Add.emplace_back("bugprone-use-after-move");
@@ -352,6 +358,7 @@ TEST_F(ConfigCompileTests, Tidy) {
       std::string("example-check.ExampleOption"), std::string("0")));
   EXPECT_TRUE(compileAndApply());
   EXPECT_EQ(Conf.Diagnostics.ClangTidy.CheckOptions.size(), 2U);
+  EXPECT_EQ(Conf.Diagnostics.ClangTidy.CheckTimeBudget, 0U);
   EXPECT_EQ(Conf.Diagnostics.ClangTidy.CheckOptions.lookup("StrictMode"),
             "true");
   EXPECT_EQ(Conf.Diagnostics.ClangTidy.CheckOptions.lookup(
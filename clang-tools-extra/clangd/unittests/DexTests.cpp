@@ -65,6 +65,34 @@ TEST(DexIterators, DocumentIterator) {
   EXPECT_TRUE(DocIterator->reachedEnd());
 }
 
+TEST(DexIterators, DocumentIteratorManyChunks) {
+  // Mix of single-byte and multi-byte deltas, spanning many chunks.
+  std::vector<DocID> Docs;
+  for (DocID I = 0; I < 5000; ++I)
+    Docs.push_back(I * (I % 3 == 0 ? 1000 : 3) + I);
+  llvm::sort(Docs);
+  Docs.erase(std::unique(Docs.begin(), Docs.end()), Docs.end());
+  const PostingList L(Docs);
+
+  auto It = L.iterator();
+  EXPECT_EQ(consumeIDs(*It), Docs);
+
+  // Advance by increasingly large strides to exercise chunk skipping.
+  It = L.iterator();
+  for (size_t I = 0, Stride = 1; I < Docs.size(); I += Stride, Stride *= 2) {
+    It->advanceTo(Docs[I]);
+    ASSERT_FALSE(It->reachedEnd());
+    EXPECT_EQ(It->peek(), Docs[I]);
+    // Advancing to a missing ID lands on the next present one.
+    if (I + 1 < Docs.size() && Docs[I] + 1 < Docs[I + 1]) {
+      It->advanceTo(Docs[I] + 1);
+      EXPECT_EQ(It->peek(), Docs[I + 1]);
+    }
+  }
+  It->advanceTo(Docs.back() + 1);
+  EXPECT_TRUE(It->reachedEnd());
+}
+
 TEST(DexIterators, AndTwoLists) {
   Corpus C{10000};
   const PostingList L0({0, 5, 7, 10, 42, 320, 9000});
@@ -8,7 +8,10 @@
 #include "Annotations.h"
 #include "FindSymbols.h"
 #include "TestFS.h"
+#include "TestIndex.h"
 #include "TestTU.h"
+#include "URI.h"
+#include "index/Index.h"
 #include "llvm/ADT/StringRef.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
@@ -301,6 +304,73 @@ TEST(WorkspaceSymbols, WithLimit) {
   EXPECT_THAT(getSymbols(TU, "foo", 1), ElementsAre(qName("foo")));
 }
 
+// Returns its symbols in order, ignoring the limit of the request.
+class OrderedIndex : public SymbolIndex {
+public:
+  std::vector<Symbol> Symbols;
+
+  bool
+  fuzzyFind(const FuzzyFindRequest &Req,
+            llvm::function_ref<void(const Symbol &)> Callback) const override {
+    for (const Symbol &Sym : Symbols)
+      Callback(Sym);
+    return false;
+  }
+
+  void
+  lookup(const LookupRequest &Req,
+         llvm::function_ref<void(const Symbol &)> Callback) const override {}
+
+  bool refs(const RefsRequest &Req,
+            llvm::function_ref<void(const Ref &)> Callback) const override {
+    return false;
+  }
+
+  bool containedRefs(const ContainedRefsRequest &Req,
+                     llvm::function_ref<void(const ContainedRefsResult &)>
+                         Callback) const override {
+    return false;
+  }
+
+  void relations(const RelationsRequest &Req,
+                 llvm::function_ref<void(const SymbolID &, const Symbol &)>
+                     Callback) const override {}
+
+  llvm::unique_function<IndexContents(llvm::StringRef) const>
+  indexedFiles() const override {
+    return [](llvm::StringRef) { return IndexContents::None; };
+  }
+
+  size_t estimateMemoryUsage() const override { return 0; }
+};
+
+TEST(WorkspaceSymbols, RankingWithLimit) {
+  std::string FileURI = URI::create(testPath("foo.h")).toString();
+  auto Var = [&](llvm::StringRef Name, unsigned References) {
+    Symbol Sym = var(Name);
+    Sym.References = References;
+    Sym.CanonicalDeclaration.FileURI = FileURI.c_str();
+    return Sym;
+  };
+  // The names match equally well, so more popular symbols rank higher.
+  OrderedIndex Index;
+  Index.Symbols = {Var("fooB", 100), Var("fooD", 1), Var("fooA", 1000),
+                   Var("fooC", 10)};
+  auto Search = [&](int Limit) {
+    auto Symbols =
+        getWorkspaceSymbols("foo", Limit, &Index, testPath("main.cpp"));
+    EXPECT_TRUE(bool(Symbols)) << "workspaceSymbols returned an error";
+    return *Symbols;
+  };
+
+  EXPECT_THAT(Search(0), ElementsAre(qName("fooA"), qName("fooB"),
+                                     qName("fooC"), qName("fooD")));
+  // Candidates that can't beat the worst kept result are dropped, while a
+  // better candidate seen after the limit is reached still replaces it.
+  EXPECT_THAT(Search(2), ElementsAre(qName("fooA"), qName("fooB")));
+  EXPECT_THAT(Search(1), ElementsAre(qName("fooA")));
+}
+
 TEST(WorkspaceSymbols, TempSpecs) {
   TestTU TU;
   TU.ExtraArgs = {"-xc++"};
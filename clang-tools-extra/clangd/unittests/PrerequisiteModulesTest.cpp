@@ -590,6 +590,73 @@ export constexpr int M = 43;
   EXPECT_NE(NewHSOptsA.PrebuiltModuleFiles, HSOptsA.PrebuiltModuleFiles);
 }
 
+TEST_F(PrerequisiteModulesTests, PersistentModuleFilesTest) {
+  MockDirectoryCompilationDatabase CDB(TestDir, FS);
+
+  CDB.addFile("M.cppm", R"cpp(
+export module M;
+export constexpr int M = 43;
+  )cpp");
+
+  CDB.addFile("A.cpp", R"cpp(
+import M;
+int A = M;
+  )cpp");
+
+  SmallString<256> ModuleFilesDir(TestDir);
+  llvm::sys::path::append(ModuleFilesDir, "module_files");
+
+  // Each call uses a new ModulesBuilder, like a new clangd session would.
+  // Returns the module file used for M.
+  auto Build = [&] {
+    ModulesBuilder Builder(CDB, ModuleFilesDir);
+    auto AInfo = Builder.buildPrerequisiteModulesFor(getFullPath("A.cpp"), FS);
+    EXPECT_TRUE(AInfo);
+    ParseInputs AInput = getInputs("A.cpp", CDB);
+    std::unique_ptr<CompilerInvocation> Invocation =
+        buildCompilerInvocation(AInput, DiagConsumer);
+    EXPECT_TRUE(AInfo->canReuse(*Invocation, FS.view(TestDir)));
+    HeaderSearchOptions HSOpts(TestDir);
+    AInfo->adjustHeaderSearchOptions(HSOpts);
+    return HSOpts.PrebuiltModuleFiles["M"];
+  };
+  auto GetUniqueID = [](llvm::StringRef Path) {
+    llvm::sys::fs::UniqueID ID;
+    EXPECT_FALSE(llvm::sys::fs::getUniqueID(Path, ID));
+    return ID;
+  };
+
+  std::string MPath = Build();
+  EXPECT_TRUE(StringRef(MPath).starts_with(ModuleFilesDir));
+  // The module file outlives the ModulesBuilder that built it.
+  ASSERT_TRUE(llvm::sys::fs::exists(MPath));
+  llvm::sys::fs::UniqueID MID = GetUniqueID(MPath);
+
+  // A later session reuses the module file instead of rebuilding it.
+  EXPECT_EQ(Build(), MPath);
+  EXPECT_EQ(GetUniqueID(MPath), MID);
+
+  // After M.cppm changes, the module file is rebuilt at the same path. It is
+  // replaced by a new file rather than rewritten in place, so that other
+  // clangd instances using the old one are unaffected.
+  CDB.addFile("M.cppm", R"cpp(
+export module M;
+export constexpr int M = 44 + 1;
+  )cpp");
+  EXPECT_EQ(Build(), MPath);
+  EXPECT_NE(GetUniqueID(MPath), MID);
+
+  // No temporary or lock files are left behind.
+  std::vector<std::string> Files;
+  std::error_code EC;
+  for (llvm::sys::fs::directory_iterator
+           It(llvm::sys::path::parent_path(MPath), EC),
+       End;
+       !EC && It != End; It.increment(EC))
+    Files.push_back(It->path());
+  EXPECT_THAT(Files, ::testing::ElementsAre(MPath));
+}
+
 } // namespace
 } // namespace clang::clangd
 
@@ -25,6 +25,7 @@ namespace clang {
 namespace clangd {
 namespace {
 
+using testing::Contains;
 using testing::ElementsAre;
 using testing::Eq;
 using testing::IsEmpty;
@@ -1634,6 +1635,43 @@ TEST(CrossFileRenameTests, DirtyBuffer) {
               testing::HasSubstr("too many occurrences"));
 }
 
+TEST(CrossFileRenameTests, ManyFiles) {
+  // Enough files to split the work across several threads.
+  constexpr unsigned NumFiles = 200;
+  FileSymbols FSymbols(IndexContents::All, true);
+  llvm::IntrusiveRefCntPtr<llvm::vfs::InMemoryFileSystem> InMemFS =
+      new llvm::vfs::InMemoryFileSystem;
+  std::vector<std::pair<std::string, Annotations>> Files;
+  for (unsigned I = 0; I < NumFiles; ++I) {
+    std::string Path = testPath("file" + std::to_string(I) + ".cc");
+    Annotations Code(std::string(I, '\n') + "class [[Foo]] {};");
+    FSymbols.update(Path, nullptr, buildRefSlab(Code, "Foo", Path), nullptr,
+                    false);
+    InMemFS->addFile(Path, 0,
+                     llvm::MemoryBuffer::getMemBufferCopy(Code.code()));
+    Files.emplace_back(std::move(Path), std::move(Code));
+  }
+  auto Index = FSymbols.buildIndex(IndexType::Light);
+
+  Annotations MainCode("class  [[Fo^o]] {};");
+  auto MainFilePath = testPath("main.cc");
+  TestTU TU = TestTU::withCode(MainCode.code());
+  auto AST = TU.build();
+  llvm::StringRef NewName = "newName";
+  RenameOptions Opts;
+  Opts.LimitFiles = 0;
+  auto Results =
+      rename({MainCode.point(), NewName, AST, MainFilePath,
+              createOverlay(getVFSFromAST(AST), InMemFS), Index.get(), Opts});
+  ASSERT_TRUE(bool(Results)) << Results.takeError();
+  auto Edits = applyEdits(std::move(Results->GlobalChanges));
+  EXPECT_EQ(Edits.size(), NumFiles + 1);
+  for (const auto &[Path, Code] : Files) {
+    std::string Expected = expectedResult(Code, NewName);
+    EXPECT_THAT(Edits, Contains(Pair(Eq(Path), Eq(Expected))));
+  }
+}
+
 TEST(CrossFileRenameTests, DeduplicateRefsFromIndex) {
   auto MainCode = Annotations("int [[^x]] = 2;");
   auto MainFilePath = testPath("main.cc");
@@ -26,6 +26,7 @@ namespace clangd {
 namespace {
 
 using testing::IsEmpty;
+using testing::Not;
 using testing::SizeIs;
 
 /// Annotates the input code with provided semantic highlightings. Results look
@@ -1316,6 +1317,30 @@ int *$Variable[[x]] = new int;
   WithContextValue WithCfg(Config::Key, std::move(Cfg));
   checkHighlightings(AnnotatedCode, {}, ~ScopeModifierMask);
 }
+
+TEST(SemanticHighlighting, RestrictToRange) {
+  Annotations Test(R"cpp(
+    int before;
+    $range[[void foo(int Param) {
+      int Local = Param;
+    }]]
+    int after;
+  )cpp");
+  TestTU TU = TestTU::withCode(Test.code());
+  auto AST = TU.build();
+  auto All = getSemanticHighlightings(AST, /*IncludeInactiveRegionTokens=*/true);
+  auto InRange = getSemanticHighlightings(
+      AST, /*IncludeInactiveRegionTokens=*/true, Test.range("range"));
+
+  std::vector<HighlightingToken> Expected;
+  for (const auto &T : All)
+    if (Test.range("range").start <= T.R.start &&
+        T.R.end <= Test.range("range").end)
+      Expected.push_back(T);
+  EXPECT_THAT(Expected, Not(IsEmpty()));
+  EXPECT_LT(Expected.size(), All.size());
+  EXPECT_EQ(InRange, Expected);
+}
 } // namespace
 } // namespace clangd
 } // namespace clang
@@ -0,0 +1,98 @@
+//===-- SystemIncludeExtractorTests.cpp -------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "GlobalCompilationDatabase.h"
+#include "clang/Tooling/CompilationDatabase.h"
+#include "llvm/ADT/ScopeExit.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/raw_ostream.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include <string>
+#include <vector>
+
+namespace clang {
+namespace clangd {
+namespace {
+
+using ::testing::AllOf;
+using ::testing::Contains;
+using ::testing::Not;
+
+// The fake driver is a shell script.
+#ifndef _WIN32
+TEST(SystemIncludeExtractorTest, DiskCache) {
+  llvm::SmallString<128> Root;
+  ASSERT_FALSE(
+      llvm::sys::fs::createUniqueDirectory("clangd-query-driver", Root));
+  auto Cleanup =
+      llvm::make_scope_exit([&] { llvm::sys::fs::remove_directories(Root); });
+  std::string Driver = (Root + "/fake-gcc").str();
+  std::string Log = (Root + "/queries.log").str();
+  std::string CacheDir = (Root + "/cache").str();
+
+  // The driver logs its arguments, so that we can tell when it is run.
+  auto WriteDriver = [&](llvm::StringRef Include) {
+    std::error_code EC;
+    llvm::raw_fd_ostream OS(Driver, EC);
+    ASSERT_FALSE(EC) << EC.message();
+    OS << "#!/bin/sh\n"
+       << "echo \"$@\" >> '" << Log << "'\n"
+       << "echo '#include <...> search starts here:' >&2\n"
+       << "echo ' " << Include << "' >&2\n"
+       << "echo 'End of search list.' >&2\n";
+    OS.close();
+    ASSERT_FALSE(llvm::sys::fs::setPermissions(
+        Driver, llvm::sys::fs::all_read | llvm::sys::fs::all_exe |
+                    llvm::sys::fs::owner_write));
+  };
+  auto NumQueries = [&] {
+    auto Buf = llvm::MemoryBuffer::getFile(Log);
+    return Buf ? (*Buf)->getBuffer().count("-E") : size_t(0);
+  };
+  // Each extractor has its own in-memory cache, so a fresh one only avoids
+  // running the driver if the results are found on disk.
+  auto Extract = [&](llvm::StringRef Dir) {
+    std::vector<std::string> Globs = {Driver};
+    auto Extractor = getSystemIncludeExtractor(Globs, Dir);
+    tooling::CompileCommand Cmd(Root, "foo.cc", {Driver, "foo.cc"}, "");
+    Extractor(Cmd, "foo.cc");
+    return Cmd.CommandLine;
+  };
+
+  WriteDriver("/first/include");
+  EXPECT_THAT(Extract(CacheDir), Contains("/first/include"));
+  EXPECT_EQ(NumQueries(), 1u);
+  std::error_code EC;
+  llvm::sys::fs::directory_iterator It(CacheDir, EC);
+  EXPECT_FALSE(EC) << EC.message();
+  EXPECT_NE(It, llvm::sys::fs::directory_iterator()) << "cache not written";
+
+  // The cached results are reloaded without running the driver.
+  EXPECT_THAT(Extract(CacheDir), Contains("/first/include"));
+  EXPECT_EQ(NumQueries(), 1u);
+
+  // Without a cache directory, the disk cache is not used.
+  EXPECT_THAT(Extract(""), Contains("/first/include"));
+  EXPECT_EQ(NumQueries(), 2u);
+
+  // Replacing the driver invalidates the cached results.
+  WriteDriver("/second/include/dir");
+  EXPECT_THAT(Extract(CacheDir), AllOf(Contains("/second/include/dir"),
+                                       Not(Contains("/first/include"))));
+  EXPECT_EQ(NumQueries(), 3u);
+  EXPECT_THAT(Extract(CacheDir), Contains("/second/include/dir"));
+  EXPECT_EQ(NumQueries(), 3u);
+}
+#endif
+
+} // namespace
+} // namespace clangd
+} // namespace clang
@@ -38,6 +38,7 @@
 #include <condition_variable>
 #include <cstdint>
 #include <functional>
+#include <limits>
 #include <memory>
 #include <mutex>
 #include <optional>
@@ -643,6 +644,113 @@ TEST_F(TUSchedulerTests, EvictedAST) {
               UnorderedElementsAre(Foo, AnyOf(Bar, Baz)));
 }
 
+TEST_F(TUSchedulerTests, EvictedASTByBytes) {
+  auto Opts = optsForTest();
+  Opts.AsyncThreadsCount = 1;
+  Opts.RetentionPolicy.MaxRetainedASTs = 3;
+  // Any AST is bigger than this, so only the most recent one is retained.
+  Opts.RetentionPolicy.MaxRetainedBytes = 1;
+  trace::TestTracer Tracer;
+  TUScheduler S(CDB, Opts);
+
+  auto Foo = testPath("foo.cpp");
+  auto Bar = testPath("bar.cpp");
+
+  S.update(Foo, getInputs(Foo, "int x=1;"), WantDiagnostics::Yes);
+  ASSERT_TRUE(S.blockUntilIdle(timeoutSeconds(60)));
+  ASSERT_THAT(S.getFilesWithCachedAST(), ElementsAre(Foo));
+  EXPECT_THAT(Tracer.takeMetric("ast_cache_evictions", "bytes"), SizeIs(0));
+
+  S.update(Bar, getInputs(Bar, "int x=2;"), WantDiagnostics::Yes);
+  ASSERT_TRUE(S.blockUntilIdle(timeoutSeconds(60)));
+  EXPECT_THAT(S.getFilesWithCachedAST(), ElementsAre(Bar));
+  EXPECT_THAT(Tracer.takeMetric("ast_cache_evictions", "bytes"), SizeIs(1));
+  EXPECT_THAT(Tracer.takeMetric("ast_cache_evictions", "count"), SizeIs(0));
+}
+
+TEST_F(TUSchedulerTests, EvictIdleASTs) {
+  auto Opts = optsForTest();
+  Opts.AsyncThreadsCount = 1;
+  Opts.RetentionPolicy.MaxRetainedASTs = 3;
+  trace::TestTracer Tracer;
+  TUScheduler S(CDB, Opts);
+
+  auto Foo = testPath("foo.cpp");
+  auto Bar = testPath("bar.cpp");
+
+  // Wait in between so that Foo is known to be the least recently used AST.
+  S.update(Foo, getInputs(Foo, "int x=1;"), WantDiagnostics::Yes);
+  ASSERT_TRUE(S.blockUntilIdle(timeoutSeconds(60)));
+  S.update(Bar, getInputs(Bar, "int x=2;"), WantDiagnostics::Yes);
+  ASSERT_TRUE(S.blockUntilIdle(timeoutSeconds(60)));
+  ASSERT_THAT(S.getFilesWithCachedAST(), UnorderedElementsAre(Foo, Bar));
+
+  // Releasing a single byte drops only the least recently used AST.
+  EXPECT_GT(S.evictIdleASTs(1), 0u);
+  EXPECT_THAT(S.getFilesWithCachedAST(), ElementsAre(Bar));
+  EXPECT_THAT(Tracer.takeMetric("ast_cache_evictions", "memory_budget"),
+              SizeIs(1));
+
+  EXPECT_GT(S.evictIdleASTs(std::numeric_limits<size_t>::max()), 0u);
+  EXPECT_THAT(S.getFilesWithCachedAST(), IsEmpty());
+  EXPECT_EQ(S.evictIdleASTs(1), 0u);
+}
+
+TEST_F(TUSchedulerTests, PreambleSharingMetric) {
+  trace::TestTracer Tracer;
+  auto Foo = testPath("foo.cpp");
+  auto Bar = testPath("bar.cpp");
+  auto Baz = testPath("baz.cpp");
+  auto Build = [&](TUScheduler &S, PathRef File, llvm::StringRef Contents) {
+    S.update(File, getInputs(File, Contents), WantDiagnostics::No);
+    return S.blockUntilIdle(timeoutSeconds(60));
+  };
+  {
+    TUScheduler S(CDB, optsForTest());
+    ASSERT_TRUE(Build(S, Foo, "#define A\nint x;"));
+    EXPECT_THAT(Tracer.takeMetric("preamble_build_sharing", "unique"),
+                ElementsAre(1));
+
+    // Same preamble and flags as Foo.
+    ASSERT_TRUE(Build(S, Bar, "#define A\nint y;"));
+    EXPECT_THAT(Tracer.takeMetric("preamble_build_sharing", "shareable"),
+                ElementsAre(1));
+
+    // A rebuild replaces the file's previous preamble.
+    ASSERT_TRUE(Build(S, Bar, "#define B\nint y;"));
+    EXPECT_THAT(Tracer.takeMetric("preamble_build_sharing", "unique"),
+                ElementsAre(1));
+    ASSERT_TRUE(Build(S, Baz, "#define B\nint z;"));
+    EXPECT_THAT(Tracer.takeMetric("preamble_build_sharing", "shareable"),
+                ElementsAre(1));
+  }
+  // Each scheduler only compares preambles of its own files.
+  TUScheduler S(CDB, optsForTest());
+  ASSERT_TRUE(Build(S, Foo, "#define A\nint x;"));
+  EXPECT_THAT(Tracer.takeMetric("preamble_build_sharing", "unique"),
+              ElementsAre(1));
+  EXPECT_THAT(Tracer.takeMetric("preamble_build_sharing", "shareable"),
+              IsEmpty());
+}
+
+TEST_F(TUSchedulerTests, EditSizeMetric) {
+  trace::TestTracer Tracer;
+  TUScheduler S(CDB, optsForTest());
+  auto Foo = testPath("foo.cpp");
+
+  S.update(Foo, getInputs(Foo, "int x = 1; int y = 2;"), WantDiagnostics::No);
+  ASSERT_TRUE(S.blockUntilIdle(timeoutSeconds(60)));
+  EXPECT_THAT(Tracer.takeMetric("ast_edit_bytes"), SizeIs(0));
+
+  S.update(Foo, getInputs(Foo, "int x = 10; int y = 2;"), WantDiagnostics::No);
+  ASSERT_TRUE(S.blockUntilIdle(timeoutSeconds(60)));
+  EXPECT_THAT(Tracer.takeMetric("ast_edit_bytes"), ElementsAre(1));
+
+  S.update(Foo, getInputs(Foo, "int x = 10;"), WantDiagnostics::No);
+  ASSERT_TRUE(S.blockUntilIdle(timeoutSeconds(60)));
+  EXPECT_THAT(Tracer.takeMetric("ast_edit_bytes"), ElementsAre(0));
+}
+
 // We send "empty" changes to TUScheduler when we think some external event
 // *might* have invalidated current state (e.g. a header was edited).
 // Verify that this doesn't evict our cache entries.
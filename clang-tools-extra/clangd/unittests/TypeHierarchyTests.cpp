@@ -768,6 +768,85 @@ struct Child2b : Child1 {};
                            parentsNotResolved(), childrenNotResolved()))));
 }
 
+// Counts the relations requests sent to the wrapped index.
+class RelationsCountingIndex : public SymbolIndex {
+public:
+  RelationsCountingIndex(const SymbolIndex &Base) : Base(Base) {}
+
+  mutable unsigned NumRelationsRequests = 0;
+
+  bool
+  fuzzyFind(const FuzzyFindRequest &Req,
+            llvm::function_ref<void(const Symbol &)> Callback) const override {
+    return Base.fuzzyFind(Req, Callback);
+  }
+
+  void
+  lookup(const LookupRequest &Req,
+         llvm::function_ref<void(const Symbol &)> Callback) const override {
+    Base.lookup(Req, Callback);
+  }
+
+  bool refs(const RefsRequest &Req,
+            llvm::function_ref<void(const Ref &)> Callback) const override {
+    return Base.refs(Req, Callback);
+  }
+
+  bool containedRefs(const ContainedRefsRequest &Req,
+                     llvm::function_ref<void(const ContainedRefsResult &)>
+                         Callback) const override {
+    return Base.containedRefs(Req, Callback);
+  }
+
+  void relations(const RelationsRequest &Req,
+                 llvm::function_ref<void(const SymbolID &, const Symbol &)>
+                     Callback) const override {
+    ++NumRelationsRequests;
+    Base.relations(Req, Callback);
+  }
+
+  llvm::unique_function<IndexContents(llvm::StringRef) const>
+  indexedFiles() const override {
+    return Base.indexedFiles();
+  }
+
+  size_t estimateMemoryUsage() const override { return 0; }
+
+private:
+  const SymbolIndex &Base;
+};
+
+TEST(Subtypes, MultiLevel) {
+  Annotations Source(R"cpp(
+struct P^arent {};
+struct Child1a : Parent {};
+struct Child1b : Parent {};
+struct Child2 : Child1a, Child1b {};
+struct Child3 : Child2 {};
+)cpp");
+
+  TestTU TU = TestTU::withCode(Source.code());
+  auto AST = TU.build();
+  auto Index = TU.index();
+  RelationsCountingIndex CountingIndex(*Index);
+
+  auto Result = getTypeHierarchy(AST, Source.point(), /*ResolveLevels=*/3,
+                                 TypeHierarchyDirection::Children,
+                                 &CountingIndex, testPath(TU.Filename));
+  ASSERT_THAT(Result, SizeIs(1));
+  // Child2 is reachable through both of its bases, and is filled in under
+  // each of them. Child3 is on the last resolved level.
+  auto Child2 = AllOf(
+      withName("Child2"),
+      children(AllOf(withName("Child3"), childrenNotResolved())));
+  EXPECT_THAT(Result.front(),
+              AllOf(withName("Parent"),
+                    children(AllOf(withName("Child1a"), children(Child2)),
+                             AllOf(withName("Child1b"), children(Child2)))));
+  // Each level is resolved with a single request.
+  EXPECT_EQ(CountingIndex.NumRelationsRequests, 3u);
+}
+
 TEST(Standard, SubTypes) {
   Annotations Source(R"cpp(
 struct Pare^nt1 {};
@@ -0,0 +1,160 @@
+//===--- ClientTests.cpp -----------------------------------------*- C++-*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include <grpc++/grpc++.h>
+
+#include "Index.pb.h"
+#include "Service.grpc.pb.h"
+#include "TestFS.h"
+#include "index/Index.h"
+#include "index/remote/Client.h"
+#include "support/Logger.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/Error.h"
+#include "llvm/Support/FormatVariadic.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace clang {
+namespace clangd {
+namespace remote {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::HasSubstr;
+using ::testing::IsEmpty;
+
+constexpr llvm::StringLiteral FooID = "057557CEBF6E6B2D";
+constexpr llvm::StringLiteral OtherID = "1111111111111111";
+
+// Answers every lookup with the same symbols, and counts the lookups.
+class FakeIndexService final : public v1::SymbolIndex::Service {
+public:
+  std::vector<Symbol> Symbols;
+  std::atomic<unsigned> NumLookups = 0;
+
+private:
+  grpc::Status Lookup(grpc::ServerContext *Context,
+                      const LookupRequest *Request,
+                      grpc::ServerWriter<LookupReply> *Reply) override {
+    ++NumLookups;
+    for (const Symbol &Sym : Symbols) {
+      LookupReply NextMessage;
+      *NextMessage.mutable_stream_result() = Sym;
+      Reply->Write(NextMessage);
+    }
+    LookupReply LastMessage;
+    LastMessage.mutable_final_result()->set_has_more(false);
+    Reply->Write(LastMessage);
+    return grpc::Status::OK;
+  }
+};
+
+Symbol makeSymbol(llvm::StringRef ID, llvm::StringRef Name) {
+  Symbol Sym;
+  Sym.set_id(ID.str());
+  Sym.set_name(Name.str());
+  Sym.mutable_info();
+  Sym.mutable_canonical_declaration()->set_file_path("foo.h");
+  return Sym;
+}
+
+class RecordingLogger : public Logger {
+public:
+  std::vector<std::string> Errors;
+
+private:
+  void log(Level L, const char *Fmt,
+           const llvm::formatv_object_base &Message) override {
+    if (L == Level::Error)
+      Errors.push_back(Message.str());
+  }
+};
+
+// The parameter is whether the server compresses its responses.
+class RemoteIndexClientTest : public ::testing::TestWithParam<bool> {
+protected:
+  void SetUp() override {
+    grpc::ServerBuilder Builder;
+    int Port = 0;
+    Builder.AddListeningPort("127.0.0.1:0", grpc::InsecureServerCredentials(),
+                             &Port);
+    if (GetParam())
+      Builder.SetDefaultCompressionAlgorithm(GRPC_COMPRESS_GZIP);
+    Builder.RegisterService(&Service);
+    Server = Builder.BuildAndStart();
+    ASSERT_TRUE(Server);
+    ASSERT_NE(Port, 0);
+    Client = getClient(llvm::formatv("127.0.0.1:{0}", Port).str(), testRoot());
+    ASSERT_TRUE(Client);
+  }
+
+  void TearDown() override {
+    if (Server)
+      Server->Shutdown();
+  }
+
+  std::vector<std::string> lookup(llvm::StringRef ID) {
+    clangd::LookupRequest Request;
+    Request.IDs.insert(llvm::cantFail(SymbolID::fromStr(ID)));
+    std::vector<std::string> Names;
+    Client->lookup(Request, [&](const clangd::Symbol &Sym) {
+      Names.push_back(Sym.Name.str());
+    });
+    return Names;
+  }
+
+  RecordingLogger Log;
+  LoggingSession Session{Log};
+  FakeIndexService Service;
+  std::unique_ptr<grpc::Server> Server;
+  std::unique_ptr<clangd::SymbolIndex> Client;
+};
+
+TEST_P(RemoteIndexClientTest, CachedReplyIsReplayed) {
+  Service.Symbols = {makeSymbol(FooID, "Foo")};
+
+  EXPECT_THAT(lookup(FooID), ElementsAre("Foo"));
+  EXPECT_EQ(Service.NumLookups.load(), 1u);
+
+  // The same request is answered from the cache.
+  EXPECT_THAT(lookup(FooID), ElementsAre("Foo"));
+  EXPECT_EQ(Service.NumLookups.load(), 1u);
+
+  // A different request still goes to the server.
+  EXPECT_THAT(lookup(OtherID), ElementsAre("Foo"));
+  EXPECT_EQ(Service.NumLookups.load(), 2u);
+  EXPECT_THAT(Log.Errors, IsEmpty());
+}
+
+TEST_P(RemoteIndexClientTest, InvalidCachedReplyIsLogged) {
+  Service.Symbols = {makeSymbol("not a symbol id", "Bad"),
+                     makeSymbol(FooID, "Foo")};
+
+  EXPECT_THAT(lookup(FooID), ElementsAre("Foo"));
+  EXPECT_EQ(Service.NumLookups.load(), 1u);
+  EXPECT_THAT(Log.Errors, ElementsAre(HasSubstr("Received invalid")));
+  Log.Errors.clear();
+
+  // Replaying the cached reply skips the invalid symbol again, and says so.
+  EXPECT_THAT(lookup(FooID), ElementsAre("Foo"));
+  EXPECT_EQ(Service.NumLookups.load(), 1u);
+  EXPECT_THAT(Log.Errors, ElementsAre(HasSubstr("Cached invalid")));
+}
+
+INSTANTIATE_TEST_SUITE_P(Compression, RemoteIndexClientTest, ::testing::Bool());
+
+} // namespace
+} // namespace remote
+} // namespace clangd
+} // namespace clang
@@ -0,0 +1,49 @@
+//===-- HistogramTests.cpp --------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "support/Histogram.h"
+#include "gtest/gtest.h"
+
+namespace clang {
+namespace clangd {
+namespace {
+using std::chrono::microseconds;
+
+TEST(LatencyHistogram, Empty) {
+  LatencyHistogram H;
+  EXPECT_EQ(H.count(), 0u);
+  EXPECT_EQ(H.quantile(0.5), microseconds(0));
+  EXPECT_EQ(H.max(), microseconds(0));
+}
+
+TEST(LatencyHistogram, Quantiles) {
+  LatencyHistogram H;
+  for (int I = 0; I < 90; ++I)
+    H.record(microseconds(100));
+  for (int I = 0; I < 10; ++I)
+    H.record(microseconds(5000));
+  EXPECT_EQ(H.count(), 100u);
+  EXPECT_EQ(H.max(), microseconds(5000));
+  // 100us falls in [64, 128), 5000us in [4096, 8192).
+  EXPECT_EQ(H.quantile(0.5), microseconds(128));
+  EXPECT_EQ(H.quantile(0.9), microseconds(128));
+  // Estimates never exceed the largest recorded value.
+  EXPECT_EQ(H.quantile(0.99), microseconds(5000));
+  EXPECT_EQ(H.quantile(1), microseconds(5000));
+}
+
+TEST(LatencyHistogram, Overflow) {
+  LatencyHistogram H;
+  H.record(std::chrono::hours(1));
+  EXPECT_EQ(H.count(), 1u);
+  EXPECT_EQ(H.quantile(0.5), std::chrono::hours(1));
+}
+
+} // namespace
+} // namespace clangd
+} // namespace clang
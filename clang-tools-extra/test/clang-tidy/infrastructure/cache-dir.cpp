@@ -0,0 +1,35 @@
+// RUN: rm -rf %t
+// RUN: mkdir -p %t/first %t/include
+// RUN: echo '#define EXPLICIT' > %t/include/cache-dir.h
+// RUN: clang-tidy -checks='-*,google-explicit-constructor' -cache-dir=%t/cache %s -- -I %t/first -I %t/include 2>&1 | FileCheck -check-prefix=CHECK-WARN %s
+// RUN: ls %t/cache | count 1
+
+// Change the stored message, so that replayed diagnostics can be told apart
+// from the ones of a new run.
+// RUN: sed -e 's/single-argument constructors must be marked explicit/replayed from the cache/' %t/cache/*.yaml > %t/entry
+// RUN: cp %t/entry %t/cache/*.yaml
+// RUN: clang-tidy -checks='-*,google-explicit-constructor' -cache-dir=%t/cache %s -- -I %t/first -I %t/include 2>&1 | FileCheck -check-prefix=CHECK-REPLAY %s
+// RUN: ls %t/cache | count 1
+
+// A different configuration gets its own entry.
+// RUN: clang-tidy -checks='-*,google-explicit-constructor,misc-unused-using-decls' -cache-dir=%t/cache %s -- -I %t/first -I %t/include 2>&1 | FileCheck -check-prefix=CHECK-WARN %s
+// RUN: ls %t/cache | count 2
+
+// A header shadowing the one that was included invalidates the entry.
+// RUN: echo '#define EXPLICIT explicit' > %t/first/cache-dir.h
+// RUN: clang-tidy -checks='-*,google-explicit-constructor' -cache-dir=%t/cache %s -- -I %t/first -I %t/include 2>&1 | FileCheck -check-prefix=CHECK-CLEAN -implicit-check-not='{{warning:|error:}}' %s
+// RUN: rm %t/first/cache-dir.h
+
+// So does a change to a header that was read.
+// RUN: echo '#define EXPLICIT explicit' > %t/include/cache-dir.h
+// RUN: clang-tidy -checks='-*,google-explicit-constructor' -cache-dir=%t/cache %s -- -I %t/first -I %t/include 2>&1 | FileCheck -check-prefix=CHECK-CLEAN -implicit-check-not='{{warning:|error:}}' %s
+
+#include "cache-dir.h"
+
+class A {
+  EXPLICIT A(int);
+};
+
+// CHECK-WARN: cache-dir.cpp:[[@LINE-3]]:12: warning: single-argument constructors must be marked explicit
+// CHECK-REPLAY: cache-dir.cpp:[[@LINE-4]]:12: warning: replayed from the cache
+// CHECK-CLEAN-NOT: warning:
@@ -57,10 +57,18 @@ public:
   /// invalid expression.
   llvm::SmallVector<Detail, 4> Details;
 
+  const NamedDecl *getConstraintOwner() const { return ConstraintOwner; }
+
+  /// The template arguments the constraints were checked with, as written.
+  ArrayRef<TemplateArgument> getTemplateArgs() const { return TemplateArgs; }
+
   void Profile(llvm::FoldingSetNodeID &ID, const ASTContext &C) {
     Profile(ID, C, ConstraintOwner, TemplateArgs);
   }
 
+  /// Profile the canonical owner and canonical template arguments, so that
+  /// checks of the same constraints spelled through different redeclarations
+  /// or type sugar share a node.
   static void Profile(llvm::FoldingSetNodeID &ID, const ASTContext &C,
                       const NamedDecl *ConstraintOwner,
                       ArrayRef<TemplateArgument> TemplateArgs);
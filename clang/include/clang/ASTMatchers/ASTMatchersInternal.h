@@ -352,6 +352,15 @@ public:
   virtual std::optional<clang::TraversalKind> TraversalKind() const {
     return std::nullopt;
   }
+
+  /// Appends to \p Names the unqualified names a \c NamedDecl must have to
+  /// be matched.
+  ///
+  /// Returns false if the matcher does not constrain the name of the node, in
+  /// which case \p Names is left unspecified.
+  virtual bool getRequiredNames(SmallVectorImpl<StringRef> &Names) const {
+    return false;
+  }
 };
 
 /// Generic interface for matchers on an AST node of type T.
@@ -539,6 +548,14 @@ public:
     return Implementation->TraversalKind();
   }
 
+  /// Appends to \p Names the unqualified names a node must have for this
+  /// matcher to match it, if any.
+  ///
+  /// \returns \c false if the matcher may match nodes of any name.
+  bool getRequiredNames(SmallVectorImpl<StringRef> &Names) const {
+    return Implementation->getRequiredNames(Names);
+  }
+
 private:
   DynTypedMatcher(ASTNodeKind SupportedKind, ASTNodeKind RestrictKind,
                   IntrusiveRefCntPtr<DynMatcherInterface> Implementation)
@@ -945,6 +962,8 @@ class HasNameMatcher : public SingleNodeMatcherInterface<NamedDecl> {
 
   bool matchesNode(const NamedDecl &Node) const override;
 
+  bool getRequiredNames(SmallVectorImpl<StringRef> &Names) const override;
+
 private:
   /// Unqualified match routine.
   ///
@@ -1524,6 +1543,10 @@ public:
       return NestedKind;
     return Traversal;
   }
+
+  bool getRequiredNames(SmallVectorImpl<StringRef> &Names) const override {
+    return this->InnerMatcher.getRequiredNames(Names);
+  }
 };
 
 template <typename MatcherType> class TraversalWrapper {
@@ -24,6 +24,10 @@ public:
   /// If set, paths are resolved as if the working directory was
   /// set to the value of WorkingDir.
   std::string WorkingDir;
+
+  /// If set, the file used to remember failed lookups of absolute paths
+  /// across compiler invocations. See PersistentNegativeStatCache.
+  std::string HeaderLookupCachePath;
 };
 
 } // end namespace clang
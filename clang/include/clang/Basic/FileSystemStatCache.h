@@ -17,6 +17,7 @@
 #include "clang/Basic/LLVM.h"
 #include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringRef.h"
+#include "llvm/ADT/StringSet.h"
 #include "llvm/Support/Allocator.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/VirtualFileSystem.h"
@@ -84,6 +85,56 @@ public:
                           llvm::vfs::FileSystem &FS) override;
 };
 
+/// A stat cache that remembers, across compiler invocations, which absolute
+/// paths were found not to exist.
+///
+/// Each negative result is stored with the modification time of the
+/// directory that would contain the path, and is only trusted while that
+/// directory's modification time is unchanged. This saves the repeated
+/// failing lookups of header search on slow file systems at the cost of one
+/// stat per directory.
+class PersistentNegativeStatCache : public FileSystemStatCache {
+public:
+  /// Load the cache stored at \p CachePath. A missing, unreadable or
+  /// malformed cache file is treated as empty.
+  explicit PersistentNegativeStatCache(StringRef CachePath);
+
+  /// Calls save().
+  ~PersistentNegativeStatCache() override;
+
+  /// Write the negative results back to the cache file if any changed. The
+  /// file is replaced atomically, so compilations sharing a cache file can at
+  /// worst lose each other's additions. Failures to write are ignored.
+  void save();
+
+  std::error_code getStat(StringRef Path, llvm::vfs::Status &Status,
+                          bool isFile,
+                          std::unique_ptr<llvm::vfs::File> *F,
+                          llvm::vfs::FileSystem &FS) override;
+
+private:
+  struct DirectoryInfo {
+    /// The modification time of the directory, in nanoseconds since the
+    /// epoch, when MissingNames was recorded.
+    int64_t ModTime = 0;
+    /// Whether ModTime was compared against the file system yet.
+    bool Validated = false;
+    /// Whether the directory still has ModTime, so MissingNames can be used
+    /// and extended.
+    bool Valid = false;
+    /// Names of entries known not to exist in the directory.
+    llvm::StringSet<> MissingNames;
+  };
+
+  /// Validate \p Info against the current state of directory \p Dir, the
+  /// first time it is used.
+  bool isUsable(StringRef Dir, DirectoryInfo &Info, llvm::vfs::FileSystem &FS);
+
+  std::string CachePath;
+  llvm::StringMap<DirectoryInfo> Directories;
+  bool Dirty = false;
+};
+
 } // namespace clang
 
 #endif // LLVM_CLANG_BASIC_FILESYSTEMSTATCACHE_H
@@ -1734,6 +1734,28 @@ public:
   void noteSLocAddressSpaceUsage(DiagnosticsEngine &Diag,
                                  std::optional<unsigned> MaxNotes = 32) const;
 
+  /// The source location address space used by a file.
+  struct SLocUsage {
+    /// The file, or null for memory buffers.
+    const FileEntry *Entry = nullptr;
+    /// A location where this file was entered.
+    SourceLocation Loc;
+    /// Number of times this file was entered.
+    unsigned Inclusions = 0;
+    /// Size usage from the file itself.
+    uint64_t DirectSize = 0;
+    /// Total size usage from the file and its macro expansions.
+    uint64_t TotalSize = 0;
+  };
+
+  /// Returns the source location address space usage of each file, sorted
+  /// from largest to smallest.
+  ///
+  /// If \p MaxEntries is set, only that many of the largest are sorted, and
+  /// the rest follow in an unspecified order.
+  std::vector<SLocUsage>
+  getSLocAddressSpaceUsage(std::optional<unsigned> MaxEntries) const;
+
   /// Get the number of local SLocEntries we have.
   unsigned local_sloc_entry_size() const { return LocalSLocEntryTable.size(); }
 
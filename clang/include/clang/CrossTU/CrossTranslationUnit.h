@@ -213,9 +213,11 @@ private:
                                                      StringRef CrossTUDir,
                                                      StringRef IndexName,
                                                      bool DisplayCTUProgress);
+  /// Returns the definition with the given lookup name in \p Unit, or null.
   template <typename T>
-  const T *findDefInDeclContext(const DeclContext *DC,
-                                StringRef LookupName);
+  const T *findDefInUnit(ASTUnit *Unit, StringRef LookupName);
+  void indexDefsInDeclContext(const DeclContext *DC,
+                              llvm::StringMap<const Decl *> &Index);
   template <typename T>
   llvm::Expected<const T *> importDefinitionImpl(const T *D, ASTUnit *Unit);
 
@@ -224,6 +226,12 @@ private:
 
   ImporterMapTy ASTUnitImporterMap;
 
+  /// The function and variable definitions of each loaded unit, by lookup
+  /// name. Built on the first lookup into a unit, so that later lookups do
+  /// not walk and generate USRs for the whole unit again.
+  llvm::DenseMap<const TranslationUnitDecl *, llvm::StringMap<const Decl *>>
+      UnitDefinitions;
+
   ASTContext &Context;
   std::shared_ptr<ASTImporterSharedState> ImporterSharedSt;
 
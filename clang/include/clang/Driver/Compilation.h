@@ -132,6 +132,9 @@ class Compilation {
   /// Whether to keep temporary files regardless of -save-temps.
   bool ForceKeepTempFiles = false;
 
+  /// The number of independent jobs ExecuteJobs() may run at once.
+  unsigned NumParallelJobs = 1;
+
 public:
   Compilation(const Driver &D, const ToolChain &DefaultToolChain,
               llvm::opt::InputArgList *Args,
@@ -236,6 +239,9 @@ public:
     PostCallback = CB;
   }
 
+  unsigned getNumParallelJobs() const { return NumParallelJobs; }
+  void setNumParallelJobs(unsigned N) { NumParallelJobs = N; }
+
   /// Returns the sysroot path.
   StringRef getSysRoot() const;
 
@@ -345,6 +351,18 @@ public:
   /// of three. The inferior process's stdin(0), stdout(1), and stderr(2) will
   /// be redirected to the corresponding paths, if provided (not std::nullopt).
   void Redirect(ArrayRef<std::optional<StringRef>> Redirects);
+
+private:
+  /// ExecuteJobsInParallel - Execute the jobs, running up to \p NumThreads of
+  /// them at once.
+  ///
+  /// A job only starts once the jobs producing its inputs are done. The output
+  /// of each job is captured and replayed in job order, so it doesn't depend
+  /// on how the jobs were scheduled.
+  void ExecuteJobsInParallel(
+      const JobList &Jobs,
+      SmallVectorImpl<std::pair<int, const Command *>> &FailingCommands,
+      unsigned NumThreads) const;
 };
 
 } // namespace driver
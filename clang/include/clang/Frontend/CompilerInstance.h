@@ -53,6 +53,7 @@ class FileManager;
 class FrontendAction;
 class InMemoryModuleCache;
 class Module;
+class PersistentNegativeStatCache;
 class Preprocessor;
 class Sema;
 class SourceManager;
@@ -93,6 +94,10 @@ class CompilerInstance : public ModuleLoader {
   /// The file manager.
   IntrusiveRefCntPtr<FileManager> FileMgr;
 
+  /// The persistent header lookup cache installed in FileMgr by
+  /// createFileManager(), if one was requested. Owned by FileMgr.
+  PersistentNegativeStatCache *HeaderLookupCache = nullptr;
+
   /// The source manager.
   IntrusiveRefCntPtr<SourceManager> SourceMgr;
 
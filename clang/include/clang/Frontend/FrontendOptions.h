@@ -507,6 +507,10 @@ public:
   /// Minimum time granularity (in microseconds) traced by time profiler.
   unsigned TimeTraceGranularity;
 
+  /// Maximum number of events each thread records in the time trace, 0 if
+  /// unlimited.
+  unsigned TimeTraceMaxEvents;
+
   /// Make time trace capture verbose event details (e.g. source filenames).
   /// This can increase the size of the output by 2-3 times.
   LLVM_PREFERRED_TYPE(bool)
@@ -534,7 +538,7 @@ public:
         EmitSymbolGraphSymbolLabelsForTesting(false),
         EmitPrettySymbolGraphs(false), GenReducedBMI(false),
         UseClangIRPipeline(false), TimeTraceGranularity(500),
-        TimeTraceVerbose(false) {}
+        TimeTraceMaxEvents(0), TimeTraceVerbose(false) {}
 
   /// getInputKindForExtension - Return the appropriate input kind for a file
   /// extension. For example, "c" would return Language::C.
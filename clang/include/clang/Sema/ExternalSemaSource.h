@@ -31,6 +31,7 @@ class DeclaratorDecl;
 class LookupResult;
 class Scope;
 class Sema;
+class TemplateArgument;
 class TypedefNameDecl;
 class ValueDecl;
 class VarDecl;
@@ -200,6 +201,17 @@ public:
   virtual void
   ReadDeclsToCheckForDeferredDiags(llvm::SmallSetVector<Decl *, 4> &Decls) {}
 
+  /// Read the template argument lists for which the associated constraints
+  /// of \p Owner are known to be satisfied.
+  ///
+  /// \p Owner is a canonical declaration. The external source should append
+  /// each argument list to \p SatisfiedArgs. Note that this routine may be
+  /// invoked multiple times; the external source should take care not to
+  /// introduce the same argument lists repeatedly.
+  virtual void ReadSatisfiedConstraints(
+      const NamedDecl *Owner,
+      SmallVectorImpl<SmallVector<TemplateArgument, 4>> &SatisfiedArgs) {}
+
   /// \copydoc Sema::CorrectTypo
   /// \note LookupKind must correspond to a valid Sema::LookupNameKind
   ///
@@ -14572,6 +14572,16 @@ private:
   llvm::ContextualFoldingSet<ConstraintSatisfaction, const ASTContext &>
       SatisfactionCache;
 
+  /// The number of constraint checks that were evaluated rather than found in
+  /// SatisfactionCache.
+  unsigned NumConstraintSatisfactionChecks = 0;
+
+  /// Add the satisfied constraint checks of \p Template recorded by the
+  /// external source to SatisfactionCache.
+  ///
+  /// \returns true if any entries were added.
+  bool loadExternalConstraintSatisfactions(const NamedDecl *Template);
+
   // The current stack of constraint satisfactions, so we can exit-early.
   llvm::SmallVector<SatisfactionStackEntryTy, 10> SatisfactionStack;
 
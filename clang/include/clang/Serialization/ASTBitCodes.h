@@ -742,6 +742,9 @@ enum ASTRecordTypes {
   UPDATE_MODULE_LOCAL_VISIBLE = 76,
 
   UPDATE_TU_LOCAL_VISIBLE = 77,
+
+  /// Record code for the constraint checks Sema found to be satisfied.
+  SATISFIED_CONSTRAINTS = 78,
 };
 
 /// Record types used within a source manager block.
@@ -1044,6 +1044,18 @@ private:
   /// The IDs of all decls with function effects to be checked.
   SmallVector<GlobalDeclID> DeclsWithEffectsToVerify;
 
+  /// A constraint check recorded as satisfied, whose argument types are
+  /// only deserialized when Sema asks about the constraint owner.
+  struct SatisfiedConstraint {
+    ModuleFile *F;
+    SmallVector<serialization::TypeID, 4> ArgTypes;
+  };
+
+  /// The satisfied constraint checks in the chain, keyed by the canonical
+  /// declaration that owns the constraints.
+  llvm::DenseMap<GlobalDeclID, SmallVector<SatisfiedConstraint, 1>>
+      SatisfiedConstraints;
+
 private:
   struct ImportedSubmodule {
     serialization::SubmoduleID ID;
@@ -2273,6 +2285,10 @@ public:
   void ReadDeclsToCheckForDeferredDiags(
       llvm::SmallSetVector<Decl *, 4> &Decls) override;
 
+  void ReadSatisfiedConstraints(
+      const NamedDecl *Owner,
+      SmallVectorImpl<SmallVector<TemplateArgument, 4>> &SatisfiedArgs) override;
+
   void ReadReferencedSelectors(
            SmallVectorImpl<std::pair<Selector, SourceLocation>> &Sels) override;
 
@@ -220,6 +220,18 @@ public:
   CacheShard &getShardForFilename(StringRef Filename) const;
   CacheShard &getShardForUID(llvm::sys::fs::UniqueID UID) const;
 
+  /// Re-stats every cached filename against \p UnderlyingFS and forgets the
+  /// entries whose existence, size or modification time changed, so that a
+  /// long-lived cache can be reused across scans of an evolving file system.
+  /// The memory of the forgotten entries is only released together with the
+  /// cache.
+  ///
+  /// This must not be called while any worker filesystem is scanning with
+  /// this cache, as workers hold on to entries for the duration of a scan.
+  ///
+  /// \returns The number of filenames that were invalidated.
+  unsigned invalidateOutOfDateEntries(llvm::vfs::FileSystem &UnderlyingFS);
+
 private:
   std::unique_ptr<CacheShard[]> CacheShards;
   unsigned NumShards;
@@ -74,13 +74,42 @@ ASTConstraintSatisfaction *ASTConstraintSatisfaction::Rebuild(
   return new (Mem) ASTConstraintSatisfaction(C, Satisfaction);
 }
 
+/// Profile \p Arg as its canonical form would be, without allocating the
+/// canonical argument in the context. Dependent types keep their sugar, since
+/// canonically equal template parameters of different templates mustn't share
+/// a satisfaction.
+static void profileCanonicalTemplateArgument(llvm::FoldingSetNodeID &ID,
+                                             const ASTContext &C,
+                                             const TemplateArgument &Arg) {
+  switch (Arg.getKind()) {
+  case TemplateArgument::Type: {
+    QualType T = Arg.getAsType();
+    if (!T->isDependentType())
+      T = ASTContext::getCanonicalType(T);
+    ID.AddInteger(Arg.getKind());
+    ID.AddPointer(T.getAsOpaquePtr());
+    return;
+  }
+  case TemplateArgument::Pack:
+    ID.AddInteger(Arg.getKind());
+    ID.AddInteger(Arg.pack_size());
+    for (const TemplateArgument &Elt : Arg.pack_elements())
+      profileCanonicalTemplateArgument(ID, C, Elt);
+    return;
+  default:
+    Arg.Profile(ID, C);
+    return;
+  }
+}
+
 void ConstraintSatisfaction::Profile(
     llvm::FoldingSetNodeID &ID, const ASTContext &C,
     const NamedDecl *ConstraintOwner, ArrayRef<TemplateArgument> TemplateArgs) {
-  ID.AddPointer(ConstraintOwner);
+  ID.AddPointer(ConstraintOwner ? ConstraintOwner->getCanonicalDecl()
+                                : nullptr);
   ID.AddInteger(TemplateArgs.size());
   for (auto &Arg : TemplateArgs)
-    Arg.Profile(ID, C);
+    profileCanonicalTemplateArgument(ID, C, Arg);
 }
 
 ConceptReference *
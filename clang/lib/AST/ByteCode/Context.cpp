@@ -315,3 +315,20 @@ unsigned Context::collectBaseOffset(const RecordDecl *BaseDecl,
 const Record *Context::getRecord(const RecordDecl *D) const {
   return P->getOrCreateRecord(D);
 }
+
+std::optional<uint64_t>
+Context::lookupMemoizedCall(ArrayRef<uint64_t> Key) const {
+  auto It = MemoizedCalls.find(SmallVector<uint64_t, 4>(Key));
+  if (It == MemoizedCalls.end())
+    return std::nullopt;
+  return It->second;
+}
+
+void Context::memoizeCall(ArrayRef<uint64_t> Key, uint64_t Result) {
+  // Bound the memory used by the table, a TU may make arbitrarily many
+  // distinct calls.
+  constexpr size_t MaxMemoizedCalls = 1 << 16;
+  if (MemoizedCalls.size() >= MaxMemoizedCalls)
+    MemoizedCalls.clear();
+  MemoizedCalls.try_emplace(SmallVector<uint64_t, 4>(Key), Result);
+}
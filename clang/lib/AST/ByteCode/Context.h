@@ -17,6 +17,10 @@
 #define LLVM_CLANG_AST_INTERP_CONTEXT_H
 
 #include "InterpStack.h"
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/SmallVector.h"
+#include <map>
+#include <optional>
 
 namespace clang {
 class ASTContext;
@@ -112,6 +116,13 @@ public:
 
   unsigned getEvalID() const { return EvalID; }
 
+  /// Returns the result of an earlier call recorded with memoizeCall().
+  std::optional<uint64_t>
+  lookupMemoizedCall(llvm::ArrayRef<uint64_t> Key) const;
+  /// Records the result of a call for -fexperimental-constexpr-call-memoization.
+  /// \p Key identifies the callee, the evaluation mode and the arguments.
+  void memoizeCall(llvm::ArrayRef<uint64_t> Key, uint64_t Result);
+
 private:
   /// Runs a function.
   bool Run(State &Parent, const Function *Func);
@@ -124,6 +135,8 @@ private:
   std::unique_ptr<Program> P;
   /// ID identifying an evaluation.
   unsigned EvalID = 0;
+  /// Results of memoized calls, shared by all evaluations.
+  std::map<llvm::SmallVector<uint64_t, 4>, uint64_t> MemoizedCalls;
 };
 
 } // namespace interp
@@ -1294,6 +1294,61 @@ bool CallVar(InterpState &S, CodePtr OpPC, const Function *Func,
   return false;
 }
 
+static bool isMemoizableType(PrimType T) {
+  return T <= PT_Uint64 || T == PT_Bool;
+}
+
+/// Returns the return type of \p Func if calls to it can be memoized, see
+/// -fexperimental-constexpr-call-memoization. Only free functions taking and
+/// returning fixed-width integers qualify: without pointers there is no way
+/// for such a call to observe state that changes between evaluations.
+static std::optional<PrimType> getMemoizableReturnType(InterpState &S,
+                                                       const Function *Func) {
+  if (!S.getLangOpts().ConstexprCallMemoization ||
+      S.checkingPotentialConstantExpression())
+    return std::nullopt;
+  if (!Func->getDecl() || Func->hasThisPointer() || Func->hasRVO() ||
+      Func->isVariadic() || Func->isBuiltin())
+    return std::nullopt;
+  // A class object may be read by name while its constructor is still
+  // modifying it.
+  if (S.EvaluatingDecl && !S.EvaluatingDecl->getType()->isScalarType())
+    return std::nullopt;
+  if (!llvm::all_of(Func->args_reverse(), isMemoizableType))
+    return std::nullopt;
+  std::optional<PrimType> RetT =
+      S.getContext().classify(Func->getDecl()->getReturnType());
+  if (!RetT || !isMemoizableType(*RetT))
+    return std::nullopt;
+  return RetT;
+}
+
+/// Returns the bits of \p V as stored in the memoization table. Unsigned
+/// values don't fit getExtValue() if their top bit is set.
+template <typename T> static uint64_t getMemoValue(const T &V) {
+  APSInt I = V.toAPSInt();
+  return I.isSigned() ? static_cast<uint64_t>(I.getSExtValue())
+                      : I.getZExtValue();
+}
+
+/// Builds the key identifying a call to \p Func with the arguments currently
+/// on top of the stack.
+static SmallVector<uint64_t, 4> getMemoKey(InterpState &S,
+                                           const Function *Func) {
+  SmallVector<uint64_t, 4> Key;
+  Key.push_back(reinterpret_cast<uintptr_t>(Func));
+  // The result may depend on std::is_constant_evaluated().
+  Key.push_back(S.inConstantContext());
+  unsigned ArgSize = Func->getArgSize();
+  for (unsigned I = 0, N = Func->getNumParams(); I != N; ++I) {
+    unsigned Offset = ArgSize - Func->getParamOffset(I);
+    INT_TYPE_SWITCH(Func->getParamType(I), {
+      Key.push_back(getMemoValue(S.Stk.peek<T>(Offset)));
+    });
+  }
+  return Key;
+}
+
 bool Call(InterpState &S, CodePtr OpPC, const Function *Func,
           uint32_t VarArgSize) {
   assert(Func);
@@ -1344,6 +1399,23 @@ bool Call(InterpState &S, CodePtr OpPC, const Function *Func,
   if (!CheckCallDepth(S, OpPC))
     return cleanup();
 
+  std::optional<PrimType> MemoRetT = getMemoizableReturnType(S, Func);
+  SmallVector<uint64_t, 4> MemoKey;
+  if (MemoRetT) {
+    MemoKey = getMemoKey(S, Func);
+    if (std::optional<uint64_t> Result =
+            S.getContext().lookupMemoizedCall(MemoKey)) {
+      cleanupAfterFunctionCall(S, OpPC, Func);
+      INT_TYPE_SWITCH(*MemoRetT, S.Stk.push<T>(T::from(*Result)));
+      return true;
+    }
+  }
+  // Results are only reused if the call was a constant expression, which we
+  // can only tell if diagnostics are being collected.
+  Expr::EvalStatus &Status = S.getEvalStatus();
+  bool CanMemoize = MemoRetT && Status.Diag && Status.Diag->empty() &&
+                    !Status.HasSideEffects && !Status.HasUndefinedBehavior;
+
   auto NewFrame = std::make_unique<InterpFrame>(S, Func, OpPC, VarArgSize);
   InterpFrame *FrameBefore = S.Current;
   S.Current = NewFrame.get();
@@ -1355,6 +1427,10 @@ bool Call(InterpState &S, CodePtr OpPC, const Function *Func,
   if (Interpret(S)) {
     NewFrame.release(); // Frame was delete'd already.
     assert(S.Current == FrameBefore);
+    if (CanMemoize && Status.Diag->empty() && !Status.HasSideEffects &&
+        !Status.HasUndefinedBehavior)
+      INT_TYPE_SWITCH(*MemoRetT, S.getContext().memoizeCall(
+                                     MemoKey, getMemoValue(S.Stk.peek<T>())));
     return true;
   }
 
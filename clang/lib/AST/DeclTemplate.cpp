@@ -367,11 +367,13 @@ bool RedeclarableTemplateDecl::loadLazySpecializationsImpl(
   if (!ExternalSource)
     return false;
 
-  // If TPL is not null, it implies that we're loading specializations for
-  // partial templates. We need to load all specializations in such cases.
+  // If TPL is not null, it implies that we're looking up a partial
+  // specialization. Their arguments refer to template parameters and can't be
+  // hashed reliably, so load all partial specializations. Full
+  // specializations are kept in a separate table and are never candidates.
   if (TPL)
     return ExternalSource->LoadExternalSpecializations(this->getCanonicalDecl(),
-                                                       /*OnlyPartial=*/false);
+                                                       /*OnlyPartial=*/true);
 
   return ExternalSource->LoadExternalSpecializations(this->getCanonicalDecl(),
                                                      Args);
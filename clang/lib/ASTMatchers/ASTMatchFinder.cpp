@@ -22,6 +22,7 @@
 #include "clang/AST/RecursiveASTVisitor.h"
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/ADT/SmallString.h"
 #include "llvm/ADT/StringMap.h"
 #include "llvm/Support/PrettyStackTrace.h"
 #include "llvm/Support/Timer.h"
@@ -1036,19 +1037,37 @@ private:
     }
   }
 
+  /// The indices of the \c DeclOrStmt matchers that can match a node kind.
+  struct MatcherFilter {
+    /// Matchers that can match a node of any name.
+    std::vector<unsigned short> AnyName;
+    /// Matchers that can only match a \c NamedDecl of the given name.
+    llvm::StringMap<std::vector<unsigned short>> ByName;
+  };
+
   void matchWithFilter(const DynTypedNode &DynNode) {
     auto Kind = DynNode.getNodeKind();
     auto it = MatcherFiltersMap.find(Kind);
-    const auto &Filter =
+    const MatcherFilter &Filter =
         it != MatcherFiltersMap.end() ? it->second : getFilterForKind(Kind);
 
-    if (Filter.empty())
+    // Matchers that require a name only need to run when the node has it.
+    ArrayRef<unsigned short> Named;
+    if (!Filter.ByName.empty()) {
+      llvm::SmallString<128> Scratch;
+      auto NameIt = Filter.ByName.find(getNodeName(DynNode, Scratch));
+      if (NameIt != Filter.ByName.end())
+        Named = NameIt->second;
+    }
+    ArrayRef<unsigned short> AnyName = Filter.AnyName;
+
+    if (Named.empty() && AnyName.empty())
       return;
 
     const bool EnableCheckProfiling = Options.CheckProfiling.has_value();
     TimeBucketRegion Timer;
     auto &Matchers = this->Matchers->DeclOrStmt;
-    for (unsigned short I : Filter) {
+    auto RunMatcher = [&](unsigned short I) {
       auto &MP = Matchers[I];
       if (EnableCheckProfiling)
         Timer.setBucket(&TimeByBucket[MP.second->getID()]);
@@ -1058,7 +1077,7 @@ private:
         TraversalKindScope RAII(getASTContext(), MP.first.getTraversalKind());
         if (getASTContext().getParentMapContext().traverseIgnored(DynNode) !=
             DynNode)
-          continue;
+          return;
       }
 
       CurMatchRAII RAII(*this, MP.second, DynNode);
@@ -1066,16 +1085,57 @@ private:
         MatchVisitor Visitor(*this, ActiveASTContext, MP.second);
         Builder.visitMatches(&Visitor);
       }
+    };
+
+    // Both lists are sorted; merge them so that the callbacks still run in
+    // the order the matchers were added.
+    while (!Named.empty() || !AnyName.empty()) {
+      if (AnyName.empty() ||
+          (!Named.empty() && Named.front() < AnyName.front())) {
+        RunMatcher(Named.front());
+        Named = Named.drop_front();
+      } else {
+        RunMatcher(AnyName.front());
+        AnyName = AnyName.drop_front();
+      }
     }
   }
 
-  const std::vector<unsigned short> &getFilterForKind(ASTNodeKind Kind) {
+  /// Returns the unqualified name \c HasNameMatcher compares against, or an
+  /// empty string if \p DynNode has none.
+  static StringRef getNodeName(const DynTypedNode &DynNode,
+                               llvm::SmallString<128> &Scratch) {
+    const auto *ND = DynNode.get<NamedDecl>();
+    if (!ND)
+      return StringRef();
+    if (ND->getIdentifier())
+      return ND->getName();
+    if (!ND->getDeclName())
+      return StringRef();
+    llvm::raw_svector_ostream OS(Scratch);
+    ND->printName(OS);
+    return OS.str();
+  }
+
+  const MatcherFilter &getFilterForKind(ASTNodeKind Kind) {
     auto &Filter = MatcherFiltersMap[Kind];
     auto &Matchers = this->Matchers->DeclOrStmt;
     assert((Matchers.size() < USHRT_MAX) && "Too many matchers.");
+    const bool IsNamedDecl =
+        ASTNodeKind::getFromNodeKind<NamedDecl>().isBaseOf(Kind);
+    SmallVector<StringRef, 4> Names;
     for (unsigned I = 0, E = Matchers.size(); I != E; ++I) {
-      if (Matchers[I].first.canMatchNodesOfKind(Kind)) {
-        Filter.push_back(I);
+      if (!Matchers[I].first.canMatchNodesOfKind(Kind))
+        continue;
+      Names.clear();
+      if (!IsNamedDecl || !Matchers[I].first.getRequiredNames(Names)) {
+        Filter.AnyName.push_back(I);
+        continue;
+      }
+      for (StringRef Name : Names) {
+        auto &Indices = Filter.ByName[Name];
+        if (Indices.empty() || Indices.back() != I)
+          Indices.push_back(I);
       }
     }
     return Filter;
@@ -1327,7 +1387,9 @@ private:
   /// kind (and derived kinds) so it is a waste to try every matcher on every
   /// node.
   /// We precalculate a list of matchers that pass the toplevel restrict check.
-  llvm::DenseMap<ASTNodeKind, std::vector<unsigned short>> MatcherFiltersMap;
+  /// Matchers that only accept a \c NamedDecl with a given name (such as
+  /// \c hasName()) are further bucketed by that name.
+  llvm::DenseMap<ASTNodeKind, MatcherFilter> MatcherFiltersMap;
 
   const MatchFinder::MatchFinderOptions &Options;
   ASTContext *ActiveASTContext;
@@ -18,6 +18,7 @@
 #include "clang/AST/ParentMapContext.h"
 #include "clang/AST/PrettyPrinter.h"
 #include "clang/ASTMatchers/ASTMatchers.h"
+#include "clang/Basic/CharInfo.h"
 #include "clang/Basic/LLVM.h"
 #include "clang/Lex/Lexer.h"
 #include "llvm/ADT/ArrayRef.h"
@@ -124,6 +125,24 @@ public:
     return Func(DynNode, Finder, Builder, InnerMatchers);
   }
 
+  bool getRequiredNames(SmallVectorImpl<StringRef> &Names) const override {
+    // allOf() requires the names of any one of its inner matchers, anyOf()
+    // the union of the names of all of them.
+    if constexpr (Func == allOfVariadicOperator) {
+      for (const DynTypedMatcher &InnerMatcher : InnerMatchers) {
+        size_t OldSize = Names.size();
+        if (InnerMatcher.getRequiredNames(Names))
+          return true;
+        Names.truncate(OldSize);
+      }
+    } else if constexpr (Func == anyOfVariadicOperator) {
+      return llvm::all_of(InnerMatchers, [&](const DynTypedMatcher &M) {
+        return M.getRequiredNames(Names);
+      });
+    }
+    return false;
+  }
+
 private:
   std::vector<DynTypedMatcher> InnerMatchers;
 };
@@ -145,6 +164,10 @@ public:
     return InnerMatcher->TraversalKind();
   }
 
+  bool getRequiredNames(SmallVectorImpl<StringRef> &Names) const override {
+    return InnerMatcher->getRequiredNames(Names);
+  }
+
 private:
   const std::string ID;
   const IntrusiveRefCntPtr<DynMatcherInterface> InnerMatcher;
@@ -181,6 +204,10 @@ public:
     return TK;
   }
 
+  bool getRequiredNames(SmallVectorImpl<StringRef> &Names) const override {
+    return InnerMatcher->getRequiredNames(Names);
+  }
+
 private:
   clang::TraversalKind TK;
   IntrusiveRefCntPtr<DynMatcherInterface> InnerMatcher;
@@ -677,6 +704,22 @@ bool HasNameMatcher::matchesNodeFullSlow(const NamedDecl &Node) const {
   return false;
 }
 
+bool HasNameMatcher::getRequiredNames(SmallVectorImpl<StringRef> &Out) const {
+  for (StringRef Name : Names) {
+    StringRef Unqualified = Name.rsplit("::").second;
+    if (Unqualified.empty())
+      Unqualified = Name;
+    // Only plain identifiers are printed the same way by every match routine.
+    if (!isValidAsciiIdentifier(Unqualified))
+      return false;
+  }
+  for (StringRef Name : Names) {
+    StringRef Unqualified = Name.rsplit("::").second;
+    Out.push_back(Unqualified.empty() ? Name : Unqualified);
+  }
+  return true;
+}
+
 bool HasNameMatcher::matchesNode(const NamedDecl &Node) const {
   assert(matchesNodeFullFast(Node) == matchesNodeFullSlow(Node));
   if (UseUnqualifiedMatch) {
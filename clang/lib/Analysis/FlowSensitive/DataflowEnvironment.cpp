@@ -771,6 +771,20 @@ Environment Environment::join(const Environment &EnvA, const Environment &EnvB,
   assert(EnvA.InitialTargetFunc == EnvB.InitialTargetFunc);
   assert(EnvA.InitialTargetStmt == EnvB.InitialTargetStmt);
 
+  if (&EnvA == &EnvB) {
+    // Joining an environment with itself (as is done for blocks with a single
+    // predecessor) yields the same state, so copy the maps as a whole rather
+    // than joining them entry by entry.
+    Environment JoinedEnv = EnvA.fork();
+    if (!EnvA.getCurrentFunc())
+      JoinedEnv.ReturnVal = nullptr;
+    if (ExprBehavior == DiscardExprState) {
+      JoinedEnv.ExprToVal.clear();
+      JoinedEnv.ExprToLoc.clear();
+    }
+    return JoinedEnv;
+  }
+
   Environment JoinedEnv(*EnvA.DACtx);
 
   JoinedEnv.CallStack = EnvA.CallStack;
@@ -33,11 +33,20 @@
 #include "clang/Support/Compiler.h"
 #include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/Error.h"
+#include "llvm/Support/TimeProfiler.h"
 
 #define DEBUG_TYPE "clang-dataflow"
 
+STATISTIC(NumAnalyses, "The # of dataflow analyses run");
+STATISTIC(NumBlockVisits, "The # of basic blocks transferred");
+STATISTIC(NumBlocksConverged,
+          "The # of basic block visits that didn't change the block state");
+STATISTIC(NumAnalysesTimedOut,
+          "The # of analyses that hit the maximum number of block visits");
+
 namespace clang {
 namespace dataflow {
 class NoopLattice;
@@ -203,9 +212,8 @@ public:
       return {AC.Analysis.typeErasedInitialElement(), AC.InitEnv.fork()};
     if (All.size() == 1)
       // Join the environment with itself so that we discard expression state if
-      // desired.
-      // FIXME: We could consider writing special-case code for this that only
-      // does the discarding, but it's not clear if this is worth it.
+      // desired. `Environment::join()` recognizes this case and only copies
+      // the state.
       return {All[0]->Lattice, Environment::join(All[0]->Env, All[0]->Env,
                                                  AC.Analysis, JoinBehavior)};
 
@@ -492,6 +500,12 @@ runTypeErasedDataflowAnalysis(
     const CFGEltCallbacksTypeErased &PostAnalysisCallbacks,
     std::int32_t MaxBlockVisits) {
   PrettyStackTraceAnalysis CrashInfo(ACFG, "runTypeErasedDataflowAnalysis");
+  llvm::TimeTraceScope TimeScope("runTypeErasedDataflowAnalysis", [&] {
+    if (const auto *ND = dyn_cast<NamedDecl>(&ACFG.getDecl()))
+      return ND->getQualifiedNameAsString();
+    return std::string();
+  });
+  ++NumAnalyses;
 
   std::optional<Environment> MaybeStartingEnv;
   if (InitEnv.callStackSize() == 0) {
@@ -520,12 +534,14 @@ runTypeErasedDataflowAnalysis(
     LLVM_DEBUG(llvm::dbgs()
                << "Processing Block " << Block->getBlockID() << "\n");
     if (++BlockVisits > MaxBlockVisits) {
+      ++NumAnalysesTimedOut;
       return llvm::createStringError(std::errc::timed_out,
                                      "maximum number of blocks processed");
     }
 
     const std::optional<TypeErasedDataflowAnalysisState> &OldBlockState =
         BlockStates[Block->getBlockID()];
+    ++NumBlockVisits;
     TypeErasedDataflowAnalysisState NewBlockState =
         transferCFGBlock(*Block, AC);
     LLVM_DEBUG({
@@ -547,6 +563,7 @@ runTypeErasedDataflowAnalysis(
             Effect2 == LatticeJoinEffect::Unchanged) {
           // The state of `Block` didn't change from widening so there's no need
           // to revisit its successors.
+          ++NumBlocksConverged;
           AC.Log.blockConverged();
           continue;
         }
@@ -555,6 +572,7 @@ runTypeErasedDataflowAnalysis(
                  OldBlockState->Env.equivalentTo(NewBlockState.Env, Analysis)) {
         // The state of `Block` didn't change after transfer so there's no need
         // to revisit its successors.
+        ++NumBlocksConverged;
         AC.Log.blockConverged();
         continue;
       }
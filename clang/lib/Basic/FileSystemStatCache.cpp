@@ -11,10 +11,14 @@
 //===----------------------------------------------------------------------===//
 
 #include "clang/Basic/FileSystemStatCache.h"
+#include "llvm/ADT/StringExtras.h"
 #include "llvm/Support/Chrono.h"
 #include "llvm/Support/ErrorOr.h"
+#include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/VirtualFileSystem.h"
+#include "llvm/Support/raw_ostream.h"
+#include <chrono>
 #include <utility>
 
 using namespace clang;
@@ -120,3 +124,122 @@ MemorizeStatCalls::getStat(StringRef Path, llvm::vfs::Status &Status,
 
   return std::error_code();
 }
+
+/// The first line of a PersistentNegativeStatCache file. It is followed by a
+/// "D <modtime> <directory>" line for each directory, and a "N <name>" line
+/// for each missing entry of that directory.
+static constexpr StringRef NegativeStatCacheMagic = "clang-negative-stat-cache 1";
+
+PersistentNegativeStatCache::PersistentNegativeStatCache(StringRef CachePath)
+    : CachePath(CachePath) {
+  llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> Buffer =
+      llvm::MemoryBuffer::getFile(CachePath, /*IsText=*/true);
+  if (!Buffer)
+    return;
+
+  StringRef Contents = (*Buffer)->getBuffer();
+  StringRef Line;
+  std::tie(Line, Contents) = Contents.split('\n');
+  if (Line != NegativeStatCacheMagic)
+    return;
+
+  DirectoryInfo *Current = nullptr;
+  while (!Contents.empty()) {
+    std::tie(Line, Contents) = Contents.split('\n');
+    if (Line.consume_front("D ")) {
+      auto [ModTime, Dir] = Line.split(' ');
+      Current = nullptr;
+      DirectoryInfo Info;
+      if (Dir.empty() || !llvm::to_integer(ModTime, Info.ModTime))
+        continue;
+      Current = &Directories.try_emplace(Dir, std::move(Info)).first->second;
+    } else if (Line.consume_front("N ") && Current && !Line.empty()) {
+      Current->MissingNames.insert(Line);
+    }
+  }
+}
+
+PersistentNegativeStatCache::~PersistentNegativeStatCache() { save(); }
+
+void PersistentNegativeStatCache::save() {
+  if (!Dirty)
+    return;
+  Dirty = false;
+
+  llvm::Error Err =
+      llvm::writeToOutput(CachePath, [&](llvm::raw_ostream &OS) {
+        OS << NegativeStatCacheMagic << '\n';
+        for (const auto &Dir : Directories) {
+          const DirectoryInfo &Info = Dir.second;
+          if (Info.MissingNames.empty())
+            continue;
+          OS << "D " << Info.ModTime << ' ' << Dir.first() << '\n';
+          for (const auto &Name : Info.MissingNames)
+            OS << "N " << Name.first() << '\n';
+        }
+        return llvm::Error::success();
+      });
+  llvm::consumeError(std::move(Err));
+}
+
+bool PersistentNegativeStatCache::isUsable(StringRef Dir, DirectoryInfo &Info,
+                                           llvm::vfs::FileSystem &FS) {
+  if (Info.Validated)
+    return Info.Valid;
+  Info.Validated = true;
+
+  llvm::ErrorOr<llvm::vfs::Status> DirStatus = FS.status(Dir);
+  if (!DirStatus || !DirStatus->isDirectory()) {
+    if (!Info.MissingNames.empty()) {
+      Info.MissingNames.clear();
+      Dirty = true;
+    }
+    return false;
+  }
+
+  llvm::sys::TimePoint<> ModTime = DirStatus->getLastModificationTime();
+  int64_t ModTimeNS = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                          ModTime.time_since_epoch())
+                          .count();
+  if (ModTimeNS != Info.ModTime) {
+    if (!Info.MissingNames.empty()) {
+      Info.MissingNames.clear();
+      Dirty = true;
+    }
+    Info.ModTime = ModTimeNS;
+    // An entry could still be added to a directory modified this recently
+    // without changing its modification time, on file systems with coarse
+    // timestamps, so don't record anything about it.
+    if (std::chrono::system_clock::now() - ModTime < std::chrono::seconds(2))
+      return false;
+  }
+
+  Info.Valid = true;
+  return true;
+}
+
+std::error_code PersistentNegativeStatCache::getStat(
+    StringRef Path, llvm::vfs::Status &Status, bool isFile,
+    std::unique_ptr<llvm::vfs::File> *F, llvm::vfs::FileSystem &FS) {
+  // Relative paths depend on the working directory, so they aren't cached.
+  StringRef Dir = llvm::sys::path::parent_path(Path);
+  StringRef Name = llvm::sys::path::filename(Path);
+  if (!llvm::sys::path::is_absolute(Path) || Dir.empty() || Name.empty() ||
+      Name == "." || Name == "..")
+    return get(Path, Status, isFile, F, nullptr, FS);
+
+  auto Known = Directories.find(Dir);
+  if (Known != Directories.end() && Known->second.MissingNames.contains(Name) &&
+      isUsable(Known->first(), Known->second, FS))
+    return std::make_error_code(std::errc::no_such_file_or_directory);
+
+  std::error_code EC = get(Path, Status, isFile, F, nullptr, FS);
+  if (EC != std::errc::no_such_file_or_directory)
+    return EC;
+
+  auto &Entry = *Directories.try_emplace(Dir).first;
+  if (isUsable(Entry.first(), Entry.second, FS) &&
+      Entry.second.MissingNames.insert(Name).second)
+    Dirty = true;
+  return EC;
+}
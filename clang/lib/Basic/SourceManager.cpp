@@ -2198,6 +2198,46 @@ void SourceManager::PrintStats() const {
                << NumMacroArgsComputed << " files with macro args computed.\n";
   llvm::errs() << "FileID scans: " << NumLinearScans << " linear, "
                << NumBinaryProbes << " binary.\n";
+
+  // Break the local address space down by the kind of entry using it.
+  enum { Files, MacroBodies, MacroArgs, TokenSplits, NumKinds };
+  unsigned NumEntries[NumKinds] = {};
+  uint64_t Sizes[NumKinds] = {};
+  for (unsigned ID = 0, E = LocalSLocEntryTable.size(); ID != E; ++ID) {
+    const SrcMgr::SLocEntry &Entry = LocalSLocEntryTable[ID];
+    SourceLocation::UIntTy Next = ID + 1 == E
+                                      ? NextLocalOffset
+                                      : LocalSLocEntryTable[ID + 1].getOffset();
+    unsigned Kind = Files;
+    if (Entry.isExpansion()) {
+      const SrcMgr::ExpansionInfo &Info = Entry.getExpansion();
+      Kind = Info.isMacroArgExpansion()      ? MacroArgs
+             : Info.isExpansionTokenRange() ? MacroBodies
+                                            : TokenSplits;
+    }
+    ++NumEntries[Kind];
+    Sizes[Kind] += Next - Entry.getOffset();
+  }
+  llvm::errs() << "Local SLoc address space: " << Sizes[Files] << "B in "
+               << NumEntries[Files] << " files, " << Sizes[MacroBodies]
+               << "B in " << NumEntries[MacroBodies] << " macro expansions, "
+               << Sizes[MacroArgs] << "B in " << NumEntries[MacroArgs]
+               << " macro argument expansions, " << Sizes[TokenSplits]
+               << "B in " << NumEntries[TokenSplits] << " token splits.\n";
+
+  // Name the files using the most address space, directly or through the
+  // macros expanded in them.
+  constexpr unsigned MaxFiles = 10;
+  std::vector<SLocUsage> Usage = getSLocAddressSpaceUsage(MaxFiles);
+  if (Usage.size() > MaxFiles)
+    Usage.resize(MaxFiles);
+  for (const SLocUsage &FileUsage : Usage) {
+    llvm::errs() << "  " << FileUsage.TotalSize << "B ("
+                 << FileUsage.DirectSize << "B directly, "
+                 << FileUsage.Inclusions << " inclusions): "
+                 << (FileUsage.Entry ? FileUsage.Entry->getName() : "<none>")
+                 << "\n";
+  }
 }
 
 LLVM_DUMP_METHOD void SourceManager::dump() const {
@@ -2256,22 +2296,11 @@ LLVM_DUMP_METHOD void SourceManager::dump() const {
   }
 }
 
-void SourceManager::noteSLocAddressSpaceUsage(
-    DiagnosticsEngine &Diag, std::optional<unsigned> MaxNotes) const {
-  struct Info {
-    // A location where this file was entered.
-    SourceLocation Loc;
-    // Number of times this FileEntry was entered.
-    unsigned Inclusions = 0;
-    // Size usage from the file itself.
-    uint64_t DirectSize = 0;
-    // Total size usage from the file and its macro expansions.
-    uint64_t TotalSize = 0;
-  };
-  using UsageMap = llvm::MapVector<const FileEntry*, Info>;
+std::vector<SourceManager::SLocUsage> SourceManager::getSLocAddressSpaceUsage(
+    std::optional<unsigned> MaxEntries) const {
+  using UsageMap = llvm::MapVector<const FileEntry *, SLocUsage>;
 
   UsageMap Usage;
-  uint64_t CountedSize = 0;
 
   auto AddUsageForFileID = [&](FileID ID) {
     // The +1 here is because getFileIDSize doesn't include the extra byte for
@@ -2284,15 +2313,16 @@ void SourceManager::noteSLocAddressSpaceUsage(
     FileID FileLocID = getFileID(FileStart);
     const FileEntry *Entry = getFileEntryForID(FileLocID);
 
-    Info &EntryInfo = Usage[Entry];
-    if (EntryInfo.Loc.isInvalid())
+    SLocUsage &EntryInfo = Usage[Entry];
+    if (EntryInfo.Loc.isInvalid()) {
+      EntryInfo.Entry = Entry;
       EntryInfo.Loc = FileStart;
+    }
     if (ID == FileLocID) {
       ++EntryInfo.Inclusions;
       EntryInfo.DirectSize += Size;
     }
     EntryInfo.TotalSize += Size;
-    CountedSize += Size;
   };
 
   // Loaded SLocEntries have indexes counting downwards from -2.
@@ -2306,18 +2336,32 @@ void SourceManager::noteSLocAddressSpaceUsage(
 
   // Sort the usage by size from largest to smallest. Break ties by raw source
   // location.
-  auto SortedUsage = Usage.takeVector();
-  auto Cmp = [](const UsageMap::value_type &A, const UsageMap::value_type &B) {
-    return A.second.TotalSize > B.second.TotalSize ||
-           (A.second.TotalSize == B.second.TotalSize &&
-            A.second.Loc < B.second.Loc);
+  std::vector<SLocUsage> SortedUsage;
+  SortedUsage.reserve(Usage.size());
+  for (auto &Entry : Usage.takeVector())
+    SortedUsage.push_back(Entry.second);
+  auto Cmp = [](const SLocUsage &A, const SLocUsage &B) {
+    return A.TotalSize > B.TotalSize ||
+           (A.TotalSize == B.TotalSize && A.Loc < B.Loc);
   };
   auto SortedEnd = SortedUsage.end();
-  if (MaxNotes && SortedUsage.size() > *MaxNotes) {
-    SortedEnd = SortedUsage.begin() + *MaxNotes;
+  if (MaxEntries && SortedUsage.size() > *MaxEntries) {
+    SortedEnd = SortedUsage.begin() + *MaxEntries;
     std::nth_element(SortedUsage.begin(), SortedEnd, SortedUsage.end(), Cmp);
   }
   std::sort(SortedUsage.begin(), SortedEnd, Cmp);
+  return SortedUsage;
+}
+
+void SourceManager::noteSLocAddressSpaceUsage(
+    DiagnosticsEngine &Diag, std::optional<unsigned> MaxNotes) const {
+  std::vector<SLocUsage> SortedUsage = getSLocAddressSpaceUsage(MaxNotes);
+  uint64_t CountedSize = 0;
+  for (const SLocUsage &FileInfo : SortedUsage)
+    CountedSize += FileInfo.TotalSize;
+  auto SortedEnd = SortedUsage.end();
+  if (MaxNotes && SortedUsage.size() > *MaxNotes)
+    SortedEnd = SortedUsage.begin() + *MaxNotes;
 
   // Produce note on sloc address space usage total.
   uint64_t LocalUsage = NextLocalOffset;
@@ -2330,7 +2374,7 @@ void SourceManager::noteSLocAddressSpaceUsage(
 
   // Produce notes on sloc address space usage for each file with a high usage.
   uint64_t ReportedSize = 0;
-  for (auto &[Entry, FileInfo] :
+  for (const SLocUsage &FileInfo :
        llvm::make_range(SortedUsage.begin(), SortedEnd)) {
     Diag.Report(FileInfo.Loc, diag::note_file_sloc_usage)
         << FileInfo.Inclusions << FileInfo.DirectSize
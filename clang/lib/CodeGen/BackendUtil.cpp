@@ -29,6 +29,8 @@
 #include "llvm/Frontend/Driver/CodeGenOptions.h"
 #include "llvm/IR/DataLayout.h"
 #include "llvm/IR/DebugInfo.h"
+#include "llvm/IR/DiagnosticHandler.h"
+#include "llvm/IR/DiagnosticInfo.h"
 #include "llvm/IR/LegacyPassManager.h"
 #include "llvm/IR/Module.h"
 #include "llvm/IR/ModuleSummaryIndex.h"
@@ -47,6 +49,8 @@
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/PrettyStackTrace.h"
 #include "llvm/Support/Program.h"
+#include "llvm/Support/ThreadPool.h"
+#include "llvm/Support/Threading.h"
 #include "llvm/Support/TimeProfiler.h"
 #include "llvm/Support/Timer.h"
 #include "llvm/Support/ToolOutputFile.h"
@@ -85,8 +89,10 @@
 #include "llvm/Transforms/Scalar/JumpThreading.h"
 #include "llvm/Transforms/Utils/Debugify.h"
 #include "llvm/Transforms/Utils/ModuleUtils.h"
+#include "llvm/Transforms/Utils/SplitModule.h"
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <optional>
 using namespace clang;
 using namespace llvm;
@@ -187,6 +193,14 @@ class EmitAssemblyHelper {
                           std::unique_ptr<raw_pwrite_stream> &OS,
                           std::unique_ptr<llvm::ToolOutputFile> &DwoOS);
 
+  /// Split the module into CodeGenOpts.CodeGenPartitions partitions and emit
+  /// an object file for each of them on a thread pool. The first partition is
+  /// written to \p OS, the others next to the main output file.
+  ///
+  /// \return False if the module can't be split, in which case nothing has
+  /// been emitted.
+  bool RunSplitCodegenPipeline(raw_pwrite_stream &OS);
+
   /// Check whether we should emit a module summary for regular LTO.
   /// The module summary should be emitted by default for regular LTO
   /// except for ld64 targets.
@@ -1194,6 +1208,10 @@ void EmitAssemblyHelper::RunOptimizationPipeline(
 void EmitAssemblyHelper::RunCodegenPipeline(
     BackendAction Action, std::unique_ptr<raw_pwrite_stream> &OS,
     std::unique_ptr<llvm::ToolOutputFile> &DwoOS) {
+  if (Action == Backend_EmitObj && CodeGenOpts.CodeGenPartitions > 1 &&
+      !PrintPipelinePasses && RunSplitCodegenPipeline(*OS))
+    return;
+
   // We still use the legacy PM to run the codegen pipeline since the new PM
   // does not work with the codegen pipeline.
   // FIXME: make the new PM work with the codegen pipeline.
@@ -1241,6 +1259,146 @@ void EmitAssemblyHelper::RunCodegenPipeline(
   }
 }
 
+namespace {
+/// Diagnostic handler for the LLVMContext of a codegen partition. Diagnostics
+/// are forwarded to the context of the module being compiled, so that they
+/// are reported through clang's DiagnosticsEngine. Partitions run on worker
+/// threads, so forwarding is serialized with \p Lock.
+class PartitionDiagnosticHandler final : public DiagnosticHandler {
+public:
+  PartitionDiagnosticHandler(LLVMContext &MainCtx, std::mutex &Lock)
+      : MainCtx(MainCtx), Lock(Lock) {}
+
+  bool handleDiagnostics(const DiagnosticInfo &DI) override {
+    std::lock_guard<std::mutex> Guard(Lock);
+    MainCtx.diagnose(DI);
+    return true;
+  }
+
+  bool isAnalysisRemarkEnabled(StringRef PassName) const override {
+    return MainCtx.getDiagHandlerPtr()->isAnalysisRemarkEnabled(PassName);
+  }
+  bool isMissedOptRemarkEnabled(StringRef PassName) const override {
+    return MainCtx.getDiagHandlerPtr()->isMissedOptRemarkEnabled(PassName);
+  }
+  bool isPassedOptRemarkEnabled(StringRef PassName) const override {
+    return MainCtx.getDiagHandlerPtr()->isPassedOptRemarkEnabled(PassName);
+  }
+  bool isAnyRemarkEnabled() const override {
+    return MainCtx.getDiagHandlerPtr()->isAnyRemarkEnabled();
+  }
+
+private:
+  LLVMContext &MainCtx;
+  std::mutex &Lock;
+};
+} // namespace
+
+bool EmitAssemblyHelper::RunSplitCodegenPipeline(raw_pwrite_stream &OS) {
+  // Split DWARF and stdout only have room for a single object, and symbols
+  // defined in module-level inline asm are not visible across partitions.
+  StringRef OutputFile = CI.getFrontendOpts().OutputFile;
+  if (!CodeGenOpts.SplitDwarfOutput.empty() || OutputFile.empty() ||
+      OutputFile == "-" || !TheModule->getModuleInlineAsm().empty())
+    return false;
+
+  PrettyStackTraceString CrashInfo("Code generation");
+  llvm::TimeTraceScope TimeScope("CodeGenPasses");
+  Timer timer;
+  if (CI.getCodeGenOpts().TimePasses) {
+    timer.init("codegen", "Machine code generation", CI.getTimerGroup());
+    CI.getFrontendTimer().yieldTo(timer);
+  }
+
+  unsigned NumPartitions = CodeGenOpts.CodeGenPartitions;
+  DefaultThreadPool CodegenThreadPool(
+      heavyweight_hardware_concurrency(NumPartitions));
+  // The extra partitions are tracked by the CompilerInstance like the main
+  // output, so they are written to temporaries and removed if an error occurs.
+  SmallVector<std::unique_ptr<raw_pwrite_stream>, 4> PartitionFiles;
+  std::mutex DiagLock;
+  LLVMContext &MainCtx = TheModule->getContext();
+  unsigned PartitionIndex = 0;
+
+  const auto HandleModulePartition = [&](std::unique_ptr<Module> MPart) {
+    unsigned Index = PartitionIndex++;
+    raw_pwrite_stream *PartOS = &OS;
+    if (Index != 0) {
+      PartitionFiles.push_back(CI.createOutputFile(
+          (OutputFile + ".part" + Twine(Index) + ".o").str(),
+          /*Binary=*/true, /*RemoveFileOnSignal=*/true,
+          /*UseTemporary=*/true));
+      if (!PartitionFiles.back())
+        return;
+      PartOS = PartitionFiles.back().get();
+    }
+
+    // Each partition is code generated in its own LLVMContext. Serialize it
+    // to bitcode on this thread, before handing it over, to avoid races on
+    // the context that owns TheModule.
+    SmallString<0> BC;
+    raw_svector_ostream BCOS(BC);
+    WriteBitcodeToFile(*MPart, BCOS);
+
+    CodegenThreadPool.async(
+        [&, PartOS](const SmallString<0> &BC) {
+          LLVMContext Ctx;
+          Ctx.setDiagnosticHandler(
+              std::make_unique<PartitionDiagnosticHandler>(MainCtx, DiagLock));
+          Expected<std::unique_ptr<Module>> MOrErr =
+              parseBitcodeFile(MemoryBufferRef(BC.str(), "partition"), Ctx);
+          if (!MOrErr) {
+            Ctx.diagnose(DiagnosticInfoGeneric(
+                "failed to read codegen partition: " +
+                toString(MOrErr.takeError())));
+            return;
+          }
+          std::unique_ptr<Module> MPartInCtx = std::move(*MOrErr);
+
+          std::unique_ptr<TargetMachine> PartTM(
+              TM->getTarget().createTargetMachine(
+                  TM->getTargetTriple().str(), TM->getTargetCPU(),
+                  TM->getTargetFeatureString(), TM->Options,
+                  TM->getRelocationModel(), TM->getCodeModel(),
+                  TM->getOptLevel()));
+          PartTM->setLargeDataThreshold(CodeGenOpts.LargeDataThreshold);
+
+          legacy::PassManager CodeGenPasses;
+          CodeGenPasses.add(createTargetTransformInfoWrapperPass(
+              PartTM->getTargetIRAnalysis()));
+          std::unique_ptr<TargetLibraryInfoImpl> TLII(
+              llvm::driver::createTLII(TargetTriple, CodeGenOpts.getVecLib()));
+          CodeGenPasses.add(new TargetLibraryInfoWrapperPass(*TLII));
+          if (PartTM->addPassesToEmitFile(
+                  CodeGenPasses, *PartOS, /*DwoOut=*/nullptr,
+                  CodeGenFileType::ObjectFile,
+                  /*DisableVerify=*/!CodeGenOpts.VerifyModule)) {
+            Ctx.diagnose(DiagnosticInfoGeneric(
+                "target does not support emitting object files for codegen "
+                "partitions"));
+            return;
+          }
+          CodeGenPasses.run(*MPartInCtx);
+        },
+        // Move BC into the task so it isn't copied.
+        std::move(BC));
+  };
+
+  // Keep local symbols in the partition that uses them, rather than
+  // externalizing them, so the objects export the same symbols as the
+  // unsplit module would.
+  if (!TM->splitModule(*TheModule, NumPartitions, HandleModulePartition))
+    SplitModule(*TheModule, NumPartitions, HandleModulePartition,
+                /*PreserveLocals=*/true);
+
+  // The tasks capture our locals, so wait for them before returning.
+  CodegenThreadPool.wait();
+
+  if (CI.getCodeGenOpts().TimePasses)
+    timer.yieldTo(CI.getFrontendTimer());
+  return true;
+}
+
 void EmitAssemblyHelper::emitAssembly(BackendAction Action,
                                       std::unique_ptr<raw_pwrite_stream> OS,
                                       BackendConsumer *BC) {
@@ -17,10 +17,17 @@
 #include "llvm/Option/ArgList.h"
 #include "llvm/Option/OptSpecifier.h"
 #include "llvm/Option/Option.h"
+#include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/ADT/SmallString.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/ThreadPool.h"
+#include "llvm/Support/Threading.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/TargetParser/Triple.h"
 #include <cassert>
+#include <condition_variable>
+#include <mutex>
 #include <string>
 #include <system_error>
 #include <utility>
@@ -237,9 +244,183 @@ static bool InputsOk(const Command &C,
   return !ActionFailed(&C.getSource(), FailingCommands);
 }
 
+/// Returns whether \p A needs the result of \p Input.
+static bool DependsOn(const Action *A, const Action *Input,
+                      llvm::SmallPtrSetImpl<const Action *> &Visited) {
+  for (const Action *AI : A->inputs())
+    if (AI == Input ||
+        (Visited.insert(AI).second && DependsOn(AI, Input, Visited)))
+      return true;
+  return false;
+}
+
+/// Copies the output captured in \p Path to \p OS and removes the file.
+static void ReplayCapturedOutput(StringRef Path, raw_ostream &OS) {
+  if (Path.empty())
+    return;
+  if (auto Buffer = llvm::MemoryBuffer::getFile(Path)) {
+    OS << (*Buffer)->getBuffer();
+    OS.flush();
+  }
+  llvm::sys::fs::remove(Path);
+}
+
+void Compilation::ExecuteJobsInParallel(const JobList &Jobs,
+                                        FailingCommandList &FailingCommands,
+                                        unsigned NumThreads) const {
+  SmallVector<const Command *, 16> Commands;
+  for (const auto &Job : Jobs)
+    Commands.push_back(&Job);
+  unsigned NumJobs = Commands.size();
+
+  // Jobs are created after the jobs producing their inputs, so a job can only
+  // depend on earlier ones. Jobs created for the same action are kept in
+  // order as well.
+  std::vector<SmallVector<unsigned, 4>> Dependents(NumJobs);
+  std::vector<unsigned> NumPendingInputs(NumJobs, 0);
+  for (unsigned I = 0; I != NumJobs; ++I) {
+    const Action *Source = &Commands[I]->getSource();
+    for (unsigned J = 0; J != I; ++J) {
+      llvm::SmallPtrSet<const Action *, 16> Visited;
+      const Action *Input = &Commands[J]->getSource();
+      if (Source == Input || DependsOn(Source, Input, Visited)) {
+        Dependents[J].push_back(I);
+        ++NumPendingInputs[I];
+      }
+    }
+  }
+
+  struct JobOutcome {
+    bool Executed = false;
+    int Res = 0;
+    std::string Error;
+    bool ExecutionFailed = false;
+    const Command *FailingCommand = nullptr;
+    SmallString<128> OutputPath;
+    SmallString<128> ErrorPath;
+  };
+  std::vector<JobOutcome> Outcomes(NumJobs);
+
+  enum class JobState { Waiting, Running, Done };
+  std::vector<JobState> States(NumJobs, JobState::Waiting);
+
+  // Failures seen so far, in the order the jobs finished. They are only used
+  // to skip the jobs depending on them; FailingCommands is filled in job
+  // order.
+  SmallVector<std::pair<int, const Command *>, 4> Failures(
+      FailingCommands.begin(), FailingCommands.end());
+
+  auto MarkDone = [&](unsigned I) {
+    States[I] = JobState::Done;
+    for (unsigned D : Dependents[I])
+      --NumPendingInputs[D];
+  };
+
+  std::mutex Mutex;
+  std::condition_variable JobFinished;
+  std::vector<unsigned> FinishedJobs;
+  llvm::DefaultThreadPool Pool(llvm::hardware_concurrency(NumThreads));
+  unsigned NumRunning = 0;
+  unsigned NextToReplay = 0;
+
+  while (true) {
+    // Start the ready jobs, earliest first.
+    for (unsigned I = 0; I != NumJobs && NumRunning < NumThreads; ++I) {
+      if (States[I] != JobState::Waiting || NumPendingInputs[I])
+        continue;
+      const Command &C = *Commands[I];
+      JobOutcome &Outcome = Outcomes[I];
+      if (!InputsOk(C, Failures)) {
+        MarkDone(I);
+        continue;
+      }
+
+      // Capture stdout and stderr unless we can't create the files, in which
+      // case the output simply goes through.
+      std::array<std::optional<StringRef>, 3> JobRedirects;
+      if (!llvm::sys::fs::createTemporaryFile("clang-job", "out",
+                                              Outcome.OutputPath))
+        JobRedirects[1] = Outcome.OutputPath.str();
+      if (!llvm::sys::fs::createTemporaryFile("clang-job", "err",
+                                              Outcome.ErrorPath))
+        JobRedirects[2] = Outcome.ErrorPath.str();
+
+      Outcome.Executed = true;
+      States[I] = JobState::Running;
+      ++NumRunning;
+      Pool.async([&, I, JobRedirects] {
+        JobOutcome &Outcome = Outcomes[I];
+        Outcome.Res = Commands[I]->Execute(JobRedirects, &Outcome.Error,
+                                           &Outcome.ExecutionFailed);
+        std::lock_guard<std::mutex> Lock(Mutex);
+        FinishedJobs.push_back(I);
+        JobFinished.notify_one();
+      });
+    }
+
+    // Replay the output of the finished jobs in job order, and report their
+    // results the way ExecuteCommand() does. Command lines are logged here,
+    // rather than when the jobs start, so that -v output is in job order too.
+    for (; NextToReplay != NumJobs && States[NextToReplay] == JobState::Done;
+         ++NextToReplay) {
+      const Command &C = *Commands[NextToReplay];
+      JobOutcome &Outcome = Outcomes[NextToReplay];
+      if (Outcome.Executed) {
+        const Command *LogFailure = nullptr;
+        if (int Res = ExecuteCommand(C, LogFailure, /*LogOnly=*/true))
+          FailingCommands.push_back(std::make_pair(Res, LogFailure));
+      }
+      ReplayCapturedOutput(Outcome.OutputPath, llvm::outs());
+      ReplayCapturedOutput(Outcome.ErrorPath, llvm::errs());
+      if (Outcome.Executed) {
+        if (PostCallback)
+          PostCallback(C, Outcome.Res);
+        if (!Outcome.Error.empty()) {
+          assert(Outcome.Res && "Error string set with 0 result code!");
+          getDriver().Diag(diag::err_drv_command_failure) << Outcome.Error;
+        }
+      }
+      if (int Res = Outcome.ExecutionFailed ? 1 : Outcome.Res)
+        FailingCommands.push_back(std::make_pair(Res, Outcome.FailingCommand));
+    }
+    if (NextToReplay == NumJobs)
+      break;
+
+    assert(NumRunning && "Waiting jobs without any running job!");
+    std::vector<unsigned> Finished;
+    {
+      std::unique_lock<std::mutex> Lock(Mutex);
+      JobFinished.wait(Lock, [&] { return !FinishedJobs.empty(); });
+      std::swap(Finished, FinishedJobs);
+    }
+    for (unsigned I : Finished) {
+      JobOutcome &Outcome = Outcomes[I];
+      if (Outcome.Res)
+        Outcome.FailingCommand = Commands[I];
+      if (int Res = Outcome.ExecutionFailed ? 1 : Outcome.Res)
+        Failures.push_back(std::make_pair(Res, Outcome.FailingCommand));
+      --NumRunning;
+      MarkDone(I);
+    }
+  }
+}
+
 void Compilation::ExecuteJobs(const JobList &Jobs,
                               FailingCommandList &FailingCommands,
                               bool LogOnly) const {
+  // Independent jobs may run in parallel when asked for, as long as nothing
+  // relies on them running one at a time: cl driver mode stops at the first
+  // failure. Driver::BuildJobs() runs cc1 out of process when parallel jobs
+  // are requested, as in-process jobs share this process's state.
+  unsigned NumThreads = NumParallelJobs;
+  if (NumThreads > 1 && Jobs.size() > 1 && !LogOnly && !ForDiagnostics &&
+      !TheDriver.IsCLMode() && Redirects.empty()) {
+    assert(llvm::none_of(Jobs, [](const Command &C) { return C.InProcess; }) &&
+           "In-process jobs can't run in parallel!");
+    ExecuteJobsInParallel(Jobs, FailingCommands, NumThreads);
+    return;
+  }
+
   // According to UNIX standard, driver need to continue compiling all the
   // inputs on the command line even one of them failed.
   // In all but CLMode, execute all the jobs unless the necessary inputs for the
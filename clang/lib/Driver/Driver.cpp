@@ -91,6 +91,7 @@
 #include "llvm/Support/Program.h"
 #include "llvm/Support/Regex.h"
 #include "llvm/Support/StringSaver.h"
+#include "llvm/Support/Threading.h"
 #include "llvm/Support/VirtualFileSystem.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/TargetParser/Host.h"
@@ -5195,9 +5196,22 @@ void Driver::BuildJobs(Compilation &C) const {
                        /*TargetDeviceOffloadKind*/ Action::OFK_None);
   }
 
+  if (const Arg *A = C.getArgs().getLastArg(options::OPT_parallel_jobs_EQ)) {
+    unsigned NumJobs;
+    if (StringRef(A->getValue()).getAsInteger(10, NumJobs))
+      Diag(diag::err_drv_invalid_int_value)
+          << A->getAsString(C.getArgs()) << A->getValue();
+    else
+      C.setNumParallelJobs(
+          NumJobs ? NumJobs
+                  : llvm::hardware_concurrency().compute_thread_count());
+  }
+
   // If we have more than one job, then disable integrated-cc1 for now. Do this
-  // also when we need to report process execution statistics.
-  if (C.getJobs().size() > 1 || CCPrintProcessStats)
+  // also when we need to report process execution statistics, or when jobs
+  // may run in parallel, as in-process jobs share this process's state.
+  if (C.getJobs().size() > 1 || CCPrintProcessStats ||
+      C.getNumParallelJobs() > 1)
     for (auto &J : C.getJobs())
       J.InProcess = false;
 
@@ -6380,6 +6380,7 @@ void Clang::ConstructJob(Compilation &C, const JobAction &JA,
   CmdArgs.push_back(D.ResourceDir.c_str());
 
   Args.AddLastArg(CmdArgs, options::OPT_working_directory);
+  Args.AddLastArg(CmdArgs, options::OPT_fheader_lookup_cache_EQ);
 
   // Add preprocessing options like -I, -D, etc. if we are using the
   // preprocessor.
@@ -6557,6 +6558,9 @@ void Clang::ConstructJob(Compilation &C, const JobAction &JA,
   if (Args.hasArg(options::OPT_fexperimental_new_constant_interpreter))
     CmdArgs.push_back("-fexperimental-new-constant-interpreter");
 
+  if (Args.hasArg(options::OPT_fexperimental_constexpr_call_memoization))
+    CmdArgs.push_back("-fexperimental-constexpr-call-memoization");
+
   if (Arg *A = Args.getLastArg(options::OPT_fbracket_depth_EQ)) {
     CmdArgs.push_back("-fbracket-depth");
     CmdArgs.push_back(A->getValue());
@@ -6954,6 +6958,7 @@ void Clang::ConstructJob(Compilation &C, const JobAction &JA,
   if (const char *Name = C.getTimeTraceFile(&JA)) {
     CmdArgs.push_back(Args.MakeArgString("-ftime-trace=" + Twine(Name)));
     Args.AddLastArg(CmdArgs, options::OPT_ftime_trace_granularity_EQ);
+    Args.AddLastArg(CmdArgs, options::OPT_ftime_trace_max_events_EQ);
     Args.AddLastArg(CmdArgs, options::OPT_ftime_trace_verbose);
   }
 
@@ -7376,11 +7381,15 @@ void Clang::ConstructJob(Compilation &C, const JobAction &JA,
   if (Args.hasFlag(options::OPT_fpch_validate_input_files_content,
                    options::OPT_fno_pch_validate_input_files_content, false))
     CmdArgs.push_back("-fvalidate-ast-input-files-content");
+  bool PCHCodegen = Args.hasFlag(options::OPT_fpch_codegen,
+                                 options::OPT_fno_pch_codegen, false);
+  // Instantiating templates while building the PCH lets every TU reuse the
+  // instantiations, and with -fpch-codegen their code is emitted only once,
+  // into the PCH's object file.
   if (Args.hasFlag(options::OPT_fpch_instantiate_templates,
-                   options::OPT_fno_pch_instantiate_templates, false))
+                   options::OPT_fno_pch_instantiate_templates, PCHCodegen))
     CmdArgs.push_back("-fpch-instantiate-templates");
-  if (Args.hasFlag(options::OPT_fpch_codegen, options::OPT_fno_pch_codegen,
-                   false))
+  if (PCHCodegen)
     CmdArgs.push_back("-fmodules-codegen");
   if (Args.hasFlag(options::OPT_fpch_debuginfo, options::OPT_fno_pch_debuginfo,
                    false))
@@ -9171,6 +9180,7 @@ void LinkerWrapper::ConstructJob(Compilation &C, const JobAction &JA,
       OPT_ftime_trace,
       OPT_ftime_trace_EQ,
       OPT_ftime_trace_granularity_EQ,
+      OPT_ftime_trace_max_events_EQ,
       OPT_ftime_trace_verbose,
       OPT_opt_record_file,
       OPT_opt_record_format,
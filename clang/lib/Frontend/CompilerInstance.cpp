@@ -14,6 +14,7 @@
 #include "clang/Basic/Diagnostic.h"
 #include "clang/Basic/DiagnosticOptions.h"
 #include "clang/Basic/FileManager.h"
+#include "clang/Basic/FileSystemStatCache.h"
 #include "clang/Basic/LangStandard.h"
 #include "clang/Basic/SourceManager.h"
 #include "clang/Basic/Stack.h"
@@ -165,6 +166,7 @@ llvm::vfs::FileSystem &CompilerInstance::getVirtualFileSystem() const {
 
 void CompilerInstance::setFileManager(FileManager *Value) {
   FileMgr = Value;
+  HeaderLookupCache = nullptr;
 }
 
 void CompilerInstance::setSourceManager(SourceManager *Value) {
@@ -387,6 +389,13 @@ FileManager *CompilerInstance::createFileManager(
     VFS =
         llvm::makeIntrusiveRefCnt<llvm::vfs::TracingFileSystem>(std::move(VFS));
   FileMgr = new FileManager(getFileSystemOpts(), std::move(VFS));
+  HeaderLookupCache = nullptr;
+  if (!getFileSystemOpts().HeaderLookupCachePath.empty()) {
+    auto Cache = std::make_unique<PersistentNegativeStatCache>(
+        getFileSystemOpts().HeaderLookupCachePath);
+    HeaderLookupCache = Cache.get();
+    FileMgr->setStatCache(std::move(Cache));
+  }
   return FileMgr.get();
 }
 
@@ -1060,6 +1069,11 @@ bool CompilerInstance::ExecuteAction(FrontendAction &Act) {
     }
   }
 
+  // Write back the failed lookups now; with -disable-free the file manager,
+  // and the cache it owns, are never destroyed.
+  if (HeaderLookupCache)
+    HeaderLookupCache->save();
+
   printDiagnosticStats();
 
   if (getFrontendOpts().ShowStats) {
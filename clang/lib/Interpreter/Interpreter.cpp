@@ -47,6 +47,7 @@
 #include "llvm/ExecutionEngine/JITSymbol.h"
 #include "llvm/ExecutionEngine/Orc/LLJIT.h"
 #include "llvm/IR/Module.h"
+#include "llvm/Support/CodeGen.h"
 #include "llvm/Support/Errc.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/raw_ostream.h"
@@ -597,6 +598,13 @@ llvm::Error Interpreter::CreateExecutor() {
     auto JTMB = createJITTargetMachineBuilder(TT);
     if (!JTMB)
       return JTMB.takeError();
+    // Generate code at the optimization level the input is compiled at. The
+    // JITTargetMachineBuilder defaults to CodeGenOptLevel::Default, which
+    // spends most of the latency of an -O0 (the default) input in backend
+    // optimizations.
+    if (std::optional<llvm::CodeGenOptLevel> Level = llvm::CodeGenOpt::getLevel(
+            getCompilerInstance()->getCodeGenOpts().OptimizationLevel))
+      JTMB->setCodeGenOptLevel(*Level);
     auto JB = IncrementalExecutor::createDefaultJITBuilder(std::move(*JTMB));
     if (!JB)
       return JB.takeError();
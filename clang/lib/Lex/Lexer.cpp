@@ -50,6 +50,15 @@
 #include <nmmintrin.h>
 #endif
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#elif __ALTIVEC__
+#include <altivec.h>
+#undef bool
+#endif
+
 using namespace clang;
 
 //===----------------------------------------------------------------------===//
@@ -2208,6 +2217,51 @@ const char *Lexer::LexUDSuffix(Token &Result, const char *CurPtr,
   return CurPtr;
 }
 
+/// Skip the bytes starting at \p CurPtr that are not nul or newline, none of
+/// \p Stops and, if \p StopAtNonASCII is set, ASCII, 16 bytes at a time.
+/// Returns a pointer to the first such byte, or to the last bytes of the
+/// buffer that don't fill a chunk, which the caller must scan character by
+/// character.
+template <char... Stops>
+static const char *skipPlainChunks(const char *CurPtr, const char *BufferEnd,
+                                   bool StopAtNonASCII) {
+#ifdef __SSE2__
+  while (BufferEnd - CurPtr >= 16) {
+    __m128i Chunk = _mm_loadu_si128((const __m128i *)CurPtr);
+    __m128i Special =
+        _mm_or_si128(_mm_cmpeq_epi8(Chunk, _mm_setzero_si128()),
+                     _mm_or_si128(_mm_cmpeq_epi8(Chunk, _mm_set1_epi8('\n')),
+                                  _mm_cmpeq_epi8(Chunk, _mm_set1_epi8('\r'))));
+    ((Special = _mm_or_si128(Special,
+                             _mm_cmpeq_epi8(Chunk, _mm_set1_epi8(Stops)))),
+     ...);
+    int Mask = _mm_movemask_epi8(Special);
+    if (StopAtNonASCII)
+      Mask |= _mm_movemask_epi8(Chunk);
+    if (Mask != 0)
+      return CurPtr + llvm::countr_zero<unsigned>(Mask);
+    CurPtr += 16;
+  }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+  while (BufferEnd - CurPtr >= 16) {
+    uint8x16_t Chunk = vld1q_u8((const uint8_t *)CurPtr);
+    uint8x16_t Special =
+        vorrq_u8(vceqzq_u8(Chunk), vorrq_u8(vceqq_u8(Chunk, vdupq_n_u8('\n')),
+                                            vceqq_u8(Chunk, vdupq_n_u8('\r'))));
+    ((Special = vorrq_u8(Special, vceqq_u8(Chunk, vdupq_n_u8(Stops)))), ...);
+    if (StopAtNonASCII)
+      Special = vorrq_u8(Special, vcgeq_u8(Chunk, vdupq_n_u8(0x80)));
+    // Narrow each byte of the comparison to a nibble to find the first match.
+    uint64_t Mask = vget_lane_u64(
+        vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(Special), 4)), 0);
+    if (Mask != 0)
+      return CurPtr + llvm::countr_zero(Mask) / 4;
+    CurPtr += 16;
+  }
+#endif
+  return CurPtr;
+}
+
 /// LexStringLiteral - Lex the remainder of a string literal, after having lexed
 /// either " or L" or u8" or u" or U".
 bool Lexer::LexStringLiteral(Token &Result, const char *CurPtr,
@@ -2223,6 +2277,10 @@ bool Lexer::LexStringLiteral(Token &Result, const char *CurPtr,
     Diag(BufferPtr, LangOpts.CPlusPlus ? diag::warn_cxx98_compat_unicode_literal
                                        : diag::warn_c99_compat_unicode_literal);
 
+  // Characters that getAndAdvanceChar may have to decode ('\\' and '?' for
+  // trigraphs) or that end the literal stop the chunked scan.
+  CurPtr = skipPlainChunks<'"', '\\', '?'>(CurPtr, BufferEnd,
+                                            /*StopAtNonASCII=*/false);
   char C = getAndAdvanceChar(CurPtr, Result);
   while (C != '"') {
     // Skip escaped characters.  Escaped newlines will already be processed by
@@ -2251,6 +2309,8 @@ bool Lexer::LexStringLiteral(Token &Result, const char *CurPtr,
 
       NulCharacter = CurPtr-1;
     }
+    CurPtr = skipPlainChunks<'"', '\\', '?'>(CurPtr, BufferEnd,
+                                              /*StopAtNonASCII=*/false);
     C = getAndAdvanceChar(CurPtr, Result);
   }
 
@@ -2612,6 +2672,12 @@ bool Lexer::SkipLineComment(Token &Result, const char *CurPtr,
 
   char C;
   while (true) {
+    const char *ChunksEnd =
+        skipPlainChunks<>(CurPtr, BufferEnd, /*StopAtNonASCII=*/true);
+    if (ChunksEnd != CurPtr) {
+      CurPtr = ChunksEnd;
+      UnicodeDecodingAlreadyDiagnosed = false;
+    }
     C = *CurPtr;
     // Skip over characters in the fast loop.
     while (isASCII(C) && C != 0 &&   // Potentially EOF.
@@ -2850,13 +2916,6 @@ static bool isEndOfBlockCommentWithEscapedNewLine(const char *CurPtr, Lexer *L,
   return true;
 }
 
-#ifdef __SSE2__
-#include <emmintrin.h>
-#elif __ALTIVEC__
-#include <altivec.h>
-#undef bool
-#endif
-
 /// We have just read from input the / and * characters that started a comment.
 /// Read until we find the * and / characters that terminate the comment.
 /// Note that we don't bother decoding trigraphs or escaped newlines in block
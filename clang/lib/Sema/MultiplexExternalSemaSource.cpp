@@ -298,6 +298,13 @@ void MultiplexExternalSemaSource::ReadDeclsToCheckForDeferredDiags(
     Sources[i]->ReadDeclsToCheckForDeferredDiags(Decls);
 }
 
+void MultiplexExternalSemaSource::ReadSatisfiedConstraints(
+    const NamedDecl *Owner,
+    SmallVectorImpl<SmallVector<TemplateArgument, 4>> &SatisfiedArgs) {
+  for (size_t i = 0; i < Sources.size(); ++i)
+    Sources[i]->ReadSatisfiedConstraints(Owner, SatisfiedArgs);
+}
+
 void MultiplexExternalSemaSource::ReadUnusedLocalTypedefNameCandidates(
     llvm::SmallSetVector<const TypedefNameDecl *, 4> &Decls) {
   for(size_t i = 0; i < Sources.size(); ++i)
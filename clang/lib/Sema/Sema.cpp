@@ -608,6 +608,8 @@ void Sema::addExternalSource(ExternalSemaSource *E) {
 void Sema::PrintStats() const {
   llvm::errs() << "\n*** Semantic Analysis Stats:\n";
   llvm::errs() << NumSFINAEErrors << " SFINAE diagnostics trapped.\n";
+  llvm::errs() << NumConstraintSatisfactionChecks
+               << " constraint satisfaction checks evaluated.\n";
 
   BumpAlloc.PrintStats();
   AnalysisWarnings.PrintStats();
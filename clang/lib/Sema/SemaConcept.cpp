@@ -613,6 +613,27 @@ static bool CheckConstraintSatisfaction(
   return false;
 }
 
+bool Sema::loadExternalConstraintSatisfactions(const NamedDecl *Template) {
+  if (!ExternalSource || !Template->getCanonicalDecl()->isFromASTFile())
+    return false;
+
+  SmallVector<SmallVector<TemplateArgument, 4>, 4> SatisfiedArgs;
+  ExternalSource->ReadSatisfiedConstraints(Template->getCanonicalDecl(),
+                                           SatisfiedArgs);
+  for (ArrayRef<TemplateArgument> Args : SatisfiedArgs) {
+    llvm::FoldingSetNodeID ID;
+    ConstraintSatisfaction::Profile(ID, Context, Template, Args);
+    void *InsertPos;
+    if (SatisfactionCache.FindNodeOrInsertPos(ID, InsertPos))
+      continue;
+    auto *Satisfaction = new ConstraintSatisfaction(Template, Args);
+    Satisfaction->IsSatisfied = true;
+    // Note that entries of SatisfactionCache are deleted in Sema's destructor.
+    SatisfactionCache.InsertNode(Satisfaction, InsertPos);
+  }
+  return !SatisfiedArgs.empty();
+}
+
 bool Sema::CheckConstraintSatisfaction(
     const NamedDecl *Template, ArrayRef<const Expr *> ConstraintExprs,
     llvm::SmallVectorImpl<Expr *> &ConvertedConstraints,
@@ -643,14 +664,28 @@ bool Sema::CheckConstraintSatisfaction(
     FlattenedArgs.insert(FlattenedArgs.end(), List.Args.begin(),
                          List.Args.end());
 
+  // The cache is keyed on the canonical declaration and canonical arguments.
   llvm::FoldingSetNodeID ID;
   ConstraintSatisfaction::Profile(ID, Context, Template, FlattenedArgs);
   void *InsertPos;
-  if (auto *Cached = SatisfactionCache.FindNodeOrInsertPos(ID, InsertPos)) {
-    OutSatisfaction = *Cached;
-    return false;
+  ConstraintSatisfaction *Cached =
+      SatisfactionCache.FindNodeOrInsertPos(ID, InsertPos);
+  if (!Cached && loadExternalConstraintSatisfactions(Template))
+    Cached = SatisfactionCache.FindNodeOrInsertPos(ID, InsertPos);
+  if (Cached) {
+    // An unsatisfied result holds the substituted constraints for diagnostics,
+    // which are only accurate for the arguments as they were written.
+    if (Cached->IsSatisfied ||
+        llvm::equal(Cached->getTemplateArgs(), FlattenedArgs,
+                    [](const TemplateArgument &A, const TemplateArgument &B) {
+                      return A.structurallyEquals(B);
+                    })) {
+      OutSatisfaction = *Cached;
+      return false;
+    }
   }
 
+  ++NumConstraintSatisfactionChecks;
   auto Satisfaction =
       std::make_unique<ConstraintSatisfaction>(Template, FlattenedArgs);
   if (::CheckConstraintSatisfaction(*this, Template, ConstraintExprs,
@@ -660,6 +695,12 @@ bool Sema::CheckConstraintSatisfaction(
     return true;
   }
 
+  // A differently spelled check already owns the cache entry; keep it.
+  if (Cached) {
+    OutSatisfaction = *Satisfaction;
+    return false;
+  }
+
   if (auto *Cached = SatisfactionCache.FindNodeOrInsertPos(ID, InsertPos)) {
     // The evaluation of this constraint resulted in us trying to re-evaluate it
     // recursively. This isn't really possible, except we try to form a
@@ -7040,6 +7040,35 @@ void Sema::AddOverloadCandidate(
     return;
   }
 
+  // Reject candidates with the wrong arity before the constructor checks
+  // below, which may need to walk (and complete) class hierarchies.
+  unsigned NumParams = Proto->getNumParams();
+
+  // (C++ 13.3.2p2): A candidate function having fewer than m
+  // parameters is viable only if it has an ellipsis in its parameter
+  // list (8.3.5).
+  if (TooManyArguments(NumParams, Args.size(), PartialOverloading) &&
+      !Proto->isVariadic() &&
+      shouldEnforceArgLimit(PartialOverloading, Function)) {
+    Candidate.Viable = false;
+    Candidate.FailureKind = ovl_fail_too_many_arguments;
+    return;
+  }
+
+  // (C++ 13.3.2p2): A candidate function having more than m parameters
+  // is viable only if the (m+1)st parameter has a default argument
+  // (8.3.6). For the purposes of overload resolution, the
+  // parameter list is truncated on the right, so that there are
+  // exactly m parameters.
+  unsigned MinRequiredArgs = Function->getMinRequiredArguments();
+  if (!AggregateCandidateDeduction && Args.size() < MinRequiredArgs &&
+      !PartialOverloading) {
+    // Not enough arguments.
+    Candidate.Viable = false;
+    Candidate.FailureKind = ovl_fail_too_few_arguments;
+    return;
+  }
+
   if (Constructor) {
     // C++ [class.copy]p3:
     //   A member function template is never instantiated to perform the copy
@@ -7086,33 +7115,6 @@ void Sema::AddOverloadCandidate(
     }
   }
 
-  unsigned NumParams = Proto->getNumParams();
-
-  // (C++ 13.3.2p2): A candidate function having fewer than m
-  // parameters is viable only if it has an ellipsis in its parameter
-  // list (8.3.5).
-  if (TooManyArguments(NumParams, Args.size(), PartialOverloading) &&
-      !Proto->isVariadic() &&
-      shouldEnforceArgLimit(PartialOverloading, Function)) {
-    Candidate.Viable = false;
-    Candidate.FailureKind = ovl_fail_too_many_arguments;
-    return;
-  }
-
-  // (C++ 13.3.2p2): A candidate function having more than m parameters
-  // is viable only if the (m+1)st parameter has a default argument
-  // (8.3.6). For the purposes of overload resolution, the
-  // parameter list is truncated on the right, so that there are
-  // exactly m parameters.
-  unsigned MinRequiredArgs = Function->getMinRequiredArguments();
-  if (!AggregateCandidateDeduction && Args.size() < MinRequiredArgs &&
-      !PartialOverloading) {
-    // Not enough arguments.
-    Candidate.Viable = false;
-    Candidate.FailureKind = ovl_fail_too_few_arguments;
-    return;
-  }
-
   // (CUDA B.1): Check for invalid calls between targets.
   if (getLangOpts().CUDA) {
     const FunctionDecl *Caller = getCurFunctionDecl(/*AllowLambda=*/true);
@@ -3667,6 +3667,10 @@ Sema::InstantiateClass(SourceLocation PointOfInstantiation,
       M.File = SourceMgr.getFilename(Loc);
       M.Line = SourceMgr.getExpansionLineNumber(Loc);
     }
+    // Summarize the cost of all the instantiations of a template.
+    M.Group = PatternDef->getQualifiedNameAsString();
+    M.GroupFile = SourceMgr.getFilename(
+        SourceMgr.getExpansionLoc(PatternDef->getLocation()));
     return M;
   });
 
@@ -5112,6 +5112,10 @@ void Sema::InstantiateFunctionDefinition(SourceLocation PointOfInstantiation,
       M.File = SourceMgr.getFilename(Loc);
       M.Line = SourceMgr.getExpansionLineNumber(Loc);
     }
+    // Summarize the cost of all the instantiations of a template.
+    M.Group = PatternDecl->getQualifiedNameAsString();
+    M.GroupFile = SourceMgr.getFilename(
+        SourceMgr.getExpansionLoc(PatternDecl->getLocation()));
     return M;
   });
 
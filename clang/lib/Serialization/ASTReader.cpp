@@ -4128,6 +4128,21 @@ llvm::Error ASTReader::ReadASTBlock(ModuleFile &F,
         DeclsWithEffectsToVerify.push_back(ReadDeclID(F, Record, I));
       break;
 
+    case SATISFIED_CONSTRAINTS:
+      for (unsigned I = 0, N = Record.size(); I != N; /*in loop*/) {
+        GlobalDeclID Owner = ReadDeclID(F, Record, I);
+        if (I == N || Record[I] > N - I - 1)
+          return llvm::createStringError(std::errc::illegal_byte_sequence,
+                                         "Invalid SATISFIED_CONSTRAINTS record");
+        unsigned NumArgs = Record[I++];
+        SatisfiedConstraint &Entry =
+            SatisfiedConstraints[Owner].emplace_back();
+        Entry.F = &F;
+        Entry.ArgTypes.append(Record.begin() + I, Record.begin() + I + NumArgs);
+        I += NumArgs;
+      }
+      break;
+
     case OPENCL_EXTENSIONS:
       for (unsigned I = 0, E = Record.size(); I != E; ) {
         auto Name = ReadString(Record, I);
@@ -7885,10 +7900,12 @@ void ASTReader::CompleteRedeclChain(const Decl *D) {
   }
 
   if (Template) {
-    // For partitial specialization, load all the specializations for safety.
+    // The redeclarations of a partial specialization are partial
+    // specializations, which can't be looked up by hash. Load all of them, but
+    // leave the (often far more numerous) full specializations alone.
     if (isa<ClassTemplatePartialSpecializationDecl,
             VarTemplatePartialSpecializationDecl>(D))
-      Template->loadLazySpecializationsImpl();
+      Template->loadLazySpecializationsImpl(/*OnlyPartial=*/true);
     else
       Template->loadLazySpecializationsImpl(Args);
   }
@@ -9318,6 +9335,31 @@ void ASTReader::ReadWeakUndeclaredIdentifiers(
   WeakUndeclaredIdentifiers.clear();
 }
 
+void ASTReader::ReadSatisfiedConstraints(
+    const NamedDecl *Owner,
+    SmallVectorImpl<SmallVector<TemplateArgument, 4>> &SatisfiedArgs) {
+  if (SatisfiedConstraints.empty())
+    return;
+
+  // The checks may have been recorded against any redeclaration that was
+  // canonical in the AST file that recorded them.
+  for (const Decl *Redecl : Owner->redecls()) {
+    if (!Redecl->isFromASTFile())
+      continue;
+    auto It = SatisfiedConstraints.find(Redecl->getGlobalID());
+    if (It == SatisfiedConstraints.end())
+      continue;
+    // Hand each entry out only once.
+    SmallVector<SatisfiedConstraint, 1> Entries = std::move(It->second);
+    SatisfiedConstraints.erase(It);
+    for (const SatisfiedConstraint &Entry : Entries) {
+      SmallVector<TemplateArgument, 4> &Args = SatisfiedArgs.emplace_back();
+      for (serialization::TypeID ID : Entry.ArgTypes)
+        Args.push_back(TemplateArgument(getLocalType(*Entry.F, ID)));
+    }
+  }
+}
+
 void ASTReader::ReadUsedVTables(SmallVectorImpl<ExternalVTableUse> &VTables) {
   for (unsigned Idx = 0, N = VTableUses.size(); Idx < N; /* In loop */) {
     ExternalVTableUse VT;
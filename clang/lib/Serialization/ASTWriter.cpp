@@ -974,6 +974,7 @@ void ASTWriter::WriteBlockInfoBlock() {
   RECORD(PP_ASSUME_NONNULL_LOC);
   RECORD(PP_UNSAFE_BUFFER_USAGE);
   RECORD(VTABLES_TO_EMIT);
+  RECORD(SATISFIED_CONSTRAINTS);
 
   // SourceManager Block.
   BLOCK(SOURCE_MANAGER_BLOCK);
@@ -6111,6 +6112,7 @@ ASTFileSignature ASTWriter::WriteASTCore(Sema *SemaPtr, StringRef isysroot,
     WritePackPragmaOptions(*SemaPtr);
     WriteFloatControlPragmaOptions(*SemaPtr);
     WriteDeclsWithEffectsToVerify(*SemaPtr);
+    WriteSatisfiedConstraints(*SemaPtr);
   }
 
   // Some simple statistics
@@ -6816,6 +6818,53 @@ TypeID ASTWriter::GetOrCreateTypeID(ASTContext &Context, QualType T) {
   });
 }
 
+/// Write the satisfied constraint checks in Sema's satisfaction cache whose
+/// owner and argument types were emitted, so importers don't redo them.
+void ASTWriter::WriteSatisfiedConstraints(Sema &SemaRef) {
+  ASTContext &Context = SemaRef.Context;
+  RecordData Record;
+  RecordData TypeIDs;
+  for (const ConstraintSatisfaction &Satisfaction : SemaRef.SatisfactionCache) {
+    if (!Satisfaction.IsSatisfied || Satisfaction.ContainsErrors)
+      continue;
+    const NamedDecl *Owner =
+        cast<NamedDecl>(Satisfaction.getConstraintOwner()->getCanonicalDecl());
+    if (!wasDeclEmitted(Owner))
+      continue;
+
+    // Only argument lists made up of types are recorded, and only if those
+    // types were already written; it's too late to emit new ones.
+    TypeIDs.clear();
+    bool AllEmitted = true;
+    for (const TemplateArgument &Arg : Satisfaction.getTemplateArgs()) {
+      if (Arg.getKind() != TemplateArgument::Type || Arg.isDependent()) {
+        AllEmitted = false;
+        break;
+      }
+      TypeIDs.push_back(MakeTypeID(
+          Context, Context.getCanonicalType(Arg.getAsType()),
+          [&](QualType T) -> TypeIdx {
+            auto It = TypeIdxs.find(T);
+            if (It == TypeIdxs.end() || It->second.getValue() == 0) {
+              AllEmitted = false;
+              return TypeIdx();
+            }
+            return It->second;
+          }));
+      if (!AllEmitted)
+        break;
+    }
+    if (!AllEmitted)
+      continue;
+
+    AddDeclRef(Owner, Record);
+    Record.push_back(TypeIDs.size());
+    Record.append(TypeIDs.begin(), TypeIDs.end());
+  }
+  if (!Record.empty())
+    Stream.EmitRecord(SATISFIED_CONSTRAINTS, Record);
+}
+
 void ASTWriter::AddEmittedDeclRef(const Decl *D, RecordDataImpl &Record) {
   if (!wasDeclEmitted(D))
     return;
@@ -27,6 +27,7 @@
 #include "llvm/ADT/FoldingSet.h"
 #include "llvm/ADT/PointerUnion.h"
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/Support/Casting.h"
 #include <cassert>
 #include <memory>
@@ -35,6 +36,16 @@
 using namespace clang;
 using namespace ento;
 
+#define DEBUG_TYPE "ExplodedGraph"
+
+STATISTIC(NumNodesCreated, "The # of exploded nodes created");
+STATISTIC(NumNodesReclaimed,
+          "The # of exploded nodes reclaimed by graph trimming");
+STATISTIC(NumNodesRecycled,
+          "The # of new exploded nodes that reused reclaimed memory");
+STATISTIC(MaxLiveNodes,
+          "The maximum # of exploded nodes alive in a graph at once");
+
 //===----------------------------------------------------------------------===//
 // Cleanup.
 //===----------------------------------------------------------------------===//
@@ -163,6 +174,7 @@ void ExplodedGraph::collectNode(ExplodedNode *node) {
   FreeNodes.push_back(node);
   Nodes.RemoveNode(node);
   --NumNodes;
+  ++NumNodesReclaimed;
   node->~ExplodedNode();
 }
 
@@ -406,6 +418,7 @@ ExplodedNode *ExplodedGraph::getNode(const ProgramPoint &L,
     if (!FreeNodes.empty()) {
       V = FreeNodes.back();
       FreeNodes.pop_back();
+      ++NumNodesRecycled;
     }
     else {
       // Allocate a new node.
@@ -413,6 +426,8 @@ ExplodedNode *ExplodedGraph::getNode(const ProgramPoint &L,
     }
 
     ++NumNodes;
+    ++NumNodesCreated;
+    MaxLiveNodes.updateMax(NumNodes);
     new (V) NodeTy(L, State, NumNodes, IsSink);
 
     if (ReclaimNodeInterval)
@@ -29,6 +29,7 @@
 #include "clang/StaticAnalyzer/Core/PathSensitive/ProgramStateTrait.h"
 #include "llvm/ADT/ImmutableMap.h"
 #include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/Support/TimeProfiler.h"
 #include "llvm/Support/raw_ostream.h"
 #include <optional>
@@ -37,6 +38,11 @@
 using namespace clang;
 using namespace ento;
 
+#define DEBUG_TYPE "RegionStore"
+
+STATISTIC(NumRedundantBindings,
+          "The # of bindings that did not change the store");
+
 //===----------------------------------------------------------------------===//
 // Representation of binding keys.
 //===----------------------------------------------------------------------===//
@@ -348,6 +354,17 @@ RegionBindingsRef RegionBindingsRef::addBinding(BindingKey K, SVal V) const {
   const MemRegion *Base = K.getBaseRegion();
 
   const ClusterBindings *ExistingCluster = lookup(Base);
+
+  // Rebinding a key to the value it already has would still copy its path in
+  // both trees, so keep the current bindings instead.
+  if (ExistingCluster) {
+    const SVal *ExistingValue = ExistingCluster->lookup(K);
+    if (ExistingValue && *ExistingValue == V) {
+      ++NumRedundantBindings;
+      return *this;
+    }
+  }
+
   ClusterBindings Cluster =
       (ExistingCluster ? *ExistingCluster : CBFactory->getEmptyMap());
 
@@ -381,6 +398,10 @@ RegionBindingsRef RegionBindingsRef::removeBinding(BindingKey K) {
     return *this;
 
   ClusterBindings NewCluster = CBFactory->remove(*Cluster, K);
+  if (NewCluster.getRootWithoutRetain() == Cluster->getRootWithoutRetain()) {
+    ++NumRedundantBindings;
+    return *this;
+  }
   if (NewCluster.isEmpty())
     return remove(Base);
   return add(Base, NewCluster);
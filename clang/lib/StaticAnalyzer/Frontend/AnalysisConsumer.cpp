@@ -33,6 +33,7 @@
 #include "clang/StaticAnalyzer/Core/PathDiagnosticConsumers.h"
 #include "clang/StaticAnalyzer/Core/PathSensitive/AnalysisManager.h"
 #include "clang/StaticAnalyzer/Core/PathSensitive/ExprEngine.h"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/PostOrderIterator.h"
 #include "llvm/ADT/ScopeExit.h"
 #include "llvm/ADT/Statistic.h"
@@ -477,6 +478,31 @@ void AnalysisConsumer::HandleDeclsCallGraph(const unsigned LocalTUDeclsSize) {
     CG.addToCallGraph(LocalTUDecls[i]);
   }
 
+  llvm::ReversePostOrderTraversal<clang::CallGraph*> RPOT(&CG);
+
+  // When the analysis is split among several workers, give each function the
+  // worker of the first caller that reaches it in topological order, and
+  // spread the remaining functions round-robin. A caller and the callees it
+  // is likely to inline thus stay together, so the "do not reanalyze
+  // previously inlined function" heuristic keeps working within each worker.
+  llvm::DenseMap<const Decl *, unsigned> WorkerOf;
+  const unsigned WorkerCount = Opts.WorkerCount;
+  if (WorkerCount > 1) {
+    unsigned NextWorker = 0;
+    for (CallGraphNode *N : RPOT) {
+      const Decl *D = N->getDecl();
+      if (!D)
+        continue;
+      auto [It, Inserted] = WorkerOf.try_emplace(D, NextWorker);
+      if (Inserted)
+        NextWorker = (NextWorker + 1) % WorkerCount;
+      unsigned Worker = It->second;
+      for (const CallGraphNode::CallRecord &Call : N->callees())
+        if (const Decl *Callee = Call.Callee->getDecl())
+          WorkerOf.try_emplace(Callee, Worker);
+    }
+  }
+
   // Walk over all of the call graph nodes in topological order, so that we
   // analyze parents before the children. Skip the functions inlined into
   // the previously processed functions. Use external Visited set to identify
@@ -485,7 +511,6 @@ void AnalysisConsumer::HandleDeclsCallGraph(const unsigned LocalTUDeclsSize) {
   // often.
   SetOfConstDecls Visited;
   SetOfConstDecls VisitedAsTopLevel;
-  llvm::ReversePostOrderTraversal<clang::CallGraph*> RPOT(&CG);
   for (auto &N : RPOT) {
     NumFunctionTopLevel++;
 
@@ -495,6 +520,10 @@ void AnalysisConsumer::HandleDeclsCallGraph(const unsigned LocalTUDeclsSize) {
     if (!D)
       continue;
 
+    // Skip the functions given to the other workers.
+    if (WorkerCount > 1 && WorkerOf.lookup(D) != Opts.WorkerIndex)
+      continue;
+
     // Skip the functions which have been processed already or previously
     // inlined.
     if (shouldSkipFunction(D, Visited, VisitedAsTopLevel))
@@ -561,11 +590,19 @@ void AnalysisConsumer::runAnalysisOnTranslationUnit(ASTContext &C) {
   BugReporter BR(*Mgr);
   const TranslationUnitDecl *TU = C.getTranslationUnitDecl();
   BR.setAnalysisEntryPoint(TU);
-  if (SyntaxCheckTimer)
-    SyntaxCheckTimer->startTimer();
-  checkerMgr->runCheckersOnASTDecl(TU, *Mgr, BR);
-  if (SyntaxCheckTimer)
-    SyntaxCheckTimer->stopTimer();
+
+  // When the analysis is split among several workers, only the first one runs
+  // the checks that don't follow the call graph, so that they are reported
+  // once.
+  const bool RunsASTChecks = Opts.WorkerIndex == 0;
+
+  if (RunsASTChecks) {
+    if (SyntaxCheckTimer)
+      SyntaxCheckTimer->startTimer();
+    checkerMgr->runCheckersOnASTDecl(TU, *Mgr, BR);
+    if (SyntaxCheckTimer)
+      SyntaxCheckTimer->stopTimer();
+  }
 
   // Run the AST-only checks using the order in which functions are defined.
   // If inlining is not turned on, use the simplest function order for path
@@ -582,15 +619,18 @@ void AnalysisConsumer::runAnalysisOnTranslationUnit(ASTContext &C) {
   // random access.  By doing so, we automatically compensate for iterators
   // possibly being invalidated, although this is a bit slower.
   const unsigned LocalTUDeclsSize = LocalTUDecls.size();
-  for (unsigned i = 0 ; i < LocalTUDeclsSize ; ++i) {
-    TraverseDecl(LocalTUDecls[i]);
+  if (RunsASTChecks) {
+    for (unsigned i = 0 ; i < LocalTUDeclsSize ; ++i) {
+      TraverseDecl(LocalTUDecls[i]);
+    }
   }
 
   if (Mgr->shouldInlineCall())
     HandleDeclsCallGraph(LocalTUDeclsSize);
 
   // After all decls handled, run checkers on the entire TranslationUnit.
-  checkerMgr->runCheckersOnEndOfTranslationUnit(TU, *Mgr, BR);
+  if (RunsASTChecks)
+    checkerMgr->runCheckersOnEndOfTranslationUnit(TU, *Mgr, BR);
 
   BR.FlushReports();
   RecVisitorBR = nullptr;
@@ -600,7 +640,8 @@ void AnalysisConsumer::runAnalysisOnTranslationUnit(ASTContext &C) {
   // name correctly.
   // FIXME: The user might have analyzed the requested function in Syntax mode,
   // but we are unaware of that.
-  if (!Opts.AnalyzeSpecificFunction.empty() && NumFunctionsAnalyzed == 0)
+  if (!Opts.AnalyzeSpecificFunction.empty() && NumFunctionsAnalyzed == 0 &&
+      Opts.WorkerCount == 1)
     reportAnalyzerFunctionMisuse(Opts, *Ctx);
 }
 
@@ -108,6 +108,54 @@ DependencyScanningFilesystemSharedCache::getShardForUID(
   return CacheShards[Hash % NumShards];
 }
 
+/// Returns true if \p Entry no longer reflects the result of a fresh \p Stat.
+static bool isOutOfDate(const CachedFileSystemEntry &Entry,
+                        const llvm::ErrorOr<llvm::vfs::Status> &Stat) {
+  if (Entry.isError() || !Stat)
+    return Entry.isError() != !Stat;
+  // Directory modification times change whenever a sibling entry does, which
+  // doesn't affect anything cached for the directory itself.
+  if (Entry.isDirectory() || Stat->isDirectory())
+    return Entry.isDirectory() != Stat->isDirectory();
+  llvm::vfs::Status Cached = Entry.getStatus();
+  return Cached.getSize() != Stat->getSize() ||
+         Cached.getLastModificationTime() != Stat->getLastModificationTime();
+}
+
+unsigned DependencyScanningFilesystemSharedCache::invalidateOutOfDateEntries(
+    llvm::vfs::FileSystem &UnderlyingFS) {
+  unsigned NumInvalidated = 0;
+  std::vector<llvm::sys::fs::UniqueID> StaleUIDs;
+  for (unsigned I = 0; I < NumShards; ++I) {
+    CacheShard &Shard = CacheShards[I];
+    std::lock_guard<std::mutex> LockGuard(Shard.CacheLock);
+    for (auto It = Shard.CacheByFilename.begin(),
+              End = Shard.CacheByFilename.end();
+         It != End;) {
+      auto Current = It++;
+      const CachedFileSystemEntry *CachedEntry = Current->getValue().first;
+      // Entries holding only a real path can't be validated by a stat, drop
+      // them in case a symlink was retargeted.
+      if (CachedEntry && !isOutOfDate(*CachedEntry,
+                                      UnderlyingFS.status(Current->getKey())))
+        continue;
+      if (CachedEntry && !CachedEntry->isError())
+        StaleUIDs.push_back(CachedEntry->getUniqueID());
+      Shard.CacheByFilename.erase(Current);
+      ++NumInvalidated;
+    }
+  }
+
+  // A rewritten file usually keeps its unique ID, make sure the next read
+  // doesn't resolve to the stale contents through it.
+  for (llvm::sys::fs::UniqueID UID : StaleUIDs) {
+    CacheShard &Shard = getShardForUID(UID);
+    std::lock_guard<std::mutex> LockGuard(Shard.CacheLock);
+    Shard.EntriesByUID.erase(UID);
+  }
+  return NumInvalidated;
+}
+
 const CachedFileSystemEntry *
 DependencyScanningFilesystemSharedCache::CacheShard::findEntryByFilename(
     StringRef Filename) const {
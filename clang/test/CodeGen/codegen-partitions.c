@@ -0,0 +1,29 @@
+// REQUIRES: x86-registered-target
+
+// Partitions after the first are written next to the main output, and all of
+// them must be passed to the link.
+// RUN: rm -rf %t && mkdir %t
+// RUN: %clang_cc1 -triple x86_64-unknown-linux-gnu -emit-obj -fcodegen-partitions=2 %s -o %t/out.o
+// RUN: llvm-nm %t/out.o %t/out.o.part1.o | FileCheck %s
+
+// Splitting stdout is not supported, so this falls back to a single object.
+// RUN: %clang_cc1 -triple x86_64-unknown-linux-gnu -emit-obj -fcodegen-partitions=2 %s -o - | llvm-nm - | FileCheck %s
+
+// Backend diagnostics from the partitions are reported by clang.
+// RUN: %clang_cc1 -triple x86_64-unknown-linux-gnu -emit-obj -fcodegen-partitions=2 -fwarn-stack-size=64 %s -o %t/diag.o 2>&1 | FileCheck %s --check-prefix=DIAG
+// DIAG: warning: stack frame size ({{[0-9]+}}) exceeds limit (64) in 'big'
+
+// Local symbols stay local and are kept with their user.
+// CHECK-DAG: T a
+// CHECK-DAG: T b
+// CHECK-DAG: t helper
+
+static int helper(int x) { return x * 2; }
+int a(int x) { return helper(x) + 1; }
+int b(int x) { return a(x) - 1; }
+
+void use(char *);
+void big(void) {
+  char buf[256];
+  use(buf);
+}
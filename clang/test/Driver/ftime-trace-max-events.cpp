@@ -0,0 +1,30 @@
+// RUN: rm -rf %t && mkdir -p %t && cd %t
+// RUN: %clangxx -S -no-canonical-prefixes -ftime-trace=limited.json \
+// RUN:   -ftime-trace-granularity=0 -ftime-trace-max-events=2 -o out %s
+// RUN: cat limited.json \
+// RUN:   | %python -c 'import json, sys; json.dump(json.loads(sys.stdin.read()), sys.stdout, sort_keys=True, indent=2)' \
+// RUN:   | FileCheck %s --check-prefix=LIMITED
+// RUN: %clangxx -S -no-canonical-prefixes -ftime-trace=unlimited.json \
+// RUN:   -ftime-trace-granularity=0 -o out %s
+// RUN: cat unlimited.json \
+// RUN:   | %python -c 'import json, sys; json.dump(json.loads(sys.stdin.read()), sys.stdout, sort_keys=True, indent=2)' \
+// RUN:   | FileCheck %s --check-prefix=UNLIMITED
+
+/// The trace is truncated and says how many events were left out.
+// LIMITED:     "droppedEvents": {{[1-9][0-9]*}},
+// UNLIMITED-NOT: "droppedEvents"
+
+// RUN: %clang -### -c -ftime-trace -ftime-trace-max-events=100 %s -o a.o 2>&1 \
+// RUN:   | FileCheck %s --check-prefix=FORWARD
+// FORWARD: -cc1{{.*}} "-ftime-trace=a.json" "-ftime-trace-max-events=100"
+
+template <typename T>
+struct Struct {
+  T Num;
+};
+
+int main() {
+  Struct<int> S;
+
+  return 0;
+}
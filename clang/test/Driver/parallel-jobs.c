@@ -0,0 +1,36 @@
+// RUN: rm -rf %t && mkdir %t
+// RUN: echo 'int a(void) { return 0; }' > %t/a.c
+// RUN: echo 'int b(void) { return 0; }' > %t/b.c
+// RUN: echo '#warning first' > %t/c.c
+// RUN: echo '#warning second' > %t/d.c
+
+// RUN: %clang -fsyntax-only --parallel-jobs=4 %t/c.c %t/d.c 2>&1 \
+// RUN:   | FileCheck --check-prefix=ORDER %s
+// RUN: %clang -fsyntax-only -fno-integrated-cc1 --parallel-jobs=4 %t/c.c %t/d.c 2>&1 \
+// RUN:   | FileCheck --check-prefix=ORDER %s
+// ORDER: c.c:1:2: warning: first
+// ORDER: d.c:1:2: warning: second
+
+// Command lines are logged in job order, each before the output of its job.
+// RUN: %clang -v -fsyntax-only --parallel-jobs=4 %t/c.c %t/d.c 2>&1 \
+// RUN:   | FileCheck --check-prefix=VERBOSE %s
+// VERBOSE: "-cc1" {{.*}}c.c"
+// VERBOSE: c.c:1:2: warning: first
+// VERBOSE: "-cc1" {{.*}}d.c"
+// VERBOSE: d.c:1:2: warning: second
+
+// cc1 runs out of process when jobs may run in parallel.
+// RUN: %clang -### -fsyntax-only --parallel-jobs=2 %t/a.c 2>&1 \
+// RUN:   | FileCheck --check-prefix=OUTOFPROCESS %s
+// OUTOFPROCESS-NOT: (in-process)
+// OUTOFPROCESS: "-cc1"
+
+// RUN: %clang -fsyntax-only --parallel-jobs=2 %t/a.c %t/b.c 2>&1 \
+// RUN:   | FileCheck --allow-empty --check-prefix=NOWARN %s
+// RUN: %clang -fsyntax-only --parallel-jobs=0 %t/a.c %t/b.c 2>&1 \
+// RUN:   | FileCheck --allow-empty --check-prefix=NOWARN %s
+// NOWARN-NOT: argument unused
+
+// RUN: not %clang -fsyntax-only --parallel-jobs=x %t/a.c 2>&1 \
+// RUN:   | FileCheck --check-prefix=INVALID %s
+// INVALID: error: invalid integral value 'x' in '--parallel-jobs=x'
@@ -4,6 +4,7 @@
 // Create PCH without codegen.
 // RUN: %clang -x c++-header %S/../Modules/Inputs/codegen-flags/foo.h -### 2>&1 | FileCheck %s -check-prefix=CHECK-PCH-CREATE
 // CHECK-PCH-CREATE: -emit-pch
+// CHECK-PCH-CREATE-NOT: -fpch-instantiate-templates
 // CHECK-PCH-CREATE-NOT: -fmodules-codegen
 // CHECK-PCH-CREATE-NOT: -fmodules-debuginfo
 /// Also test that the default extension name is .pch instead of .gch
@@ -12,10 +13,16 @@
 // Create PCH with -fpch-codegen.
 // RUN: %clang -x c++-header -fpch-codegen %S/../Modules/Inputs/codegen-flags/foo.h -o %t/foo-cg.pch -### 2>&1 | FileCheck %s -check-prefix=CHECK-PCH-CODEGEN-CREATE
 // CHECK-PCH-CODEGEN-CREATE: -emit-pch
+// CHECK-PCH-CODEGEN-CREATE: -fpch-instantiate-templates
 // CHECK-PCH-CODEGEN-CREATE: -fmodules-codegen
 // CHECK-PCH-CODEGEN-CREATE: "-x" "c++-header"
 // CHECK-PCH-CODEGEN-CREATE-NOT: -fmodules-debuginfo
 
+// -fpch-codegen implies -fpch-instantiate-templates unless disabled.
+// RUN: %clang -x c++-header -fpch-codegen -fno-pch-instantiate-templates %S/../Modules/Inputs/codegen-flags/foo.h -o %t/foo-cg.pch -### 2>&1 | FileCheck %s -check-prefix=CHECK-PCH-CODEGEN-NO-INST
+// CHECK-PCH-CODEGEN-NO-INST-NOT: -fpch-instantiate-templates
+// CHECK-PCH-CODEGEN-NO-INST: -fmodules-codegen
+
 // Create PCH with -fpch-debuginfo.
 // RUN: %clang -x c++-header -fpch-debuginfo %S/../Modules/Inputs/codegen-flags/foo.h -g -o %t/foo-di.pch -### 2>&1 | FileCheck %s -check-prefix=CHECK-PCH-DEBUGINFO-CREATE
 // CHECK-PCH-DEBUGINFO-CREATE: -emit-pch
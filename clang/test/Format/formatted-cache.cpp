@@ -0,0 +1,21 @@
+// RUN: rm -rf %t && mkdir %t
+// RUN: printf 'int a;\nint  b;\n' > %t/file.cpp
+// RUN: printf 'int a;\nint b;\n' > %t/clean.cpp
+
+// Runs formatting only some ranges don't record anything, as the rest of the
+// file may need changes.
+// RUN: clang-format --dry-run --Werror --formatted-cache=%t/cache -lines=1:1 %t/file.cpp
+// RUN: clang-format --dry-run --Werror --formatted-cache=%t/cache -offset=0 -length=6 %t/file.cpp
+// RUN: not test -e %t/cache
+// RUN: not clang-format --dry-run --Werror --formatted-cache=%t/cache %t/file.cpp 2>&1 \
+// RUN:   | FileCheck %s --check-prefix=VIOLATION
+// VIOLATION: file.cpp:2:4: error: code should be clang-formatted
+// RUN: not test -e %t/cache
+
+// A file that is formatted is recorded once.
+// RUN: clang-format --dry-run --Werror --formatted-cache=%t/cache %t/clean.cpp
+// RUN: clang-format --dry-run --Werror --formatted-cache=%t/cache %t/clean.cpp %t/clean.cpp
+// RUN: FileCheck %s --check-prefix=CACHE --input-file=%t/cache
+// CACHE: clang-format-formatted-cache
+// CACHE-NEXT: {{^[0-9a-f]{16}$}}
+// CACHE-NOT: {{.}}
@@ -0,0 +1,35 @@
+// RUN: rm -rf %t && mkdir %t
+// RUN: printf 'int  a;\n' > %t/a.cpp
+// RUN: printf 'int b;\n' > %t/b.cpp
+// RUN: printf 'int  c;\n' > %t/c.cpp
+// RUN: printf 'int  d;\n' > %t/d.cpp
+
+// The formatted files are written in command-line order, the same as without
+// -j.
+// RUN: clang-format %t/a.cpp %t/b.cpp %t/c.cpp %t/d.cpp > %t/serial.txt
+// RUN: clang-format -j2 %t/a.cpp %t/b.cpp %t/c.cpp %t/d.cpp > %t/parallel.txt
+// RUN: diff %t/serial.txt %t/parallel.txt
+// RUN: FileCheck %s --check-prefix=STDOUT --input-file=%t/parallel.txt
+// STDOUT:      {{^}}int a;
+// STDOUT-NEXT: {{^}}int b;
+// STDOUT-NEXT: {{^}}int c;
+// STDOUT-NEXT: {{^}}int d;
+
+// Diagnostics are also written in command-line order, including errors for
+// files that can't be read.
+// RUN: not clang-format -j2 --dry-run --Werror %t/a.cpp %t/b.cpp %t/missing.cpp %t/c.cpp %t/d.cpp 2>&1 \
+// RUN:   | FileCheck %s --check-prefix=DIAG
+// DIAG:     a.cpp:1:4: error: code should be clang-formatted
+// DIAG-NOT: b.cpp
+// DIAG:     missing.cpp: {{.+}}
+// DIAG:     c.cpp:1:4: error: code should be clang-formatted
+// DIAG:     d.cpp:1:4: error: code should be clang-formatted
+
+// The exit code is an error if formatting any of the files fails.
+// RUN: clang-format -j2 --dry-run --Werror %t/b.cpp %t/b.cpp %t/b.cpp
+// RUN: not clang-format -j2 --dry-run --Werror %t/a.cpp %t/b.cpp %t/b.cpp
+// RUN: not clang-format -j2 --dry-run --Werror %t/b.cpp %t/b.cpp %t/d.cpp
+// RUN: not clang-format -j2 %t/b.cpp %t/missing.cpp %t/b.cpp > %t/missing.txt
+// RUN: FileCheck %s --check-prefix=MISSING --input-file=%t/missing.txt
+// MISSING:      {{^}}int b;
+// MISSING-NEXT: {{^}}int b;
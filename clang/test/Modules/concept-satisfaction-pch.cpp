@@ -0,0 +1,44 @@
+// RUN: rm -rf %t
+// RUN: split-file %s %t
+//
+// RUN: %clang_cc1 -std=c++20 -x c++-header %t/header.h -emit-pch -o %t/header.pch
+// RUN: %clang_cc1 -std=c++20 -include-pch %t/header.pch %t/reuse.cpp -fsyntax-only -verify -print-stats 2>&1 \
+// RUN:   | FileCheck %s --check-prefix=REUSED
+// RUN: %clang_cc1 -std=c++20 -include %t/header.h %t/reuse.cpp -fsyntax-only -print-stats 2>&1 \
+// RUN:   | FileCheck %s --check-prefix=EVALUATED
+// RUN: %clang_cc1 -std=c++20 -include-pch %t/header.pch %t/unsatisfied.cpp -fsyntax-only -verify
+
+// REUSED: {{^}}0 constraint satisfaction checks evaluated.
+// EVALUATED: {{^[1-9][0-9]*}} constraint satisfaction checks evaluated.
+
+//--- header.h
+template <typename T>
+concept Small = sizeof(T) <= 4;
+
+template <Small T>
+struct Box {};
+
+// These satisfied checks are recorded in the PCH.
+static_assert(Small<int>);
+Box<short> ShortBox;
+
+//--- reuse.cpp
+// expected-no-diagnostics
+using Int = int;
+
+// Satisfied checks from the PCH are read back rather than evaluated again,
+// including through type sugar.
+static_assert(Small<int>);
+static_assert(Small<Int>);
+Box<short> AnotherShortBox;
+
+//--- unsatisfied.cpp
+// Unsatisfied checks are still evaluated and diagnosed.
+static_assert(Small<long long>);
+// expected-error@-1 {{static assertion failed}}
+// expected-note@-2 {{because 'long long' does not satisfy 'Small'}}
+// expected-note@header.h:2 {{because 'sizeof(long long) <= 4' (8 <= 4) evaluated to false}}
+Box<long long> BigBox;
+// expected-error@-1 {{constraints not satisfied for class template 'Box' [with T = long long]}}
+// expected-note@header.h:4 {{because 'long long' does not satisfy 'Small'}}
+// expected-note@header.h:2 {{because 'sizeof(long long) <= 4' (8 <= 4) evaluated to false}}
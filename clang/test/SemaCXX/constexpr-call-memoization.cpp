@@ -0,0 +1,26 @@
+// RUN: %clang_cc1 -std=c++20 -fsyntax-only -verify -fexperimental-new-constant-interpreter -fexperimental-constexpr-call-memoization %s
+
+// Without memoization this takes hundreds of millions of calls.
+constexpr unsigned long long fib(unsigned n) {
+  return n < 2 ? n : fib(n - 1) + fib(n - 2);
+}
+static_assert(fib(40) == 102334155ull);
+static_assert(fib(80) == 23416728348467685ull);
+
+// Calls that aren't constant expressions are not memoized.
+constexpr int divide(int a, int b) { return a / b; } // expected-note 2{{division by zero}}
+static_assert(divide(1, 0) == 0); // expected-error {{not an integral constant expression}} \
+                                  // expected-note {{in call to}}
+static_assert(divide(1, 0) == 0); // expected-error {{not an integral constant expression}} \
+                                  // expected-note {{in call to}}
+static_assert(divide(4, 2) == 2);
+
+// Unsigned 64-bit arguments and results with the top bit set.
+constexpr unsigned long long flip(unsigned long long x) { return ~x; }
+static_assert(flip(0) == 0xFFFFFFFFFFFFFFFFull);
+static_assert(flip(0) == 0xFFFFFFFFFFFFFFFFull);
+static_assert(flip(0x8000000000000000ull) == 0x7FFFFFFFFFFFFFFFull);
+static_assert(flip(0x8000000000000000ull) == 0x7FFFFFFFFFFFFFFFull);
+constexpr long long negate(long long x) { return -x; }
+static_assert(negate(5) == -5);
+static_assert(negate(5) == -5);
@@ -163,3 +163,15 @@ namespace PR48545 {
       D z(0, 0);
   }
 }
+
+namespace ArityBeforeSliceCheck {
+  // The inherited constructor taking two arguments is rejected on arity alone,
+  // without completing Incomplete<int> to check for slicing.
+  template<typename T> struct Incomplete { static_assert(sizeof(T) == 0, ""); };
+  struct B {
+    B(int);
+    B(Incomplete<int> &, int);
+  };
+  struct D : B { using B::B; };
+  D d(0);
+}
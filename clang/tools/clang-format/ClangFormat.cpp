@@ -20,12 +20,19 @@
 #include "clang/Basic/Version.h"
 #include "clang/Format/Format.h"
 #include "clang/Rewrite/Core/Rewriter.h"
+#include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringSwitch.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Format.h"
 #include "llvm/Support/InitLLVM.h"
 #include "llvm/Support/Process.h"
+#include "llvm/Support/ThreadPool.h"
+#include "llvm/Support/Threading.h"
+#include "llvm/Support/xxhash.h"
 #include <fstream>
+#include <mutex>
 
 using namespace llvm;
 using clang::tooling::Replacements;
@@ -214,6 +221,22 @@ static cl::opt<bool> ListIgnored("list-ignored",
                                  cl::desc("List ignored files."),
                                  cl::cat(ClangFormatCategory), cl::Hidden);
 
+static cl::opt<unsigned>
+    NumThreads("j",
+               cl::desc("The number of files to format in parallel\n"
+                        "(0 = one per hardware thread). The output of\n"
+                        "each file is still written in the order of\n"
+                        "the files on the command line."),
+               cl::init(1), cl::cat(ClangFormatCategory));
+
+static cl::opt<std::string> FormattedCache(
+    "formatted-cache",
+    cl::desc("A file recording the files found to be formatted already.\n"
+             "With -i or --dry-run, a file whose content and style match\n"
+             "a record is skipped. Not used with -lines, -offset or\n"
+             "-length."),
+    cl::value_desc("filename"), cl::init(""), cl::cat(ClangFormatCategory));
+
 namespace clang {
 namespace format {
 
@@ -235,8 +258,8 @@ static bool parseLineRange(StringRef Input, unsigned &FromLine,
          LineRange.second.getAsInteger(0, ToLine);
 }
 
-static bool fillRanges(MemoryBuffer *Code,
-                       std::vector<tooling::Range> &Ranges) {
+static bool fillRanges(MemoryBuffer *Code, std::vector<tooling::Range> &Ranges,
+                       raw_ostream &ErrOS) {
   IntrusiveRefCntPtr<llvm::vfs::InMemoryFileSystem> InMemoryFileSystem(
       new llvm::vfs::InMemoryFileSystem);
   FileManager Files(FileSystemOptions(), InMemoryFileSystem);
@@ -248,22 +271,22 @@ static bool fillRanges(MemoryBuffer *Code,
                                  InMemoryFileSystem.get());
   if (!LineRanges.empty()) {
     if (!Offsets.empty() || !Lengths.empty()) {
-      errs() << "error: cannot use -lines with -offset/-length\n";
+      ErrOS << "error: cannot use -lines with -offset/-length\n";
       return true;
     }
 
     for (unsigned i = 0, e = LineRanges.size(); i < e; ++i) {
       unsigned FromLine, ToLine;
       if (parseLineRange(LineRanges[i], FromLine, ToLine)) {
-        errs() << "error: invalid <start line>:<end line> pair\n";
+        ErrOS << "error: invalid <start line>:<end line> pair\n";
         return true;
       }
       if (FromLine < 1) {
-        errs() << "error: start line should be at least 1\n";
+        ErrOS << "error: start line should be at least 1\n";
         return true;
       }
       if (FromLine > ToLine) {
-        errs() << "error: start line should not exceed end line\n";
+        ErrOS << "error: start line should not exceed end line\n";
         return true;
       }
       SourceLocation Start = Sources.translateLineCol(ID, FromLine, 1);
@@ -277,26 +300,28 @@ static bool fillRanges(MemoryBuffer *Code,
     return false;
   }
 
-  if (Offsets.empty())
-    Offsets.push_back(0);
-  if (Offsets.size() != Lengths.size() &&
-      !(Offsets.size() == 1 && Lengths.empty())) {
-    errs() << "error: number of -offset and -length arguments must match.\n";
+  // Files may be formatted in parallel, so leave -offset itself unchanged.
+  SmallVector<unsigned, 4> RangeOffsets(Offsets.begin(), Offsets.end());
+  if (RangeOffsets.empty())
+    RangeOffsets.push_back(0);
+  if (RangeOffsets.size() != Lengths.size() &&
+      !(RangeOffsets.size() == 1 && Lengths.empty())) {
+    ErrOS << "error: number of -offset and -length arguments must match.\n";
     return true;
   }
-  for (unsigned i = 0, e = Offsets.size(); i != e; ++i) {
-    if (Offsets[i] >= Code->getBufferSize()) {
-      errs() << "error: offset " << Offsets[i] << " is outside the file\n";
+  for (unsigned i = 0, e = RangeOffsets.size(); i != e; ++i) {
+    if (RangeOffsets[i] >= Code->getBufferSize()) {
+      ErrOS << "error: offset " << RangeOffsets[i] << " is outside the file\n";
       return true;
     }
     SourceLocation Start =
-        Sources.getLocForStartOfFile(ID).getLocWithOffset(Offsets[i]);
+        Sources.getLocForStartOfFile(ID).getLocWithOffset(RangeOffsets[i]);
     SourceLocation End;
     if (i < Lengths.size()) {
-      if (Offsets[i] + Lengths[i] > Code->getBufferSize()) {
-        errs() << "error: invalid length " << Lengths[i]
-               << ", offset + length (" << Offsets[i] + Lengths[i]
-               << ") is outside the file.\n";
+      if (RangeOffsets[i] + Lengths[i] > Code->getBufferSize()) {
+        ErrOS << "error: invalid length " << Lengths[i]
+              << ", offset + length (" << RangeOffsets[i] + Lengths[i]
+              << ") is outside the file.\n";
         return true;
       }
       End = Start.getLocWithOffset(Lengths[i]);
@@ -310,47 +335,49 @@ static bool fillRanges(MemoryBuffer *Code,
   return false;
 }
 
-static void outputReplacementXML(StringRef Text) {
+static void outputReplacementXML(StringRef Text, raw_ostream &OS) {
   // FIXME: When we sort includes, we need to make sure the stream is correct
   // utf-8.
   size_t From = 0;
   size_t Index;
   while ((Index = Text.find_first_of("\n\r<&", From)) != StringRef::npos) {
-    outs() << Text.substr(From, Index - From);
+    OS << Text.substr(From, Index - From);
     switch (Text[Index]) {
     case '\n':
-      outs() << "&#10;";
+      OS << "&#10;";
       break;
     case '\r':
-      outs() << "&#13;";
+      OS << "&#13;";
       break;
     case '<':
-      outs() << "&lt;";
+      OS << "&lt;";
       break;
     case '&':
-      outs() << "&amp;";
+      OS << "&amp;";
       break;
     default:
       llvm_unreachable("Unexpected character encountered!");
     }
     From = Index + 1;
   }
-  outs() << Text.substr(From);
+  OS << Text.substr(From);
 }
 
-static void outputReplacementsXML(const Replacements &Replaces) {
+static void outputReplacementsXML(const Replacements &Replaces,
+                                  raw_ostream &OS) {
   for (const auto &R : Replaces) {
-    outs() << "<replacement "
-           << "offset='" << R.getOffset() << "' "
-           << "length='" << R.getLength() << "'>";
-    outputReplacementXML(R.getReplacementText());
-    outs() << "</replacement>\n";
+    OS << "<replacement "
+       << "offset='" << R.getOffset() << "' "
+       << "length='" << R.getLength() << "'>";
+    outputReplacementXML(R.getReplacementText(), OS);
+    OS << "</replacement>\n";
   }
 }
 
 static bool
 emitReplacementWarnings(const Replacements &Replaces, StringRef AssumedFileName,
-                        const std::unique_ptr<llvm::MemoryBuffer> &Code) {
+                        const std::unique_ptr<llvm::MemoryBuffer> &Code,
+                        raw_ostream &ErrOS) {
   unsigned Errors = 0;
   if (WarnFormat && !NoWarnFormat) {
     SourceMgr Mgr;
@@ -365,7 +392,7 @@ emitReplacementWarnings(const Replacements &Replaces, StringRef AssumedFileName,
                            : SourceMgr::DiagKind::DK_Warning,
           "code should be clang-formatted [-Wclang-format-violations]");
 
-      Diag.print(nullptr, llvm::errs(), ShowColors && !NoShowColors);
+      Diag.print(nullptr, ErrOS, ShowColors && !NoShowColors);
       if (ErrorLimit && ++Errors >= ErrorLimit)
         break;
     }
@@ -377,20 +404,20 @@ static void outputXML(const Replacements &Replaces,
                       const Replacements &FormatChanges,
                       const FormattingAttemptStatus &Status,
                       const cl::opt<unsigned> &Cursor,
-                      unsigned CursorPosition) {
-  outs() << "<?xml version='1.0'?>\n<replacements "
-            "xml:space='preserve' incomplete_format='"
-         << (Status.FormatComplete ? "false" : "true") << "'";
+                      unsigned CursorPosition, raw_ostream &OS) {
+  OS << "<?xml version='1.0'?>\n<replacements "
+        "xml:space='preserve' incomplete_format='"
+     << (Status.FormatComplete ? "false" : "true") << "'";
   if (!Status.FormatComplete)
-    outs() << " line='" << Status.Line << "'";
-  outs() << ">\n";
+    OS << " line='" << Status.Line << "'";
+  OS << ">\n";
   if (Cursor.getNumOccurrences() != 0) {
-    outs() << "<cursor>" << FormatChanges.getShiftedCodePosition(CursorPosition)
-           << "</cursor>\n";
+    OS << "<cursor>" << FormatChanges.getShiftedCodePosition(CursorPosition)
+       << "</cursor>\n";
   }
 
-  outputReplacementsXML(Replaces);
-  outs() << "</replacements>\n";
+  outputReplacementsXML(Replaces, OS);
+  OS << "</replacements>\n";
 }
 
 class ClangFormatDiagConsumer : public DiagnosticConsumer {
@@ -405,11 +432,145 @@ class ClangFormatDiagConsumer : public DiagnosticConsumer {
   }
 };
 
+/// The styles found for the files of each directory, keyed on the directory
+/// and the language. The style of a file only depends on its language and on
+/// the configuration files found from its directory upwards, so all the files
+/// of a language in a directory share it.
+struct CachedStyle {
+  FormatStyle Style;
+  /// A hash of the configuration, which tells whether a file recorded in the
+  /// -formatted-cache was formatted with the same style.
+  uint64_t Hash;
+};
+static std::mutex StyleCacheMutex;
+static StringMap<CachedStyle> StyleCache;
+
+/// Returns the style to use for \p FileName, with the command line overrides
+/// applied.
+static Expected<FormatStyle> getStyleForFile(StringRef FileName, StringRef Code,
+                                             uint64_t &Hash) {
+  SmallString<128> Key(FileName);
+  llvm::sys::fs::make_absolute(Key);
+  llvm::sys::path::remove_filename(Key);
+  Key += '\0';
+  Key += std::to_string(guessLanguage(FileName, Code));
+
+  {
+    std::lock_guard<std::mutex> Lock(StyleCacheMutex);
+    auto It = StyleCache.find(Key);
+    if (It != StyleCache.end()) {
+      Hash = It->second.Hash;
+      return It->second.Style;
+    }
+  }
+
+  Expected<FormatStyle> FormatStyle =
+      getStyle(Style, FileName, FallbackStyle, Code, nullptr,
+               WNoErrorList.isSet(WNoError::Unknown));
+  if (!FormatStyle)
+    return FormatStyle.takeError();
+
+  StringRef QualifierAlignmentOrder = QualifierAlignment;
+
+  FormatStyle->QualifierAlignment =
+      StringSwitch<FormatStyle::QualifierAlignmentStyle>(
+          QualifierAlignmentOrder.lower())
+          .Case("right", FormatStyle::QAS_Right)
+          .Case("left", FormatStyle::QAS_Left)
+          .Default(FormatStyle->QualifierAlignment);
+
+  if (FormatStyle->QualifierAlignment == FormatStyle::QAS_Left) {
+    FormatStyle->QualifierOrder = {"const", "volatile", "type"};
+  } else if (FormatStyle->QualifierAlignment == FormatStyle::QAS_Right) {
+    FormatStyle->QualifierOrder = {"type", "const", "volatile"};
+  } else if (QualifierAlignmentOrder.contains("type")) {
+    FormatStyle->QualifierAlignment = FormatStyle::QAS_Custom;
+    SmallVector<StringRef> Qualifiers;
+    QualifierAlignmentOrder.split(Qualifiers, " ", /*MaxSplit=*/-1,
+                                  /*KeepEmpty=*/false);
+    FormatStyle->QualifierOrder = {Qualifiers.begin(), Qualifiers.end()};
+  }
+
+  if (SortIncludes.getNumOccurrences() != 0) {
+    if (SortIncludes)
+      FormatStyle->SortIncludes = FormatStyle::SI_CaseSensitive;
+    else
+      FormatStyle->SortIncludes = FormatStyle::SI_Never;
+  }
+
+  Hash = xxh3_64bits(configurationAsText(*FormatStyle));
+  std::lock_guard<std::mutex> Lock(StyleCacheMutex);
+  StyleCache.try_emplace(Key, CachedStyle{*FormatStyle, Hash});
+  return FormatStyle;
+}
+
+/// The -formatted-cache records: hashes of the content and style of files that
+/// needed no change.
+static std::mutex FormattedCacheMutex;
+static DenseSet<uint64_t> FormattedFiles;
+static bool FormattedFilesChanged = false;
+
+static uint64_t hashFormattedFile(uint64_t StyleHash, StringRef Code) {
+  const uint64_t Parts[] = {StyleHash, xxh3_64bits(Code)};
+  return xxh3_64bits(ArrayRef<uint8_t>(
+      reinterpret_cast<const uint8_t *>(Parts), sizeof(Parts)));
+}
+
+static bool isKnownFormatted(uint64_t Hash) {
+  std::lock_guard<std::mutex> Lock(FormattedCacheMutex);
+  return FormattedFiles.contains(Hash);
+}
+
+static void recordFormatted(uint64_t Hash) {
+  std::lock_guard<std::mutex> Lock(FormattedCacheMutex);
+  if (FormattedFiles.insert(Hash).second)
+    FormattedFilesChanged = true;
+}
+
+/// The first line of a -formatted-cache file. Records made by another version
+/// of clang-format are discarded, as its formatting may differ.
+static std::string formattedCacheHeader() {
+  return "clang-format-formatted-cache " +
+         getClangToolFullVersion("clang-format");
+}
+
+static void loadFormattedCache() {
+  ErrorOr<std::unique_ptr<MemoryBuffer>> Buffer =
+      MemoryBuffer::getFile(FormattedCache, /*IsText=*/true);
+  if (!Buffer)
+    return;
+  SmallVector<StringRef, 0> Lines;
+  (*Buffer)->getBuffer().split(Lines, '\n', /*MaxSplit=*/-1,
+                               /*KeepEmpty=*/false);
+  if (Lines.empty() || Lines.front() != formattedCacheHeader())
+    return;
+  for (StringRef Line : ArrayRef(Lines).drop_front()) {
+    uint64_t Hash;
+    if (!Line.getAsInteger(16, Hash))
+      FormattedFiles.insert(Hash);
+  }
+}
+
+static void saveFormattedCache() {
+  if (!FormattedFilesChanged)
+    return;
+  if (Error Err = writeToOutput(FormattedCache, [](raw_ostream &OS) {
+        OS << formattedCacheHeader() << '\n';
+        for (uint64_t Hash : FormattedFiles)
+          OS << format_hex_no_prefix(Hash, 16) << '\n';
+        return Error::success();
+      })) {
+    errs() << "error: cannot write " << FormattedCache << ": "
+           << toString(std::move(Err)) << '\n';
+  }
+}
+
 // Returns true on error.
-static bool format(StringRef FileName, bool ErrorOnIncompleteFormat = false) {
+static bool format(StringRef FileName, raw_ostream &OS, raw_ostream &ErrOS,
+                   bool ErrorOnIncompleteFormat = false) {
   const bool IsSTDIN = FileName == "-";
   if (!OutputXML && Inplace && IsSTDIN) {
-    errs() << "error: cannot use -i when reading from stdin.\n";
+    ErrOS << "error: cannot use -i when reading from stdin.\n";
     return true;
   }
   // On Windows, overwriting a file with an open file mapping doesn't work,
@@ -419,7 +580,7 @@ static bool format(StringRef FileName, bool ErrorOnIncompleteFormat = false) {
           ? MemoryBuffer::getFileAsStream(FileName)
           : MemoryBuffer::getFileOrSTDIN(FileName, /*IsText=*/true);
   if (std::error_code EC = CodeOrErr.getError()) {
-    errs() << FileName << ": " << EC.message() << "\n";
+    ErrOS << FileName << ": " << EC.message() << "\n";
     return true;
   }
   std::unique_ptr<llvm::MemoryBuffer> Code = std::move(CodeOrErr.get());
@@ -431,57 +592,42 @@ static bool format(StringRef FileName, bool ErrorOnIncompleteFormat = false) {
   const char *InvalidBOM = SrcMgr::ContentCache::getInvalidBOM(BufStr);
 
   if (InvalidBOM) {
-    errs() << "error: encoding with unsupported byte order mark \""
-           << InvalidBOM << "\" detected";
+    ErrOS << "error: encoding with unsupported byte order mark \""
+          << InvalidBOM << "\" detected";
     if (!IsSTDIN)
-      errs() << " in file '" << FileName << "'";
-    errs() << ".\n";
+      ErrOS << " in file '" << FileName << "'";
+    ErrOS << ".\n";
     return true;
   }
 
   std::vector<tooling::Range> Ranges;
-  if (fillRanges(Code.get(), Ranges))
+  if (fillRanges(Code.get(), Ranges, ErrOS))
     return true;
   StringRef AssumedFileName = IsSTDIN ? AssumeFileName : FileName;
   if (AssumedFileName.empty()) {
-    llvm::errs() << "error: empty filenames are not allowed\n";
+    ErrOS << "error: empty filenames are not allowed\n";
     return true;
   }
 
+  uint64_t StyleHash;
   Expected<FormatStyle> FormatStyle =
-      getStyle(Style, AssumedFileName, FallbackStyle, Code->getBuffer(),
-               nullptr, WNoErrorList.isSet(WNoError::Unknown));
+      getStyleForFile(AssumedFileName, Code->getBuffer(), StyleHash);
   if (!FormatStyle) {
-    llvm::errs() << toString(FormatStyle.takeError()) << "\n";
+    ErrOS << toString(FormatStyle.takeError()) << "\n";
     return true;
   }
 
-  StringRef QualifierAlignmentOrder = QualifierAlignment;
-
-  FormatStyle->QualifierAlignment =
-      StringSwitch<FormatStyle::QualifierAlignmentStyle>(
-          QualifierAlignmentOrder.lower())
-          .Case("right", FormatStyle::QAS_Right)
-          .Case("left", FormatStyle::QAS_Left)
-          .Default(FormatStyle->QualifierAlignment);
-
-  if (FormatStyle->QualifierAlignment == FormatStyle::QAS_Left) {
-    FormatStyle->QualifierOrder = {"const", "volatile", "type"};
-  } else if (FormatStyle->QualifierAlignment == FormatStyle::QAS_Right) {
-    FormatStyle->QualifierOrder = {"type", "const", "volatile"};
-  } else if (QualifierAlignmentOrder.contains("type")) {
-    FormatStyle->QualifierAlignment = FormatStyle::QAS_Custom;
-    SmallVector<StringRef> Qualifiers;
-    QualifierAlignmentOrder.split(Qualifiers, " ", /*MaxSplit=*/-1,
-                                  /*KeepEmpty=*/false);
-    FormatStyle->QualifierOrder = {Qualifiers.begin(), Qualifiers.end()};
-  }
-
-  if (SortIncludes.getNumOccurrences() != 0) {
-    if (SortIncludes)
-      FormatStyle->SortIncludes = FormatStyle::SI_CaseSensitive;
-    else
-      FormatStyle->SortIncludes = FormatStyle::SI_Never;
+  // Skip the file if it was found to be formatted with this style before.
+  // Records are about whole files, so they are neither used nor made when
+  // only some ranges are formatted.
+  const bool UseFormattedCache =
+      !FormattedCache.empty() && !IsSTDIN && (Inplace || DryRun) &&
+      !OutputXML && LineRanges.empty() && Offsets.empty() && Lengths.empty();
+  uint64_t FormattedHash = 0;
+  if (UseFormattedCache) {
+    FormattedHash = hashFormattedFile(StyleHash, Code->getBuffer());
+    if (isKnownFormatted(FormattedHash))
+      return false;
   }
   unsigned CursorPosition = Cursor;
   Replacements Replaces = sortIncludes(*FormatStyle, Code->getBuffer(), Ranges,
@@ -495,12 +641,12 @@ static bool format(StringRef FileName, bool ErrorOnIncompleteFormat = false) {
     auto Err = Replaces.add(tooling::Replacement(
         tooling::Replacement(AssumedFileName, 0, 0, "x = ")));
     if (Err)
-      llvm::errs() << "Bad Json variable insertion\n";
+      ErrOS << "Bad Json variable insertion\n";
   }
 
   auto ChangedCode = tooling::applyAllReplacements(Code->getBuffer(), Replaces);
   if (!ChangedCode) {
-    llvm::errs() << toString(ChangedCode.takeError()) << "\n";
+    ErrOS << toString(ChangedCode.takeError()) << "\n";
     return true;
   }
   // Get new affected ranges after sorting `#includes`.
@@ -509,12 +655,17 @@ static bool format(StringRef FileName, bool ErrorOnIncompleteFormat = false) {
   Replacements FormatChanges =
       reformat(*FormatStyle, *ChangedCode, Ranges, AssumedFileName, &Status);
   Replaces = Replaces.merge(FormatChanges);
+  // Only record files that were formatted completely, so that skipping a
+  // recorded file can't hide a --fail-on-incomplete-format error.
+  if (UseFormattedCache && Status.FormatComplete &&
+      Replaces.size() == (IsJson ? 1u : 0u))
+    recordFormatted(FormattedHash);
   if (DryRun) {
     return Replaces.size() > (IsJson ? 1u : 0u) &&
-           emitReplacementWarnings(Replaces, AssumedFileName, Code);
+           emitReplacementWarnings(Replaces, AssumedFileName, Code, ErrOS);
   }
   if (OutputXML) {
-    outputXML(Replaces, FormatChanges, Status, Cursor, CursorPosition);
+    outputXML(Replaces, FormatChanges, Status, Cursor, CursorPosition, OS);
   } else {
     IntrusiveRefCntPtr<llvm::vfs::InMemoryFileSystem> InMemoryFileSystem(
         new llvm::vfs::InMemoryFileSystem);
@@ -535,15 +686,15 @@ static bool format(StringRef FileName, bool ErrorOnIncompleteFormat = false) {
         return true;
     } else {
       if (Cursor.getNumOccurrences() != 0) {
-        outs() << "{ \"Cursor\": "
-               << FormatChanges.getShiftedCodePosition(CursorPosition)
-               << ", \"IncompleteFormat\": "
-               << (Status.FormatComplete ? "false" : "true");
+        OS << "{ \"Cursor\": "
+           << FormatChanges.getShiftedCodePosition(CursorPosition)
+           << ", \"IncompleteFormat\": "
+           << (Status.FormatComplete ? "false" : "true");
         if (!Status.FormatComplete)
-          outs() << ", \"Line\": " << Status.Line;
-        outs() << " }\n";
+          OS << ", \"Line\": " << Status.Line;
+        OS << " }\n";
       }
-      Rewrite.getEditBuffer(ID).write(outs());
+      Rewrite.getEditBuffer(ID).write(OS);
     }
   }
   return ErrorOnIncompleteFormat && !Status.FormatComplete;
@@ -710,7 +861,7 @@ int main(int argc, const char **argv) {
   if (FileNames.empty()) {
     if (isIgnored(AssumeFileName))
       return 0;
-    return clang::format::format("-", FailOnIncompleteFormat);
+    return clang::format::format("-", outs(), errs(), FailOnIncompleteFormat);
   }
 
   if (FileNames.size() > 1 &&
@@ -720,8 +871,7 @@ int main(int argc, const char **argv) {
     return 1;
   }
 
-  unsigned FileNo = 1;
-  bool Error = false;
+  std::vector<StringRef> FilesToFormat;
   for (const auto &FileName : FileNames) {
     const bool Ignored = isIgnored(FileName);
     if (ListIgnored) {
@@ -729,13 +879,58 @@ int main(int argc, const char **argv) {
         outs() << FileName << '\n';
       continue;
     }
-    if (Ignored)
-      continue;
+    if (!Ignored)
+      FilesToFormat.push_back(FileName);
+  }
+
+  if (!FormattedCache.empty())
+    clang::format::loadFormattedCache();
+
+  auto PrintProgress = [FileNo = 1u](StringRef FileName) mutable {
     if (Verbose) {
       errs() << "Formatting [" << FileNo++ << "/" << FileNames.size() << "] "
              << FileName << "\n";
     }
-    Error |= clang::format::format(FileName, FailOnIncompleteFormat);
+  };
+
+  bool Error = false;
+  if (NumThreads == 1 || FilesToFormat.size() < 2) {
+    for (StringRef FileName : FilesToFormat) {
+      PrintProgress(FileName);
+      Error |= clang::format::format(FileName, outs(), errs(),
+                                     FailOnIncompleteFormat);
+    }
+  } else {
+    // Format the files in parallel, but buffer the output of each one and
+    // write it out in order, as soon as the files before it are done.
+    struct FileResult {
+      std::string Out;
+      std::string Err;
+      bool Error = false;
+    };
+    std::vector<FileResult> Results(FilesToFormat.size());
+    std::vector<std::shared_future<void>> Done;
+    Done.reserve(FilesToFormat.size());
+    DefaultThreadPool Pool(hardware_concurrency(NumThreads));
+    for (size_t I = 0, E = FilesToFormat.size(); I != E; ++I) {
+      Done.push_back(Pool.async([&, I] {
+        raw_string_ostream OS(Results[I].Out);
+        raw_string_ostream ErrOS(Results[I].Err);
+        Results[I].Error = clang::format::format(FilesToFormat[I], OS, ErrOS,
+                                                 FailOnIncompleteFormat);
+      }));
+    }
+    for (size_t I = 0, E = FilesToFormat.size(); I != E; ++I) {
+      Done[I].wait();
+      PrintProgress(FilesToFormat[I]);
+      outs() << Results[I].Out;
+      errs() << Results[I].Err;
+      Error |= Results[I].Error;
+      Results[I] = FileResult();
+    }
   }
+
+  if (!FormattedCache.empty())
+    clang::format::saveFormattedCache();
   return Error ? 1 : 0;
 }
@@ -245,6 +245,8 @@ int cc1_main(ArrayRef<const char *> Argv, const char *Argv0, void *MainAddr) {
     llvm::timeTraceProfilerInitialize(
         Clang->getFrontendOpts().TimeTraceGranularity, Argv0,
         Clang->getFrontendOpts().TimeTraceVerbose);
+    llvm::timeTraceProfilerSetMaxEvents(
+        Clang->getFrontendOpts().TimeTraceMaxEvents);
   }
   // --print-supported-cpus takes priority over the actual compilation.
   if (Clang->getFrontendOpts().PrintSupportedCPUs)
@@ -268,6 +268,41 @@ TEST(MatchFinder, InterceptsEndOfTranslationUnit) {
   EXPECT_TRUE(VerifyCallback.Called);
 }
 
+TEST(MatchFinder, RunsNameBucketedMatchersInOrder) {
+  struct RecordingCallback : public MatchFinder::MatchCallback {
+    RecordingCallback(std::vector<std::string> &Log, StringRef Tag)
+        : Log(Log), Tag(Tag) {}
+    void run(const MatchFinder::MatchResult &Result) override {
+      const auto *ND = Result.Nodes.getNodeAs<NamedDecl>("d");
+      Log.push_back(Tag.str() + ":" + ND->getNameAsString());
+    }
+    std::vector<std::string> &Log;
+    StringRef Tag;
+  };
+
+  std::vector<std::string> Log;
+  RecordingCallback HasF(Log, "hasF"), Any(Log, "any"),
+      AnyOfFG(Log, "anyOfFG"), Qualified(Log, "qualified"), Ctor(Log, "ctor");
+  MatchFinder Finder;
+  Finder.addMatcher(functionDecl(hasName("f")).bind("d"), &HasF);
+  Finder.addMatcher(functionDecl().bind("d"), &Any);
+  Finder.addMatcher(
+      namedDecl(anyOf(hasName("f"), hasAnyName("g", "f"))).bind("d"),
+      &AnyOfFG);
+  Finder.addMatcher(functionDecl(hasName("::ns::f")).bind("d"), &Qualified);
+  Finder.addMatcher(cxxConstructorDecl(hasName("S")).bind("d"), &Ctor);
+
+  std::unique_ptr<ASTUnit> AST(tooling::buildASTFromCode(
+      "void f(); void g(); void h(); namespace ns { void f(); }"
+      "struct S { S(); };"));
+  ASSERT_TRUE(AST.get());
+  Finder.matchAST(AST->getASTContext());
+  EXPECT_EQ(Log, (std::vector<std::string>{
+                     "hasF:f", "any:f", "anyOfFG:f", "any:g", "anyOfFG:g",
+                     "any:h", "hasF:f", "any:f", "anyOfFG:f", "qualified:f",
+                     "any:S", "ctor:S"}));
+}
+
 TEST(Matcher, matchOverEntireASTContext) {
   std::unique_ptr<ASTUnit> AST =
       clang::tooling::buildASTFromCode("struct { int *foo; };");
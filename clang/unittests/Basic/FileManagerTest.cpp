@@ -10,6 +10,8 @@
 #include "clang/Basic/FileSystemOptions.h"
 #include "clang/Basic/FileSystemStatCache.h"
 #include "llvm/ADT/STLExtras.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/FileUtilities.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/VirtualFileSystem.h"
 #include "llvm/Testing/Support/Error.h"
@@ -578,4 +580,58 @@ TEST_F(FileManagerTest, getBypassFile) {
   EXPECT_EQ(&FE, &SearchRef->getFileEntry());
 }
 
+TEST_F(FileManagerTest, persistentNegativeStatCache) {
+  SmallString<64> Root;
+#ifdef _WIN32
+  Root = "C:/";
+#else
+  Root = "/";
+#endif
+  std::string Existing = (Root + "inc/a.h").str();
+  std::string Missing = (Root + "inc/missing.h").str();
+
+  SmallString<128> CachePath;
+  ASSERT_FALSE(
+      llvm::sys::fs::createTemporaryFile("stat-cache", "txt", CachePath));
+  llvm::FileRemover Cleanup(CachePath);
+
+  // The directory is created with the files' modification time, which is
+  // long enough ago for its entries to be cached.
+  auto makeFS = [&](time_t DirModTime, bool WithMissing) {
+    auto FS = llvm::makeIntrusiveRefCnt<llvm::vfs::InMemoryFileSystem>();
+    FS->addFile(Existing, DirModTime, llvm::MemoryBuffer::getMemBuffer(""));
+    if (WithMissing)
+      FS->addFile(Missing, DirModTime, llvm::MemoryBuffer::getMemBuffer(""));
+    return FS;
+  };
+  auto stat = [&](PersistentNegativeStatCache &Cache,
+                  llvm::vfs::FileSystem &FS, StringRef Path) {
+    llvm::vfs::Status Status;
+    return Cache.getStat(Path, Status, /*isFile=*/true, nullptr, FS);
+  };
+
+  {
+    auto FS = makeFS(1000, /*WithMissing=*/false);
+    PersistentNegativeStatCache Cache(CachePath);
+    EXPECT_FALSE(stat(Cache, *FS, Existing));
+    EXPECT_EQ(stat(Cache, *FS, Missing), std::errc::no_such_file_or_directory);
+  }
+
+  // While the directory is unchanged, the recorded failure is returned
+  // without consulting the file system.
+  {
+    auto FS = makeFS(1000, /*WithMissing=*/true);
+    PersistentNegativeStatCache Cache(CachePath);
+    EXPECT_EQ(stat(Cache, *FS, Missing), std::errc::no_such_file_or_directory);
+    EXPECT_FALSE(stat(Cache, *FS, Existing));
+  }
+
+  // A new modification time invalidates it.
+  {
+    auto FS = makeFS(2000, /*WithMissing=*/true);
+    PersistentNegativeStatCache Cache(CachePath);
+    EXPECT_FALSE(stat(Cache, *FS, Missing));
+  }
+}
+
 } // anonymous namespace
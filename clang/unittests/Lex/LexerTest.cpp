@@ -708,6 +708,33 @@ TEST_F(LexerTest, RawAndNormalLexSameForLineComments) {
   EXPECT_TRUE(ToksView.empty());
 }
 
+TEST_F(LexerTest, LongLineCommentsAndStringLiterals) {
+  // Long enough runs that the lexer scans them in chunks, with the interesting
+  // characters at varying offsets into a chunk.
+  std::string Filler(37, 'x');
+  std::string Literal1 = "\"" + Filler + "\\\"" + Filler + "\"";
+  std::string Literal2 = "\"" + Filler + "\xc3\xa9" + Filler + "\"";
+  std::string Literal3 = "\"" + Filler + "\\\n" + Filler + "\"";
+  std::string Source = "// " + Filler + "\xc3\xa9" + Filler + " \\\n" +
+                       Filler + "\n"
+                       "const char *a = " + Literal1 + ";\n"
+                       "const char *b = " + Literal2 + "; // " + Filler + "\n"
+                       "const char *c = " + Literal3 + ";\n";
+  LangOpts.LineComment = true;
+  std::vector<Token> Toks = CheckLex(
+      Source, {tok::kw_const, tok::kw_char, tok::star, tok::identifier,
+               tok::equal,    tok::string_literal, tok::semi,
+               tok::kw_const, tok::kw_char, tok::star, tok::identifier,
+               tok::equal,    tok::string_literal, tok::semi,
+               tok::kw_const, tok::kw_char, tok::star, tok::identifier,
+               tok::equal,    tok::string_literal, tok::semi});
+  ASSERT_EQ(Toks.size(), 21u);
+  EXPECT_EQ(Toks[5].getLength(), Literal1.size());
+  EXPECT_EQ(Toks[12].getLength(), Literal2.size());
+  EXPECT_EQ(Toks[19].getLength(), Literal3.size());
+  EXPECT_TRUE(Toks[19].needsCleaning());
+}
+
 TEST_F(LexerTest, GetRawTokenOnEscapedNewLineChecksWhitespace) {
   const llvm::StringLiteral Source = R"cc(
   #define ONE \
@@ -0,0 +1,90 @@
+//===- unittests/StaticAnalyzer/AnalysisWorkersTest.cpp -------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "CheckerRegistration.h"
+#include "clang/AST/Decl.h"
+#include "clang/StaticAnalyzer/Core/BugReporter/BugReporter.h"
+#include "clang/StaticAnalyzer/Core/BugReporter/BugType.h"
+#include "clang/StaticAnalyzer/Core/Checker.h"
+#include "clang/StaticAnalyzer/Core/PathSensitive/CheckerContext.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/StringRef.h"
+#include "gtest/gtest.h"
+
+using namespace clang;
+using namespace ento;
+
+namespace {
+
+// Reports every function analyzed as a top-level function.
+class TopLevelFunctionReporter : public Checker<check::BeginFunction> {
+  const BugType Bug{this, "Top-level function"};
+
+public:
+  void checkBeginFunction(CheckerContext &C) const {
+    if (!C.inTopFrame())
+      return;
+    const auto *FD = dyn_cast<FunctionDecl>(C.getStackFrame()->getDecl());
+    if (!FD)
+      return;
+    if (ExplodedNode *Node = C.generateNonFatalErrorNode(C.getState())) {
+      auto Report = std::make_unique<PathSensitiveBugReport>(
+          Bug, FD->getNameAsString(), Node);
+      C.emitReport(std::move(Report));
+    }
+  }
+};
+
+void addTopLevelFunctionReporter(AnalysisASTConsumer &AnalysisConsumer,
+                                 AnalyzerOptions &AnOpts) {
+  AnOpts.CheckersAndPackages = {{"test.TopLevelFunctionReporter", true}};
+  AnalysisConsumer.AddCheckerRegistrationFn([](CheckerRegistry &Registry) {
+    Registry.addChecker<TopLevelFunctionReporter>(
+        "test.TopLevelFunctionReporter", "Description", "");
+  });
+}
+
+std::vector<std::string> analyzedFunctions(const std::string &Code,
+                                           std::vector<std::string> Args) {
+  std::string Diags;
+  EXPECT_TRUE(runCheckerOnCodeWithArgs<addTopLevelFunctionReporter>(
+      Code, Args, Diags, /*OnlyEmitWarnings=*/true));
+  SmallVector<StringRef, 8> Lines;
+  StringRef(Diags).split(Lines, '\n', /*MaxSplit=*/-1, /*KeepEmpty=*/false);
+  std::vector<std::string> Names;
+  for (StringRef Line : Lines)
+    Names.push_back(Line.rsplit(": ").second.str());
+  return Names;
+}
+
+TEST(AnalysisWorkers, EachTopLevelFunctionIsAnalyzedOnce) {
+  constexpr auto Code = R"(
+    void leaf() {}
+    void caller() { leaf(); }
+    void a() {}
+    void b() {}
+    void c() {}
+  )";
+
+  std::vector<std::string> Serial = analyzedFunctions(Code, {});
+  llvm::sort(Serial);
+  ASSERT_FALSE(Serial.empty());
+
+  std::vector<std::string> Split;
+  for (const char *Index : {"worker-index=0", "worker-index=1"}) {
+    std::vector<std::string> Part = analyzedFunctions(
+        Code, {"-Xclang", "-analyzer-config", "-Xclang", "worker-count=2",
+               "-Xclang", "-analyzer-config", "-Xclang", Index});
+    EXPECT_FALSE(Part.empty());
+    llvm::append_range(Split, Part);
+  }
+  llvm::sort(Split);
+  EXPECT_EQ(Serial, Split);
+}
+
+} // namespace
@@ -15,6 +15,7 @@
 #include "llvm/Support/Path.h"
 #include "llvm/Support/TimeProfiler.h"
 #include "llvm/Support/VirtualFileSystem.h"
+#include <map>
 #include <stack>
 
 #include "gtest/gtest.h"
@@ -346,3 +347,42 @@ Frontend (test.c)
 )",
             buildTraceGraph(Json));
 }
+
+TEST(TimeProfilerTest, TemplateInstantiationSummary) {
+  std::string A_H = R"(
+    template <typename T>
+    struct S {
+      void foo() {}
+    };
+  )";
+  std::string Code = R"(
+    #include "a.h"
+    void user() {
+      S<int>().foo();
+      S<float>().foo();
+    }
+  )";
+
+  setupProfiler();
+  ASSERT_TRUE(compileFromString(Code, "-std=c++20", "test.cc",
+                                /*Headers=*/{{"a.h", A_H}}));
+  std::string Json = teardownProfiler();
+
+  Expected<json::Value> Root = json::parse(Json);
+  ASSERT_TRUE(bool(Root));
+  json::Array *Groups = Root->getAsObject()->getArray("groupSummary");
+  ASSERT_TRUE(Groups);
+  std::map<std::string, int64_t> Counts;
+  for (json::Value &Group : *Groups) {
+    json::Object *G = Group.getAsObject();
+    EXPECT_EQ(llvm::sys::path::filename(G->getString("file").value_or("")),
+              "a.h");
+    std::string Key =
+        G->getString("name")->str() + " " + G->getString("group")->str();
+    Counts[Key] = *G->getInteger("count");
+  }
+  EXPECT_EQ(Counts, (std::map<std::string, int64_t>{
+                        {"InstantiateClass S", 2},
+                        {"InstantiateFunction S::foo", 2},
+                    }));
+}
@@ -178,3 +178,34 @@ TEST(DependencyScanningFilesystem, CacheStatFailures) {
   DepFS.exists("/cache/a.pcm");
   EXPECT_EQ(InstrumentingFS->NumStatusCalls, 5u);
 }
+
+TEST(DependencyScanningFilesystem, InvalidateOutOfDateEntries) {
+  auto InMemoryFS = llvm::makeIntrusiveRefCnt<llvm::vfs::InMemoryFileSystem>();
+  InMemoryFS->setCurrentWorkingDirectory("/");
+  InMemoryFS->addFile("/foo", 0, llvm::MemoryBuffer::getMemBuffer(""));
+
+  auto InstrumentingFS =
+      llvm::makeIntrusiveRefCnt<llvm::vfs::TracingFileSystem>(InMemoryFS);
+
+  DependencyScanningFilesystemSharedCache SharedCache;
+  {
+    DependencyScanningWorkerFilesystem DepFS(SharedCache, InstrumentingFS);
+    EXPECT_TRUE(DepFS.status("/foo"));
+    EXPECT_FALSE(DepFS.status("/bar"));
+    EXPECT_EQ(InstrumentingFS->NumStatusCalls, 2u);
+  }
+
+  // Nothing changed, nothing is invalidated.
+  EXPECT_EQ(SharedCache.invalidateOutOfDateEntries(*InMemoryFS), 0u);
+
+  InMemoryFS->addFile("/bar", 0, llvm::MemoryBuffer::getMemBuffer("bar"));
+  EXPECT_EQ(SharedCache.invalidateOutOfDateEntries(*InMemoryFS), 1u);
+
+  DependencyScanningWorkerFilesystem DepFS(SharedCache, InstrumentingFS);
+  EXPECT_TRUE(DepFS.status("/foo"));
+  EXPECT_EQ(InstrumentingFS->NumStatusCalls, 2u); // Still cached.
+  auto Bar = DepFS.status("/bar");
+  ASSERT_TRUE(Bar);
+  EXPECT_EQ(Bar->getSize(), 3u);
+  EXPECT_EQ(InstrumentingFS->NumStatusCalls, 3u);
+}
@@ -125,8 +125,9 @@ static void PrintAccumulatedStats() {
   Lock lock(&print_lock);
   stats.Print();
   StackDepotStats stack_depot_stats = StackDepotGetStats();
-  Printf("Stats: StackDepot: %zd ids; %zdM allocated\n",
-         stack_depot_stats.n_uniq_ids, stack_depot_stats.allocated >> 20);
+  Printf("Stats: StackDepot: %zd ids; %zd words; %zdM allocated\n",
+         stack_depot_stats.n_uniq_ids, stack_depot_stats.n_words,
+         stack_depot_stats.allocated >> 20);
   PrintInternalAllocatorStats();
 }
 
@@ -15,6 +15,8 @@
 #include "FuzzerTracePC.h"
 #include "FuzzerUtil.h"
 
+#include <cctype>
+#include <cstdint>
 #include <fstream>
 #include <iterator>
 #include <set>
@@ -35,6 +37,30 @@ void Merger::ParseOrExit(std::istream &IS, bool ParseCoverage) {
   }
 }
 
+// Calls F for each of the numbers in Line that follow position Pos, until the
+// first character that isn't a number or a space, like extracting them from a
+// std::istringstream would. FT and COV lines of large corpora are long, and
+// this is much faster.
+template <class Callback>
+static void ForEachNumber(const std::string &Line, std::streamoff Pos,
+                          Callback F) {
+  if (Pos < 0)
+    return;
+  for (size_t I = Pos, E = Line.size(); I < E;) {
+    while (I < E && std::isspace(static_cast<unsigned char>(Line[I])))
+      I++;
+    if (I == E || Line[I] < '0' || Line[I] > '9')
+      return;
+    uint64_t N = 0;
+    for (; I < E && Line[I] >= '0' && Line[I] <= '9'; I++) {
+      N = N * 10 + (Line[I] - '0');
+      if (N > UINT32_MAX)
+        return;
+    }
+    F(static_cast<uint32_t>(N));
+  }
+}
+
 // The control file example:
 //
 // 3 # The number of inputs
@@ -103,8 +129,8 @@ bool Merger::Parse(std::istream &IS, bool ParseCoverage) {
       HaveFtMarker = true;
       if (ParseCoverage) {
         TmpFeatures.clear();  // use a vector from outer scope to avoid resizes.
-        while (ISS1 >> N)
-          TmpFeatures.push_back(N);
+        ForEachNumber(Line, ISS1.tellg(),
+                      [&](uint32_t Fe) { TmpFeatures.push_back(Fe); });
         std::sort(TmpFeatures.begin(), TmpFeatures.end());
         Files[CurrentFileIdx].Features = TmpFeatures;
       }
@@ -113,9 +139,10 @@ bool Merger::Parse(std::istream &IS, bool ParseCoverage) {
       if (CurrentFileIdx != LastSeenStartMarker)
         return false;
       if (ParseCoverage)
-        while (ISS1 >> N)
-          if (PCs.insert(N).second)
-            Files[CurrentFileIdx].Cov.push_back(N);
+        ForEachNumber(Line, ISS1.tellg(), [&](uint32_t PC) {
+          if (PCs.insert(PC).second)
+            Files[CurrentFileIdx].Cov.push_back(PC);
+        });
     } else {
       return false;
     }
@@ -26,11 +26,16 @@ template <class T> char *WriteBytes(const T &Pod, char *Buffer) {
   return Buffer + sizeof(T);
 }
 
-void RecordStackId(const uptr Key, UNUSED LockedMemInfoBlock *const &MIB,
-                   void *Arg) {
-  // No need to touch the MIB value here since we are only recording the key.
-  auto *StackIds = reinterpret_cast<Vector<u64> *>(Arg);
-  StackIds->PushBack(Key);
+struct MIBMapSummary {
+  Vector<u64> StackIds;
+  u64 TotalAccessHistogramEntries = 0;
+};
+
+// Collects everything needed to size the buffer in a single walk of the map.
+void RecordMIB(const uptr Key, LockedMemInfoBlock *const &MIB, void *Arg) {
+  auto *Summary = reinterpret_cast<MIBMapSummary *>(Arg);
+  Summary->StackIds.PushBack(Key);
+  Summary->TotalAccessHistogramEntries += MIB->mib.AccessHistogramSize;
 }
 } // namespace
 
@@ -232,24 +237,17 @@ u64 SerializeToRawProfile(MIBMapTy &MIBMap, ArrayRef<LoadedModule> Modules,
   // is a u64 which holds the number of entries in the section by convention.
   const u64 NumSegmentBytes = RoundUpTo(SegmentSizeBytes(Modules), 8);
 
-  Vector<u64> StackIds;
-  MIBMap.ForEach(RecordStackId, reinterpret_cast<void *>(&StackIds));
+  MIBMapSummary Summary;
+  MIBMap.ForEach(RecordMIB, reinterpret_cast<void *>(&Summary));
+  const Vector<u64> &StackIds = Summary.StackIds;
   // The first 8b are for the total number of MIB records. Each MIB record is
   // preceded by a 8b stack id which is associated with stack frames in the next
   // section.
   const u64 NumMIBInfoBytes = RoundUpTo(
       sizeof(u64) + StackIds.Size() * (sizeof(u64) + sizeof(MemInfoBlock)), 8);
 
-  // Get Number of AccessHistogram entries in total
-  u64 TotalAccessHistogramEntries = 0;
-  MIBMap.ForEach(
-      [](const uptr Key, UNUSED LockedMemInfoBlock *const &MIB, void *Arg) {
-        u64 *TotalAccessHistogramEntries = (u64 *)Arg;
-        *TotalAccessHistogramEntries += MIB->mib.AccessHistogramSize;
-      },
-      reinterpret_cast<void *>(&TotalAccessHistogramEntries));
   const u64 NumHistogramBytes =
-      RoundUpTo(TotalAccessHistogramEntries * sizeof(uint64_t), 8);
+      RoundUpTo(Summary.TotalAccessHistogramEntries * sizeof(uint64_t), 8);
 
   const u64 NumStackBytes = RoundUpTo(StackSizeBytes(StackIds), 8);
 
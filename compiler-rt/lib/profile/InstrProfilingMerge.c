@@ -158,19 +158,23 @@ int __llvm_profile_merge_from_buffer(const char *ProfileData,
   if (SrcNameStart < SrcCountersStart || SrcNameStart < SrcBitmapStart)
     return 1;
 
+  // The merge runs with the profile file locked, so keep the per-counter loops
+  // free of calls.
+  const int IsByteCoverage =
+      (__llvm_profile_get_version() & VARIANT_MASK_BYTE_COVERAGE) != 0;
+  const size_t CounterEntrySize = __llvm_profile_counter_entry_size();
+
   // Merge counters by iterating the entire counter section when data section is
   // empty due to correlation.
   if (Header->NumData == 0) {
-    for (uintptr_t SrcCounter = SrcCountersStart,
-                   DstCounter = (uintptr_t)__llvm_profile_begin_counters();
-         SrcCounter < SrcCountersEnd;) {
-      if (__llvm_profile_get_version() & VARIANT_MASK_BYTE_COVERAGE) {
-        *(char *)DstCounter &= *(const char *)SrcCounter;
-      } else {
-        *(uint64_t *)DstCounter += *(const uint64_t *)SrcCounter;
-      }
-      SrcCounter += __llvm_profile_counter_entry_size();
-      DstCounter += __llvm_profile_counter_entry_size();
+    char *DstCounters = (char *)__llvm_profile_begin_counters();
+    uint64_t NC = Header->NumCounters;
+    if (IsByteCoverage) {
+      for (uint64_t I = 0; I < NC; I++)
+        DstCounters[I] &= ((const char *)SrcCountersStart)[I];
+    } else {
+      for (uint64_t I = 0; I < NC; I++)
+        ((uint64_t *)DstCounters)[I] += ((const uint64_t *)SrcCountersStart)[I];
     }
     return 0;
   }
@@ -207,15 +211,15 @@ int __llvm_profile_merge_from_buffer(const char *ProfileData,
     if (NC == 0)
       return 1;
     if (SrcCounters < SrcCountersStart || SrcCounters >= SrcNameStart ||
-        (SrcCounters + __llvm_profile_counter_entry_size() * NC) > SrcNameStart)
+        (SrcCounters + CounterEntrySize * NC) > SrcNameStart)
       return 1;
-    for (unsigned I = 0; I < NC; I++) {
-      if (__llvm_profile_get_version() & VARIANT_MASK_BYTE_COVERAGE) {
-        // A value of zero signifies the function is covered.
+    if (IsByteCoverage) {
+      // A value of zero signifies the function is covered.
+      for (unsigned I = 0; I < NC; I++)
         ((char *)DstCounters)[I] &= ((const char *)SrcCounters)[I];
-      } else {
+    } else {
+      for (unsigned I = 0; I < NC; I++)
         ((uint64_t *)DstCounters)[I] += ((const uint64_t *)SrcCounters)[I];
-      }
     }
 
     uintptr_t SrcBitmap =
@@ -1083,6 +1083,10 @@ inline void AvoidCVE_2016_2143() {}
 struct StackDepotStats {
   uptr n_uniq_ids;
   uptr allocated;
+  // Number of words written to the stack store, before compression. This
+  // includes a header for each trace and block padding. Only reported by
+  // StackDepotGetStats().
+  uptr n_words = 0;
 };
 
 // The default value for allocator_release_to_os_interval_ms common flag to
@@ -46,8 +46,9 @@ void *BackgroundThread(void *arg) {
       StackDepotStats stack_depot_stats = StackDepotGetStats();
       if (prev_reported_stack_depot_size * 11 / 10 <
           stack_depot_stats.allocated) {
-        Printf("%s: StackDepot: %zd ids; %zdM allocated\n", SanitizerToolName,
-               stack_depot_stats.n_uniq_ids, stack_depot_stats.allocated >> 20);
+        Printf("%s: StackDepot: %zd ids; %zd words; %zdM allocated\n",
+               SanitizerToolName, stack_depot_stats.n_uniq_ids,
+               stack_depot_stats.n_words, stack_depot_stats.allocated >> 20);
         prev_reported_stack_depot_size = stack_depot_stats.allocated;
       }
     }
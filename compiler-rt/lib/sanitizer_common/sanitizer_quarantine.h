@@ -112,8 +112,13 @@ class Quarantine {
       SpinMutexLock l(&cache_mutex_);
       cache_.Transfer(c);
     }
-    if (cache_.Size() > GetMaxSize() && recycle_mutex_.TryLock())
+    atomic_fetch_add(&drain_count_, 1, memory_order_relaxed);
+    if (cache_.Size() <= GetMaxSize())
+      return;
+    if (recycle_mutex_.TryLock())
       Recycle(atomic_load_relaxed(&min_size_), cb);
+    else
+      atomic_fetch_add(&busy_recycle_count_, 1, memory_order_relaxed);
   }
 
   void NOINLINE DrainAndRecycle(Cache *c, Callback cb) {
@@ -129,6 +134,9 @@ class Quarantine {
     // It assumes that the world is stopped, just as the allocator's PrintStats.
     Printf("Quarantine limits: global: %zdMb; thread local: %zdKb\n",
            GetMaxSize() >> 20, GetMaxCacheSize() >> 10);
+    Printf("Quarantine drains: %zd; recycling already in progress: %zd\n",
+           atomic_load_relaxed(&drain_count_),
+           atomic_load_relaxed(&busy_recycle_count_));
     cache_.PrintStats();
   }
 
@@ -142,6 +150,11 @@ class Quarantine {
   StaticSpinMutex cache_mutex_;
   StaticSpinMutex recycle_mutex_;
   Cache cache_;
+  // Number of thread local caches transferred to the global one.
+  atomic_uintptr_t drain_count_;
+  // Number of those transfers that went over the limit while another thread
+  // was recycling, and left the recycling to it.
+  atomic_uintptr_t busy_recycle_count_;
   char pad2_[kCacheLineSize];
 
   void NOINLINE Recycle(uptr min_size, Callback cb)
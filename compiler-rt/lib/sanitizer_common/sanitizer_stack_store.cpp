@@ -71,6 +71,8 @@ uptr StackStore::Allocated() const {
   return atomic_load_relaxed(&allocated_) + sizeof(*this);
 }
 
+uptr StackStore::Words() const { return atomic_load_relaxed(&total_frames_); }
+
 uptr *StackStore::Alloc(uptr count, uptr *idx, uptr *pack) {
   for (;;) {
     // Optimisic lock-free allocation, essentially try to bump the
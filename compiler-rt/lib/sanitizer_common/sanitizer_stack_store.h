@@ -39,6 +39,9 @@ class StackStore {
            uptr *pack /* number of blocks completed by this call */);
   StackTrace Load(Id id);
   uptr Allocated() const;
+  // Number of words used by stored traces: the frames plus a header for each
+  // trace and any padding at the end of a block.
+  uptr Words() const;
 
   // Packs all blocks which don't expect any more writes. A block is going to be
   // packed once. As soon trace from that block was requested, it will unpack
@@ -203,7 +203,11 @@ StackDepotNode::args_type StackDepotNode::load(u32 id) const {
   return stackStore.Load(store_id);
 }
 
-StackDepotStats StackDepotGetStats() { return theDepot.GetStats(); }
+StackDepotStats StackDepotGetStats() {
+  StackDepotStats stats = theDepot.GetStats();
+  stats.n_words = stackStore.Words();
+  return stats;
+}
 
 u32 StackDepotPut(StackTrace stack) { return theDepot.Put(stack); }
 
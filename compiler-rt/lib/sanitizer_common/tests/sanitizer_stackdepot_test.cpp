@@ -74,6 +74,15 @@ TEST_F(StackDepotTest, Same) {
   EXPECT_EQ(0, internal_memcmp(stack.trace, array, sizeof(array)));
 }
 
+TEST_F(StackDepotTest, Words) {
+  uptr array[] = {1, 2, 3, 4, 7};
+  StackTrace s1(array, ARRAY_SIZE(array));
+  StackDepotPut(s1);
+  StackDepotPut(s1);
+  // A single copy of the trace, plus its header.
+  EXPECT_EQ(ARRAY_SIZE(array) + 1, StackDepotGetStats().n_words);
+}
+
 TEST_F(StackDepotTest, Several) {
   uptr array1[] = {1, 2, 3, 4, 7};
   StackTrace s1(array1, ARRAY_SIZE(array1));
@@ -14,7 +14,10 @@
 #include "gtest/gtest.h"
 
 #include <atomic>
+#include <cerrno>
+#include <cstdint>
 #include <future>
+#include <sys/mman.h>
 #include <thread>
 #include <unistd.h>
 
@@ -164,6 +167,37 @@ TEST(BufferQueueTest, GenerationalSupport) {
   EXPECT_EQ(Buffers.releaseBuffer(B1), BufferQueue::ErrorCode::Ok);
 }
 
+// Returns whether the page containing P is still mapped.
+static bool isMapped(void *P) {
+  uintptr_t PageSize = sysconf(_SC_PAGESIZE);
+  void *Page = reinterpret_cast<void *>(reinterpret_cast<uintptr_t>(P) &
+                                        ~(PageSize - 1));
+  if (msync(Page, PageSize, MS_ASYNC) == 0)
+    return true;
+  EXPECT_EQ(errno, ENOMEM);
+  return false;
+}
+
+TEST(BufferQueueTest, ReleasingOldGenerationFreesBackingStore) {
+  bool Success = false;
+  BufferQueue Buffers(kSize, 10, Success);
+  ASSERT_TRUE(Success);
+  BufferQueue::Buffer B0;
+  ASSERT_EQ(Buffers.getBuffer(B0), BufferQueue::ErrorCode::Ok);
+  void *OldData = B0.Data;
+  ASSERT_EQ(Buffers.finalize(), BufferQueue::ErrorCode::Ok);
+
+  // Re-initialising drops the queue's reference to the old backing store, but
+  // B0 still holds one and keeps it alive.
+  ASSERT_EQ(Buffers.init(kSize, 10), BufferQueue::ErrorCode::Ok);
+  ASSERT_TRUE(isMapped(OldData));
+
+  // Returning the last buffer of the old generation frees its backing store.
+  EXPECT_EQ(Buffers.releaseBuffer(B0), BufferQueue::ErrorCode::Ok);
+  EXPECT_EQ(B0.Data, nullptr);
+  EXPECT_FALSE(isMapped(OldData));
+}
+
 TEST(BufferQueueTest, GenerationalSupportAcrossThreads) {
   bool Success = false;
   BufferQueue Buffers(kSize, 10, Success);
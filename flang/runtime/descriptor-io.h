@@ -471,12 +471,12 @@ static RT_API_ATTRS bool UnformattedDescriptorIO(IoStatementState &io,
                            : childUnf->Receive(&x, totalBytes, swappingBytes);
       }
     }};
-    bool swapEndianness{externalUnf && externalUnf->unit().swapEndianness()};
-    if (!swapEndianness &&
-        descriptor.IsContiguous()) { // contiguous unformatted I/O
+    if (descriptor.IsContiguous()) { // contiguous unformatted I/O
+      // Byte swapping, if any, is applied by the unit to each unit of
+      // swappingBytes, so it doesn't need element-wise transfers.
       char &x{ExtractElement<char>(io, descriptor, subscripts)};
       return Transfer(x, numElements * elementBytes);
-    } else { // non-contiguous or byte-swapped intrinsic type unformatted I/O
+    } else { // non-contiguous intrinsic type unformatted I/O
       for (std::size_t j{0}; j < numElements; ++j) {
         char &x{ExtractElement<char>(io, descriptor, subscripts)};
         if (!Transfer(x, elementBytes)) {
@@ -53,6 +53,8 @@ private:
 
   void *allocate_impl(size_t alignment, size_t size);
 
+  bool grow_in_place(Block *block, size_t size);
+
   span<cpp::byte> block_to_span(Block *block) {
     return span<cpp::byte>(block->usable_space(), block->inner_size());
   }
@@ -182,6 +184,9 @@ LIBC_INLINE void *FreeListHeap::realloc(void *ptr, size_t size) {
   if (old_size >= size)
     return ptr;
 
+  if (grow_in_place(block, size))
+    return ptr;
+
   void *new_ptr = allocate(size);
   // Don't invalidate ptr if allocate(size) fails to initilize the memory.
   if (new_ptr == nullptr)
@@ -192,6 +197,34 @@ LIBC_INLINE void *FreeListHeap::realloc(void *ptr, size_t size) {
   return new_ptr;
 }
 
+// Grows a used block to at least `size` bytes by taking space from the free
+// block after it, if there is one large enough. This avoids a copy, and keeps
+// a buffer that is repeatedly grown from leaving its old copies behind.
+LIBC_INLINE bool FreeListHeap::grow_in_place(Block *block, size_t size) {
+  Block *next = block->next();
+  if (next->used() || block->inner_size() + next->outer_size() < size)
+    return false;
+
+  // Marking the block free brings the prev_ field of the next block back to
+  // life, but it holds the last bytes of the contents while the block is used.
+  cpp::byte *tail =
+      block->usable_space() + block->inner_size() - sizeof(size_t);
+  cpp::byte saved_tail[sizeof(size_t)];
+  LIBC_NAMESPACE::inline_memcpy(saved_tail, tail, sizeof(size_t));
+
+  block->mark_free();
+  free_store.remove(next);
+  block->merge_next();
+  // The block after `next` is used, free blocks are always coalesced, so the
+  // remainder can't be merged any further.
+  if (optional<Block *> remainder = block->split(size))
+    free_store.insert(*remainder);
+  block->mark_used();
+
+  LIBC_NAMESPACE::inline_memcpy(tail, saved_tail, sizeof(size_t));
+  return true;
+}
+
 LIBC_INLINE void *FreeListHeap::calloc(size_t num, size_t size) {
   size_t bytes;
   if (__builtin_mul_overflow(num, size, &bytes))
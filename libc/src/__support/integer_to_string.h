@@ -152,6 +152,14 @@ public:
 using StringBufferWriter = StringBufferWriterImpl<true>;
 using BackwardStringBufferWriter = StringBufferWriterImpl<false>;
 
+// The decimal representations of 0 to 99, two characters each.
+LIBC_INLINE_VAR constexpr char DECIMAL_DIGIT_PAIRS[] =
+    "0001020304050607080910111213141516171819"
+    "2021222324252627282930313233343536373839"
+    "4041424344454647484950515253545556575859"
+    "6061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
 } // namespace details
 
 namespace radix {
@@ -396,6 +404,15 @@ template <typename T, typename Fmt = radix::Dec> class IntegerToString {
     LIBC_INLINE static void
     write_unsigned_number_dec(UNSIGNED_T value,
                               details::BackwardStringBufferWriter &sink) {
+      // Built-in types are converted two digits at a time, which halves the
+      // number of divisions.
+      if constexpr (cpp::is_integral_v<UNSIGNED_T>) {
+        for (; sink.ok() && value >= 100; value /= 100) {
+          const size_t pair = static_cast<size_t>(value % 100);
+          sink.push(details::DECIMAL_DIGIT_PAIRS[2 * pair + 1]);
+          sink.push(details::DECIMAL_DIGIT_PAIRS[2 * pair]);
+        }
+      }
       while (sink.ok() && value != 0) {
         const uint8_t digit = extract_decimal_digit(value);
         sink.push(digit_char(digit));
@@ -167,10 +167,45 @@ LIBC_INLINE void quick_sort_impl(A &array, const void *ancestor_pivot,
   }
 }
 
+// Returns the length of the sorted run at the beginning of the array, and
+// sets |was_reversed| if that run is strictly descending.
+template <typename A, typename F>
+LIBC_INLINE size_t find_existing_run(const A &array, bool &was_reversed,
+                                     const F &is_less) {
+  const size_t array_len = array.len();
+  if (array_len < 2)
+    return array_len;
+
+  size_t run_len = 2;
+  was_reversed = is_less(array.get(1), array.get(0));
+  if (was_reversed) {
+    while (run_len < array_len &&
+           is_less(array.get(run_len), array.get(run_len - 1)))
+      ++run_len;
+  } else {
+    while (run_len < array_len &&
+           !is_less(array.get(run_len), array.get(run_len - 1)))
+      ++run_len;
+  }
+  return run_len;
+}
+
 constexpr size_t ilog2(size_t n) { return cpp::bit_width(n) - 1; }
 
 template <typename A, typename F>
 LIBC_INLINE void quick_sort(A &array, const F &is_less) {
+  // Arrays that are already sorted, in either direction, are common inputs.
+  // Detect them in linear time instead of partitioning them. The scan stops
+  // at the first element out of order, so it is cheap for other inputs.
+  bool was_reversed = false;
+  const size_t array_len = array.len();
+  if (find_existing_run(array, was_reversed, is_less) == array_len) {
+    if (was_reversed)
+      for (size_t i = 0; i < array_len / 2; ++i)
+        array.swap(i, array_len - 1 - i);
+    return;
+  }
+
   const void *ancestor_pivot = nullptr;
   // Limit the number of imbalanced partitions to `2 * floor(log2(len))`.
   // The binary OR by one is used to eliminate the zero-check in the logarithm.
@@ -153,6 +153,43 @@ TEST_FOR_EACH_ALLOCATOR(ReallocHasSameContent, 2048) {
   EXPECT_EQ(LIBC_NAMESPACE::memcmp(data1, data2, ALLOC_SIZE), 0);
 }
 
+TEST_FOR_EACH_ALLOCATOR(ReallocGrowsInPlace, 2048) {
+  constexpr size_t ALLOC_SIZE = 256;
+  constexpr size_t kNewAllocSize = 512;
+
+  byte *ptr1 = reinterpret_cast<byte *>(allocator.allocate(ALLOC_SIZE));
+  ASSERT_NE(ptr1, static_cast<byte *>(nullptr));
+  for (size_t i = 0; i < ALLOC_SIZE; ++i)
+    ptr1[i] = byte(i);
+
+  // The rest of the heap is free, so the block can take space from the block
+  // after it.
+  byte *ptr2 =
+      reinterpret_cast<byte *>(allocator.realloc(ptr1, kNewAllocSize));
+  ASSERT_EQ(ptr1, ptr2);
+  for (size_t i = 0; i < ALLOC_SIZE; ++i)
+    EXPECT_EQ(ptr2[i], byte(i));
+
+  // Space past the grown block is still available.
+  void *ptr3 = allocator.allocate(ALLOC_SIZE);
+  ASSERT_NE(ptr3, static_cast<void *>(nullptr));
+  EXPECT_GE(reinterpret_cast<byte *>(ptr3), ptr2 + kNewAllocSize);
+}
+
+TEST_FOR_EACH_ALLOCATOR(ReallocMovesWhenNextBlockIsUsed, 2048) {
+  constexpr size_t ALLOC_SIZE = 256;
+  constexpr size_t kNewAllocSize = 512;
+
+  void *ptr1 = allocator.allocate(ALLOC_SIZE);
+  void *ptr2 = allocator.allocate(ALLOC_SIZE);
+  ASSERT_NE(ptr1, static_cast<void *>(nullptr));
+  ASSERT_NE(ptr2, static_cast<void *>(nullptr));
+
+  void *ptr3 = allocator.realloc(ptr1, kNewAllocSize);
+  ASSERT_NE(ptr3, static_cast<void *>(nullptr));
+  EXPECT_NE(ptr1, ptr3);
+}
+
 TEST_FOR_EACH_ALLOCATOR(ReturnsNullReallocFreedPointer, 2048) {
   constexpr size_t ALLOC_SIZE = 512;
   constexpr size_t kNewAllocSize = 256;
@@ -80,6 +80,18 @@ public:
       ASSERT_EQ(array[i], i + 1);
   }
 
+  void test_sorted_array_with_last_element_out_of_order(
+      SortingRoutine sort_func) {
+    int array[] = {2,  3,  4,  5,  6,  7,  8,  9,  10, 11, 12, 13, 14,
+                   15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 1};
+    constexpr size_t ARRAY_LEN = sizeof(array) / sizeof(int);
+
+    int_sort(sort_func, array, ARRAY_LEN);
+
+    for (int i = 0; i < int(ARRAY_LEN); ++i)
+      ASSERT_EQ(array[i], i + 1);
+  }
+
   void test_all_equal_elements(SortingRoutine sort_func) {
     int array[] = {100, 100, 100, 100, 100, 100, 100, 100, 100,
                    100, 100, 100, 100, 100, 100, 100, 100, 100,
@@ -358,6 +370,9 @@ public:
   TEST_F(LlvmLibc##Name##Test, ReverseSortedArray) {                           \
     test_reversed_sorted_array(Func);                                          \
   }                                                                            \
+  TEST_F(LlvmLibc##Name##Test, SortedArrayWithLastElementOutOfOrder) {         \
+    test_sorted_array_with_last_element_out_of_order(Func);                    \
+  }                                                                            \
   TEST_F(LlvmLibc##Name##Test, AllEqualElements) {                             \
     test_all_equal_elements(Func);                                             \
   }                                                                            \
@@ -28,6 +28,7 @@
 #include <__format/formatter_char.h>
 #include <__format/formatter_floating_point.h>
 #include <__format/formatter_integer.h>
+#include <__format/formatter_output.h>
 #include <__format/formatter_pointer.h>
 #include <__format/formatter_string.h>
 #include <__format/parser_std_format_spec.h>
@@ -303,6 +304,18 @@ _LIBCPP_HIDE_FROM_ABI constexpr typename _Ctx::iterator __vformat_to(_ParseCtx&&
   auto __end                       = __parse_ctx.end();
   typename _Ctx::iterator __out_it = __ctx.out();
   while (__begin != __end) {
+    if constexpr (!same_as<remove_cvref_t<_Ctx>, __compile_time_basic_format_context<_CharT>>) {
+      // Write the literal text up to the next '{' or '}' at once, instead of
+      // one code unit at a time.
+      auto __first = __begin;
+      while (__begin != __end && *__begin != _CharT('{') && *__begin != _CharT('}'))
+        ++__begin;
+      if (__first != __begin) {
+        __out_it = __formatter::__copy(__first, __begin, std::move(__out_it));
+        continue;
+      }
+    }
+
     switch (*__begin) {
     case _CharT('{'):
       ++__begin;
@@ -116,7 +116,10 @@ static void __libcpp_platform_wake_by_address(__cxx_atomic_contention_t const vo
 
 #endif // __linux__
 
-static constexpr size_t __libcpp_contention_table_size = (1 << 8); /* < there's no magic in this number */
+// Unrelated atomics that hash to the same entry share its contention count,
+// so notifying one of them wakes the waiters of all of them. Each entry takes
+// a cache line, so the table is 64KiB of zero-initialized memory.
+static constexpr size_t __libcpp_contention_table_size = (1 << 10);
 
 struct alignas(64) /*  aim to avoid false sharing */ __libcpp_contention_table_entry {
   __cxx_atomic_contention_t __contention_state;
@@ -319,7 +319,9 @@ __parse_fractional_decimal_constant(const char* __input, ptrdiff_t __n, ptrdiff_
   const _Tp __mantissa_truncate_threshold = numeric_limits<_Tp>::max() / 10;
   bool __fraction                         = false;
   for (; __offset < __n; ++__offset) {
-    if (std::isdigit(__input[__offset])) {
+    // Compare against the digits directly, std::isdigit needs to look up the
+    // character class in the current C locale.
+    if (__input[__offset] >= '0' && __input[__offset] <= '9') {
       __result.__is_valid = true;
 
       uint32_t __digit = __input[__offset] - '0';
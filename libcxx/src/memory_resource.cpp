@@ -6,6 +6,7 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <bit>
 #include <cstddef>
 #include <memory>
 #include <memory_resource>
@@ -283,15 +284,8 @@ int unsynchronized_pool_resource::__pool_index(size_t bytes, size_t align) const
   if (align > alignof(std::max_align_t) || bytes > (size_t(1) << __num_fixed_pools_))
     return __num_fixed_pools_;
   else {
-    int i = 0;
     bytes = (bytes > align) ? bytes : align;
-    bytes -= 1;
-    bytes >>= __log2_smallest_block_size;
-    while (bytes != 0) {
-      bytes >>= 1;
-      i += 1;
-    }
-    return i;
+    return std::bit_width((bytes - 1) >> __log2_smallest_block_size);
   }
 }
 
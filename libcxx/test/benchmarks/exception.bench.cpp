@@ -0,0 +1,54 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, no-exceptions
+
+#include <benchmark/benchmark.h>
+#include <stdexcept>
+
+#include "test_macros.h"
+
+// Throws an E from depth frames below the caller. Each frame has a cleanup, so
+// the personality routine has work to do in every one of them.
+template <class E>
+TEST_NOINLINE void throw_at_depth(int depth) {
+  struct Cleanup {
+    ~Cleanup() { benchmark::ClobberMemory(); }
+  } cleanup;
+  if (depth == 0)
+    throw E("benchmark");
+  throw_at_depth<E>(depth - 1);
+}
+
+template <class Catch, class E>
+void bm_throw_catch(benchmark::State& state) {
+  const int depth = state.range(0);
+  for (auto _ : state) {
+    try {
+      throw_at_depth<E>(depth);
+    } catch (const Catch& e) {
+      benchmark::DoNotOptimize(&e);
+    }
+  }
+}
+BENCHMARK(bm_throw_catch<std::runtime_error, std::runtime_error>)->Arg(1)->Arg(10)->Arg(50);
+BENCHMARK(bm_throw_catch<std::exception, std::range_error>)->Arg(1)->Arg(10)->Arg(50);
+
+void bm_throw_catch_all(benchmark::State& state) {
+  const int depth = state.range(0);
+  for (auto _ : state) {
+    try {
+      throw_at_depth<std::runtime_error>(depth);
+    } catch (...) {
+      benchmark::ClobberMemory();
+    }
+  }
+}
+BENCHMARK(bm_throw_catch_all)->Arg(1)->Arg(10)->Arg(50);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,72 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14, c++17
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "GenerateInput.h"
+#include "test_macros.h"
+
+template <class GenInputs>
+void BM_Insert(benchmark::State& st, GenInputs gen) {
+  auto in   = gen(st.range(0));
+  using Key = typename decltype(in)::value_type;
+  for (auto _ : st) {
+    std::unordered_map<Key, int> m;
+    for (const auto& k : in)
+      m.emplace(k, 0);
+    benchmark::DoNotOptimize(m);
+  }
+}
+
+template <class GenInputs>
+void BM_FindHit(benchmark::State& st, GenInputs gen) {
+  auto in   = gen(st.range(0));
+  using Key = typename decltype(in)::value_type;
+  std::unordered_map<Key, int> m;
+  for (const auto& k : in)
+    m.emplace(k, 0);
+  for (auto _ : st) {
+    for (const auto& k : in)
+      benchmark::DoNotOptimize(m.find(k));
+  }
+}
+
+template <class GenInputs>
+void BM_FindMiss(benchmark::State& st, GenInputs gen) {
+  // Look up the second half of the inputs in a map of the first half.
+  auto in   = gen(2 * st.range(0));
+  using Key = typename decltype(in)::value_type;
+  std::unordered_map<Key, int> m;
+  for (std::size_t i = 0; i < in.size() / 2; ++i)
+    m.emplace(in[i], 0);
+  for (std::size_t i = in.size() / 2; i < in.size(); ++i)
+    m.erase(in[i]);
+  for (auto _ : st) {
+    for (std::size_t i = in.size() / 2; i < in.size(); ++i)
+      benchmark::DoNotOptimize(m.find(in[i]));
+  }
+}
+
+BENCHMARK_CAPTURE(BM_Insert, uint64_random, getRandomIntegerInputs<uint64_t>)->Range(1 << 4, 1 << 16);
+BENCHMARK_CAPTURE(BM_Insert, string_random, getRandomStringInputs)->Range(1 << 4, 1 << 16);
+
+BENCHMARK_CAPTURE(BM_FindHit, uint64_random, getRandomIntegerInputs<uint64_t>)->Range(1 << 4, 1 << 16);
+BENCHMARK_CAPTURE(BM_FindHit, string_random, getRandomStringInputs)->Range(1 << 4, 1 << 16);
+
+BENCHMARK_CAPTURE(BM_FindMiss, uint64_random, getRandomIntegerInputs<uint64_t>)->Range(1 << 4, 1 << 16);
+BENCHMARK_CAPTURE(BM_FindMiss, string_random, getRandomStringInputs)->Range(1 << 4, 1 << 16);
+
+BENCHMARK_MAIN();
@@ -36,6 +36,7 @@
 #include "llvm/Support/BinaryStreamReader.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Debug.h"
+#include "llvm/Support/Format.h"
 #include "llvm/Support/LEB128.h"
 #include "llvm/Support/MathExtras.h"
 #include "llvm/Support/Parallel.h"
@@ -1262,6 +1263,54 @@ void LinkerDriver::parsePDBAltPath() {
   ctx.config.pdbAltPath = buf;
 }
 
+// Print how much input each kind of file brought in, and how much of the
+// section contents of object files was kept by /opt:ref, for /summary.
+static void printInputSummary(COFFLinkerContext &ctx) {
+  SmallString<256> buffer;
+  raw_svector_ostream stream(buffer);
+
+  stream << center_justify("Input Summary", 80) << '\n'
+         << std::string(80, '-') << '\n';
+
+  auto print = [&](uint64_t v, StringRef s) {
+    stream << format_decimal(v, 15) << " " << s << '\n';
+  };
+
+  uint64_t objBytes = 0, sectionBytes = 0, liveSectionBytes = 0;
+  for (ObjFile *file : ctx.objFileInstances) {
+    objBytes += file->mb.getBufferSize();
+    for (Chunk *c : file->getChunks()) {
+      auto *sc = dyn_cast<SectionChunk>(c);
+      if (!sc)
+        continue;
+      sectionBytes += sc->getSize();
+      if (sc->live)
+        liveSectionBytes += sc->getSize();
+    }
+  }
+  print(ctx.objFileInstances.size(), "Object files");
+  print(objBytes, "Object file bytes");
+  print(sectionBytes, "Section bytes");
+  print(liveSectionBytes, "Live section bytes");
+
+  uint64_t numBitcodeFiles = 0, bitcodeBytes = 0;
+  ctx.forEachSymtab([&](SymbolTable &symtab) {
+    numBitcodeFiles += symtab.bitcodeFileInstances.size();
+    for (BitcodeFile *file : symtab.bitcodeFileInstances)
+      bitcodeBytes += file->mb.getBufferSize();
+  });
+  print(numBitcodeFiles, "Bitcode files");
+  print(bitcodeBytes, "Bitcode file bytes");
+
+  uint64_t importBytes = 0;
+  for (ImportFile *file : ctx.importFileInstances)
+    importBytes += file->mb.getBufferSize();
+  print(ctx.importFileInstances.size(), "Import files");
+  print(importBytes, "Import file bytes");
+
+  Msg(ctx) << buffer;
+}
+
 /// Convert resource files and potentially merge input resource object
 /// trees into one resource tree.
 /// Call after ObjFile::Instances is complete.
@@ -2789,6 +2838,9 @@ void LinkerDriver::linkerMain(ArrayRef<const char *> argsArr) {
   // Write the result.
   writeResult(ctx);
 
+  if (config->showSummary)
+    printInputSummary(ctx);
+
   // Stop early so we can print the results.
   rootTimer.stop();
   if (config->showTiming)
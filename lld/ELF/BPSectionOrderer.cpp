@@ -64,8 +64,8 @@ struct BPOrdererELF : lld::BPOrderer<BPOrdererELF> {
 
 DenseMap<const InputSectionBase *, int> elf::runBalancedPartitioning(
     Ctx &ctx, StringRef profilePath, bool forFunctionCompression,
-    bool forDataCompression, bool compressionSortStartupFunctions,
-    bool verbose) {
+    bool forDataCompression, bool compressionSortStartupFunctions, bool verbose,
+    const DenseMap<const InputSectionBase *, int> &leadingOrder) {
   // Collect candidate sections and associated symbols.
   SmallVector<InputSectionBase *> sections;
   DenseMap<CachedHashStringRef, std::set<unsigned>> rootSymbolToSectionIdxs;
@@ -78,6 +78,10 @@ DenseMap<const InputSectionBase *, int> elf::runBalancedPartitioning(
     auto *sec = dyn_cast_or_null<InputSectionBase>(d->section);
     if (!sec || sec->size == 0 || !orderer.secToSym.try_emplace(sec, d).second)
       return;
+    // Sections that are already ordered keep their symbol for the page fault
+    // estimate, but are not ordered again.
+    if (leadingOrder.count(sec))
+      return;
     rootSymbolToSectionIdxs[CachedHashStringRef(getRootSymbol(sym.getName()))]
         .insert(sections.size());
     sections.emplace_back(sec);
@@ -88,8 +92,19 @@ DenseMap<const InputSectionBase *, int> elf::runBalancedPartitioning(
   for (ELFFileBase *file : ctx.objectFiles)
     for (Symbol *sym : file->getLocalSymbols())
       addSection(*sym);
-  return orderer.computeOrder(profilePath, forFunctionCompression,
-                              forDataCompression,
-                              compressionSortStartupFunctions, verbose,
-                              sections, rootSymbolToSectionIdxs);
+
+  SmallVector<const InputSectionBase *, 0> leadingSections;
+  for (auto [sec, prio] : leadingOrder)
+    leadingSections.push_back(sec);
+  llvm::sort(leadingSections,
+             [&](const InputSectionBase *a, const InputSectionBase *b) {
+               return leadingOrder.lookup(a) < leadingOrder.lookup(b);
+             });
+  if (verbose && !leadingSections.empty())
+    dbgs() << "Placed " << leadingSections.size()
+           << " already ordered sections first\n";
+  return orderer.computeOrder(
+      profilePath, forFunctionCompression, forDataCompression,
+      compressionSortStartupFunctions, verbose, sections,
+      rootSymbolToSectionIdxs, leadingSections);
 }
@@ -27,10 +27,13 @@ class InputSectionBase;
 /// It is important that -ffunction-sections and -fdata-sections compiler flags
 /// are used to ensure functions and data are in their own sections and thus
 /// can be reordered.
-llvm::DenseMap<const InputSectionBase *, int>
-runBalancedPartitioning(Ctx &ctx, llvm::StringRef profilePath,
-                        bool forFunctionCompression, bool forDataCompression,
-                        bool compressionSortStartupFunctions, bool verbose);
+///
+/// Sections in \p leadingOrder, e.g. the hot sections ordered by the call
+/// graph profile, are left out and assumed to be placed first.
+llvm::DenseMap<const InputSectionBase *, int> runBalancedPartitioning(
+    Ctx &ctx, llvm::StringRef profilePath, bool forFunctionCompression,
+    bool forDataCompression, bool compressionSortStartupFunctions, bool verbose,
+    const llvm::DenseMap<const InputSectionBase *, int> &leadingOrder = {});
 
 } // namespace lld::elf
 
@@ -266,6 +266,7 @@ struct Config {
   CGProfileSortKind callGraphProfileSort;
   llvm::StringRef irpgoProfilePath;
   bool bpStartupFunctionSort = false;
+  bool bpCallGraphProfileSort = false;
   bool bpCompressionSortStartupFunctions = false;
   bool bpFunctionOrderForCompression = false;
   bool bpDataOrderForCompression = false;
@@ -410,6 +411,7 @@ struct Config {
   unsigned optimize;
   StringRef thinLTOJobs;
   unsigned timeTraceGranularity;
+  unsigned timeTraceMaxEvents;
   int32_t splitStackAdjustSize;
   StringRef packageMetadata;
 
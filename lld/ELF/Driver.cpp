@@ -652,8 +652,10 @@ void LinkerDriver::linkerMain(ArrayRef<const char *> argsArr) {
     return;
 
   // Initialize time trace profiler.
-  if (ctx.arg.timeTraceEnabled)
+  if (ctx.arg.timeTraceEnabled) {
     timeTraceProfilerInitialize(ctx.arg.timeTraceGranularity, ctx.arg.progName);
+    timeTraceProfilerSetMaxEvents(ctx.arg.timeTraceMaxEvents);
+  }
 
   {
     llvm::TimeTraceScope timeScope("ExecuteLinker");
@@ -1151,6 +1153,9 @@ static void parseBPOrdererOptions(Ctx &ctx, opt::InputArgList &args) {
   ctx.arg.bpCompressionSortStartupFunctions =
       args.hasFlag(OPT_bp_compression_sort_startup_functions,
                    OPT_no_bp_compression_sort_startup_functions, false);
+  ctx.arg.bpCallGraphProfileSort =
+      args.hasFlag(OPT_bp_call_graph_profile_sort,
+                   OPT_no_bp_call_graph_profile_sort, false);
   ctx.arg.bpVerboseSectionOrderer = args.hasArg(OPT_verbose_bp_section_orderer);
 
   ctx.arg.irpgoProfilePath = args.getLastArgValue(OPT_irpgo_profile);
@@ -1512,6 +1517,8 @@ static void readConfigs(Ctx &ctx, opt::InputArgList &args) {
       args.hasArg(OPT_time_trace_eq) && !ctx.e.disableOutput;
   ctx.arg.timeTraceGranularity =
       args::getInteger(args, OPT_time_trace_granularity, 500);
+  ctx.arg.timeTraceMaxEvents =
+      args::getInteger(args, OPT_time_trace_max_events, 0);
   ctx.arg.trace = args.hasArg(OPT_trace);
   ctx.arg.undefined = args::getStrings(args, OPT_undefined);
   ctx.arg.undefinedVersion =
@@ -150,10 +150,11 @@ private:
   // the index of the next class. If threading is enabled, they are either
   // (0, 1) or (1, 0).
   //
-  // Note on single-thread: if that's the case, they are always (0, 0)
+  // Note on single-thread: if that's the case, they are always equal
   // because we can safely read the next class without worrying about race
   // conditions. Using the same location makes this algorithm converge
-  // faster because it uses results of the same iteration earlier.
+  // faster because it uses results of the same iteration earlier. They are
+  // (0, 0) unless a parallel round ran first, in which case they are (1, 1).
   int current = 0;
   int next = 0;
 };
@@ -414,6 +415,9 @@ void ICF<ELFT>::forEachClass(llvm::function_ref<void(size_t, size_t)> fn) {
   // If threading is disabled or the number of sections are
   // too small to use threading, call Fn sequentially.
   if (parallel::strategy.ThreadsRequested == 1 || sections.size() < 1024) {
+    // Update the slot written last in place. This only differs from slot 0 if
+    // earlier rounds ran in parallel on more sections.
+    current = next;
     forEachClassRange(0, sections.size(), fn);
     ++cnt;
     return;
@@ -522,6 +526,30 @@ template <class ELFT> void ICF<ELFT>::run() {
     segregate(begin, end, eqClassBase, true);
   });
 
+  // Most sections are unique by now and can't be folded. Drop them, so that
+  // the rounds below only visit classes that may still split. Their class
+  // IDs stay valid for relocations referring to them, so copy them into both
+  // slots. As class IDs are derived from positions in `sections`, following
+  // rounds use a base past all IDs assigned so far.
+  {
+    llvm::TimeTraceScope timeScope("Drop unique sections");
+    // forEachClassRange() groups by the `current` slot, but a parallel round
+    // leaves its results in `next`.
+    current = next;
+    size_t numSections = sections.size();
+    SmallVector<InputSection *, 0> candidates;
+    forEachClassRange(0, numSections, [&](size_t begin, size_t end) {
+      if (end - begin == 1) {
+        InputSection *s = sections[begin];
+        s->eqClass[0] = s->eqClass[1] = s->eqClass[next];
+        return;
+      }
+      candidates.append(sections.begin() + begin, sections.begin() + end);
+    });
+    sections = std::move(candidates);
+    eqClassBase += numSections;
+  }
+
   // Split groups by comparing relocations until convergence is obtained.
   do {
     repeat = false;
@@ -535,13 +563,19 @@ template <class ELFT> void ICF<ELFT>::run() {
   auto print = [&ctx = ctx]() -> ELFSyncStream {
     return {ctx, ctx.arg.printIcfSections ? DiagLevel::Msg : DiagLevel::None};
   };
-  // Merge sections by the equivalence class.
+  // Merge sections by the equivalence class, as computed by the last round.
+  current = next;
+  size_t numClasses = 0, numFolded = 0;
+  uint64_t bytesSaved = 0;
   forEachClassRange(0, sections.size(), [&](size_t begin, size_t end) {
     if (end - begin == 1)
       return;
+    ++numClasses;
     print() << "selected section " << sections[begin];
     for (size_t i = begin + 1; i < end; ++i) {
       print() << "  removing identical section " << sections[i];
+      ++numFolded;
+      bytesSaved += sections[i]->getSize();
       sections[begin]->replace(sections[i]);
 
       // At this point we know sections merged are fully identical and hence
@@ -552,6 +586,9 @@ template <class ELFT> void ICF<ELFT>::run() {
     }
   });
 
+  Log(ctx) << "ICF folded " << numFolded << " sections into " << numClasses
+           << " classes, saving " << bytesSaved << " bytes";
+
   // Change Defined symbol's section field to the canonical one.
   auto fold = [](Symbol *sym) {
     if (auto *d = dyn_cast<Defined>(sym))
@@ -26,6 +26,7 @@
 #include "llvm/Support/ARMBuildAttributes.h"
 #include "llvm/Support/Endian.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/RISCVAttributeParser.h"
 #include "llvm/Support/TimeProfiler.h"
@@ -349,6 +350,13 @@ template <class ELFT>
 static void
 doParseFiles(Ctx &ctx,
              const SmallVector<std::unique_ptr<InputFile>, 0> &files) {
+  // Symbol resolution below is serial, but hashing symbol names only reads
+  // the input files. Do that in parallel first.
+  parallelForEach(files, [&](const std::unique_ptr<InputFile> &file) {
+    if (file->kind() == InputFile::ObjKind && file->ekind == ctx.arg.ekind)
+      cast<ObjFile<ELFT>>(file.get())->hashGlobalSymbolNames();
+  });
+
   // Add all files to the symbol table. This will add almost all symbols that we
   // need to the symbol table. This process might add files to the link due to
   // addDependentLibrary.
@@ -1113,10 +1121,10 @@ void ObjFile<ELFT>::initializeSymbols(const object::ELFFile<ELFT> &obj) {
     symbols = std::make_unique<Symbol *[]>(numSymbols);
 
   // Some entries have been filled by LazyObjFile.
-  auto *symtab = ctx.symtab.get();
   for (size_t i = firstGlobal, end = eSyms.size(); i != end; ++i)
     if (!symbols[i])
-      symbols[i] = symtab->insert(CHECK2(eSyms[i].getName(stringTable), this));
+      symbols[i] = insertGlobal(i, CHECK2(eSyms[i].getName(stringTable), this));
+  globalSymHashes = {};
 
   // Perform symbol resolution on non-local symbols.
   SmallVector<unsigned, 32> undefineds;
@@ -1911,15 +1919,42 @@ template <class ELFT> void ObjFile<ELFT>::parseLazy() {
   // resolve() may trigger this->extract() if an existing symbol is an undefined
   // symbol. If that happens, this function has served its purpose, and we can
   // exit from the loop early.
-  auto *symtab = ctx.symtab.get();
   for (size_t i = firstGlobal, end = eSyms.size(); i != end; ++i) {
     if (eSyms[i].st_shndx == SHN_UNDEF)
       continue;
-    symbols[i] = symtab->insert(CHECK2(eSyms[i].getName(stringTable), this));
+    symbols[i] = insertGlobal(i, CHECK2(eSyms[i].getName(stringTable), this));
     symbols[i]->resolve(ctx, LazySymbol{*this});
     if (!lazy)
       break;
   }
+  // Symbols that are left are inserted if the file is extracted, which is
+  // rare enough not to keep the hashes around.
+  globalSymHashes = {};
+}
+
+template <class ELFT> void ObjFile<ELFT>::hashGlobalSymbolNames() {
+  ArrayRef<Elf_Sym> eSyms = this->getELFSyms<ELFT>();
+  if (eSyms.size() <= firstGlobal)
+    return;
+  SmallVector<uint32_t, 0> hashes;
+  hashes.reserve(eSyms.size() - firstGlobal);
+  for (const Elf_Sym &eSym : eSyms.slice(firstGlobal)) {
+    Expected<StringRef> name = eSym.getName(stringTable);
+    // Leave the error to be reported by the serial parse.
+    if (!name) {
+      consumeError(name.takeError());
+      return;
+    }
+    hashes.push_back(SymbolTable::hashSymbolName(*name));
+  }
+  globalSymHashes = std::move(hashes);
+}
+
+template <class ELFT>
+Symbol *ObjFile<ELFT>::insertGlobal(size_t i, StringRef name) {
+  if (globalSymHashes.empty())
+    return ctx.symtab->insert(name);
+  return ctx.symtab->insert(name, globalSymHashes[i - firstGlobal]);
 }
 
 bool InputFile::shouldExtractForCommon(StringRef name) const {
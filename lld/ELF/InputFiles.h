@@ -294,6 +294,10 @@ public:
   void postParse();
   void importCmseSymbols();
 
+  // Compute the symbol table hashes of the names of global symbols. This
+  // only reads the file, so it can be done in parallel before parse().
+  void hashGlobalSymbolNames();
+
 private:
   void initializeSections(bool ignoreComdats,
                           const llvm::object::ELFFile<ELFT> &obj);
@@ -319,6 +323,13 @@ private:
   // The following variable contains the contents of .symtab_shndx.
   // If the section does not exist (which is common), the array is empty.
   ArrayRef<Elf_Word> shndxTable;
+
+  // SymbolTable::hashSymbolName() of each global symbol, indexed from
+  // firstGlobal, if computed by hashGlobalSymbolNames(). Released once the
+  // symbols are inserted.
+  SmallVector<uint32_t, 0> globalSymHashes;
+
+  Symbol *insertGlobal(size_t i, StringRef name);
 };
 
 class BitcodeFile : public InputFile {
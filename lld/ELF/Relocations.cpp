@@ -1689,22 +1689,30 @@ template <class ELFT> void elf::scanRelocations(Ctx &ctx) {
   // for parallelism.
   bool serial = !ctx.arg.zCombreloc || ctx.arg.emachine == EM_MIPS ||
                 ctx.arg.emachine == EM_PPC64;
+  // Scanning a section doesn't depend on other sections of the same file, so
+  // files with many sections, typically LTO output, are split into several
+  // tasks to balance the load.
+  constexpr size_t sectionsPerTask = 1024;
   parallel::TaskGroup tg;
   auto outerFn = [&]() {
     for (ELFFileBase *f : ctx.objectFiles) {
-      auto fn = [f, &ctx]() {
-        RelocationScanner scanner(ctx);
-        for (InputSectionBase *s : f->getSections()) {
-          if (s && s->kind() == SectionBase::Regular && s->isLive() &&
-              (s->flags & SHF_ALLOC) &&
-              !(s->type == SHT_ARM_EXIDX && ctx.arg.emachine == EM_ARM))
-            scanner.template scanSection<ELFT>(*s);
-        }
-      };
-      if (serial)
-        fn();
-      else
-        tg.spawn(fn);
+      ArrayRef<InputSectionBase *> sections = f->getSections();
+      for (size_t i = 0, e = sections.size(); i < e; i += sectionsPerTask) {
+        auto fn = [&ctx, sections = sections.slice(
+                             i, std::min(sectionsPerTask, e - i))]() {
+          RelocationScanner scanner(ctx);
+          for (InputSectionBase *s : sections) {
+            if (s && s->kind() == SectionBase::Regular && s->isLive() &&
+                (s->flags & SHF_ALLOC) &&
+                !(s->type == SHT_ARM_EXIDX && ctx.arg.emachine == EM_ARM))
+              scanner.template scanSection<ELFT>(*s);
+          }
+        };
+        if (serial)
+          fn();
+        else
+          tg.spawn(fn);
+      }
     }
     auto scanEH = [&] {
       RelocationScanner scanner(ctx);
@@ -45,6 +45,11 @@ public:
 
   Symbol *insert(StringRef name);
 
+  // Same as insert(name), with hash being hashSymbolName(name). Hashing does
+  // not touch the table, so callers can hash names in parallel ahead of time.
+  Symbol *insert(StringRef name, uint32_t hash);
+  static uint32_t hashSymbolName(StringRef name);
+
   template <typename T> Symbol *addSymbol(const T &newSym) {
     Symbol *sym = insert(newSym.getName());
     sym->resolve(ctx, newSym);
@@ -3480,7 +3480,7 @@ readPubNamesAndTypes(Ctx &ctx, const LLDDwarfObj<ELFT> &obj,
 static std::pair<SmallVector<GdbIndexSection::GdbSymbol, 0>, size_t>
 createSymbols(
     Ctx &ctx,
-    ArrayRef<SmallVector<GdbIndexSection::NameAttrEntry, 0>> nameAttrs,
+    MutableArrayRef<SmallVector<GdbIndexSection::NameAttrEntry, 0>> nameAttrs,
     const SmallVector<GdbIndexSection::GdbChunk, 0> &chunks) {
   using GdbSymbol = GdbIndexSection::GdbSymbol;
   using NameAttrEntry = GdbIndexSection::NameAttrEntry;
@@ -3500,26 +3500,46 @@ createSymbols(
   const size_t concurrency =
       llvm::bit_floor(std::min<size_t>(ctx.arg.threadCount, numShards));
   const size_t shift = 32 - llvm::countr_zero(numShards);
+
+  // First group the entries of each file by shard, keeping their relative
+  // order, so that each thread only visits the entries of its own shards.
+  auto shardBegins =
+      std::make_unique<std::array<uint32_t, numShards + 1>[]>(nameAttrs.size());
+  parallelFor(0, nameAttrs.size(), [&](size_t i) {
+    SmallVector<NameAttrEntry, 0> &entries = nameAttrs[i];
+    llvm::stable_sort(entries, [&](const NameAttrEntry &a,
+                                   const NameAttrEntry &b) {
+      return (a.name.hash() >> shift) < (b.name.hash() >> shift);
+    });
+    std::array<uint32_t, numShards + 1> &begins = shardBegins[i];
+    for (size_t shardId = 0, j = 0; shardId <= numShards; ++shardId) {
+      while (j != entries.size() && (entries[j].name.hash() >> shift) < shardId)
+        ++j;
+      begins[shardId] = j;
+    }
+  });
+
   auto map =
       std::make_unique<DenseMap<CachedHashStringRef, size_t>[]>(numShards);
   auto symbols = std::make_unique<SmallVector<GdbSymbol, 0>[]>(numShards);
   parallelFor(0, concurrency, [&](size_t threadId) {
-    uint32_t i = 0;
-    for (ArrayRef<NameAttrEntry> entries : nameAttrs) {
-      for (const NameAttrEntry &ent : entries) {
-        size_t shardId = ent.name.hash() >> shift;
-        if ((shardId & (concurrency - 1)) != threadId)
-          continue;
-
-        uint32_t v = ent.cuIndexAndAttrs + cuIdxs[i];
-        auto [it, inserted] =
-            map[shardId].try_emplace(ent.name, symbols[shardId].size());
-        if (inserted)
-          symbols[shardId].push_back({ent.name, {v}, 0, 0});
-        else
-          symbols[shardId][it->second].cuVector.push_back(v);
+    for (size_t i = 0, e = nameAttrs.size(); i != e; ++i) {
+      ArrayRef<NameAttrEntry> entries = nameAttrs[i];
+      for (size_t shardId = threadId; shardId < numShards;
+           shardId += concurrency) {
+        for (const NameAttrEntry &ent :
+             entries.slice(shardBegins[i][shardId],
+                           shardBegins[i][shardId + 1] -
+                               shardBegins[i][shardId])) {
+          uint32_t v = ent.cuIndexAndAttrs + cuIdxs[i];
+          auto [it, inserted] =
+              map[shardId].try_emplace(ent.name, symbols[shardId].size());
+          if (inserted)
+            symbols[shardId].push_back({ent.name, {v}, 0, 0});
+          else
+            symbols[shardId][it->second].cuVector.push_back(v);
+        }
       }
-      ++i;
     }
   });
 
@@ -3677,14 +3697,14 @@ void GdbIndexSection::writeTo(uint8_t *buf) {
   });
 
   // Write the CU vectors.
-  for (GdbSymbol &sym : symbols) {
-    write32le(buf, sym.cuVector.size());
-    buf += 4;
+  parallelForEach(symbols, [&](GdbSymbol &sym) {
+    uint8_t *p = buf + sym.cuVectorOff;
+    write32le(p, sym.cuVector.size());
     for (uint32_t val : sym.cuVector) {
-      write32le(buf, val);
-      buf += 4;
+      p += 4;
+      write32le(p, val);
     }
-  }
+  });
 }
 
 bool GdbIndexSection::isNeeded() const { return !chunks.empty(); }
@@ -367,7 +367,10 @@ template <class ELFT> void Writer<ELFT>::run() {
   {
     llvm::TimeTraceScope timeScope("Write output file");
     // Write the result down to a file.
-    openFile();
+    {
+      llvm::TimeTraceScope timeScope("Open output file");
+      openFile();
+    }
     if (errCount(ctx))
       return;
 
@@ -382,11 +385,17 @@ template <class ELFT> void Writer<ELFT>::run() {
 
     // Backfill .note.gnu.build-id section content. This is done at last
     // because the content is usually a hash value of the entire output file.
-    writeBuildId();
+    {
+      llvm::TimeTraceScope timeScope("Write build ID");
+      writeBuildId();
+    }
     if (errCount(ctx))
       return;
 
     if (!ctx.e.disableOutput) {
+      // Committing flushes the buffer to disk if it is not mmapped, and
+      // renames the temporary file over the output.
+      llvm::TimeTraceScope timeScope("Commit output file");
       if (auto e = buffer->commit())
         Err(ctx) << "failed to write output '" << buffer->getPath()
                  << "': " << std::move(e);
@@ -1081,17 +1090,28 @@ static void maybeShuffle(Ctx &ctx,
 // If both --symbol-ordering-file and call graph profile are present, the order
 // file takes precedence, but the call graph profile is still used for symbols
 // that don't appear in the order file.
+//
+// With --bp-call-graph-profile-sort, the sections in the call graph profile are
+// placed first, and balanced partitioning orders the remaining ones.
 static DenseMap<const InputSectionBase *, int> buildSectionOrder(Ctx &ctx) {
   DenseMap<const InputSectionBase *, int> sectionOrder;
   if (ctx.arg.bpStartupFunctionSort || ctx.arg.bpFunctionOrderForCompression ||
       ctx.arg.bpDataOrderForCompression) {
+    DenseMap<const InputSectionBase *, int> hotOrder;
+    if (ctx.arg.bpCallGraphProfileSort && !ctx.arg.callGraphProfile.empty())
+      hotOrder = computeCallGraphProfileOrder(ctx);
     TimeTraceScope timeScope("Balanced Partitioning Section Orderer");
     sectionOrder = runBalancedPartitioning(
         ctx, ctx.arg.bpStartupFunctionSort ? ctx.arg.irpgoProfilePath : "",
         ctx.arg.bpFunctionOrderForCompression,
         ctx.arg.bpDataOrderForCompression,
         ctx.arg.bpCompressionSortStartupFunctions,
-        ctx.arg.bpVerboseSectionOrderer);
+        ctx.arg.bpVerboseSectionOrderer, hotOrder);
+    // Both orders use negative priorities ending at -1. Shift the hot ones
+    // below the others.
+    int numOrdered = sectionOrder.size();
+    for (auto [sec, prio] : hotOrder)
+      sectionOrder[sec] = prio - numOrdered;
   } else if (!ctx.arg.callGraphProfile.empty()) {
     sectionOrder = computeCallGraphProfileOrder(ctx);
   }
@@ -1877,9 +1897,18 @@ template <class ELFT> void Writer<ELFT>::finalizeSections() {
     // that we can correctly decide if a dynamic relocation is needed. This is
     // called after processSymbolAssignments() because it needs to know whether
     // a linker-script-defined symbol is absolute.
-    scanRelocations<ELFT>(ctx);
-    reportUndefinedSymbols(ctx);
-    postScanRelocations(ctx);
+    {
+      llvm::TimeTraceScope timeScope("Scan input relocations");
+      scanRelocations<ELFT>(ctx);
+    }
+    {
+      llvm::TimeTraceScope timeScope("Report undefined symbols");
+      reportUndefinedSymbols(ctx);
+    }
+    {
+      llvm::TimeTraceScope timeScope("Process relocation requests");
+      postScanRelocations(ctx);
+    }
 
     if (ctx.in.plt && ctx.in.plt->isNeeded())
       ctx.in.plt->addSymbols();
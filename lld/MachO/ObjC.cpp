@@ -1334,23 +1334,30 @@ void ObjcCategoryMerger::eraseMergedCategories() {
 }
 
 void ObjcCategoryMerger::doMerge() {
-  collectAndValidateCategoriesData();
-
-  for (auto &[baseClass, catInfos] : categoryMap) {
-    bool merged = false;
-    if (auto *baseClassDef = dyn_cast<Defined>(baseClass)) {
-      // Merge all categories into the base class
-      merged = mergeCategoriesIntoBaseClass(baseClassDef, catInfos);
-    } else if (catInfos.size() > 1) {
-      // Merge all categories into a new, single category
-      merged = mergeCategoriesIntoSingleCategory(catInfos);
+  {
+    TimeTraceScope timeScope("Collect categories");
+    collectAndValidateCategoriesData();
+  }
+
+  {
+    TimeTraceScope timeScope("Merge categories");
+    for (auto &[baseClass, catInfos] : categoryMap) {
+      bool merged = false;
+      if (auto *baseClassDef = dyn_cast<Defined>(baseClass)) {
+        // Merge all categories into the base class
+        merged = mergeCategoriesIntoBaseClass(baseClassDef, catInfos);
+      } else if (catInfos.size() > 1) {
+        // Merge all categories into a new, single category
+        merged = mergeCategoriesIntoSingleCategory(catInfos);
+      }
+      if (!merged)
+        warn("ObjC category merging skipped for class symbol' " +
+             baseClass->getName().str() + "'\n");
     }
-    if (!merged)
-      warn("ObjC category merging skipped for class symbol' " +
-           baseClass->getName().str() + "'\n");
   }
 
   // Erase all categories that were merged
+  TimeTraceScope timeScope("Erase merged categories");
   eraseMergedCategories();
 }
 
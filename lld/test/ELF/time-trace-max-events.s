@@ -0,0 +1,23 @@
+# REQUIRES: x86
+
+# RUN: llvm-mc -filetype=obj -triple=x86_64 %s -o %t.o
+
+## --time-trace-max-events truncates the trace and reports the dropped events.
+# RUN: ld.lld --time-trace=%t.json --time-trace-granularity=0 \
+# RUN:   --time-trace-max-events=2 %t.o -o %t
+# RUN: cat %t.json \
+# RUN:   | %python -c 'import json, sys; json.dump(json.loads(sys.stdin.read()), sys.stdout, sort_keys=True, indent=2)' \
+# RUN:   | FileCheck %s --check-prefix=LIMITED
+
+## Without it, no event is dropped.
+# RUN: ld.lld --time-trace=%t.all.json --time-trace-granularity=0 %t.o -o %t
+# RUN: cat %t.all.json \
+# RUN:   | %python -c 'import json, sys; json.dump(json.loads(sys.stdin.read()), sys.stdout, sort_keys=True, indent=2)' \
+# RUN:   | FileCheck %s --check-prefix=UNLIMITED
+
+# LIMITED:       "droppedEvents": {{[1-9][0-9]*}},
+# UNLIMITED-NOT: "droppedEvents"
+
+.globl _start
+_start:
+  ret
@@ -51,10 +51,15 @@ void CodeSection::finalizeContents() {
   writeUleb128(os, functions.size(), "function count");
   bodySize = codeSectionHeader.size();
 
+  // With --compress-relocations, calculateSize() computes the size of each
+  // function after re-encoding its relocations. Functions are independent of
+  // each other, so do that in parallel and only lay them out serially.
+  parallelForEach(functions,
+                  [](InputFunction *func) { func->calculateSize(); });
+
   for (InputFunction *func : functions) {
     func->outputSec = this;
     func->outSecOff = bodySize;
-    func->calculateSize();
     // All functions should have a non-empty body at this point
     assert(func->getSize());
     bodySize += func->getSize();
@@ -77,9 +82,10 @@ void CodeSection::writeTo(uint8_t *buf) {
   // Write code section headers
   memcpy(buf, codeSectionHeader.data(), codeSectionHeader.size());
 
-  // Write code section bodies
-  for (const InputChunk *chunk : functions)
-    chunk->writeTo(buf);
+  // Write code section bodies. Each function applies its own relocations to
+  // its own part of the output.
+  parallelForEach(functions,
+                  [&](const InputChunk *chunk) { chunk->writeTo(buf); });
 }
 
 uint32_t CodeSection::getNumRelocations() const {
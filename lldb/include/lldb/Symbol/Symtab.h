@@ -13,6 +13,7 @@
 #include "lldb/Symbol/Symbol.h"
 #include "lldb/Utility/RangeMap.h"
 #include "lldb/lldb-private.h"
+#include "llvm/ADT/DenseSet.h"
 #include <map>
 #include <mutex>
 #include <vector>
@@ -343,13 +344,13 @@ private:
                                         SymbolContextList &sc_list);
 
   void RegisterMangledNameEntry(
-      uint32_t value, std::set<const char *> &class_contexts,
+      uint32_t value, llvm::DenseSet<const char *> &class_contexts,
       std::vector<std::pair<NameToIndexMap::Entry, const char *>> &backlog,
       RichManglingContext &rmc);
 
   void RegisterBacklogEntry(const NameToIndexMap::Entry &entry,
                             const char *decl_context,
-                            const std::set<const char *> &class_contexts);
+                            const llvm::DenseSet<const char *> &class_contexts);
 
   Symtab(const Symtab &) = delete;
   const Symtab &operator=(const Symtab &) = delete;
@@ -63,6 +63,11 @@ private:
   const MemoryCache &operator=(const MemoryCache &) = delete;
 
   lldb::DataBufferSP GetL2CacheLine(lldb::addr_t addr, Status &error);
+
+  // Read \a num_lines consecutive L2 cache lines starting at \a
+  // line_base_addr from the inferior with a single read, and add the lines
+  // that were read to the L2 cache.
+  void FillL2CacheLines(lldb::addr_t line_base_addr, size_t num_lines);
 };
 
     
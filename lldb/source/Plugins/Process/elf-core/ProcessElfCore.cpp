@@ -189,10 +189,9 @@ Status ProcessElfCore::DoLoadCore() {
   /// PT_AARCH64_MEMTAG_MTE - Contains AArch64 MTE memory tags for a range of
   ///                         Process Address Space.
   for (const elf::ELFProgramHeader &H : segments) {
-    DataExtractor data = core->GetSegmentData(H);
-
     // Parse thread contexts and auxv structure
     if (H.p_type == llvm::ELF::PT_NOTE) {
+      DataExtractor data = core->GetSegmentData(H);
       if (llvm::Error error = ParseThreadContextsFromNoteSegment(H, data))
         return Status::FromError(std::move(error));
     }
@@ -630,7 +629,7 @@ llvm::Error ProcessElfCore::parseFreeBSDNotes(llvm::ArrayRef<CoreNote> notes) {
         (note.info.n_type == ELF::NT_PRPSINFO && have_prpsinfo)) {
       assert(thread_data.gpregset.GetByteSize() > 0);
       // Add the new thread to thread list
-      m_thread_data.push_back(thread_data);
+      m_thread_data.push_back(std::move(thread_data));
       thread_data = ThreadData();
       have_prstatus = false;
       have_prpsinfo = false;
@@ -664,7 +663,7 @@ llvm::Error ProcessElfCore::parseFreeBSDNotes(llvm::ArrayRef<CoreNote> notes) {
         "Could not find NT_PRSTATUS note in core file.",
         llvm::inconvertibleErrorCode());
   }
-  m_thread_data.push_back(thread_data);
+  m_thread_data.push_back(std::move(thread_data));
   return llvm::Error::success();
 }
 
@@ -728,7 +727,7 @@ llvm::Error ProcessElfCore::parseNetBSDNotes(llvm::ArrayRef<CoreNote> notes) {
         if (note.info.n_type == NETBSD::AARCH64::NT_REGS) {
           // If this is the next thread, push the previous one first.
           if (had_nt_regs) {
-            m_thread_data.push_back(thread_data);
+            m_thread_data.push_back(std::move(thread_data));
             thread_data = ThreadData();
             had_nt_regs = false;
           }
@@ -754,7 +753,7 @@ llvm::Error ProcessElfCore::parseNetBSDNotes(llvm::ArrayRef<CoreNote> notes) {
         if (note.info.n_type == NETBSD::I386::NT_REGS) {
           // If this is the next thread, push the previous one first.
           if (had_nt_regs) {
-            m_thread_data.push_back(thread_data);
+            m_thread_data.push_back(std::move(thread_data));
             thread_data = ThreadData();
             had_nt_regs = false;
           }
@@ -780,7 +779,7 @@ llvm::Error ProcessElfCore::parseNetBSDNotes(llvm::ArrayRef<CoreNote> notes) {
         if (note.info.n_type == NETBSD::AMD64::NT_REGS) {
           // If this is the next thread, push the previous one first.
           if (had_nt_regs) {
-            m_thread_data.push_back(thread_data);
+            m_thread_data.push_back(std::move(thread_data));
             thread_data = ThreadData();
             had_nt_regs = false;
           }
@@ -809,7 +808,7 @@ llvm::Error ProcessElfCore::parseNetBSDNotes(llvm::ArrayRef<CoreNote> notes) {
 
   // Push the last thread.
   if (had_nt_regs)
-    m_thread_data.push_back(thread_data);
+    m_thread_data.push_back(std::move(thread_data));
 
   if (m_thread_data.empty())
     return llvm::make_error<llvm::StringError>(
@@ -878,7 +877,7 @@ llvm::Error ProcessElfCore::parseOpenBSDNotes(llvm::ArrayRef<CoreNote> notes) {
         "Could not find general purpose registers note in core file.",
         llvm::inconvertibleErrorCode());
   }
-  m_thread_data.push_back(thread_data);
+  m_thread_data.push_back(std::move(thread_data));
   return llvm::Error::success();
 }
 
@@ -907,7 +906,7 @@ llvm::Error ProcessElfCore::parseLinuxNotes(llvm::ArrayRef<CoreNote> notes) {
         (note.info.n_type == ELF::NT_PRPSINFO && have_prpsinfo)) {
       assert(thread_data.gpregset.GetByteSize() > 0);
       // Add the new thread to thread list
-      m_thread_data.push_back(thread_data);
+      m_thread_data.push_back(std::move(thread_data));
       thread_data = ThreadData();
       have_prstatus = false;
       have_prpsinfo = false;
@@ -975,7 +974,7 @@ llvm::Error ProcessElfCore::parseLinuxNotes(llvm::ArrayRef<CoreNote> notes) {
   }
   // Add last entry in the note section
   if (have_prstatus)
-    m_thread_data.push_back(thread_data);
+    m_thread_data.push_back(std::move(thread_data));
   return llvm::Error::success();
 }
 
@@ -22,6 +22,7 @@
 #endif
 #include <ctime>
 #include <sys/types.h>
+#include <unordered_map>
 
 #include "lldb/Breakpoint/Watchpoint.h"
 #include "lldb/Breakpoint/WatchpointAlgorithms.h"
@@ -1513,12 +1514,24 @@ bool ProcessGDBRemote::DoUpdateThreadList(ThreadList &old_thread_list,
     num_thread_ids = m_thread_ids.size();
   }
 
-  ThreadList old_thread_list_copy(old_thread_list);
+  // Index the old threads by protocol ID once, instead of searching the old
+  // thread list for each thread, which is quadratic in the number of threads.
+  std::unordered_map<lldb::tid_t, ThreadSP> old_threads;
+  for (size_t i = 0, e = old_thread_list.GetSize(false); i < e; ++i) {
+    ThreadSP old_thread_sp(old_thread_list.GetThreadAtIndex(i, false));
+    if (old_thread_sp)
+      old_threads.try_emplace(old_thread_sp->GetProtocolID(), old_thread_sp);
+  }
+
   if (num_thread_ids > 0) {
     for (size_t i = 0; i < num_thread_ids; ++i) {
       lldb::tid_t tid = m_thread_ids[i];
-      ThreadSP thread_sp(
-          old_thread_list_copy.RemoveThreadByProtocolID(tid, false));
+      ThreadSP thread_sp;
+      auto old_it = old_threads.find(tid);
+      if (old_it != old_threads.end()) {
+        thread_sp = std::move(old_it->second);
+        old_threads.erase(old_it);
+      }
       if (!thread_sp) {
         thread_sp = std::make_shared<ThreadGDBRemote>(*this, tid);
         LLDB_LOGV(log, "Making new thread: {0} for thread ID: {1:x}.",
@@ -1533,16 +1546,10 @@ bool ProcessGDBRemote::DoUpdateThreadList(ThreadList &old_thread_list,
     }
   }
 
-  // Whatever that is left in old_thread_list_copy are not present in
-  // new_thread_list. Remove non-existent threads from internal id table.
-  size_t old_num_thread_ids = old_thread_list_copy.GetSize(false);
-  for (size_t i = 0; i < old_num_thread_ids; i++) {
-    ThreadSP old_thread_sp(old_thread_list_copy.GetThreadAtIndex(i, false));
-    if (old_thread_sp) {
-      lldb::tid_t old_thread_id = old_thread_sp->GetProtocolID();
-      m_thread_id_to_index_id_map.erase(old_thread_id);
-    }
-  }
+  // Whatever that is left in old_threads are not present in new_thread_list.
+  // Remove non-existent threads from internal id table.
+  for (const auto &old_thread : old_threads)
+    m_thread_id_to_index_id_map.erase(old_thread.first);
 
   return true;
 }
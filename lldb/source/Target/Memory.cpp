@@ -151,6 +151,27 @@ lldb::DataBufferSP MemoryCache::GetL2CacheLine(lldb::addr_t line_base_addr,
   return data_buffer_heap_sp;
 }
 
+void MemoryCache::FillL2CacheLines(lldb::addr_t line_base_addr,
+                                   size_t num_lines) {
+  assert((line_base_addr % m_L2_cache_line_byte_size) == 0);
+
+  std::lock_guard<std::recursive_mutex> guard(m_mutex);
+  DataBufferHeap buffer(num_lines * m_L2_cache_line_byte_size, 0);
+  // Errors are not reported here, GetL2CacheLine() will retry the lines that
+  // are missing and report the error of the failing read.
+  Status error;
+  size_t bytes_read = m_process.ReadMemoryFromInferior(
+      line_base_addr, buffer.GetBytes(), buffer.GetByteSize(), error);
+
+  for (size_t offset = 0; offset < bytes_read;
+       offset += m_L2_cache_line_byte_size) {
+    size_t line_size = std::min<size_t>(m_L2_cache_line_byte_size,
+                                        bytes_read - offset);
+    m_L2_cache[line_base_addr + offset] = std::make_shared<DataBufferHeap>(
+        buffer.GetBytes() + offset, line_size);
+  }
+}
+
 size_t MemoryCache::Read(addr_t addr, void *dst, size_t dst_len,
                          Status &error) {
   if (!dst || dst_len == 0)
@@ -206,6 +227,18 @@ size_t MemoryCache::Read(addr_t addr, void *dst, size_t dst_len,
   // We're going to have all of our loads and reads be cache line aligned.
   addr_t cache_line_offset = addr % m_L2_cache_line_byte_size;
   addr_t cache_line_base_addr = addr - cache_line_offset;
+
+  // If the read straddles two cache lines and neither of them is cached yet,
+  // fetch both with a single read from the inferior instead of one round trip
+  // per line.
+  addr_t next_cache_line_base_addr =
+      cache_line_base_addr + m_L2_cache_line_byte_size;
+  if (cache_line_offset + dst_len > m_L2_cache_line_byte_size &&
+      !m_L2_cache.count(cache_line_base_addr) &&
+      !m_L2_cache.count(next_cache_line_base_addr) &&
+      !m_invalid_ranges.FindEntryThatContains(next_cache_line_base_addr))
+    FillL2CacheLines(cache_line_base_addr, 2);
+
   DataBufferSP first_cache_line = GetL2CacheLine(cache_line_base_addr, error);
   // If we get nothing, then the read to the inferior likely failed. Nothing to
   // do here.
@@ -79,7 +79,9 @@ public:
 
   StringPoolValueType GetMangledCounterpart(const char *ccstr) {
     if (ccstr != nullptr) {
-      const PoolEntry &pool = selectPool(llvm::StringRef(ccstr));
+      // The pool entry knows the length of the string, no need for strlen().
+      const PoolEntry &pool =
+          selectPool(GetStringMapEntryFromKeyData(ccstr).getKey());
       llvm::sys::SmartScopedReader<false> rlock(pool.m_mutex);
       return GetStringMapEntryFromKeyData(ccstr).getValue();
     }
@@ -144,7 +146,8 @@ public:
     {
       // Now assign the demangled const string as the counterpart of the
       // mangled const string...
-      PoolEntry &pool = selectPool(llvm::StringRef(mangled_ccstr));
+      PoolEntry &pool =
+          selectPool(GetStringMapEntryFromKeyData(mangled_ccstr).getKey());
       llvm::sys::SmartScopedWriter<false> wlock(pool.m_mutex);
       GetStringMapEntryFromKeyData(mangled_ccstr).setValue(demangled_ccstr);
     }
@@ -883,6 +883,7 @@ void Variables::Clear() {
   locals.Clear();
   globals.Clear();
   registers.Clear();
+  scope_name_counts.clear();
   referenced_variables.clear();
 }
 
@@ -86,6 +86,12 @@ struct Variables {
   lldb::SBValueList globals;
   lldb::SBValueList registers;
 
+  /// Number of variables with each name in the top-level scopes above, keyed
+  /// by the scope's variablesReference. Computed on the first request for a
+  /// scope, so that paging through it doesn't walk the whole scope each time.
+  /// Will be cleared when the scopes change.
+  llvm::DenseMap<int64_t, std::map<std::string, int>> scope_name_counts;
+
   int64_t next_temporary_var_ref{VARREF_FIRST_VAR_IDX};
   int64_t next_permanent_var_ref{PermanentVariableStartIndex};
 
@@ -2791,6 +2791,7 @@ void request_scopes(DAP &dap, const llvm::json::Object &request) {
                                              /*statics=*/true,
                                              /*in_scope_only=*/true);
   dap.variables.registers = frame.GetRegisters();
+  dap.variables.scope_name_counts.clear();
   body.try_emplace("scopes", dap.CreateTopLevelScopes());
   response.try_emplace("body", std::move(body));
   dap.SendJSON(llvm::json::Value(std::move(response)));
@@ -4166,7 +4167,7 @@ void request_variables(DAP &dap, const llvm::json::Object &request) {
           GetTopLevelScope(dap, variablesReference)) {
     // variablesReference is one of our scopes, not an actual variable it is
     // asking for the list of args, locals or globals.
-    int64_t start_idx = 0;
+    int64_t start_idx = start;
     int64_t num_children = 0;
 
     if (variablesReference == VARREF_REGS) {
@@ -4214,15 +4215,22 @@ void request_variables(DAP &dap, const llvm::json::Object &request) {
         variables.emplace_back(std::move(object));
       }
     }
-    const int64_t end_idx = start_idx + ((count == 0) ? num_children : count);
-
-    // We first find out which variable names are duplicated
-    std::map<std::string, int> variable_name_counts;
-    for (auto i = start_idx; i < end_idx; ++i) {
-      lldb::SBValue variable = top_scope->GetValueAtIndex(i);
-      if (!variable.IsValid())
-        break;
-      variable_name_counts[GetNonNullVariableName(variable)]++;
+    const int64_t end_idx = std::min(
+        num_children, start_idx + ((count == 0) ? num_children : count));
+
+    // We first find out which variable names are duplicated. Look at the
+    // whole scope, a name may be duplicated outside of the requested page.
+    // This is only done for the first page requested for the scope.
+    auto [counts_it, inserted] =
+        dap.variables.scope_name_counts.try_emplace(variablesReference);
+    std::map<std::string, int> &variable_name_counts = counts_it->second;
+    if (inserted) {
+      for (int64_t i = 0; i < num_children; ++i) {
+        lldb::SBValue variable = top_scope->GetValueAtIndex(i);
+        if (!variable.IsValid())
+          break;
+        variable_name_counts[GetNonNullVariableName(variable)]++;
+      }
     }
 
     // Now we construct the result with unique display variable names
@@ -4256,7 +4264,12 @@ void request_variables(DAP &dap, const llvm::json::Object &request) {
             dap.enable_synthetic_child_debugging,
             /*is_name_duplicated=*/false, custom_name));
       };
-      const int64_t num_children = variable.GetNumChildren();
+      // Only count the children up to one past the requested page. Counting
+      // all the children of some synthetic values, like linked lists, means
+      // walking all of them.
+      const int64_t num_children =
+          count == 0 ? variable.GetNumChildren()
+                     : variable.GetNumChildren(start + count + 1);
       int64_t end_idx = start + ((count == 0) ? num_children : count);
       int64_t i = start;
       for (; i < end_idx && i < num_children; ++i)
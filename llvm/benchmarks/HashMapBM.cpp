@@ -0,0 +1,134 @@
+//===- HashMapBM.cpp - DenseMap and StringMap benchmarks ------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// Measures insertion and lookups in DenseMap and StringMap with the kinds of
+// keys the hot maps of the compiler use: pointers (value and symbol maps),
+// dense integers and symbol names.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/Twine.h"
+#include "benchmark/benchmark.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace llvm;
+
+static uint32_t xorshift(uint32_t State) {
+  State ^= State << 13;
+  State ^= State >> 17;
+  State ^= State << 5;
+  return State;
+}
+
+// Heap allocated objects, whose addresses are used as keys.
+static std::vector<std::unique_ptr<uint64_t>> makeObjects(int64_t N) {
+  std::vector<std::unique_ptr<uint64_t>> Objects;
+  Objects.reserve(N);
+  for (int64_t I = 0; I < N; ++I)
+    Objects.push_back(std::make_unique<uint64_t>(I));
+  return Objects;
+}
+
+static std::vector<std::string> makeNames(int64_t N) {
+  std::vector<std::string> Names;
+  Names.reserve(N);
+  uint32_t Seed = 0xcafebabe;
+  for (int64_t I = 0; I < N; ++I) {
+    Seed = xorshift(Seed);
+    Names.push_back(
+        ("_ZN4llvm" + Twine(Seed % 1000) + "function" + Twine(I)).str());
+  }
+  return Names;
+}
+
+static void BM_DenseMapPointerInsert(benchmark::State &State) {
+  auto Objects = makeObjects(State.range(0));
+  for (auto _ : State) {
+    DenseMap<const uint64_t *, unsigned> Map;
+    for (const auto &O : Objects)
+      Map.try_emplace(O.get(), 0);
+    benchmark::DoNotOptimize(Map.size());
+  }
+  State.SetItemsProcessed(State.iterations() * State.range(0));
+}
+
+static void BM_DenseMapPointerLookup(benchmark::State &State) {
+  auto Objects = makeObjects(State.range(0));
+  auto Misses = makeObjects(State.range(0));
+  DenseMap<const uint64_t *, unsigned> Map;
+  for (const auto &O : Objects)
+    Map.try_emplace(O.get(), 0);
+  for (auto _ : State) {
+    for (const auto &O : Objects)
+      benchmark::DoNotOptimize(Map.find(O.get()));
+    for (const auto &O : Misses)
+      benchmark::DoNotOptimize(Map.find(O.get()));
+  }
+  State.SetItemsProcessed(State.iterations() * State.range(0) * 2);
+}
+
+static void BM_DenseMapIntegerLookup(benchmark::State &State) {
+  std::vector<unsigned> Keys;
+  uint32_t Seed = 0xcafebabe;
+  for (int64_t I = 0; I < State.range(0); ++I)
+    Keys.push_back(Seed = xorshift(Seed));
+  DenseMap<unsigned, unsigned> Map;
+  for (unsigned K : Keys)
+    Map.try_emplace(K, 0);
+  for (auto _ : State)
+    for (unsigned K : Keys)
+      benchmark::DoNotOptimize(Map.find(K));
+  State.SetItemsProcessed(State.iterations() * State.range(0));
+}
+
+static void BM_StringMapInsert(benchmark::State &State) {
+  auto Names = makeNames(State.range(0));
+  for (auto _ : State) {
+    StringMap<unsigned> Map;
+    for (const std::string &Name : Names)
+      Map.try_emplace(Name, 0);
+    benchmark::DoNotOptimize(Map.size());
+  }
+  State.SetItemsProcessed(State.iterations() * State.range(0));
+}
+
+static void BM_StringMapLookup(benchmark::State &State) {
+  auto Names = makeNames(State.range(0));
+  StringMap<unsigned> Map;
+  for (const std::string &Name : Names)
+    Map.try_emplace(Name, 0);
+  for (auto _ : State)
+    for (const std::string &Name : Names)
+      benchmark::DoNotOptimize(Map.find(Name));
+  State.SetItemsProcessed(State.iterations() * State.range(0));
+}
+
+static void BM_DenseMapStringRefLookup(benchmark::State &State) {
+  auto Names = makeNames(State.range(0));
+  DenseMap<StringRef, unsigned> Map;
+  for (const std::string &Name : Names)
+    Map.try_emplace(Name, 0);
+  for (auto _ : State)
+    for (const std::string &Name : Names)
+      benchmark::DoNotOptimize(Map.find(Name));
+  State.SetItemsProcessed(State.iterations() * State.range(0));
+}
+
+BENCHMARK(BM_DenseMapPointerInsert)->Range(64, 1 << 20);
+BENCHMARK(BM_DenseMapPointerLookup)->Range(64, 1 << 20);
+BENCHMARK(BM_DenseMapIntegerLookup)->Range(64, 1 << 20);
+BENCHMARK(BM_StringMapInsert)->Range(64, 1 << 20);
+BENCHMARK(BM_StringMapLookup)->Range(64, 1 << 20);
+BENCHMARK(BM_DenseMapStringRefLookup)->Range(64, 1 << 20);
+
+BENCHMARK_MAIN();
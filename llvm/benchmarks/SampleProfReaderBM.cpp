@@ -0,0 +1,106 @@
+//===- SampleProfReaderBM.cpp - Sample profile loading benchmarks ---------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// Measures loading an extbinary sample profile in full, as llvm-profdata
+// does, and loading only the functions of one module through the function
+// offset table, as a compile does.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/Twine.h"
+#include "llvm/IR/DerivedTypes.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/ProfileData/SampleProf.h"
+#include "llvm/ProfileData/SampleProfReader.h"
+#include "llvm/ProfileData/SampleProfWriter.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/VirtualFileSystem.h"
+#include "llvm/Support/raw_ostream.h"
+#include "benchmark/benchmark.h"
+
+#include <memory>
+#include <string>
+
+using namespace llvm;
+using namespace sampleprof;
+
+static std::string functionName(int64_t I) {
+  return ("_ZN4llvm9benchmark8functionEi" + Twine(I)).str();
+}
+
+// An extbinary profile of N functions with a few body and call samples each.
+static SmallString<0> writeProfile(int64_t N) {
+  std::vector<std::string> Names;
+  Names.reserve(N);
+  for (int64_t I = 0; I < N; ++I)
+    Names.push_back(functionName(I));
+
+  SampleProfileMap Profiles;
+  for (int64_t I = 0; I < N; ++I) {
+    FunctionSamples &Samples = Profiles.create(SampleContext(Names[I]));
+    Samples.addTotalSamples(1000 + I);
+    Samples.addHeadSamples(10);
+    for (uint32_t Line = 1; Line <= 8; ++Line)
+      Samples.addBodySamples(Line, 0, 100 + Line);
+    Samples.addCalledTargetSamples(4, 0, FunctionId(Names[(I + 1) % N]), 50);
+  }
+
+  SmallString<0> Buffer;
+  std::unique_ptr<raw_ostream> OS =
+      std::make_unique<raw_svector_ostream>(Buffer);
+  auto WriterOrErr = SampleProfileWriter::create(OS, SPF_Ext_Binary);
+  if (!WriterOrErr)
+    report_fatal_error("cannot create the sample profile writer");
+  if ((*WriterOrErr)->write(Profiles))
+    report_fatal_error("cannot write the sample profile");
+  WriterOrErr->reset();
+  return Buffer;
+}
+
+static void loadProfile(benchmark::State &State, StringRef Profile,
+                        const Module *M) {
+  LLVMContext Ctx;
+  auto FS = vfs::getRealFileSystem();
+  for (auto _ : State) {
+    std::unique_ptr<MemoryBuffer> Buffer = MemoryBuffer::getMemBuffer(
+        Profile, "profile", /*RequiresNullTerminator=*/false);
+    auto ReaderOrErr = SampleProfileReader::create(Buffer, Ctx, *FS);
+    if (!ReaderOrErr)
+      report_fatal_error("cannot create the sample profile reader");
+    if (M)
+      (*ReaderOrErr)->setModule(M);
+    if ((*ReaderOrErr)->read())
+      report_fatal_error("cannot read the sample profile");
+    benchmark::DoNotOptimize((*ReaderOrErr)->getProfiles().size());
+  }
+}
+
+static void BM_LoadWholeProfile(benchmark::State &State) {
+  SmallString<0> Profile = writeProfile(State.range(0));
+  loadProfile(State, Profile, /*M=*/nullptr);
+  State.SetItemsProcessed(State.iterations() * State.range(0));
+}
+BENCHMARK(BM_LoadWholeProfile)->Arg(1 << 12)->Arg(1 << 16);
+
+static void BM_LoadModuleFunctions(benchmark::State &State) {
+  SmallString<0> Profile = writeProfile(State.range(0));
+  // A module defining one out of every 64 functions of the profile.
+  LLVMContext Ctx;
+  Module M("bench", Ctx);
+  FunctionType *FTy = FunctionType::get(Type::getVoidTy(Ctx), false);
+  for (int64_t I = 0; I < State.range(0); I += 64)
+    Function::Create(FTy, GlobalValue::ExternalLinkage, functionName(I), M);
+  loadProfile(State, Profile, &M);
+  State.SetItemsProcessed(State.iterations() * M.size());
+}
+BENCHMARK(BM_LoadModuleFunctions)->Arg(1 << 12)->Arg(1 << 16);
+
+BENCHMARK_MAIN();
@@ -224,6 +224,17 @@ public:
     return {};
   }
 
+  /// Remove all entries. The entries themselves are not destroyed, they are
+  /// owned by the allocator. Must not run concurrently with insert().
+  void clear() {
+    for (uint32_t Idx = 0; Idx < NumberOfBuckets; Idx++) {
+      Bucket &CurBucket = BucketsArray[Idx];
+      memset(CurBucket.Hashes, 0, sizeof(ExtHashBitsTy) * CurBucket.Size);
+      memset(CurBucket.Entries, 0, sizeof(EntryDataTy) * CurBucket.Size);
+      CurBucket.NumberOfEntries = 0;
+    }
+  }
+
   /// Print information about current state of hash table structures.
   void printStatistic(raw_ostream &OS) {
     OS << "\n--- HashTable statistic:\n";
@@ -1457,6 +1457,11 @@ private:
   /// This is a cache of the values we have analyzed so far.
   ValueExprMapType ValueExprMap;
 
+  /// The number of instructions looked through so far, checked against
+  /// -scalar-evolution-max-values-per-function. Unlike ValueExprMap, this
+  /// never shrinks when values are forgotten.
+  unsigned NumInstructionsAnalyzed = 0;
+
   /// This is a cache for expressions that got folded to a different existing
   /// SCEV.
   DenseMap<FoldID, const SCEV *> FoldCache;
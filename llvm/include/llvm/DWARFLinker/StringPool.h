@@ -9,10 +9,8 @@
 #ifndef LLVM_DWARFLINKER_STRINGPOOL_H
 #define LLVM_DWARFLINKER_STRINGPOOL_H
 
-#include "llvm/ADT/ConcurrentHashtable.h"
 #include "llvm/CodeGen/DwarfStringPoolEntry.h"
-#include "llvm/Support/Allocator.h"
-#include "llvm/Support/PerThreadBumpPtrAllocator.h"
+#include "llvm/Support/ConcurrentStringPool.h"
 #include <string_view>
 
 namespace llvm {
@@ -20,57 +18,11 @@ namespace dwarf_linker {
 
 /// StringEntry keeps data of the string: the length, external offset
 /// and a string body which is placed right after StringEntry.
-using StringEntry = StringMapEntry<std::nullopt_t>;
+using StringEntry = ConcurrentStringPool::EntryTy;
 
-class StringPoolEntryInfo {
-public:
-  /// \returns Hash value for the specified \p Key.
-  static inline uint64_t getHashValue(const StringRef &Key) {
-    return xxh3_64bits(Key);
-  }
+using StringPoolEntryInfo = ConcurrentStringPoolEntryInfo;
 
-  /// \returns true if both \p LHS and \p RHS are equal.
-  static inline bool isEqual(const StringRef &LHS, const StringRef &RHS) {
-    return LHS == RHS;
-  }
-
-  /// \returns key for the specified \p KeyData.
-  static inline StringRef getKey(const StringEntry &KeyData) {
-    return KeyData.getKey();
-  }
-
-  /// \returns newly created object of KeyDataTy type.
-  static inline StringEntry *
-  create(const StringRef &Key,
-         llvm::parallel::PerThreadBumpPtrAllocator &Allocator) {
-    return StringEntry::create(Key, Allocator);
-  }
-};
-
-class StringPool
-    : public ConcurrentHashTableByPtr<StringRef, StringEntry,
-                                      llvm::parallel::PerThreadBumpPtrAllocator,
-                                      StringPoolEntryInfo> {
-public:
-  StringPool()
-      : ConcurrentHashTableByPtr<StringRef, StringEntry,
-                                 llvm::parallel::PerThreadBumpPtrAllocator,
-                                 StringPoolEntryInfo>(Allocator) {}
-
-  StringPool(size_t InitialSize)
-      : ConcurrentHashTableByPtr<StringRef, StringEntry,
-                                 llvm::parallel::PerThreadBumpPtrAllocator,
-                                 StringPoolEntryInfo>(Allocator, InitialSize) {}
-
-  llvm::parallel::PerThreadBumpPtrAllocator &getAllocatorRef() {
-    return Allocator;
-  }
-
-  void clear() { Allocator.Reset(); }
-
-private:
-  llvm::parallel::PerThreadBumpPtrAllocator Allocator;
-};
+using StringPool = ConcurrentStringPool;
 
 } // namespace dwarf_linker
 } // end namespace llvm
@@ -234,6 +234,12 @@ public:
     return unit_iterator_range(DWOUnits.begin(), DWOUnits.end());
   }
 
+  /// Parse the DIEs of all the units up front, on \p NumThreads threads (0
+  /// uses all hardware threads). Units are otherwise parsed lazily on first
+  /// use, one at a time. Only the abbreviations are parsed serially, the DIEs
+  /// of different units are extracted concurrently.
+  void extractAllUnitDIEs(unsigned NumThreads = 0);
+
   /// Get the number of compile units in this context.
   unsigned getNumCompileUnits() {
     return State->getNormalUnits().getNumInfoUnits();
@@ -362,6 +362,15 @@ public:
   /// \param   FI The function info object to emplace into our functions list.
   void addFunctionInfo(FunctionInfo &&FI);
 
+  /// Add several function infos to this GSYM creator at once.
+  ///
+  /// This takes the lock protecting the functions list only once, which makes
+  /// it the better choice for producers running on many threads that create
+  /// one batch of function infos per unit of work.
+  ///
+  /// \param   FIs The function info objects to move into our functions list.
+  void addFunctionInfos(std::vector<FunctionInfo> &&FIs);
+
   /// Load call site information from a YAML file.
   ///
   /// This function reads call site information from a specified YAML file and
@@ -63,6 +63,12 @@ public:
     std::string FallbackDebugPath;
     std::string DWPName;
     std::vector<std::string> DebugFileDirectory;
+    /// Directories searched for a prebuilt "<binary>.gsym" file, in addition
+    /// to the directory of the binary itself. A GSYM file is preferred to
+    /// the DWARF of the binary when found, its UUID matches the build ID of
+    /// the binary and \c DisableGsym is not set.
+    std::vector<std::string> GsymFileDirectory;
+    bool DisableGsym = false;
     size_t MaxCacheSize =
         sizeof(size_t) == 4
             ? 512 * 1024 * 1024 /* 512 MiB */
@@ -178,6 +184,9 @@ private:
                                   const ELFObjectFileBase *Obj,
                                   const std::string &ArchName);
 
+  std::unique_ptr<DIContext> lookUpGsymFile(const std::string &Path,
+                                            const ObjectFile *Obj);
+
   bool findDebugBinary(const std::string &OrigPath,
                        const std::string &DebuglinkName, uint32_t CRCHash,
                        std::string &Result);
@@ -1977,6 +1977,12 @@ public:
   /// they are required to fully configure the pass pipeline for that target.
   virtual bool shouldAddDefaultTargetPasses(const Triple &TT) const;
 
+  /// Called by JITLink before applying fixups to determine whether the blocks
+  /// of the graph may be fixed up in parallel, on the llvm::parallel thread
+  /// pool. This pays off for large graphs. The default implementation returns
+  /// false.
+  virtual bool shouldApplyFixupsConcurrently() const;
+
   /// Returns the mark-live pass to be used for this link. If no pass is
   /// returned (the default) then the target-specific linker implementation will
   /// choose a conservative default (usually marking all symbols live).
@@ -31,6 +31,10 @@ public:
   /// notifyObjectCompiled - Provides a pointer to compiled code for Module M.
   virtual void notifyObjectCompiled(const Module *M, MemoryBufferRef Obj) = 0;
 
+  /// Called instead of notifyObjectCompiled when compiling Module M, whose
+  /// object getObject could not provide, failed.
+  virtual void notifyObjectCompileFailed(const Module *M) {}
+
   /// Returns a pointer to a newly allocated MemoryBuffer that contains the
   /// object which corresponds with Module M, or 0 if an object is not
   /// available.
@@ -54,6 +54,7 @@ private:
 
   CompileResult tryToLoadFromObjectCache(const Module &M);
   void notifyObjectCompiled(const Module &M, const MemoryBuffer &ObjBuffer);
+  void notifyObjectCompileFailed(const Module &M);
 
   TargetMachine &TM;
   ObjectCache *ObjCache = nullptr;
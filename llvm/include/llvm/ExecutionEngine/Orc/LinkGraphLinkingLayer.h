@@ -144,6 +144,16 @@ public:
     return *this;
   }
 
+  /// If set, the blocks of each graph linked by this layer are fixed up in
+  /// parallel, on the llvm::parallel thread pool. This pays off for large
+  /// graphs. Only set this for targets whose fixups don't write outside of
+  /// the block being fixed up, such as x86-64.
+  LinkGraphLinkingLayer &
+  setApplyFixupsConcurrently(bool ApplyFixupsConcurrently) {
+    this->ApplyFixupsConcurrently = ApplyFixupsConcurrently;
+    return *this;
+  }
+
 protected:
   /// Emit a LinkGraph with the given backing buffer.
   ///
@@ -169,6 +179,7 @@ private:
   std::unique_ptr<jitlink::JITLinkMemoryManager> MemMgrOwnership;
   bool OverrideObjectFlags = false;
   bool AutoClaimObjectSymbols = false;
+  bool ApplyFixupsConcurrently = false;
   DenseMap<ResourceKey, std::vector<FinalizedAlloc>> Allocs;
   std::vector<std::shared_ptr<Plugin>> Plugins;
 };
@@ -0,0 +1,72 @@
+//===- PersistentObjectCache.h - On-disk object cache for ORC ---*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// An ObjectCache that keeps the objects compiled by the JIT in a directory,
+// so that later processes can load them instead of compiling the same IR.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_EXECUTIONENGINE_ORC_PERSISTENTOBJECTCACHE_H
+#define LLVM_EXECUTIONENGINE_ORC_PERSISTENTOBJECTCACHE_H
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/ExecutionEngine/ObjectCache.h"
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace llvm {
+
+class TargetMachine;
+
+namespace orc {
+
+/// A content-addressed on-disk ObjectCache.
+///
+/// Objects are stored under a hash of the bitcode of the module and of a
+/// target key, which must describe everything besides the IR that affects
+/// code generation. Use getTargetKey() to build one from a TargetMachine.
+/// Cached objects are memory mapped when they are loaded.
+///
+/// The key of a module is computed when the compiler queries the cache, since
+/// code generation may modify the module before the compiled object is
+/// reported. Entries are written atomically, so several processes can share
+/// the cache directory.
+class PersistentObjectCache : public ObjectCache {
+public:
+  PersistentObjectCache(StringRef CacheDir, StringRef TargetKey)
+      : CacheDir(CacheDir), TargetKey(TargetKey) {}
+
+  /// Returns a key covering the LLVM version and revision, and the target,
+  /// CPU, features and code generation options of \p TM.
+  static std::string getTargetKey(const TargetMachine &TM);
+
+  std::unique_ptr<MemoryBuffer> getObject(const Module *M) override;
+  void notifyObjectCompiled(const Module *M, MemoryBufferRef Obj) override;
+  void notifyObjectCompileFailed(const Module *M) override;
+
+  /// Returns the path of the entry for \p M.
+  std::string getEntryPath(const Module &M) const;
+
+private:
+  std::string computeKey(const Module &M) const;
+  std::string getEntryPath(StringRef Key) const;
+
+  std::string CacheDir;
+  std::string TargetKey;
+
+  std::mutex PendingMutex;
+  /// The keys of the modules that missed in the cache and are being compiled.
+  DenseMap<const Module *, std::string> PendingKeys;
+};
+
+} // end namespace orc
+} // end namespace llvm
+
+#endif // LLVM_EXECUTIONENGINE_ORC_PERSISTENTOBJECTCACHE_H
@@ -21,6 +21,9 @@
 #include "llvm/Transforms/Utils/BasicBlockUtils.h"
 #include "llvm/Transforms/Utils/Cloning.h"
 
+#include <atomic>
+#include <chrono>
+
 namespace llvm {
 namespace orc {
 
@@ -59,6 +62,38 @@ public:
     this->ProfilerFunc = std::move(ProfilerFunc);
   }
 
+  /// Sets the number of calls after which reoptimizeIfCallFrequent requests
+  /// the reoptimization of a function. Only affects modules emitted after
+  /// the call. May be called while other threads emit modules.
+  void setCallCountThreshold(uint64_t Threshold) {
+    CallCountThresholdForLayer.store(Threshold, std::memory_order_relaxed);
+  }
+
+  uint64_t getCallCountThreshold() const {
+    return CallCountThresholdForLayer.load(std::memory_order_relaxed);
+  }
+
+  /// Counters of the reoptimizations that produced one version of the
+  /// materialization units, e.g. the second tier for version 1.
+  struct VersionStats {
+    /// Number of units reoptimized to this version.
+    uint64_t NumReoptimized = 0;
+    /// Number of reoptimizations to this version that failed.
+    uint64_t NumFailed = 0;
+    /// Time from the reoptimization request to the redirection of the
+    /// symbols to the new definitions, summed over NumReoptimized.
+    std::chrono::nanoseconds TotalLatency{0};
+    /// Longest of the latencies summed in TotalLatency.
+    std::chrono::nanoseconds MaxLatency{0};
+  };
+
+  /// Returns the counters of the reoptimizations, indexed by the version
+  /// they produced. Version 0, the initial emission, is never reoptimized to.
+  std::vector<VersionStats> getVersionStats() const {
+    std::lock_guard<std::mutex> Lock(StatsMutex);
+    return Stats;
+  }
+
   /// Registers reoptimize runtime dispatch handlers to given PlatformJD. The
   /// reoptimization request will not be handled if dispatch handler is not
   /// registered by using this function.
@@ -69,10 +104,11 @@ public:
   void emit(std::unique_ptr<MaterializationResponsibility> R,
             ThreadSafeModule TSM) override;
 
+  /// Default call count threshold of reoptimizeIfCallFrequent.
   static const uint64_t CallCountThreshold = 10;
 
   /// Basic AddProfilerFunc that reoptimizes the function when the call count
-  /// exceeds CallCountThreshold.
+  /// exceeds the call count threshold of \p Parent.
   static Error reoptimizeIfCallFrequent(ReOptimizeLayer &Parent,
                                         ReOptMaterializationUnitID MUID,
                                         unsigned CurVersion,
@@ -147,6 +183,10 @@ private:
   void rt_reoptimize(SendErrorFn SendResult, ReOptMaterializationUnitID MUID,
                      uint32_t CurVersion);
 
+  void recordReoptimization(uint32_t Version,
+                            std::chrono::steady_clock::time_point Start,
+                            bool Succeeded);
+
   static Expected<Constant *>
   createReoptimizeArgBuffer(Module &M, ReOptMaterializationUnitID MUID,
                             uint32_t CurVersion);
@@ -168,6 +208,10 @@ private:
 
   ReOptimizeFunc ReOptFunc;
   AddProfilerFunc ProfilerFunc;
+  std::atomic<uint64_t> CallCountThresholdForLayer{CallCountThreshold};
+
+  mutable std::mutex StatsMutex;
+  std::vector<VersionStats> Stats;
 
   std::mutex Mutex;
   std::map<ReOptMaterializationUnitID, ReOptMaterializationUnitState> MUStates;
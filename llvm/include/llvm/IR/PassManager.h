@@ -824,6 +824,14 @@ using ModuleAnalysisManagerFunctionProxy =
 /// Note that although function passes can access module analyses, module
 /// analyses are not invalidated while the function passes are running, so they
 /// may be stale.  Function analyses will not be stale.
+///
+/// Functions are visited one at a time, in module order. The principles above
+/// are not enough to run the pipelines of several functions concurrently:
+/// creating or deleting instructions updates the use lists of the globals and
+/// constants they refer to, and creating constants, types or metadata updates
+/// the uniquing tables of the \c LLVMContext, none of which are synchronized.
+/// Parallelism over a large module is instead obtained by splitting it, as
+/// ThinLTO and parallel code generation do.
 class ModuleToFunctionPassAdaptor
     : public PassInfoMixin<ModuleToFunctionPassAdaptor> {
 public:
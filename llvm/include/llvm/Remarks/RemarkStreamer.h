@@ -44,6 +44,8 @@ namespace remarks {
 class RemarkStreamer final {
   /// The regex used to filter remarks based on the passes that emit them.
   std::optional<Regex> PassFilter;
+  /// The regex used to filter remarks based on their names.
+  std::optional<Regex> NameFilter;
   /// The object used to serialize the remarks to a specific format.
   std::unique_ptr<remarks::RemarkSerializer> RemarkSerializer;
   /// The filename that the remark diagnostics are emitted to.
@@ -66,6 +68,11 @@ public:
   Error setFilter(StringRef Filter);
   /// Check wether the string matches the filter.
   bool matchesFilter(StringRef Str);
+  /// Set a remark name filter based on a regex \p Filter.
+  /// Returns an error if the regex is invalid.
+  Error setNameFilter(StringRef Filter);
+  /// Check wether the remark name matches the name filter.
+  bool matchesNameFilter(StringRef Name);
   /// Check if the remarks also need to have associated metadata in a section.
   bool needsSection() const;
 };
@@ -16,6 +16,7 @@
 #define LLVM_SUPPORT_CACHING_H
 
 #include "llvm/Support/Error.h"
+#include "llvm/Support/MemoryBufferRef.h"
 
 namespace llvm {
 
@@ -90,17 +91,35 @@ private:
 using AddBufferFn = std::function<void(unsigned Task, const Twine &ModuleName,
                                        std::unique_ptr<MemoryBuffer> MB)>;
 
+/// A cache shared between machines, such as a content-addressed store or an
+/// HTTP service, that backs a local cache. Either callback may be left empty.
+///
+/// Both callbacks must be thread safe. Failures to reach the remote cache are
+/// not errors: Fetch should report them as misses, and Store should drop the
+/// object.
+struct RemoteFileCache {
+  /// Returns the object stored under \p Key, or null if there is none.
+  std::function<std::unique_ptr<MemoryBuffer>(StringRef Key)> Fetch;
+  /// Publishes \p Object, which was just produced, under \p Key.
+  std::function<void(StringRef Key, MemoryBufferRef Object)> Store;
+};
+
 /// Create a local file system cache which uses the given cache name, temporary
 /// file prefix, cache directory and file callback.  This function does not
 /// immediately create the cache directory if it does not yet exist; this is
 /// done lazily the first time a file is added.  The cache name appears in error
 /// messages for errors during caching. The temporary file prefix is used in the
 /// temporary file naming scheme used when writing files atomically.
+///
+/// On a miss, the object is looked up in \p Remote, if any, and copied to the
+/// local cache when found there. Objects produced on a miss are stored to
+/// \p Remote as well as to the local cache.
 Expected<FileCache> localCache(
     const Twine &CacheNameRef, const Twine &TempFilePrefixRef,
     const Twine &CacheDirectoryPathRef,
     AddBufferFn AddBuffer = [](size_t Task, const Twine &ModuleName,
-                               std::unique_ptr<MemoryBuffer> MB) {});
+                               std::unique_ptr<MemoryBuffer> MB) {},
+    RemoteFileCache Remote = RemoteFileCache());
 } // namespace llvm
 
 #endif
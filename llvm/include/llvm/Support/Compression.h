@@ -61,9 +61,14 @@ constexpr int BestSizeCompression = 12;
 
 bool isAvailable();
 
+/// Compress \p Input into \p CompressedBuffer. If \p NumThreads is not 0 and
+/// zstd was built with multi-threading support, the input is split into jobs
+/// compressed by that many worker threads. The output is still a single
+/// frame, decompressed like any other.
 void compress(ArrayRef<uint8_t> Input,
               SmallVectorImpl<uint8_t> &CompressedBuffer,
-              int Level = DefaultCompression, bool EnableLdm = false);
+              int Level = DefaultCompression, bool EnableLdm = false,
+              unsigned NumThreads = 0);
 
 Error decompress(ArrayRef<uint8_t> Input, uint8_t *Output,
                  size_t &UncompressedSize);
@@ -101,9 +106,10 @@ struct Params {
   Format format;
   int level;
   bool zstdEnableLdm = false; // Enable zstd long distance matching
-  // This may support multi-threading for zstd in the future. Note that
-  // different threads may produce different output, so be careful if certain
-  // output determinism is desired.
+  // Number of zstd worker threads, 0 compresses on the calling thread. Note
+  // that the output with workers differs from the output without, so be
+  // careful if certain output determinism is desired.
+  unsigned zstdNumThreads = 0;
 };
 
 // Return nullptr if LLVM was built with support (LLVM_ENABLE_ZLIB,
@@ -0,0 +1,102 @@
+//===- ConcurrentStringPool.h -----------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file defines ConcurrentStringPool, a string interning table that can
+/// be shared by the threads of the parallel executor.
+///
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_SUPPORT_CONCURRENTSTRINGPOOL_H
+#define LLVM_SUPPORT_CONCURRENTSTRINGPOOL_H
+
+#include "llvm/ADT/ConcurrentHashtable.h"
+#include "llvm/ADT/StringMapEntry.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/PerThreadBumpPtrAllocator.h"
+#include "llvm/Support/xxhash.h"
+#include <optional>
+
+namespace llvm {
+
+/// Hashing and allocation traits of the entries of a ConcurrentStringPool.
+class ConcurrentStringPoolEntryInfo {
+public:
+  using EntryTy = StringMapEntry<std::nullopt_t>;
+
+  /// \returns Hash value for the specified \p Key.
+  static inline uint64_t getHashValue(const StringRef &Key) {
+    return xxh3_64bits(Key);
+  }
+
+  /// \returns true if both \p LHS and \p RHS are equal.
+  static inline bool isEqual(const StringRef &LHS, const StringRef &RHS) {
+    return LHS == RHS;
+  }
+
+  /// \returns key for the specified \p KeyData.
+  static inline StringRef getKey(const EntryTy &KeyData) {
+    return KeyData.getKey();
+  }
+
+  /// \returns newly created object of EntryTy type.
+  static inline EntryTy *
+  create(const StringRef &Key,
+         llvm::parallel::PerThreadBumpPtrAllocator &Allocator) {
+    return EntryTy::create(Key, Allocator);
+  }
+};
+
+/// A string interning table for concurrent use.
+///
+/// Strings are inserted and looked up concurrently without a global lock, the
+/// table is split into buckets that are resized independently. Each string is
+/// copied once into a per thread arena and stays valid until the pool is
+/// cleared or destroyed, so interned strings can be compared by address.
+///
+/// As the arena is a PerThreadBumpPtrAllocator, insertions must happen on
+/// threads of the parallel executor, e.g. from parallelFor or a TaskGroup.
+class ConcurrentStringPool
+    : public ConcurrentHashTableByPtr<StringRef,
+                                      ConcurrentStringPoolEntryInfo::EntryTy,
+                                      llvm::parallel::PerThreadBumpPtrAllocator,
+                                      ConcurrentStringPoolEntryInfo> {
+  using BaseTy =
+      ConcurrentHashTableByPtr<StringRef,
+                               ConcurrentStringPoolEntryInfo::EntryTy,
+                               llvm::parallel::PerThreadBumpPtrAllocator,
+                               ConcurrentStringPoolEntryInfo>;
+
+public:
+  using EntryTy = ConcurrentStringPoolEntryInfo::EntryTy;
+
+  ConcurrentStringPool() : BaseTy(Allocator) {}
+
+  ConcurrentStringPool(size_t InitialSize) : BaseTy(Allocator, InitialSize) {}
+
+  /// \returns the unique copy of \p Str owned by the pool.
+  StringRef intern(StringRef Str) { return insert(Str).first->getKey(); }
+
+  llvm::parallel::PerThreadBumpPtrAllocator &getAllocatorRef() {
+    return Allocator;
+  }
+
+  /// Remove all strings and release their memory. Previously interned
+  /// strings become invalid. Must not run concurrently with intern().
+  void clear() {
+    BaseTy::clear();
+    Allocator.Reset();
+  }
+
+private:
+  llvm::parallel::PerThreadBumpPtrAllocator Allocator;
+};
+
+} // end namespace llvm
+
+#endif // LLVM_SUPPORT_CONCURRENTSTRINGPOOL_H
@@ -99,7 +99,9 @@ public:
   // exactly in the order which they were spawned.
   void spawn(std::function<void()> f);
 
-  void sync() const { L.sync(); }
+  /// Wait for all the spawned tasks to finish. When called from a thread of
+  /// the parallel executor, runs the tasks not started yet itself.
+  void sync() const;
 
   bool isParallel() const { return Parallel; }
 };
@@ -101,6 +101,12 @@ struct TimeTraceMetadata {
   // Source file and line number information for the event.
   std::string File;
   int Line = 0;
+  // If set, the written trace summarizes the count, inclusive and exclusive
+  // time of the events sharing a name and group, e.g. all the instantiations
+  // of one template. Exclusive time leaves out nested grouped events.
+  std::string Group;
+  // Source file the group belongs to, summaries are also rolled up by file.
+  std::string GroupFile;
 
   bool isEmpty() const { return Detail.empty() && File.empty(); }
 };
@@ -119,6 +125,12 @@ void timeTraceProfilerInitialize(unsigned TimeTraceGranularity,
                                  StringRef ProcName,
                                  bool TimeTraceVerbose = false);
 
+/// Limit the number of events each thread records to \p MaxEvents, 0 removes
+/// the limit. Events past the limit are left out of the trace, but are still
+/// accounted for in the totals and summaries, so a bounded profile can be
+/// collected from long running, heavily multi-threaded processes.
+void timeTraceProfilerSetMaxEvents(size_t MaxEvents);
+
 /// Cleanup the time trace profiler, if it was initialized.
 void timeTraceProfilerCleanup();
 
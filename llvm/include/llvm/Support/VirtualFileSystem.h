@@ -14,9 +14,11 @@
 #ifndef LLVM_SUPPORT_VIRTUALFILESYSTEM_H
 #define LLVM_SUPPORT_VIRTUALFILESYSTEM_H
 
+#include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/IntrusiveRefCntPtr.h"
 #include "llvm/ADT/STLFunctionalExtras.h"
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Support/Chrono.h"
 #include "llvm/Support/Errc.h"
@@ -30,6 +32,7 @@
 #include <cstdint>
 #include <ctime>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <system_error>
@@ -1199,6 +1202,44 @@ protected:
                  unsigned IndentLevel) const override;
 };
 
+/// File system that caches the results of status() calls to the underlying
+/// file system, including failed lookups, so repeated stats of the same path
+/// (e.g. when searching header search paths) only reach the underlying file
+/// system once.
+///
+/// The cache is shared by all threads using this file system. Changes to the
+/// underlying file system after a path was looked up are not observed.
+class StatusCachingFileSystem
+    : public llvm::RTTIExtends<StatusCachingFileSystem, ProxyFileSystem> {
+public:
+  static const char ID;
+
+  StatusCachingFileSystem(llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> FS)
+      : RTTIExtends(std::move(FS)) {}
+
+  ErrorOr<Status> status(const Twine &Path) override;
+
+  bool exists(const Twine &Path) override { return bool(status(Path)); }
+
+  /// Looks up the status of all of \p Paths that are not cached yet, in
+  /// parallel, and caches the results. This hides the latency of file systems
+  /// with slow metadata operations, such as network file systems. The
+  /// underlying file system must support concurrent status() calls.
+  void prefetchStatus(ArrayRef<std::string> Paths);
+
+protected:
+  void printImpl(raw_ostream &OS, PrintType Type,
+                 unsigned IndentLevel) const override;
+
+private:
+  /// Returns the key of \p Path in StatusCache, or std::nullopt if it can't
+  /// be made absolute.
+  std::optional<std::string> getCacheKey(const Twine &Path) const;
+
+  mutable std::mutex CacheMutex;
+  StringMap<ErrorOr<Status>> StatusCache;
+};
+
 } // namespace vfs
 } // namespace llvm
 
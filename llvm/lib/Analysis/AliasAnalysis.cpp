@@ -46,6 +46,7 @@
 #include "llvm/Support/AtomicOrdering.h"
 #include "llvm/Support/Casting.h"
 #include "llvm/Support/CommandLine.h"
+#include "llvm/Support/Timer.h"
 #include <cassert>
 #include <functional>
 #include <iterator>
@@ -71,6 +72,12 @@ static cl::opt<bool> EnableAATrace("aa-trace", cl::Hidden, cl::init(false));
 static const bool EnableAATrace = false;
 #endif
 
+/// Time the root alias queries, to see how much of a pass is spent in them.
+static cl::opt<bool>
+    TimeAAQueries("time-aa-queries", cl::Hidden, cl::init(false),
+                  cl::desc("Time alias analysis queries, reported alongside "
+                           "-time-passes"));
+
 AAResults::AAResults(const TargetLibraryInfo &TLI) : TLI(TLI) {}
 
 AAResults::AAResults(AAResults &&Arg)
@@ -113,6 +120,11 @@ AliasResult AAResults::alias(const MemoryLocation &LocA,
                              const Instruction *CtxI) {
   AliasResult Result = AliasResult::MayAlias;
 
+  // Only time root queries, recursive ones are part of their time.
+  NamedRegionTimer T("alias", "Alias queries", DEBUG_TYPE,
+                     "Alias Analysis Queries",
+                     TimeAAQueries && AAQI.Depth == 0);
+
   if (EnableAATrace) {
     for (unsigned I = 0; I < AAQI.Depth; ++I)
       dbgs() << "  ";
@@ -144,6 +144,8 @@ STATISTIC(NumExitCountsNotComputed,
           "Number of loop exits without predictable exit counts");
 STATISTIC(NumBruteForceTripCountsComputed,
           "Number of loops with trip counts computed by force");
+STATISTIC(NumValuesOverBudget,
+          "Number of values left unanalyzed past the per-function budget");
 
 #ifdef EXPENSIVE_CHECKS
 bool llvm::VerifySCEV = true;
@@ -219,6 +221,12 @@ static cl::opt<unsigned>
                   cl::desc("Size of the expression which is considered huge"),
                   cl::init(4096));
 
+static cl::opt<unsigned> MaxValuesPerFunction(
+    "scalar-evolution-max-values-per-function", cl::Hidden,
+    cl::desc("Maximum number of instructions analyzed in a function before "
+             "new instructions are treated as opaque (0 = no limit)"),
+    cl::init(0));
+
 static cl::opt<unsigned> RangeIterThreshold(
     "scev-range-iter-threshold", cl::Hidden,
     cl::desc("Threshold for switching to iteratively computing SCEV ranges"),
@@ -7522,6 +7530,18 @@ ScalarEvolution::getOperandsToCreate(Value *V, SmallVectorImpl<Value *> &Ops) {
     // analysis depends on.
     if (!DT.isReachableFromEntry(I->getParent()))
       return getUnknown(PoisonValue::get(V->getType()));
+
+    // Once the function has used up its budget, stop looking through new
+    // instructions. Treating them as opaque is always correct, and bounds the
+    // work done on huge functions.
+    if (MaxValuesPerFunction &&
+        NumInstructionsAnalyzed >= MaxValuesPerFunction) {
+      LLVM_DEBUG(dbgs() << "SCEV: budget exhausted, treating " << *I
+                        << " as unknown\n");
+      ++NumValuesOverBudget;
+      return getUnknown(V);
+    }
+    ++NumInstructionsAnalyzed;
   } else if (ConstantInt *CI = dyn_cast<ConstantInt>(V))
     return getConstant(CI);
   else if (isa<GlobalAlias>(V))
@@ -13657,6 +13677,7 @@ ScalarEvolution::ScalarEvolution(ScalarEvolution &&Arg)
     : F(Arg.F), DL(Arg.DL), HasGuards(Arg.HasGuards), TLI(Arg.TLI), AC(Arg.AC),
       DT(Arg.DT), LI(Arg.LI), CouldNotCompute(std::move(Arg.CouldNotCompute)),
       ValueExprMap(std::move(Arg.ValueExprMap)),
+      NumInstructionsAnalyzed(Arg.NumInstructionsAnalyzed),
       PendingLoopPredicates(std::move(Arg.PendingLoopPredicates)),
       PendingPhiRanges(std::move(Arg.PendingPhiRanges)),
       PendingMerges(std::move(Arg.PendingMerges)),
@@ -8,6 +8,7 @@
 
 #include "DwarfStringPool.h"
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/ADT/Twine.h"
 #include "llvm/CodeGen/AsmPrinter.h"
 #include "llvm/MC/MCAsmInfo.h"
@@ -17,6 +18,11 @@
 
 using namespace llvm;
 
+#define DEBUG_TYPE "dwarfdebug"
+
+STATISTIC(NumStringsEmitted, "Number of DWARF pool strings emitted");
+STATISTIC(NumStringBytesEmitted, "Number of DWARF pool string bytes emitted");
+
 DwarfStringPool::DwarfStringPool(BumpPtrAllocator &A, AsmPrinter &Asm,
                                  StringRef Prefix)
     : Pool(A), Prefix(Prefix),
@@ -77,6 +83,9 @@ void DwarfStringPool::emit(AsmPrinter &Asm, MCSection *StrSection,
   if (Pool.empty())
     return;
 
+  NumStringsEmitted += Pool.size();
+  NumStringBytesEmitted += NumBytes;
+
   // Start the dwarf str section.
   Asm.OutStreamer->switchSection(StrSection);
 
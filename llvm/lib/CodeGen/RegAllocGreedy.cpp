@@ -2493,6 +2493,10 @@ MCRegister RAGreedy::selectOrSplitImpl(const LiveInterval &VirtReg,
   // If we couldn't allocate a register from spilling, there is probably some
   // invalid inline assembly. The base class will report it.
   if (Stage >= RS_Done || !VirtReg.isSpillable()) {
+    // Recoloring recurses into selectOrSplitImpl, only time the outermost.
+    NamedRegionTimer T("last_chance_recoloring", "Last Chance Recoloring",
+                       TimerGroupName, TimerGroupDescription,
+                       TimePassesIsEnabled && Depth == 0);
     return tryLastChanceRecoloring(VirtReg, Order, NewVRegs, FixedRegisters,
                                    RecolorStack, Depth);
   }
@@ -2774,7 +2778,12 @@ bool RAGreedy::runOnMachineFunction(MachineFunction &mf) {
   SpillerInstance.reset(
       createInlineSpiller({*LIS, LSS, *DomTree, *MBFI}, *MF, *VRM, *VRAI));
 
-  VRAI->calculateSpillWeightsAndHints();
+  {
+    NamedRegionTimer T("spill_weights", "Spill Weights and Hints",
+                       TimerGroupName, TimerGroupDescription,
+                       TimePassesIsEnabled);
+    VRAI->calculateSpillWeightsAndHints();
+  }
 
   LLVM_DEBUG(LIS->dump());
 
@@ -2786,11 +2795,20 @@ bool RAGreedy::runOnMachineFunction(MachineFunction &mf) {
   SetOfBrokenHints.clear();
 
   allocatePhysRegs();
-  tryHintsRecoloring();
+  {
+    NamedRegionTimer T("hints_recoloring", "Hints Recoloring", TimerGroupName,
+                       TimerGroupDescription, TimePassesIsEnabled);
+    tryHintsRecoloring();
+  }
 
   if (VerifyEnabled)
     MF->verify(this, "Before post optimization", &errs());
-  postOptimization();
+  {
+    NamedRegionTimer T("post_optimization", "Post Optimization",
+                       TimerGroupName, TimerGroupDescription,
+                       TimePassesIsEnabled);
+    postOptimization();
+  }
   reportStats();
 
   releaseMemory();
@@ -84,6 +84,8 @@ using namespace llvm::SDPatternMatch;
 #define DEBUG_TYPE "dagcombine"
 
 STATISTIC(NodesCombined   , "Number of dag nodes combined");
+STATISTIC(NodesVisited    , "Number of dag nodes visited by the combiner");
+STATISTIC(NodesReplaced   , "Number of dag nodes replaced by a new node");
 STATISTIC(PreIndexedNodes , "Number of pre-indexed nodes created");
 STATISTIC(PostIndexedNodes, "Number of post-indexed nodes created");
 STATISTIC(OpsNarrowed     , "Number of load/op/store narrowed");
@@ -1773,6 +1775,7 @@ void DAGCombiner::Run(CombineLevel AtLevel) {
     }
 
     LLVM_DEBUG(dbgs() << "\nCombining: "; N->dump(&DAG));
+    ++NodesVisited;
 
     // Add any operands of the new node which have not yet been combined to the
     // worklist as well. getNextWorklistEntry flags nodes that have been
@@ -1804,6 +1807,7 @@ void DAGCombiner::Run(CombineLevel AtLevel) {
            "Node was deleted but visit returned new node!");
 
     LLVM_DEBUG(dbgs() << " ... into: "; RV.dump(&DAG));
+    ++NodesReplaced;
 
     if (N->getNumValues() == RV->getNumValues())
       DAG.ReplaceAllUsesWith(N, RV.getNode());
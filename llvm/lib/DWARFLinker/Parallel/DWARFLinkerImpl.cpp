@@ -14,6 +14,7 @@
 #include "llvm/Support/FormatVariadic.h"
 #include "llvm/Support/Parallel.h"
 #include "llvm/Support/ThreadPool.h"
+#include "llvm/Support/TimeProfiler.h"
 
 using namespace llvm;
 using namespace dwarf_linker;
@@ -181,26 +182,29 @@ Error DWARFLinkerImpl::link() {
         hardware_concurrency(GlobalData.getOptions().Threads);
 
   // Link object files.
-  if (GlobalData.getOptions().Threads == 1) {
-    for (std::unique_ptr<LinkContext> &Context : ObjectContexts) {
-      // Link object file.
-      if (Error Err = Context->link(ArtificialTypeUnit.get()))
-        GlobalData.error(std::move(Err), Context->InputDWARFFile.FileName);
-
-      Context->InputDWARFFile.unload();
-    }
-  } else {
-    DefaultThreadPool Pool(llvm::parallel::strategy);
-    for (std::unique_ptr<LinkContext> &Context : ObjectContexts)
-      Pool.async([&]() {
+  {
+    llvm::TimeTraceScope TimeScope("Link object files");
+    if (GlobalData.getOptions().Threads == 1) {
+      for (std::unique_ptr<LinkContext> &Context : ObjectContexts) {
         // Link object file.
         if (Error Err = Context->link(ArtificialTypeUnit.get()))
           GlobalData.error(std::move(Err), Context->InputDWARFFile.FileName);
 
         Context->InputDWARFFile.unload();
-      });
-
-    Pool.wait();
+      }
+    } else {
+      DefaultThreadPool Pool(llvm::parallel::strategy);
+      for (std::unique_ptr<LinkContext> &Context : ObjectContexts)
+        Pool.async([&]() {
+          // Link object file.
+          if (Error Err = Context->link(ArtificialTypeUnit.get()))
+            GlobalData.error(std::move(Err), Context->InputDWARFFile.FileName);
+
+          Context->InputDWARFFile.unload();
+        });
+
+      Pool.wait();
+    }
   }
 
   if (ArtificialTypeUnit != nullptr && !ArtificialTypeUnit->getTypePool()
@@ -208,6 +212,7 @@ Error DWARFLinkerImpl::link() {
                                             ->getValue()
                                             .load()
                                             ->Children.empty()) {
+    llvm::TimeTraceScope TimeScope("Emit artificial type unit");
     if (GlobalData.getTargetTriple().has_value())
       if (Error Err = ArtificialTypeUnit->finishCloningAndEmit(
               (*GlobalData.getTargetTriple()).get()))
@@ -865,8 +870,11 @@ void DWARFLinkerImpl::glueCompileUnitsAndWriteToTheOutput() {
   // units into the resulting file.
   emitCommonSectionsAndWriteCompileUnitsToTheOutput();
 
-  if (ArtificialTypeUnit != nullptr)
+  if (ArtificialTypeUnit != nullptr) {
+    if (GlobalData.getOptions().Statistics)
+      TypePoolStats = ArtificialTypeUnit->getTypePool().getStatistics();
     ArtificialTypeUnit.reset();
+  }
 
   // Write common debug sections into the resulting file.
   writeCommonSectionsToTheOutput();
@@ -941,6 +949,20 @@ void DWARFLinkerImpl::printStatistic() {
                           ComputePercentange(InputTotal, OutputTotal));
   outs() << "----------------------------------------------------------------"
             "---------------\n\n";
+
+  if (TypePoolStats) {
+    outs() << "Type deduplication\n";
+    outs() << "----------------------------------------------------------------"
+              "---------------\n";
+    outs() << formatv("{0,-45} {1,10}\n", "Unique types",
+                      TypePoolStats->NumTypes);
+    outs() << formatv("{0,-45} {1,10}\n", "Declaration-only types",
+                      TypePoolStats->NumDeclarationOnlyTypes);
+    outs() << formatv("{0,-45} {1,10}b\n", "Type pool memory",
+                      TypePoolStats->BytesAllocated);
+    outs() << "----------------------------------------------------------------"
+              "---------------\n\n";
+  }
 }
 
 void DWARFLinkerImpl::assignOffsets() {
@@ -345,6 +345,10 @@ protected:
 
   /// Type unit.
   std::unique_ptr<TypeUnit> ArtificialTypeUnit;
+
+  /// Statistics of the type pool, collected before the artificial type unit
+  /// is released.
+  std::optional<TypePool::Statistics> TypePoolStats;
   /// @}
 
   /// \defgroup Data members accessed sequentially.
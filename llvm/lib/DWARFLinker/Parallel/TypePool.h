@@ -157,6 +157,36 @@ public:
   /// Return root for all type entries.
   TypeEntry *getRoot() const { return Root; }
 
+  /// Counters describing the kept type entries.
+  struct Statistics {
+    /// Number of types kept in the pool.
+    uint64_t NumTypes = 0;
+
+    /// Number of kept types for which no definition was met.
+    uint64_t NumDeclarationOnlyTypes = 0;
+
+    /// Number of bytes allocated for the type entries and their DIEs.
+    uint64_t BytesAllocated = 0;
+  };
+
+  /// Collect statistics for the kept type entries. Must not be called while
+  /// types are being added.
+  Statistics getStatistics() const {
+    Statistics Result;
+    std::function<void(TypeEntry * Entry)> CountRec = [&](TypeEntry *Entry) {
+      Entry->getValue().load()->Children.forEach([&](TypeEntry *Child) {
+        ++Result.NumTypes;
+        if (Child->getValue().load()->hasOnlyDeclaration())
+          ++Result.NumDeclarationOnlyTypes;
+        CountRec(Child);
+      });
+    };
+
+    CountRec(getRoot());
+    Result.BytesAllocated = Allocator.getBytesAllocated();
+    return Result;
+  }
+
   /// Return thread local allocator used by pool.
   BumpPtrAllocator &getThreadLocalAllocator() {
     return Allocator.getThreadLocalAllocator();
@@ -50,6 +50,7 @@
 #include "llvm/Support/LEB128.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
+#include "llvm/Support/ThreadPool.h"
 #include "llvm/Support/raw_ostream.h"
 #include <cstdint>
 #include <deque>
@@ -1511,6 +1512,20 @@ DWARFUnit *DWARFContext::getUnitForOffset(uint64_t Offset) {
   return State->getNormalUnits().getUnitForOffset(Offset);
 }
 
+void DWARFContext::extractAllUnitDIEs(unsigned NumThreads) {
+  // The abbreviation sets are cached in the context and shared between units,
+  // parse them sequentially first so that the extraction of the DIEs of each
+  // unit only touches its own data. The DIEs of all units must be extracted
+  // before any of them is accessed, as there might be cross-unit references.
+  for (const auto &U : info_section_units())
+    U->getAbbreviations();
+
+  DefaultThreadPool Pool(hardware_concurrency(NumThreads));
+  for (const auto &U : info_section_units())
+    Pool.async([&U]() { U->getUnitDIE(/*ExtractUnitDIEOnly=*/false); });
+  Pool.wait();
+}
+
 DWARFCompileUnit *DWARFContext::getCompileUnitForOffset(uint64_t Offset) {
   return dyn_cast_or_null<DWARFCompileUnit>(getUnitForOffset(Offset));
 }
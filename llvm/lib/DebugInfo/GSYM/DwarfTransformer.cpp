@@ -29,6 +29,11 @@ struct llvm::gsym::CUInfo {
   const DWARFDebugLine::LineTable *LineTable;
   const char *CompDir;
   std::vector<uint32_t> FileCache;
+  /// The function infos created for this compile unit. They are handed to the
+  /// GsymCreator in one batch once the whole compile unit has been converted,
+  /// so that threads converting different compile units only contend on the
+  /// functions list once per compile unit.
+  std::vector<FunctionInfo> FunctionInfos;
   uint64_t Language = 0;
   uint8_t AddrSize = 0;
 
@@ -548,7 +553,7 @@ void DwarfTransformer::handleDie(OutputAggregator &Out, CUInfo &CUI,
       if (LoadDwarfCallSites)
         parseCallSiteInfoFromDwarf(CUI, Die, FI);
 
-      Gsym.addFunctionInfo(std::move(FI));
+      CUI.FunctionInfos.push_back(std::move(FI));
     }
   } break;
   default:
@@ -646,24 +651,16 @@ Error DwarfTransformer::convert(uint32_t NumThreads, OutputAggregator &Out) {
       DWARFDie Die = getDie(*CU);
       CUInfo CUI(DICtx, dyn_cast<DWARFCompileUnit>(CU.get()));
       handleDie(Out, CUI, Die);
+      Gsym.addFunctionInfos(std::move(CUI.FunctionInfos));
     }
   } else {
     // LLVM Dwarf parser is not thread-safe and we need to parse all DWARF up
     // front before we start accessing any DIEs since there might be
     // cross compile unit references in the DWARF. If we don't do this we can
     // end up crashing.
+    DICtx.extractAllUnitDIEs(NumThreads);
 
-    // We need to call getAbbreviations sequentially first so that getUnitDIE()
-    // only works with its local data.
-    for (const auto &CU : DICtx.compile_units())
-      CU->getAbbreviations();
-
-    // Now parse all DIEs in case we have cross compile unit references in a
-    // thread pool.
     DefaultThreadPool pool(hardware_concurrency(NumThreads));
-    for (const auto &CU : DICtx.compile_units())
-      pool.async([&CU]() { CU->getUnitDIE(false /*CUDieOnly*/); });
-    pool.wait();
 
     // Now convert all DWARF to GSYM in a thread pool.
     std::mutex LogMutex;
@@ -676,6 +673,7 @@ Error DwarfTransformer::convert(uint32_t NumThreads, OutputAggregator &Out) {
           raw_string_ostream StrStream(storage);
           OutputAggregator ThreadOut(Out.GetOS() ? &StrStream : nullptr);
           handleDie(ThreadOut, CUI, Die);
+          Gsym.addFunctionInfos(std::move(CUI.FunctionInfos));
           // Print ThreadLogStorage lines into an actual stream under a lock
           std::lock_guard<std::mutex> guard(LogMutex);
           if (Out.GetOS()) {
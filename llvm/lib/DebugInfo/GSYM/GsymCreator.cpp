@@ -398,6 +398,13 @@ void GsymCreator::addFunctionInfo(FunctionInfo &&FI) {
   Funcs.emplace_back(std::move(FI));
 }
 
+void GsymCreator::addFunctionInfos(std::vector<FunctionInfo> &&FIs) {
+  std::lock_guard<std::mutex> Guard(Mutex);
+  for (FunctionInfo &FI : FIs)
+    Funcs.emplace_back(std::move(FI));
+  FIs.clear();
+}
+
 void GsymCreator::forEachFunctionInfo(
     std::function<bool(FunctionInfo &)> const &Callback) {
   std::lock_guard<std::mutex> Guard(Mutex);
@@ -0,0 +1,151 @@
+//===-- GsymDIContext.cpp -------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/DebugInfo/GSYM/GsymDIContext.h"
+#include "llvm/DebugInfo/GSYM/LookupResult.h"
+#include "llvm/Support/Path.h"
+
+using namespace llvm;
+using namespace llvm::gsym;
+
+GsymDIContext::GsymDIContext(std::unique_ptr<GsymReader> Reader)
+    : DIContext(CK_GSYM), Reader(std::move(Reader)) {}
+
+void GsymDIContext::dump(raw_ostream &OS, DIDumpOptions DumpOpts) {}
+
+static bool fillLineInfoFromLocation(const SourceLocation &Location,
+                                     DILineInfoSpecifier Specifier,
+                                     DILineInfo &LineInfo) {
+  // FIXME Demangle in case of DINameKind::ShortName
+  if (Specifier.FNKind != DINameKind::None)
+    LineInfo.FunctionName = Location.Name.str();
+
+  switch (Specifier.FLIKind) {
+  case DILineInfoSpecifier::FileLineInfoKind::RelativeFilePath:
+    // We have no information to determine the relative path, so we fall back
+    // to returning the absolute path.
+  case DILineInfoSpecifier::FileLineInfoKind::RawValue:
+  case DILineInfoSpecifier::FileLineInfoKind::AbsoluteFilePath:
+    if (Location.Dir.empty()) {
+      if (Location.Base.empty())
+        LineInfo.FileName = DILineInfo::BadString;
+      else
+        LineInfo.FileName = Location.Base.str();
+    } else {
+      SmallString<128> Path(Location.Dir);
+      sys::path::append(Path, Location.Base);
+      LineInfo.FileName = static_cast<std::string>(Path);
+    }
+    break;
+
+  case DILineInfoSpecifier::FileLineInfoKind::BaseNameOnly:
+    LineInfo.FileName = Location.Base.str();
+    break;
+
+  default:
+    return false;
+  }
+  LineInfo.Line = Location.Line;
+  // GSYM has no Source, Column, StartFileName or StartLine information.
+  return true;
+}
+
+DILineInfo
+GsymDIContext::getLineInfoForAddress(object::SectionedAddress Address,
+                                     DILineInfoSpecifier Specifier) {
+  auto ResultOrErr = Reader->lookup(Address.Address);
+  if (!ResultOrErr) {
+    consumeError(ResultOrErr.takeError());
+    return {};
+  }
+
+  const LookupResult &Result = *ResultOrErr;
+  DILineInfo LineInfo;
+  if (Result.Locations.empty()) {
+    // No line table for this function, only a symbol from the symbol table.
+    // FIXME Demangle in case of DINameKind::ShortName
+    if (Specifier.FNKind != DINameKind::None)
+      LineInfo.FunctionName = Result.FuncName.str();
+  } else if (!fillLineInfoFromLocation(Result.Locations.front(), Specifier,
+                                       LineInfo))
+    return {};
+
+  LineInfo.StartAddress = Result.FuncRange.start();
+  return LineInfo;
+}
+
+DILineInfo
+GsymDIContext::getLineInfoForDataAddress(object::SectionedAddress Address) {
+  // GSYM does not convey such information.
+  return {};
+}
+
+DILineInfoTable
+GsymDIContext::getLineInfoForAddressRange(object::SectionedAddress Address,
+                                          uint64_t Size,
+                                          DILineInfoSpecifier Specifier) {
+  if (Size == 0)
+    return {};
+
+  auto FuncInfoOrErr = Reader->getFunctionInfo(Address.Address);
+  if (!FuncInfoOrErr) {
+    consumeError(FuncInfoOrErr.takeError());
+    return {};
+  }
+
+  DILineInfoTable Table;
+  if (!FuncInfoOrErr->OptLineTable)
+    return Table;
+  for (const LineEntry &Entry : *FuncInfoOrErr->OptLineTable) {
+    if (Entry.Addr < Address.Address)
+      continue;
+    if (Entry.Addr >= Address.Address + Size)
+      break;
+    auto ResultOrErr = Reader->lookup(Entry.Addr);
+    if (!ResultOrErr) {
+      consumeError(ResultOrErr.takeError());
+      continue;
+    }
+    DILineInfo LineInfo;
+    if (ResultOrErr->Locations.empty() ||
+        !fillLineInfoFromLocation(ResultOrErr->Locations.front(), Specifier,
+                                  LineInfo))
+      continue;
+    LineInfo.StartAddress = ResultOrErr->FuncRange.start();
+    Table.push_back(std::make_pair(Entry.Addr, LineInfo));
+  }
+  return Table;
+}
+
+DIInliningInfo
+GsymDIContext::getInliningInfoForAddress(object::SectionedAddress Address,
+                                         DILineInfoSpecifier Specifier) {
+  auto ResultOrErr = Reader->lookup(Address.Address);
+  if (!ResultOrErr) {
+    consumeError(ResultOrErr.takeError());
+    return {};
+  }
+
+  const LookupResult &Result = *ResultOrErr;
+  DIInliningInfo InlineInfo;
+  for (const SourceLocation &Location : Result.Locations) {
+    DILineInfo LineInfo;
+    if (!fillLineInfoFromLocation(Location, Specifier, LineInfo))
+      return {};
+
+    LineInfo.StartAddress = Result.FuncRange.start();
+    InlineInfo.addFrame(LineInfo);
+  }
+  return InlineInfo;
+}
+
+std::vector<DILocal>
+GsymDIContext::getLocalsForAddress(object::SectionedAddress Address) {
+  // GSYM does not convey such information.
+  return {};
+}
@@ -15,6 +15,8 @@
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/DebugInfo/BTF/BTFContext.h"
 #include "llvm/DebugInfo/DWARF/DWARFContext.h"
+#include "llvm/DebugInfo/GSYM/GsymDIContext.h"
+#include "llvm/DebugInfo/GSYM/GsymReader.h"
 #include "llvm/DebugInfo/PDB/PDB.h"
 #include "llvm/DebugInfo/PDB/PDBContext.h"
 #include "llvm/DebugInfo/Symbolize/SymbolizableObjectFile.h"
@@ -411,6 +413,52 @@ ObjectFile *LLVMSymbolizer::lookUpDebuglinkObject(const std::string &Path,
   return DbgObjOrErr.get();
 }
 
+std::unique_ptr<DIContext>
+LLVMSymbolizer::lookUpGsymFile(const std::string &Path,
+                               const ObjectFile *Obj) {
+  auto CheckGsymFile = [](StringRef GsymPath) {
+    sys::fs::file_status Status;
+    std::error_code EC = sys::fs::status(GsymPath, Status);
+    return !EC && !sys::fs::is_directory(Status);
+  };
+
+  // First, look beside the binary file.
+  std::string GsymPath = Path + ".gsym";
+  if (!CheckGsymFile(GsymPath)) {
+    // Then, look in the directories specified by GsymFileDirectory.
+    GsymPath.clear();
+    for (const std::string &Directory : Opts.GsymFileDirectory) {
+      SmallString<128> FilePath(Directory);
+      sys::path::append(FilePath, sys::path::filename(Path) + ".gsym");
+      if (CheckGsymFile(FilePath)) {
+        GsymPath = std::string(FilePath);
+        break;
+      }
+    }
+    if (GsymPath.empty())
+      return nullptr;
+  }
+
+  auto ReaderOrErr = gsym::GsymReader::openFile(GsymPath);
+  if (!ReaderOrErr) {
+    // Ignore errors, fall back to the debug info of the binary.
+    consumeError(ReaderOrErr.takeError());
+    return nullptr;
+  }
+  // Only use a GSYM file that was created from this very binary. GSYM files
+  // record the build ID (ELF) or UUID (Mach-O) of their binary.
+  ArrayRef<uint8_t> BinaryUUID;
+  if (auto *MachO = dyn_cast<MachOObjectFile>(Obj))
+    BinaryUUID = MachO->getUuid();
+  else
+    BinaryUUID = getBuildID(Obj);
+  const gsym::Header &Hdr = ReaderOrErr->getHeader();
+  if (ArrayRef<uint8_t>(Hdr.UUID, Hdr.UUIDSize) != BinaryUUID)
+    return nullptr;
+  return std::make_unique<gsym::GsymDIContext>(
+      std::make_unique<gsym::GsymReader>(std::move(*ReaderOrErr)));
+}
+
 ObjectFile *LLVMSymbolizer::lookUpBuildIDObject(const std::string &Path,
                                                 const ELFObjectFileBase *Obj,
                                                 const std::string &ArchName) {
@@ -660,6 +708,8 @@ LLVMSymbolizer::getOrCreateModuleInfo(StringRef ModuleName) {
       Context.reset(new PDBContext(*CoffObject, std::move(Session)));
     }
   }
+  if (!Context && !Opts.DisableGsym)
+    Context = lookUpGsymFile(std::string(BinaryName), Objects.first);
   if (!Context)
     Context = DWARFContext::create(
         *Objects.second, DWARFContext::ProcessDebugRelocations::Process,
@@ -398,6 +398,8 @@ bool JITLinkContext::shouldAddDefaultTargetPasses(const Triple &TT) const {
   return true;
 }
 
+bool JITLinkContext::shouldApplyFixupsConcurrently() const { return false; }
+
 LinkGraphPassFunction JITLinkContext::getMarkLivePass(const Triple &TT) const {
   return LinkGraphPassFunction();
 }
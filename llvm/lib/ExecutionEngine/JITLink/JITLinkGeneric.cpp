@@ -11,6 +11,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "JITLinkGeneric.h"
+#include "llvm/Support/TimeProfiler.h"
 
 #define DEBUG_TYPE "jitlink"
 
@@ -34,7 +35,10 @@ void JITLinkerBase::linkPhase1(std::unique_ptr<JITLinkerBase> Self) {
     G->dump(dbgs());
   });
 
-  prune(*G);
+  {
+    TimeTraceScope TimeScope("JITLink prune", G->getName());
+    prune(*G);
+  }
 
   LLVM_DEBUG({
     dbgs() << "Link graph \"" << G->getName() << "\" post-pruning:\n";
@@ -157,8 +161,11 @@ void JITLinkerBase::linkPhase3(std::unique_ptr<JITLinkerBase> Self,
   });
 
   // Fix up block content.
-  if (auto Err = fixUpBlocks(*G))
-    return abandonAllocAndBailOut(std::move(Self), std::move(Err));
+  {
+    TimeTraceScope TimeScope("JITLink fixup", G->getName());
+    if (auto Err = fixUpBlocks(*G))
+      return abandonAllocAndBailOut(std::move(Self), std::move(Err));
+  }
 
   LLVM_DEBUG({
     dbgs() << "Link graph \"" << G->getName() << "\" after copy-and-fixup:\n";
@@ -199,6 +206,7 @@ void JITLinkerBase::linkPhase4(std::unique_ptr<JITLinkerBase> Self,
 }
 
 Error JITLinkerBase::runPasses(LinkGraphPassList &Passes) {
+  TimeTraceScope TimeScope("JITLink passes", G->getName());
   for (auto &P : Passes)
     if (auto Err = P(*G))
       return Err;
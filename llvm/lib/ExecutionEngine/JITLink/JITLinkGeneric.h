@@ -14,6 +14,9 @@
 #define LIB_EXECUTIONENGINE_JITLINK_JITLINKGENERIC_H
 
 #include "llvm/ExecutionEngine/JITLink/JITLink.h"
+#include "llvm/Support/Parallel.h"
+
+#include <mutex>
 
 #define DEBUG_TYPE "jitlink"
 
@@ -58,6 +61,11 @@ protected:
   // a GOT start symbol prior to fixup).
   PassConfiguration &getPassConfig() { return Passes; }
 
+  // Returns true if the context allows blocks to be fixed up in parallel.
+  bool shouldApplyFixupsConcurrently() const {
+    return Ctx->shouldApplyFixupsConcurrently();
+  }
+
   // Phase 1:
   //   1.1: Run pre-prune passes
   //   1.2: Prune graph
@@ -132,46 +140,85 @@ private:
   Error fixUpBlocks(LinkGraph &G) const override {
     LLVM_DEBUG(dbgs() << "Fixing up blocks:\n");
 
+    if (shouldApplyFixupsConcurrently())
+      return fixUpBlocksConcurrently(G);
+
     for (auto &Sec : G.sections()) {
       bool NoAllocSection = Sec.getMemLifetime() == orc::MemLifetime::NoAlloc;
+      for (auto *B : Sec.blocks())
+        if (auto Err = fixUpBlock(G, *B, NoAllocSection))
+          return Err;
+    }
 
+    return Error::success();
+  }
+
+  Error fixUpBlocksConcurrently(LinkGraph &G) const {
+    // Fixups only write to the content of the block they belong to, so blocks
+    // can be fixed up independently. Content of no-alloc sections is copied
+    // onto the graph's allocator, which is not thread safe, before starting.
+    std::vector<Block *> Blocks;
+    std::vector<Block *> NoAllocBlocks;
+    for (auto &Sec : G.sections()) {
+      bool NoAllocSection = Sec.getMemLifetime() == orc::MemLifetime::NoAlloc;
       for (auto *B : Sec.blocks()) {
-        LLVM_DEBUG(dbgs() << "  " << *B << ":\n");
-
-        // Copy Block data and apply fixups.
-        LLVM_DEBUG(dbgs() << "    Applying fixups.\n");
-        assert((!B->isZeroFill() || all_of(B->edges(),
-                                           [](const Edge &E) {
-                                             return E.getKind() ==
-                                                    Edge::KeepAlive;
-                                           })) &&
-               "Non-KeepAlive edges in zero-fill block?");
-
-        // If this is a no-alloc section then copy the block content into
-        // memory allocated on the Graph's allocator (if it hasn't been
-        // already).
-        if (NoAllocSection)
+        if (NoAllocSection) {
           (void)B->getMutableContent(G);
+          NoAllocBlocks.push_back(B);
+        } else
+          Blocks.push_back(B);
+      }
+    }
 
-        for (auto &E : B->edges()) {
-
-          // Skip non-relocation edges.
-          if (!E.isRelocation())
-            continue;
-
-          // If B is a block in a Standard or Finalize section then make sure
-          // that no edges point to symbols in NoAlloc sections.
-          assert((NoAllocSection || !E.getTarget().isDefined() ||
-                  E.getTarget().getSection().getMemLifetime() !=
-                      orc::MemLifetime::NoAlloc) &&
-                 "Block in allocated section has edge pointing to no-alloc "
-                 "section");
-
-          // Dispatch to LinkerImpl for fixup.
-          if (auto Err = impl().applyFixup(G, *B, E))
-            return Err;
+    std::mutex ErrMutex;
+    Error Err = Error::success();
+    auto FixUp = [&](ArrayRef<Block *> Blocks, bool NoAllocSection) {
+      parallelFor(0, Blocks.size(), [&](size_t I) {
+        if (auto BlockErr = fixUpBlock(G, *Blocks[I], NoAllocSection)) {
+          std::lock_guard<std::mutex> Lock(ErrMutex);
+          Err = joinErrors(std::move(Err), std::move(BlockErr));
         }
-      }
+      });
+    };
+    FixUp(Blocks, /*NoAllocSection=*/false);
+    FixUp(NoAllocBlocks, /*NoAllocSection=*/true);
+    return Err;
+  }
+
+  Error fixUpBlock(LinkGraph &G, Block &B, bool NoAllocSection) const {
+    LLVM_DEBUG(dbgs() << "  " << B << ":\n");
+
+    // Copy Block data and apply fixups.
+    LLVM_DEBUG(dbgs() << "    Applying fixups.\n");
+    assert((!B.isZeroFill() || all_of(B.edges(),
+                                      [](const Edge &E) {
+                                        return E.getKind() == Edge::KeepAlive;
+                                      })) &&
+           "Non-KeepAlive edges in zero-fill block?");
+
+    // If this is a no-alloc section then copy the block content into
+    // memory allocated on the Graph's allocator (if it hasn't been
+    // already).
+    if (NoAllocSection)
+      (void)B.getMutableContent(G);
+
+    for (auto &E : B.edges()) {
+
+      // Skip non-relocation edges.
+      if (!E.isRelocation())
+        continue;
+
+      // If B is a block in a Standard or Finalize section then make sure
+      // that no edges point to symbols in NoAlloc sections.
+      assert((NoAllocSection || !E.getTarget().isDefined() ||
+              E.getTarget().getSection().getMemLifetime() !=
+                  orc::MemLifetime::NoAlloc) &&
+             "Block in allocated section has edge pointing to no-alloc "
+             "section");
+
+      // Dispatch to LinkerImpl for fixup.
+      if (auto Err = impl().applyFixup(G, B, E))
+        return Err;
     }
 
     return Error::success();
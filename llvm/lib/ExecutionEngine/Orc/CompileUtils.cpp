@@ -47,9 +47,11 @@ Expected<SimpleCompiler::CompileResult> SimpleCompiler::operator()(Module &M) {
 
     legacy::PassManager PM;
     MCContext *Ctx;
-    if (TM.addPassesToEmitMC(PM, Ctx, ObjStream))
+    if (TM.addPassesToEmitMC(PM, Ctx, ObjStream)) {
+      notifyObjectCompileFailed(M);
       return make_error<StringError>("Target does not support MC emission",
                                      inconvertibleErrorCode());
+    }
     PM.run(M);
   }
 
@@ -59,8 +61,10 @@ Expected<SimpleCompiler::CompileResult> SimpleCompiler::operator()(Module &M) {
 
   auto Obj = object::ObjectFile::createObjectFile(ObjBuffer->getMemBufferRef());
 
-  if (!Obj)
+  if (!Obj) {
+    notifyObjectCompileFailed(M);
     return Obj.takeError();
+  }
 
   notifyObjectCompiled(M, *ObjBuffer);
   return std::move(ObjBuffer);
@@ -74,6 +78,11 @@ SimpleCompiler::tryToLoadFromObjectCache(const Module &M) {
   return ObjCache->getObject(&M);
 }
 
+void SimpleCompiler::notifyObjectCompileFailed(const Module &M) {
+  if (ObjCache)
+    ObjCache->notifyObjectCompileFailed(&M);
+}
+
 void SimpleCompiler::notifyObjectCompiled(const Module &M,
                                           const MemoryBuffer &ObjBuffer) {
   if (ObjCache)
@@ -225,6 +225,10 @@ public:
     }
   }
 
+  bool shouldApplyFixupsConcurrently() const override {
+    return Layer.ApplyFixupsConcurrently;
+  }
+
   LinkGraphPassFunction getMarkLivePass(const Triple &TT) const override {
     return [this](LinkGraph &G) { return markResponsibilitySymbolsLive(G); };
   }
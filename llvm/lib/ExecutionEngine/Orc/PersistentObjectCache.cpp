@@ -0,0 +1,154 @@
+//===---- PersistentObjectCache.cpp - On-disk object cache for ORC --------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ExecutionEngine/Orc/PersistentObjectCache.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Bitcode/BitcodeWriter.h"
+#include "llvm/Config/llvm-config.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/SHA256.h"
+#include "llvm/Support/VCSRevision.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Target/TargetMachine.h"
+
+using namespace llvm;
+using namespace llvm::orc;
+
+std::string PersistentObjectCache::getTargetKey(const TargetMachine &TM) {
+  std::string Key;
+  raw_string_ostream OS(Key);
+  // Development builds of the same version differ in their revision.
+  OS << LLVM_VERSION_STRING << ';';
+#ifdef LLVM_REVISION
+  OS << LLVM_REVISION << ';';
+#endif
+  OS << TM.getTargetTriple().str() << ';' << TM.getTargetCPU() << ';'
+     << TM.getTargetFeatureString() << ';'
+     << static_cast<int>(TM.getOptLevel()) << ';'
+     << static_cast<int>(TM.getRelocationModel()) << ';'
+     << static_cast<int>(TM.getCodeModel()) << ';';
+
+  // All options that can change the generated object. Options that only
+  // affect diagnostics or textual assembly output are left out.
+  const TargetOptions &Opts = TM.Options;
+  OS << Opts.UnsafeFPMath << Opts.NoInfsFPMath << Opts.NoNaNsFPMath
+     << Opts.NoTrappingFPMath << Opts.NoSignedZerosFPMath
+     << Opts.ApproxFuncFPMath << Opts.EnableAIXExtendedAltivecABI
+     << Opts.HonorSignDependentRoundingFPMathOption << Opts.NoZerosInBSS
+     << Opts.GuaranteedTailCallOpt << Opts.StackSymbolOrdering
+     << Opts.EnableFastISel << Opts.EnableGlobalISel << Opts.UseInitArray
+     << Opts.DisableIntegratedAS << Opts.FunctionSections << Opts.DataSections
+     << Opts.IgnoreXCOFFVisibility << Opts.XCOFFTracebackTable
+     << Opts.UniqueSectionNames << Opts.UniqueBasicBlockSectionNames
+     << Opts.SeparateNamedSections << Opts.TrapUnreachable
+     << Opts.NoTrapAfterNoreturn << Opts.EmulatedTLS << Opts.EnableTLSDESC
+     << Opts.EnableIPRA << Opts.EmitStackSizeSection
+     << Opts.EnableMachineOutliner << Opts.EnableMachineFunctionSplitter
+     << Opts.EnableStaticDataPartitioning << Opts.SupportsDefaultOutlining
+     << Opts.EmitAddrsig << Opts.BBAddrMap << Opts.EmitCallSiteInfo
+     << Opts.SupportsDebugEntryValues << Opts.EnableDebugEntryValues
+     << Opts.ValueTrackingVariableLocations << Opts.ForceDwarfFrameSection
+     << Opts.XRayFunctionIndex << Opts.DebugStrictDwarf << Opts.Hotpatch
+     << Opts.PPCGenScalarMASSEntries << Opts.JMCInstrument
+     << Opts.EnableCFIFixup << Opts.MisExpect << Opts.XCOFFReadOnlyPointers
+     << ';' << static_cast<int>(Opts.GlobalISelAbort) << ';'
+     << static_cast<int>(Opts.BBSections) << ';' << Opts.LoopAlignment << ';'
+     << static_cast<int>(Opts.FloatABIType) << ';'
+     << static_cast<int>(Opts.AllowFPOpFusion) << ';'
+     << static_cast<int>(Opts.ThreadModel) << ';'
+     << static_cast<int>(Opts.EABIVersion) << ';'
+     << static_cast<int>(Opts.DebuggerTuning) << ';' << Opts.FPDenormalMode
+     << ';' << Opts.FP32DenormalMode << ';'
+     << static_cast<int>(Opts.ExceptionModel) << ';'
+     << Opts.ObjectFilenameForDebug << ';';
+  if (Opts.BBSectionsFuncListBuf)
+    OS << toHex(SHA256::hash(arrayRefFromStringRef(
+                    Opts.BBSectionsFuncListBuf->getBuffer())),
+                /*LowerCase=*/true);
+  OS << ';';
+
+  const MCTargetOptions &MCOpts = Opts.MCOptions;
+  OS << MCOpts.MCRelaxAll << MCOpts.MCNoExecStack
+     << MCOpts.MCIncrementalLinkerCompatible << MCOpts.FDPIC << MCOpts.Dwarf64
+     << MCOpts.Crel << MCOpts.ImplicitMapSyms << MCOpts.X86RelaxRelocations
+     << MCOpts.X86Sse2Avx << MCOpts.EmitCompactUnwindNonCanonical << ';'
+     << static_cast<int>(MCOpts.EmitDwarfUnwind) << ';' << MCOpts.DwarfVersion
+     << ';' << static_cast<int>(MCOpts.MCUseDwarfDirectory) << ';'
+     << static_cast<int>(MCOpts.CompressDebugSections) << ';'
+     << MCOpts.ABIName << ';' << MCOpts.SplitDwarfFile << ';' << MCOpts.Argv0
+     << ';' << MCOpts.CommandlineArgs;
+  return Key;
+}
+
+std::string PersistentObjectCache::computeKey(const Module &M) const {
+  SmallString<0> Bitcode;
+  raw_svector_ostream OS(Bitcode);
+  WriteBitcodeToFile(M, OS);
+  SHA256 Hasher;
+  Hasher.update(TargetKey);
+  Hasher.update(Bitcode);
+  return toHex(Hasher.final(), /*LowerCase=*/true);
+}
+
+std::string PersistentObjectCache::getEntryPath(StringRef Key) const {
+  SmallString<256> Path(CacheDir);
+  sys::path::append(Path, Key + ".o");
+  return std::string(Path);
+}
+
+std::string PersistentObjectCache::getEntryPath(const Module &M) const {
+  return getEntryPath(computeKey(M));
+}
+
+std::unique_ptr<MemoryBuffer>
+PersistentObjectCache::getObject(const Module *M) {
+  std::string Key = computeKey(*M);
+  auto BufferOrErr =
+      MemoryBuffer::getFile(getEntryPath(Key), /*IsText=*/false,
+                            /*RequiresNullTerminator=*/false);
+  if (BufferOrErr)
+    return std::move(*BufferOrErr);
+
+  // Remember the key, the module may be modified by code generation before
+  // the compiled object is reported.
+  std::lock_guard<std::mutex> Lock(PendingMutex);
+  PendingKeys[M] = std::move(Key);
+  return nullptr;
+}
+
+void PersistentObjectCache::notifyObjectCompileFailed(const Module *M) {
+  std::lock_guard<std::mutex> Lock(PendingMutex);
+  PendingKeys.erase(M);
+}
+
+void PersistentObjectCache::notifyObjectCompiled(const Module *M,
+                                                 MemoryBufferRef Obj) {
+  std::string Key;
+  {
+    std::lock_guard<std::mutex> Lock(PendingMutex);
+    auto I = PendingKeys.find(M);
+    if (I == PendingKeys.end())
+      return;
+    Key = std::move(I->second);
+    PendingKeys.erase(I);
+  }
+
+  if (sys::fs::create_directories(CacheDir))
+    return;
+  // writeToOutput() goes through a temporary file, so concurrent processes
+  // never observe a partially written entry. Failing to store an entry only
+  // means the next process compiles the module again.
+  consumeError(writeToOutput(getEntryPath(Key), [&](raw_ostream &OS) {
+    OS << Obj.getBuffer();
+    return Error::success();
+  }));
+}
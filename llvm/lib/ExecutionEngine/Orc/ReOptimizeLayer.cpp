@@ -100,7 +100,8 @@ Error ReOptimizeLayer::reoptimizeIfCallFrequent(ReOptimizeLayer &Parent,
       auto &BB = F.getEntryBlock();
       auto *IP = &*BB.getFirstInsertionPt();
       IRBuilder<> IRB(IP);
-      Value *Threshold = ConstantInt::get(I64Ty, CallCountThreshold, true);
+      Value *Threshold =
+          ConstantInt::get(I64Ty, Parent.getCallCountThreshold(), true);
       Value *Cnt = IRB.CreateLoad(I64Ty, Counter);
       // Use EQ to prevent further reoptimize calls.
       Value *Cmp = IRB.CreateICmpEQ(Cnt, Threshold);
@@ -164,37 +165,52 @@ void ReOptimizeLayer::rt_reoptimize(SendErrorFn SendResult,
     return;
   }
 
+  auto Start = std::chrono::steady_clock::now();
   ThreadSafeModule TSM = cloneToNewContext(MUState.getThreadSafeModule());
   auto OldRT = MUState.getResourceTracker();
   auto &JD = OldRT->getJITDylib();
 
-  if (auto Err = ReOptFunc(*this, MUID, CurVersion + 1, OldRT, TSM)) {
+  auto Fail = [&](Error Err) {
     ES.reportError(std::move(Err));
     MUState.reoptimizeFailed();
+    recordReoptimization(CurVersion + 1, Start, /*Succeeded=*/false);
     SendResult(Error::success());
-    return;
-  }
+  };
+
+  if (auto Err = ReOptFunc(*this, MUID, CurVersion + 1, OldRT, TSM))
+    return Fail(std::move(Err));
 
   auto SymbolDests =
       emitMUImplSymbols(MUState, CurVersion + 1, JD, std::move(TSM));
-  if (!SymbolDests) {
-    ES.reportError(SymbolDests.takeError());
-    MUState.reoptimizeFailed();
-    SendResult(Error::success());
-    return;
-  }
+  if (!SymbolDests)
+    return Fail(SymbolDests.takeError());
 
-  if (auto Err = RSManager.redirect(JD, std::move(*SymbolDests))) {
-    ES.reportError(std::move(Err));
-    MUState.reoptimizeFailed();
-    SendResult(Error::success());
-    return;
-  }
+  if (auto Err = RSManager.redirect(JD, std::move(*SymbolDests)))
+    return Fail(std::move(Err));
 
   MUState.reoptimizeSucceeded();
+  recordReoptimization(CurVersion + 1, Start, /*Succeeded=*/true);
   SendResult(Error::success());
 }
 
+void ReOptimizeLayer::recordReoptimization(
+    uint32_t Version, std::chrono::steady_clock::time_point Start,
+    bool Succeeded) {
+  auto Latency = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - Start);
+  std::lock_guard<std::mutex> Lock(StatsMutex);
+  if (Stats.size() <= Version)
+    Stats.resize(Version + 1);
+  VersionStats &VS = Stats[Version];
+  if (!Succeeded) {
+    ++VS.NumFailed;
+    return;
+  }
+  ++VS.NumReoptimized;
+  VS.TotalLatency += Latency;
+  VS.MaxLatency = std::max(VS.MaxLatency, Latency);
+}
+
 Expected<Constant *> ReOptimizeLayer::createReoptimizeArgBuffer(
     Module &M, ReOptMaterializationUnitID MUID, uint32_t CurVersion) {
   size_t ArgBufferSize = SPSReoptimizeArgList::size(MUID, CurVersion);
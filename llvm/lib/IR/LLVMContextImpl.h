@@ -1517,6 +1517,11 @@ public:
 
   DenseMap<const Value *, ValueName *> ValueNames;
 
+  // The uniquing tables below are deliberately unsynchronized, see the comment
+  // on LLVMContext. Guarding them alone would not let several threads create
+  // IR in one context: uniquing a constant or a metadata node also adds uses to
+  // its operands, and the resulting use lists are shared with every function
+  // referring to them.
   DenseMap<unsigned, std::unique_ptr<ConstantInt>> IntZeroConstants;
   DenseMap<unsigned, std::unique_ptr<ConstantInt>> IntOneConstants;
   DenseMap<APInt, std::unique_ptr<ConstantInt>> IntConstants;
@@ -79,8 +79,11 @@ LLVMRemarkStreamer::toRemark(const DiagnosticInfoOptimizationBase &Diag) const {
 }
 
 void LLVMRemarkStreamer::emit(const DiagnosticInfoOptimizationBase &Diag) {
-  if (!RS.matchesFilter(Diag.getPassName()))
-      return;
+  // Filter before converting, so dropped remarks never reach the serializer
+  // or its string table.
+  if (!RS.matchesFilter(Diag.getPassName()) ||
+      !RS.matchesNameFilter(Diag.getRemarkName()))
+    return;
 
   // First, convert the diagnostic to a remark.
   remarks::Remark R = toRemark(Diag);
@@ -95,7 +98,7 @@ char LLVMRemarkSetupFormatError::ID = 0;
 Expected<std::unique_ptr<ToolOutputFile>> llvm::setupLLVMOptimizationRemarks(
     LLVMContext &Context, StringRef RemarksFilename, StringRef RemarksPasses,
     StringRef RemarksFormat, bool RemarksWithHotness,
-    std::optional<uint64_t> RemarksHotnessThreshold) {
+    std::optional<uint64_t> RemarksHotnessThreshold, StringRef RemarksNames) {
   if (RemarksWithHotness || RemarksHotnessThreshold.value_or(1))
       Context.setDiagnosticsHotnessRequested(true);
 
@@ -136,13 +139,17 @@ Expected<std::unique_ptr<ToolOutputFile>> llvm::setupLLVMOptimizationRemarks(
     if (Error E = Context.getMainRemarkStreamer()->setFilter(RemarksPasses))
       return make_error<LLVMRemarkSetupPatternError>(std::move(E));
 
+  if (!RemarksNames.empty())
+    if (Error E = Context.getMainRemarkStreamer()->setNameFilter(RemarksNames))
+      return make_error<LLVMRemarkSetupPatternError>(std::move(E));
+
   return std::move(RemarksFile);
 }
 
 Error llvm::setupLLVMOptimizationRemarks(
     LLVMContext &Context, raw_ostream &OS, StringRef RemarksPasses,
     StringRef RemarksFormat, bool RemarksWithHotness,
-    std::optional<uint64_t> RemarksHotnessThreshold) {
+    std::optional<uint64_t> RemarksHotnessThreshold, StringRef RemarksNames) {
   if (RemarksWithHotness || RemarksHotnessThreshold.value_or(1))
     Context.setDiagnosticsHotnessRequested(true);
 
@@ -170,5 +177,9 @@ Error llvm::setupLLVMOptimizationRemarks(
     if (Error E = Context.getMainRemarkStreamer()->setFilter(RemarksPasses))
       return make_error<LLVMRemarkSetupPatternError>(std::move(E));
 
+  if (!RemarksNames.empty())
+    if (Error E = Context.getMainRemarkStreamer()->setNameFilter(RemarksNames))
+      return make_error<LLVMRemarkSetupPatternError>(std::move(E));
+
   return Error::success();
 }
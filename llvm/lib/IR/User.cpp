@@ -130,6 +130,11 @@ bool User::isDroppable() const {
 //                         User operator new Implementations
 //===----------------------------------------------------------------------===//
 
+// Users are allocated from the global heap rather than from an arena owned by
+// their function: they are created before being inserted anywhere, and
+// instructions and blocks routinely move between functions (inlining, loop
+// extraction, function cloning and merging), so no single owner outlives them.
+
 void *User::allocateFixedOperandUser(size_t Size, unsigned Us,
                                      unsigned DescBytes) {
   assert(Us < (1u << NumUserOperandsBits) && "Too many operands");
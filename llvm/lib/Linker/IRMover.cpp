@@ -12,6 +12,7 @@
 #include "llvm/ADT/SetVector.h"
 #include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/IR/AutoUpgrade.h"
 #include "llvm/IR/Constants.h"
 #include "llvm/IR/DebugInfoMetadata.h"
@@ -34,6 +35,12 @@
 #include <utility>
 using namespace llvm;
 
+#define DEBUG_TYPE "irmover"
+
+STATISTIC(NumFunctionBodiesLinked, "Number of function bodies linked");
+STATISTIC(NumGlobalVariablesLinked,
+          "Number of global variable initializers linked");
+
 /// Most of the errors produced by this module are inconvertible StringErrors.
 /// This convenience function lets us return one of those more easily.
 static Error stringErr(const Twine &T) {
@@ -1147,9 +1154,12 @@ void IRLinker::linkIFuncResolver(GlobalIFunc &Dst, GlobalIFunc &Src) {
 }
 
 Error IRLinker::linkGlobalValueBody(GlobalValue &Dst, GlobalValue &Src) {
-  if (auto *F = dyn_cast<Function>(&Src))
+  if (auto *F = dyn_cast<Function>(&Src)) {
+    ++NumFunctionBodiesLinked;
     return linkFunctionBody(cast<Function>(Dst), *F);
+  }
   if (auto *GVar = dyn_cast<GlobalVariable>(&Src)) {
+    ++NumGlobalVariablesLinked;
     linkGlobalVariable(cast<GlobalVariable>(Dst), *GVar);
     return Error::success();
   }
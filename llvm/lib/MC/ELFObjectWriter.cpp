@@ -756,7 +756,10 @@ void ELFWriter::writeSectionData(const MCAssembler &Asm, MCSection &Sec) {
     return;
   }
 
-  SmallVector<char, 128> UncompressedData;
+  // Size the buffer up front, growing it while writing would transiently
+  // need up to twice the memory of large debug sections.
+  SmallVector<char, 0> UncompressedData;
+  UncompressedData.reserve(Asm.getSectionFileSize(Section));
   raw_svector_ostream VecOS(UncompressedData);
   Asm.writeSectionData(VecOS, &Section);
   ArrayRef<uint8_t> Uncompressed =
@@ -783,6 +786,9 @@ void ELFWriter::writeSectionData(const MCAssembler &Asm, MCSection &Sec) {
     return;
   }
 
+  // The uncompressed contents are no longer needed, release them before
+  // writing out the compressed data.
+  UncompressedData = SmallVector<char, 0>();
   Section.setFlags(Section.getFlags() | ELF::SHF_COMPRESSED);
   // Alignment field should reflect the requirements of
   // the compressed section header.
@@ -66,6 +66,10 @@ STATISTIC(evaluateFixup, "Number of evaluated fixups");
 STATISTIC(ObjectBytes, "Number of emitted object file bytes");
 STATISTIC(RelaxationSteps, "Number of assembler layout and relaxation steps");
 STATISTIC(RelaxedInstructions, "Number of relaxed instructions");
+STATISTIC(RelaxationFragments,
+          "Number of fragments visited by assembler relaxation steps");
+STATISTIC(RelaxationChanges,
+          "Number of fragments that changed in assembler relaxation steps");
 
 } // end namespace stats
 } // end anonymous namespace
@@ -1295,9 +1299,13 @@ bool MCAssembler::layoutOnce() {
 
   bool Changed = false;
   for (MCSection &Sec : *this)
-    for (MCFragment &Frag : Sec)
-      if (relaxFragment(Frag))
+    for (MCFragment &Frag : Sec) {
+      ++stats::RelaxationFragments;
+      if (relaxFragment(Frag)) {
+        ++stats::RelaxationChanges;
         Changed = true;
+      }
+    }
   return Changed;
 }
 
@@ -18,11 +18,13 @@
 #include "llvm/Support/Compression.h"
 #include "llvm/Support/Endian.h"
 #include "llvm/Support/ErrorHandling.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <iterator>
+#include <optional>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -2108,15 +2110,29 @@ template <class ELFT> void ELFWriter<ELFT>::writeShdrs() {
 }
 
 template <class ELFT> Error ELFWriter<ELFT>::writeSectionData() {
+  // Segments are responsible for writing their contents, so only write the
+  // section data if the section is not in a segment. Note that this renders
+  // sections in segments effectively immutable.
+  SmallVector<SectionBase *, 0> ToWrite;
   for (SectionBase &Sec : Obj.sections())
-    // Segments are responsible for writing their contents, so only write the
-    // section data if the section is not in a segment. Note that this renders
-    // sections in segments effectively immutable.
     if (Sec.ParentSegment == nullptr)
-      if (Error Err = Sec.accept(*SecWriter))
-        return Err;
-
-  return Error::success();
+      ToWrite.push_back(&Sec);
+
+  // Each section is written to its own range of the output buffer, so the
+  // sections, some of which need to be decompressed, are written in parallel.
+  std::vector<std::optional<Error>> Errs(ToWrite.size());
+  parallelFor(0, ToWrite.size(),
+              [&](size_t I) { Errs[I] = ToWrite[I]->accept(*SecWriter); });
+
+  // Report the error of the first failing section, like a serial write would.
+  Error Err = Error::success();
+  for (std::optional<Error> &SecErr : Errs) {
+    if (Err)
+      consumeError(std::move(*SecErr));
+    else
+      Err = std::move(*SecErr);
+  }
+  return Err;
 }
 
 template <class ELFT> void ELFWriter<ELFT>::writeSegmentData() {
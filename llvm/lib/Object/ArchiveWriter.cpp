@@ -31,6 +31,7 @@
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/Format.h"
 #include "llvm/Support/MathExtras.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/SmallVectorMemoryBuffer.h"
 #include "llvm/Support/raw_ostream.h"
@@ -733,10 +734,26 @@ bool isImportDescriptor(StringRef Name) {
           Name.ends_with(NullThunkDataSuffix));
 }
 
-static Expected<std::vector<unsigned>> getSymbols(SymbolicFile *Obj,
-                                                  uint16_t Index,
-                                                  raw_ostream &SymNames,
-                                                  SymMap *SymMap) {
+// Collect the names of the symbols of Obj that belong in the archive symbol
+// table. This only reads Obj, so it can run concurrently for different members
+// as long as they are not bitcode files, which share an LLVMContext.
+static Error collectSymbolNames(SymbolicFile &Obj,
+                                std::vector<std::string> &Names) {
+  for (const object::BasicSymbolRef &S : Obj.symbols()) {
+    if (!isArchiveSymbol(S))
+      continue;
+    std::string Name;
+    raw_string_ostream NameStream(Name);
+    if (Error E = S.printName(NameStream))
+      return E;
+    Names.push_back(std::move(Name));
+  }
+  return Error::success();
+}
+
+static Expected<std::vector<unsigned>>
+getSymbols(SymbolicFile *Obj, uint16_t Index, raw_ostream &SymNames,
+           SymMap *SymMap, const std::vector<std::string> *CollectedNames) {
   std::vector<unsigned> Ret;
 
   if (Obj == nullptr)
@@ -746,30 +763,38 @@ static Expected<std::vector<unsigned>> getSymbols(SymbolicFile *Obj,
   if (SymMap)
     Map = SymMap->UseECMap && isECObject(*Obj) ? &SymMap->ECMap : &SymMap->Map;
 
-  for (const object::BasicSymbolRef &S : Obj->symbols()) {
-    if (!isArchiveSymbol(S))
-      continue;
+  auto AddSymbol = [&](StringRef Name) {
     if (Map) {
-      std::string Name;
-      raw_string_ostream NameStream(Name);
-      if (Error E = S.printName(NameStream))
-        return std::move(E);
-      if (!Map->try_emplace(Name, Index).second)
-        continue; // ignore duplicated symbol
+      if (!Map->try_emplace(std::string(Name), Index).second)
+        return; // ignore duplicated symbol
       if (Map == &SymMap->Map) {
         Ret.push_back(SymNames.tell());
         SymNames << Name << '\0';
         // If EC is enabled, then the import descriptors are NOT put into EC
         // objects so we need to copy them to the EC map manually.
         if (SymMap->UseECMap && isImportDescriptor(Name))
-          SymMap->ECMap[Name] = Index;
+          SymMap->ECMap[std::string(Name)] = Index;
       }
     } else {
       Ret.push_back(SymNames.tell());
-      if (Error E = S.printName(SymNames))
-        return std::move(E);
-      SymNames << '\0';
+      SymNames << Name << '\0';
     }
+  };
+
+  if (CollectedNames) {
+    for (const std::string &Name : *CollectedNames)
+      AddSymbol(Name);
+    return Ret;
+  }
+
+  for (const object::BasicSymbolRef &S : Obj->symbols()) {
+    if (!isArchiveSymbol(S))
+      continue;
+    std::string Name;
+    raw_string_ostream NameStream(Name);
+    if (Error E = S.printName(NameStream))
+      return std::move(E);
+    AddSymbol(Name);
   }
   return Ret;
 }
@@ -881,6 +906,28 @@ computeMemberData(raw_ostream &StringTable, raw_ostream &SymNames,
     }
   }
 
+  // Reading the symbol names is the bulk of the work for archives with many
+  // members, so it is done in parallel for all members that can be read
+  // independently. Symbols are still added to the table in member order. If
+  // reading fails, the member is read again in order below, which reports the
+  // error like a serial run would.
+  std::vector<std::vector<std::string>> CollectedNames;
+  std::unique_ptr<bool[]> HasCollectedNames;
+  if (NeedSymbols != SymtabWritingMode::NoSymtab && SymFiles.size() > 1) {
+    CollectedNames.resize(SymFiles.size());
+    HasCollectedNames = std::make_unique<bool[]>(SymFiles.size());
+    parallelFor(0, SymFiles.size(), [&](size_t I) {
+      SymbolicFile *SymFile = SymFiles[I].get();
+      if (!SymFile || SymFile->isIR())
+        return;
+      if (Error E = collectSymbolNames(*SymFile, CollectedNames[I])) {
+        consumeError(std::move(E));
+        return;
+      }
+      HasCollectedNames[I] = true;
+    });
+  }
+
   // The big archive format needs to know the offset of the previous member
   // header.
   uint64_t PrevOffset = 0;
@@ -963,8 +1010,11 @@ computeMemberData(raw_ostream &StringTable, raw_ostream &SymNames,
 
     std::vector<unsigned> Symbols;
     if (NeedSymbols != SymtabWritingMode::NoSymtab) {
-      Expected<std::vector<unsigned>> SymbolsOrErr =
-          getSymbols(CurSymFile.get(), Index + 1, SymNames, SymMap);
+      Expected<std::vector<unsigned>> SymbolsOrErr = getSymbols(
+          CurSymFile.get(), Index + 1, SymNames, SymMap,
+          HasCollectedNames && HasCollectedNames[Index]
+              ? &CollectedNames[Index]
+              : nullptr);
       if (!SymbolsOrErr)
         return createFileError(M->MemberName, SymbolsOrErr.takeError());
       Symbols = std::move(*SymbolsOrErr);
@@ -1197,7 +1247,7 @@ Error writeArchiveToStream(raw_ostream &Out,
         Expected<std::vector<unsigned>> SymbolsOrErr = getSymbols(
             M.SymFile.get(), 0,
             is64BitSymbolicFile(M.SymFile.get()) ? SymNames64 : SymNames32,
-            nullptr);
+            nullptr, nullptr);
         if (!SymbolsOrErr)
           return SymbolsOrErr.takeError();
       }
@@ -27,6 +27,7 @@
 #include "llvm/Support/Error.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/VirtualFileSystem.h"
 #include "llvm/Support/raw_ostream.h"
 #include <algorithm>
@@ -995,22 +996,35 @@ static Error handleMaybeNoDataFoundError(Error E) {
       });
 }
 
-Error CoverageMapping::loadFromFile(
-    StringRef Filename, StringRef Arch, StringRef CompilationDir,
-    IndexedInstrProfReader &ProfileReader, CoverageMapping &Coverage,
-    bool &DataFound, SmallVectorImpl<object::BuildID> *FoundBinaryIDs) {
+namespace {
+
+/// The coverage mapping readers of one object file, along with the buffers
+/// they reference.
+struct CoverageFileReaders {
+  std::unique_ptr<MemoryBuffer> CovMappingBuf;
+  SmallVector<std::unique_ptr<MemoryBuffer>, 4> Buffers;
+  SmallVector<std::unique_ptr<CoverageMappingReader>, 4> Readers;
+  SmallVector<object::BuildIDRef> BinaryIDs;
+};
+
+} // end anonymous namespace
+
+// Open Filename and create the readers for the coverage mapping it contains.
+// This only depends on the file itself, so it can run concurrently for
+// different files.
+static Error createFileReaders(StringRef Filename, StringRef Arch,
+                               StringRef CompilationDir,
+                               CoverageFileReaders &Result,
+                               bool ReadBinaryIDs) {
   auto CovMappingBufOrErr = MemoryBuffer::getFileOrSTDIN(
       Filename, /*IsText=*/false, /*RequiresNullTerminator=*/false);
   if (std::error_code EC = CovMappingBufOrErr.getError())
     return createFileError(Filename, errorCodeToError(EC));
-  MemoryBufferRef CovMappingBufRef =
-      CovMappingBufOrErr.get()->getMemBufferRef();
-  SmallVector<std::unique_ptr<MemoryBuffer>, 4> Buffers;
+  Result.CovMappingBuf = std::move(CovMappingBufOrErr.get());
 
-  SmallVector<object::BuildIDRef> BinaryIDs;
   auto CoverageReadersOrErr = BinaryCoverageReader::create(
-      CovMappingBufRef, Arch, Buffers, CompilationDir,
-      FoundBinaryIDs ? &BinaryIDs : nullptr);
+      Result.CovMappingBuf->getMemBufferRef(), Arch, Result.Buffers,
+      CompilationDir, ReadBinaryIDs ? &Result.BinaryIDs : nullptr);
   if (Error E = CoverageReadersOrErr.takeError()) {
     E = handleMaybeNoDataFoundError(std::move(E));
     if (E)
@@ -1018,17 +1032,35 @@ Error CoverageMapping::loadFromFile(
     return E;
   }
 
-  SmallVector<std::unique_ptr<CoverageMappingReader>, 4> Readers;
   for (auto &Reader : CoverageReadersOrErr.get())
-    Readers.push_back(std::move(Reader));
-  if (FoundBinaryIDs && !Readers.empty()) {
+    Result.Readers.push_back(std::move(Reader));
+  return Error::success();
+}
+
+// Note the coverage data and binary IDs found in FileReaders.
+static void addFoundData(const CoverageFileReaders &FileReaders,
+                         bool &DataFound,
+                         SmallVectorImpl<object::BuildID> *FoundBinaryIDs) {
+  if (FoundBinaryIDs && !FileReaders.Readers.empty()) {
     llvm::append_range(*FoundBinaryIDs,
-                       llvm::map_range(BinaryIDs, [](object::BuildIDRef BID) {
-                         return object::BuildID(BID);
-                       }));
+                       llvm::map_range(FileReaders.BinaryIDs,
+                                       [](object::BuildIDRef BID) {
+                                         return object::BuildID(BID);
+                                       }));
   }
-  DataFound |= !Readers.empty();
-  if (Error E = loadFromReaders(Readers, ProfileReader, Coverage))
+  DataFound |= !FileReaders.Readers.empty();
+}
+
+Error CoverageMapping::loadFromFile(
+    StringRef Filename, StringRef Arch, StringRef CompilationDir,
+    IndexedInstrProfReader &ProfileReader, CoverageMapping &Coverage,
+    bool &DataFound, SmallVectorImpl<object::BuildID> *FoundBinaryIDs) {
+  CoverageFileReaders FileReaders;
+  if (Error E = createFileReaders(Filename, Arch, CompilationDir, FileReaders,
+                                  FoundBinaryIDs != nullptr))
+    return E;
+  addFoundData(FileReaders, DataFound, FoundBinaryIDs);
+  if (Error E = loadFromReaders(FileReaders.Readers, ProfileReader, Coverage))
     return createFileError(Filename, std::move(E));
   return Error::success();
 }
@@ -1052,13 +1084,37 @@ Expected<std::unique_ptr<CoverageMapping>> CoverageMapping::load(
     return Arches[Idx];
   };
 
+  // Opening the object files and parsing their coverage mapping sections is
+  // independent for each file, so it is done in parallel. Records are then
+  // loaded in order, as the profile reader is not thread safe.
+  std::vector<CoverageFileReaders> FileReaders(ObjectFilenames.size());
+  std::vector<std::optional<Error>> FileErrors(ObjectFilenames.size());
+  parallelFor(0, ObjectFilenames.size(), [&](size_t I) {
+    FileErrors[I] = createFileReaders(ObjectFilenames[I], GetArch(I),
+                                      CompilationDir, FileReaders[I],
+                                      /*ReadBinaryIDs=*/true);
+  });
+
+  Error Err = Error::success();
   SmallVector<object::BuildID> FoundBinaryIDs;
-  for (const auto &File : llvm::enumerate(ObjectFilenames)) {
-    if (Error E =
-            loadFromFile(File.value(), GetArch(File.index()), CompilationDir,
-                         *ProfileReader, *Coverage, DataFound, &FoundBinaryIDs))
-      return std::move(E);
+  for (size_t I = 0, N = ObjectFilenames.size(); I != N; ++I) {
+    if (Err) {
+      // Only the first error is reported.
+      consumeError(std::move(*FileErrors[I]));
+      continue;
+    }
+    Err = std::move(*FileErrors[I]);
+    if (!Err) {
+      addFoundData(FileReaders[I], DataFound, &FoundBinaryIDs);
+      if (Error E = loadFromReaders(FileReaders[I].Readers, *ProfileReader,
+                                    *Coverage))
+        Err = createFileError(ObjectFilenames[I], std::move(E));
+    }
+    // Release the readers as soon as their records are loaded.
+    FileReaders[I] = CoverageFileReaders();
   }
+  if (Err)
+    return std::move(Err);
 
   if (BIDFetcher) {
     std::vector<object::BuildID> ProfileBinaryIDs;
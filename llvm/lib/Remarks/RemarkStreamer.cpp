@@ -31,16 +31,20 @@ RemarkStreamer::RemarkStreamer(
       Filename(FilenameIn ? std::optional<std::string>(FilenameIn->str())
                           : std::nullopt) {}
 
-Error RemarkStreamer::setFilter(StringRef Filter) {
+static Error setRegexFilter(std::optional<Regex> &Dst, StringRef Filter) {
   Regex R = Regex(Filter);
   std::string RegexError;
   if (!R.isValid(RegexError))
     return createStringError(std::make_error_code(std::errc::invalid_argument),
                              RegexError.data());
-  PassFilter = std::move(R);
+  Dst = std::move(R);
   return Error::success();
 }
 
+Error RemarkStreamer::setFilter(StringRef Filter) {
+  return setRegexFilter(PassFilter, Filter);
+}
+
 bool RemarkStreamer::matchesFilter(StringRef Str) {
   if (PassFilter)
     return PassFilter->match(Str);
@@ -48,6 +52,16 @@ bool RemarkStreamer::matchesFilter(StringRef Str) {
   return true;
 }
 
+Error RemarkStreamer::setNameFilter(StringRef Filter) {
+  return setRegexFilter(NameFilter, Filter);
+}
+
+bool RemarkStreamer::matchesNameFilter(StringRef Name) {
+  if (NameFilter)
+    return NameFilter->match(Name);
+  return true;
+}
+
 bool RemarkStreamer::needsSection() const {
   if (EnableRemarksSection == cl::BOU_TRUE)
     return true;
@@ -9,6 +9,7 @@
 // This file implements the localCache function, which simplifies creating,
 // adding to, and querying a local file system cache. localCache takes care of
 // periodically pruning older files from the cache using a CachePruningPolicy.
+// The local cache can be backed by a remote cache shared between machines.
 //
 //===----------------------------------------------------------------------===//
 
@@ -26,10 +27,41 @@
 
 using namespace llvm;
 
+/// Copies an object fetched from a remote cache to the local cache entry
+/// \p EntryPath. This is best effort: the object is used either way.
+static void copyToLocalCache(StringRef CacheDirectoryPath,
+                             StringRef TempFilePrefix, StringRef EntryPath,
+                             StringRef Contents) {
+  if (sys::fs::create_directories(CacheDirectoryPath, /*IgnoreExisting=*/true))
+    return;
+  SmallString<64> TempFilenameModel;
+  sys::path::append(TempFilenameModel, CacheDirectoryPath,
+                    TempFilePrefix + "-%%%%%%.tmp.o");
+  Expected<sys::fs::TempFile> Temp = sys::fs::TempFile::create(
+      TempFilenameModel, sys::fs::owner_read | sys::fs::owner_write);
+  if (!Temp) {
+    consumeError(Temp.takeError());
+    return;
+  }
+  raw_fd_ostream OS(Temp->FD, /*shouldClose=*/false);
+  OS << Contents;
+  OS.flush();
+  if (OS.has_error()) {
+    OS.clear_error();
+    consumeError(Temp->discard());
+    return;
+  }
+  if (Error E = Temp->keep(EntryPath)) {
+    consumeError(std::move(E));
+    consumeError(Temp->discard());
+  }
+}
+
 Expected<FileCache> llvm::localCache(const Twine &CacheNameRef,
                                      const Twine &TempFilePrefixRef,
                                      const Twine &CacheDirectoryPathRef,
-                                     AddBufferFn AddBuffer) {
+                                     AddBufferFn AddBuffer,
+                                     RemoteFileCache Remote) {
 
   // Create local copies which are safely captured-by-copy in lambdas
   SmallString<64> CacheName, TempFilePrefix, CacheDirectoryPath;
@@ -73,6 +105,16 @@ Expected<FileCache> llvm::localCache(const Twine &CacheNameRef,
       return createStringError(EC, Twine("Failed to open cache file ") +
                                        EntryPath + ": " + EC.message() + "\n");
 
+    // Then, see if another machine already produced the file.
+    if (Remote.Fetch) {
+      if (std::unique_ptr<MemoryBuffer> MB = Remote.Fetch(Key)) {
+        copyToLocalCache(CacheDirectoryPath, TempFilePrefix, EntryPath,
+                         MB->getBuffer());
+        AddBuffer(Task, ModuleName, std::move(MB));
+        return AddStreamFn();
+      }
+    }
+
     // This file stream is responsible for commiting the resulting file to the
     // cache and calling AddBuffer to add it to the link.
     struct CacheStream : CachedFileStream {
@@ -80,13 +122,17 @@ Expected<FileCache> llvm::localCache(const Twine &CacheNameRef,
       sys::fs::TempFile TempFile;
       std::string ModuleName;
       unsigned Task;
+      std::string Key;
+      std::function<void(StringRef Key, MemoryBufferRef Object)> Store;
 
       CacheStream(std::unique_ptr<raw_pwrite_stream> OS, AddBufferFn AddBuffer,
                   sys::fs::TempFile TempFile, std::string EntryPath,
-                  std::string ModuleName, unsigned Task)
+                  std::string ModuleName, unsigned Task, std::string Key,
+                  std::function<void(StringRef, MemoryBufferRef)> Store)
           : CachedFileStream(std::move(OS), std::move(EntryPath)),
             AddBuffer(std::move(AddBuffer)), TempFile(std::move(TempFile)),
-            ModuleName(ModuleName), Task(Task) {}
+            ModuleName(ModuleName), Task(Task), Key(std::move(Key)),
+            Store(std::move(Store)) {}
 
       ~CacheStream() {
         // TODO: Manually commit rather than using non-trivial destructor,
@@ -135,11 +181,13 @@ Expected<FileCache> llvm::localCache(const Twine &CacheNameRef,
                              TempFile.TmpName + " to " + ObjectPathName + ": " +
                              toString(std::move(E)) + "\n");
 
+        if (Store)
+          Store(Key, (*MBOrErr)->getMemBufferRef());
         AddBuffer(Task, ModuleName, std::move(*MBOrErr));
       }
     };
 
-    return [=](size_t Task, const Twine &ModuleName)
+    return [=, Key = Key.str()](size_t Task, const Twine &ModuleName)
                -> Expected<std::unique_ptr<CachedFileStream>> {
       // Create the cache directory if not already done. Doing this lazily
       // ensures the filesystem isn't mutated until the cache is.
@@ -164,7 +212,7 @@ Expected<FileCache> llvm::localCache(const Twine &CacheNameRef,
       return std::make_unique<CacheStream>(
           std::make_unique<raw_fd_ostream>(Temp->FD, /* ShouldClose */ false),
           AddBuffer, std::move(*Temp), std::string(EntryPath), ModuleName.str(),
-          Task);
+          Task, Key, Remote.Store);
     };
   };
   return FileCache(Func, CacheDirectoryPathRef.str());
@@ -535,15 +535,21 @@ bool Parser::parseNumber(char First, Value &Out) {
 
 bool Parser::parseString(std::string &Out) {
   // leading quote was already consumed.
-  for (char C = next(); C != '"'; C = next()) {
+  for (;;) {
+    // Copy the run of characters up to the next quote, escape or control
+    // character at once, rather than one push_back at a time.
+    const char *Run = P;
+    while (P != End && *P != '"' && *P != '\\' && (*P & 0x1f) != *P)
+      ++P;
+    Out.append(Run, P);
+
+    char C = next();
+    if (C == '"')
+      return true;
     if (LLVM_UNLIKELY(P == End))
       return parseError("Unterminated string");
-    if (LLVM_UNLIKELY((C & 0x1f) == C))
+    if (LLVM_UNLIKELY(C != '\\'))
       return parseError("Control character in string");
-    if (LLVM_LIKELY(C != '\\')) {
-      Out.push_back(C);
-      continue;
-    }
     // Handle escape sequence.
     switch (C = next()) {
     case '"':
@@ -574,7 +580,6 @@ bool Parser::parseString(std::string &Out) {
       return parseError("Invalid escape sequence");
     }
   }
-  return true;
 }
 
 static void encodeUtf8(uint32_t Rune, std::string &Out) {
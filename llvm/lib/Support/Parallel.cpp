@@ -7,6 +7,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "llvm/Support/Parallel.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/Config/llvm-config.h"
 #include "llvm/Support/ManagedStatic.h"
 #include "llvm/Support/Threading.h"
@@ -16,6 +17,12 @@
 #include <thread>
 #include <vector>
 
+#define DEBUG_TYPE "parallel"
+
+STATISTIC(NumTasks, "Number of tasks spawned on the parallel executor");
+STATISTIC(NumTasksRunWhileWaiting,
+          "Number of tasks run by a thread waiting for their task group");
+
 llvm::ThreadPoolStrategy llvm::parallel::strategy;
 
 namespace llvm {
@@ -38,7 +45,10 @@ namespace {
 class Executor {
 public:
   virtual ~Executor() = default;
-  virtual void add(std::function<void()> func) = 0;
+  virtual void add(std::function<void()> func, const TaskGroup *Group) = 0;
+  /// Runs one of the tasks spawned by \p Group that no thread picked up yet
+  /// on the calling thread. Returns false if there is no such task.
+  virtual bool runQueuedTask(const TaskGroup *Group) = 0;
   virtual size_t getThreadCount() const = 0;
 
   static Executor *getDefaultExecutor();
@@ -97,14 +107,29 @@ public:
     static void call(void *Ptr) { ((ThreadPoolExecutor *)Ptr)->stop(); }
   };
 
-  void add(std::function<void()> F) override {
+  void add(std::function<void()> F, const TaskGroup *Group) override {
     {
       std::lock_guard<std::mutex> Lock(Mutex);
-      WorkStack.push_back(std::move(F));
+      WorkStack.push_back({std::move(F), Group});
     }
     Cond.notify_one();
   }
 
+  bool runQueuedTask(const TaskGroup *Group) override {
+    std::unique_lock<std::mutex> Lock(Mutex);
+    // The tasks of the innermost group were pushed last, look from the top.
+    auto It = llvm::find_if(llvm::reverse(WorkStack), [&](const Task &T) {
+      return T.Group == Group;
+    });
+    if (It == WorkStack.rend())
+      return false;
+    std::function<void()> F = std::move(It->F);
+    WorkStack.erase(std::next(It).base());
+    Lock.unlock();
+    F();
+    return true;
+  }
+
   size_t getThreadCount() const override { return ThreadCount; }
 
 private:
@@ -116,15 +141,20 @@ private:
       Cond.wait(Lock, [&] { return Stop || !WorkStack.empty(); });
       if (Stop)
         break;
-      auto Task = std::move(WorkStack.back());
+      std::function<void()> F = std::move(WorkStack.back().F);
       WorkStack.pop_back();
       Lock.unlock();
-      Task();
+      F();
     }
   }
 
+  struct Task {
+    std::function<void()> F;
+    const TaskGroup *Group;
+  };
+
   std::atomic<bool> Stop{false};
-  std::vector<std::function<void()>> WorkStack;
+  std::vector<Task> WorkStack;
   std::mutex Mutex;
   std::condition_variable Cond;
   std::promise<void> ThreadsCreated;
@@ -174,20 +204,29 @@ size_t getThreadCount() {
 }
 #endif
 
-// Latch::sync() called by the dtor may cause one thread to block. If is a dead
-// lock if all threads in the default executor are blocked. To prevent the dead
-// lock, only allow the root TaskGroup to run tasks parallelly. In the scenario
-// of nested parallel_for_each(), only the outermost one runs parallelly.
+// Nested TaskGroups run their tasks in parallel too. A worker thread that
+// waits for one of them would dead lock the executor if all threads ended up
+// waiting, so sync() first runs the tasks of the group that no other thread
+// picked up yet on the waiting thread, like a serial group would have done.
+// It only blocks once each task of the group is running somewhere.
 TaskGroup::TaskGroup()
 #if LLVM_ENABLE_THREADS
-    : Parallel((parallel::strategy.ThreadsRequested != 1) &&
-               (threadIndex == UINT_MAX)) {}
+    : Parallel(parallel::strategy.ThreadsRequested != 1) {}
 #else
     : Parallel(false) {}
 #endif
 TaskGroup::~TaskGroup() {
   // We must ensure that all the workloads have finished before decrementing the
   // instances count.
+  sync();
+}
+
+void TaskGroup::sync() const {
+#if LLVM_ENABLE_THREADS
+  if (Parallel && threadIndex != UINT_MAX)
+    while (detail::Executor::getDefaultExecutor()->runQueuedTask(this))
+      ++NumTasksRunWhileWaiting;
+#endif
   L.sync();
 }
 
@@ -195,10 +234,13 @@ void TaskGroup::spawn(std::function<void()> F) {
 #if LLVM_ENABLE_THREADS
   if (Parallel) {
     L.inc();
-    detail::Executor::getDefaultExecutor()->add([&, F = std::move(F)] {
-      F();
-      L.dec();
-    });
+    ++NumTasks;
+    detail::Executor::getDefaultExecutor()->add(
+        [&, F = std::move(F)] {
+          F();
+          L.dec();
+        },
+        this);
     return;
   }
 #endif
@@ -11,6 +11,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "llvm/Support/TimeProfiler.h"
+#include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/STLFunctionalExtras.h"
 #include "llvm/ADT/SmallVector.h"
@@ -20,8 +21,10 @@
 #include "llvm/Support/Process.h"
 #include "llvm/Support/Threading.h"
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <chrono>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -51,6 +54,9 @@ TimeTraceProfilerInstances &getTimeTraceProfilerInstances() {
 
 } // anonymous namespace
 
+// Maximum number of events recorded by each thread, 0 if unlimited.
+static std::atomic<size_t> MaxEventsPerThread{0};
+
 // Per Thread instance
 static LLVM_THREAD_LOCAL TimeTraceProfiler *TimeTraceProfilerInstance = nullptr;
 
@@ -112,6 +118,8 @@ struct llvm::TimeTraceProfilerEntry {
 struct InProgressEntry {
   TimeTraceProfilerEntry Event;
   std::vector<TimeTraceProfilerEntry> InstantEvents;
+  // Time spent in grouped events directly nested in this one.
+  DurationType NestedGroupedDuration = DurationType::zero();
 
   InProgressEntry(TimePointType S, TimePointType E, std::string N,
                   std::string Dt, TimeTraceEventType Et)
@@ -185,9 +193,14 @@ struct llvm::TimeTraceProfiler {
 
     // Only include sections longer or equal to TimeTraceGranularity msec.
     if (duration_cast<microseconds>(Duration).count() >= TimeTraceGranularity) {
-      Entries.emplace_back(E);
-      for (auto &IE : Iter->get()->InstantEvents) {
-        Entries.emplace_back(IE);
+      size_t MaxEvents = MaxEventsPerThread.load(std::memory_order_relaxed);
+      if (MaxEvents && Entries.size() >= MaxEvents) {
+        NumDroppedEvents += 1 + Iter->get()->InstantEvents.size();
+      } else {
+        Entries.emplace_back(E);
+        for (auto &IE : Iter->get()->InstantEvents) {
+          Entries.emplace_back(IE);
+        }
       }
     }
 
@@ -205,9 +218,40 @@ struct llvm::TimeTraceProfiler {
       CountAndTotal.second += Duration;
     };
 
+    if (!E.Metadata.Group.empty())
+      summarizeGroup(Iter - Stack.begin(), Duration);
+
     Stack.erase(Iter);
   }
 
+  // Accounts the grouped event at \p Index in the stack, which lasted for
+  // \p Duration.
+  void summarizeGroup(size_t Index, DurationType Duration) {
+    const InProgressEntry &Entry = *Stack[Index];
+    const TimeTraceProfilerEntry &E = Entry.Event;
+    ArrayRef<std::unique_ptr<InProgressEntry>> Enclosing =
+        ArrayRef(Stack).take_front(Index);
+    GroupSummary &Summary = SummaryPerGroup[{E.Name, E.Metadata.Group}];
+    ++Summary.Count;
+    Summary.Exclusive += Duration - Entry.NestedGroupedDuration;
+    if (Summary.File.empty())
+      Summary.File = E.Metadata.GroupFile;
+    // Like totals, don't count recursive events of a group twice.
+    if (llvm::none_of(Enclosing,
+                      [&](const std::unique_ptr<InProgressEntry> &Val) {
+                        return Val->Event.Name == E.Name &&
+                               Val->Event.Metadata.Group == E.Metadata.Group;
+                      }))
+      Summary.Inclusive += Duration;
+    for (const std::unique_ptr<InProgressEntry> &Val :
+         llvm::reverse(Enclosing)) {
+      if (!Val->Event.Metadata.Group.empty()) {
+        Val->NestedGroupedDuration += Duration;
+        break;
+      }
+    }
+  }
+
   // Write events from this TimeTraceProfilerInstance and
   // ThreadTimeTraceProfilerInstances.
   void write(raw_pwrite_stream &OS) {
@@ -352,6 +396,14 @@ struct llvm::TimeTraceProfiler {
     J.arrayEnd();
     J.attributeEnd();
 
+    writeSummaries(J, Instances.List);
+
+    size_t AllDroppedEvents = NumDroppedEvents;
+    for (const TimeTraceProfiler *TTP : Instances.List)
+      AllDroppedEvents += TTP->NumDroppedEvents;
+    if (AllDroppedEvents)
+      J.attribute("droppedEvents", int64_t(AllDroppedEvents));
+
     // Emit the absolute time when this TimeProfiler started.
     // This can be used to combine the profiling data from
     // multiple processes and preserve actual time intervals.
@@ -363,9 +415,88 @@ struct llvm::TimeTraceProfiler {
     J.objectEnd();
   }
 
+  // Writes the per group summaries of this instance and \p Threads, sorted by
+  // decreasing exclusive time.
+  void writeSummaries(json::OStream &J,
+                      ArrayRef<TimeTraceProfiler *> Threads) const {
+    std::map<std::pair<std::string, std::string>, GroupSummary> AllSummaries;
+    auto Combine = [&](const TimeTraceProfiler &TTP) {
+      for (const auto &[Key, Summary] : TTP.SummaryPerGroup) {
+        GroupSummary &Combined = AllSummaries[Key];
+        Combined.Count += Summary.Count;
+        Combined.Inclusive += Summary.Inclusive;
+        Combined.Exclusive += Summary.Exclusive;
+        if (Combined.File.empty())
+          Combined.File = Summary.File;
+      }
+    };
+    Combine(*this);
+    for (const TimeTraceProfiler *TTP : Threads)
+      Combine(*TTP);
+    if (AllSummaries.empty())
+      return;
+
+    using SummaryRef = std::pair<const std::pair<std::string, std::string> *,
+                                 const GroupSummary *>;
+    std::vector<SummaryRef> Sorted;
+    // Exclusive times of a file add up without double counting.
+    std::map<std::pair<std::string, std::string>, GroupSummary> PerFile;
+    for (const auto &[Key, Summary] : AllSummaries) {
+      Sorted.emplace_back(&Key, &Summary);
+      GroupSummary &File = PerFile[{Key.first, Summary.File}];
+      File.Count += Summary.Count;
+      File.Exclusive += Summary.Exclusive;
+    }
+    auto ByExclusive = [](const auto &A, const auto &B) {
+      return A.second->Exclusive > B.second->Exclusive;
+    };
+    llvm::sort(Sorted, ByExclusive);
+
+    auto toUs = [](DurationType D) {
+      return int64_t(duration_cast<microseconds>(D).count());
+    };
+    J.attributeArray("groupSummary", [&] {
+      for (const auto &[Key, Summary] : Sorted)
+        J.object([&] {
+          J.attribute("name", Key->first);
+          J.attribute("group", Key->second);
+          if (!Summary->File.empty())
+            J.attribute("file", Summary->File);
+          J.attribute("count", int64_t(Summary->Count));
+          J.attribute("inclusive us", toUs(Summary->Inclusive));
+          J.attribute("exclusive us", toUs(Summary->Exclusive));
+        });
+    });
+
+    Sorted.clear();
+    for (const auto &[Key, Summary] : PerFile)
+      Sorted.emplace_back(&Key, &Summary);
+    llvm::sort(Sorted, ByExclusive);
+    J.attributeArray("fileSummary", [&] {
+      for (const auto &[Key, Summary] : Sorted)
+        J.object([&] {
+          J.attribute("name", Key->first);
+          J.attribute("file", Key->second);
+          J.attribute("count", int64_t(Summary->Count));
+          J.attribute("exclusive us", toUs(Summary->Exclusive));
+        });
+    });
+  }
+
+  struct GroupSummary {
+    size_t Count = 0;
+    DurationType Inclusive = DurationType::zero();
+    DurationType Exclusive = DurationType::zero();
+    std::string File;
+  };
+
   SmallVector<std::unique_ptr<InProgressEntry>, 16> Stack;
   SmallVector<TimeTraceProfilerEntry, 128> Entries;
+  // Events not recorded because Entries reached MaxEventsPerThread.
+  size_t NumDroppedEvents = 0;
   StringMap<CountAndDurationType> CountAndTotalPerName;
+  // Keyed by event name and group.
+  std::map<std::pair<std::string, std::string>, GroupSummary> SummaryPerGroup;
   // System clock time when the session was begun.
   const time_point<system_clock> BeginningOfTime;
   // Profiling clock time when the session was begun.
@@ -398,6 +529,10 @@ void llvm::timeTraceProfilerInitialize(unsigned TimeTraceGranularity,
       TimeTraceVerbose);
 }
 
+void llvm::timeTraceProfilerSetMaxEvents(size_t MaxEvents) {
+  MaxEventsPerThread.store(MaxEvents, std::memory_order_relaxed);
+}
+
 // Removes all TimeTraceProfilerInstances.
 // Called from main thread.
 void llvm::timeTraceProfilerCleanup() {
@@ -32,6 +32,7 @@
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/FileSystem/UniqueID.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/SMLoc.h"
 #include "llvm/Support/SourceMgr.h"
@@ -2983,9 +2984,82 @@ void TracingFileSystem::printImpl(raw_ostream &OS, PrintType Type,
   getUnderlyingFS().print(OS, Type, IndentLevel + 1);
 }
 
+std::optional<std::string>
+StatusCachingFileSystem::getCacheKey(const Twine &Path) const {
+  SmallString<256> Key;
+  Path.toVector(Key);
+  if (getUnderlyingFS().makeAbsolute(Key))
+    return std::nullopt;
+  return std::string(Key);
+}
+
+ErrorOr<Status> StatusCachingFileSystem::status(const Twine &Path) {
+  std::optional<std::string> Key = getCacheKey(Path);
+  if (!Key)
+    return ProxyFileSystem::status(Path);
+  // Entries are looked up by absolute path, but callers expect the name they
+  // asked for. Unless the underlying file system deliberately exposes an
+  // external path, see RedirectingFileSystem's use-external-names.
+  auto WithName = [&](const ErrorOr<Status> &Result) -> ErrorOr<Status> {
+    if (!Result)
+      return Result.getError();
+    if (Result->ExposesExternalVFSPath)
+      return *Result;
+    return Status::copyWithNewName(*Result, Path);
+  };
+  {
+    std::lock_guard<std::mutex> Lock(CacheMutex);
+    auto It = StatusCache.find(*Key);
+    if (It != StatusCache.end())
+      return WithName(It->second);
+  }
+  // Don't hold the lock while waiting on the underlying file system, another
+  // thread racing on the same path simply stores the same result.
+  ErrorOr<Status> Result = ProxyFileSystem::status(Path);
+  std::lock_guard<std::mutex> Lock(CacheMutex);
+  return WithName(
+      StatusCache.try_emplace(*Key, std::move(Result)).first->second);
+}
+
+void StatusCachingFileSystem::prefetchStatus(ArrayRef<std::string> Paths) {
+  // The cache keys of the paths that aren't cached yet, and the paths.
+  std::vector<std::pair<std::string, StringRef>> Missing;
+  {
+    std::lock_guard<std::mutex> Lock(CacheMutex);
+    for (const std::string &Path : Paths)
+      if (std::optional<std::string> Key = getCacheKey(Path))
+        if (!StatusCache.contains(*Key))
+          Missing.emplace_back(std::move(*Key), Path);
+  }
+  parallelFor(0, Missing.size(), [&](size_t I) {
+    ErrorOr<Status> Result = ProxyFileSystem::status(Missing[I].second);
+    std::lock_guard<std::mutex> Lock(CacheMutex);
+    StatusCache.try_emplace(Missing[I].first, std::move(Result));
+  });
+}
+
+void StatusCachingFileSystem::printImpl(raw_ostream &OS, PrintType Type,
+                                        unsigned IndentLevel) const {
+  printIndent(OS, IndentLevel);
+  OS << "StatusCachingFileSystem\n";
+  if (Type == PrintType::Summary)
+    return;
+
+  {
+    std::lock_guard<std::mutex> Lock(CacheMutex);
+    printIndent(OS, IndentLevel);
+    OS << "NumCachedStatuses=" << StatusCache.size() << "\n";
+  }
+
+  if (Type == PrintType::Contents)
+    Type = PrintType::Summary;
+  getUnderlyingFS().print(OS, Type, IndentLevel + 1);
+}
+
 const char FileSystem::ID = 0;
 const char OverlayFileSystem::ID = 0;
 const char ProxyFileSystem::ID = 0;
 const char InMemoryFileSystem::ID = 0;
 const char RedirectingFileSystem::ID = 0;
 const char TracingFileSystem::ID = 0;
+const char StatusCachingFileSystem::ID = 0;
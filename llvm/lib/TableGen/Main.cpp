@@ -17,6 +17,7 @@
 #include "llvm/TableGen/Main.h"
 #include "TGLexer.h"
 #include "TGParser.h"
+#include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/ADT/Twine.h"
 #include "llvm/Support/CommandLine.h"
@@ -35,6 +36,7 @@
 #include <string>
 #include <system_error>
 #include <utility>
+#include <vector>
 using namespace llvm;
 
 static cl::opt<std::string>
@@ -64,6 +66,15 @@ WriteIfChanged("write-if-changed", cl::desc("Only write output if it changed"));
 static cl::opt<bool>
 TimePhases("time-phases", cl::desc("Time phases of parser and backend"));
 
+// Only backends registered with TableGen::Emitter::Opt can be named here.
+// Tools that select their backend through their own action option, such as
+// clang-tblgen and mlir-tblgen, do not support this.
+static cl::list<std::string> ExtraOutputs(
+    "extra-output",
+    cl::desc("Also run the backend <action> on the parsed records and write "
+             "its output to <file>"),
+    cl::value_desc("action=file"));
+
 static cl::opt<bool> NoWarnOnUnusedTemplateArgs(
     "no-warn-on-unused-template-args",
     cl::desc("Disable unused template argument warnings."));
@@ -77,8 +88,10 @@ static int reportError(const char *ProgName, Twine Msg) {
 /// Create a dependency file for `-d` option.
 ///
 /// This functionality is really only for the benefit of the build system.
-/// It is similar to GCC's `-M*` family of options.
-static int createDependencyFile(const TGParser &Parser, const char *argv0) {
+/// It is similar to GCC's `-M*` family of options. All outputs, including the
+/// ones from `-extra-output`, are listed as targets.
+static int createDependencyFile(const TGParser &Parser, const char *argv0,
+                                ArrayRef<StringRef> ExtraOutputFilenames) {
   if (OutputFilename == "-")
     return reportError(argv0, "the option -d must be used together with -o\n");
 
@@ -87,7 +100,10 @@ static int createDependencyFile(const TGParser &Parser, const char *argv0) {
   if (EC)
     return reportError(argv0, "error opening " + DependFilename + ":" +
                                   EC.message() + "\n");
-  DepOut.os() << OutputFilename << ":";
+  DepOut.os() << OutputFilename;
+  for (StringRef Filename : ExtraOutputFilenames)
+    DepOut.os() << ' ' << Filename;
+  DepOut.os() << ":";
   for (const auto &Dep : Parser.getDependencies()) {
     DepOut.os() << ' ' << Dep;
   }
@@ -96,6 +112,28 @@ static int createDependencyFile(const TGParser &Parser, const char *argv0) {
   return 0;
 }
 
+/// Write \p Contents to \p Filename, honoring `-write-if-changed`.
+static int writeOutput(const char *argv0, StringRef Filename,
+                       StringRef Contents) {
+  if (WriteIfChanged) {
+    // Only updates the real output file if there are any differences.
+    // This prevents recompilation of all the files depending on it if there
+    // aren't any.
+    if (auto ExistingOrErr = MemoryBuffer::getFile(Filename, /*IsText=*/true))
+      if (std::move(ExistingOrErr.get())->getBuffer() == Contents)
+        return 0;
+  }
+  std::error_code EC;
+  ToolOutputFile OutFile(Filename, EC, sys::fs::OF_Text);
+  if (EC)
+    return reportError(argv0, "error opening " + Filename + ": " +
+                                  EC.message() + "\n");
+  OutFile.os() << Contents;
+  if (ErrorsPrinted == 0)
+    OutFile.keep();
+  return 0;
+}
+
 int llvm::TableGenMain(const char *argv0,
                        std::function<TableGenMainFn> MainFn) {
   RecordKeeper Records;
@@ -146,36 +184,46 @@ int llvm::TableGenMain(const char *argv0,
   if (status)
     return 1;
 
+  // Run the additional backends on the same records, which saves parsing the
+  // input again for every output generated from it.
+  std::vector<std::pair<StringRef, std::string>> ExtraOutStrings;
+  for (StringRef Extra : ExtraOutputs) {
+    auto [Action, Filename] = Extra.split('=');
+    if (Filename.empty())
+      return reportError(argv0, "invalid -extra-output '" + Extra +
+                                    "', expected <action>=<file>\n");
+    Timer.startBackendTimer(("Backend " + Action).str());
+    std::string ExtraString;
+    raw_string_ostream ExtraOut(ExtraString);
+    bool NotFound =
+        TableGen::Emitter::ApplyCallback(Action.ltrim('-'), Records, ExtraOut);
+    Timer.stopBackendTimer();
+    if (NotFound)
+      return reportError(argv0, "unknown action '" + Action +
+                                    "' in -extra-output; only backends "
+                                    "registered with TableGen::Emitter::Opt "
+                                    "are supported\n");
+    ExtraOutStrings.emplace_back(Filename, std::move(ExtraString));
+  }
+
   // Always write the depfile, even if the main output hasn't changed.
   // If it's missing, Ninja considers the output dirty.  If this was below
   // the early exit below and someone deleted the .inc.d file but not the .inc
   // file, tablegen would never write the depfile.
   if (!DependFilename.empty()) {
-    if (int Ret = createDependencyFile(Parser, argv0))
+    SmallVector<StringRef> ExtraOutputFilenames;
+    for (const auto &[Filename, Contents] : ExtraOutStrings)
+      ExtraOutputFilenames.push_back(Filename);
+    if (int Ret = createDependencyFile(Parser, argv0, ExtraOutputFilenames))
       return Ret;
   }
 
   Timer.startTimer("Write output");
-  bool WriteFile = true;
-  if (WriteIfChanged) {
-    // Only updates the real output file if there are any differences.
-    // This prevents recompilation of all the files depending on it if there
-    // aren't any.
-    if (auto ExistingOrErr =
-            MemoryBuffer::getFile(OutputFilename, /*IsText=*/true))
-      if (std::move(ExistingOrErr.get())->getBuffer() == OutString)
-        WriteFile = false;
-  }
-  if (WriteFile) {
-    std::error_code EC;
-    ToolOutputFile OutFile(OutputFilename, EC, sys::fs::OF_Text);
-    if (EC)
-      return reportError(argv0, "error opening " + OutputFilename + ": " +
-                                    EC.message() + "\n");
-    OutFile.os() << OutString;
-    if (ErrorsPrinted == 0)
-      OutFile.keep();
-  }
+  if (int Ret = writeOutput(argv0, OutputFilename, OutString))
+    return Ret;
+  for (const auto &[Filename, Contents] : ExtraOutStrings)
+    if (int Ret = writeOutput(argv0, Filename, Contents))
+      return Ret;
 
   Timer.stopTimer();
   Timer.stopPhaseTiming();
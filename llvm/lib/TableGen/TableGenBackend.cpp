@@ -69,6 +69,19 @@ bool llvm::TableGen::Emitter::ApplyCallback(const RecordKeeper &Records,
   return false;
 }
 
+bool llvm::TableGen::Emitter::ApplyCallback(StringRef Name,
+                                            const RecordKeeper &Records,
+                                            raw_ostream &OS) {
+  cl::parser<FnT> &Parser = CallbackFunction->getParser();
+  if (Parser.findOption(Name) == Parser.getNumOptions())
+    return true;
+  FnT Fn;
+  if (Parser.parse(*CallbackFunction, Name, "", Fn) || !Fn)
+    return true;
+  Fn(Records, OS);
+  return false;
+}
+
 static void printLine(raw_ostream &OS, const Twine &Prefix, char Fill,
                       StringRef Suffix) {
   size_t Pos = (size_t)OS.tell();
@@ -17,6 +17,7 @@
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/Statistic.h"
 #include "llvm/ADT/StringRef.h"
+#include "llvm/ADT/StringSet.h"
 #include "llvm/Bitcode/BitcodeReader.h"
 #include "llvm/IR/AutoUpgrade.h"
 #include "llvm/IR/Function.h"
@@ -67,6 +68,8 @@ STATISTIC(NumImportedFunctions, "Number of functions imported in backend");
 STATISTIC(NumImportedGlobalVars,
           "Number of global variables imported in backend");
 STATISTIC(NumImportedModules, "Number of modules imported from");
+STATISTIC(NumSkippedModules,
+          "Number of modules not loaded as no definition is imported from them");
 STATISTIC(NumDeadSymbols, "Number of dead stripped symbols in index");
 STATISTIC(NumLiveSymbols, "Number of live symbols in index");
 
@@ -1823,8 +1826,22 @@ Expected<bool> FunctionImporter::importFunctions(
 
   IRMover Mover(DestModule);
 
+  // Only definitions are linked below, so a module that is only imported from
+  // as declarations doesn't need to be loaded at all.
+  StringSet<> ModulesWithDefinitions;
+  for (const auto &[SrcMod, GUID, ImportType] : ImportList)
+    if (ImportType == GlobalValueSummary::Definition)
+      ModulesWithDefinitions.insert(SrcMod);
+
   // Do the actual import of functions now, one Module at a time
   for (const auto &ModName : ImportList.getSourceModules()) {
+    if (!ModulesWithDefinitions.contains(ModName)) {
+      LLVM_DEBUG(dbgs() << "Not loading " << ModName
+                        << ", only declarations are imported from it\n");
+      ++NumSkippedModules;
+      continue;
+    }
+
     // Get the module for the import
     Expected<std::unique_ptr<Module>> SrcModuleOrErr = ModuleLoader(ModName);
     if (!SrcModuleOrErr)
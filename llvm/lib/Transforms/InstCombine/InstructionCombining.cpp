@@ -121,6 +121,10 @@ STATISTIC(NumThreeIterations, "Number of functions with three iterations");
 STATISTIC(NumFourOrMoreIterations,
           "Number of functions with four or more iterations");
 
+STATISTIC(NumUnchangedFunctions,
+          "Number of functions left unchanged by a run of instcombine");
+STATISTIC(NumVisited  , "Number of insts visited");
+
 STATISTIC(NumCombined , "Number of insts combined");
 STATISTIC(NumConstProp, "Number of constant folds");
 STATISTIC(NumDeadInst , "Number of dead inst eliminated");
@@ -5197,6 +5201,7 @@ bool InstCombinerImpl::run() {
 
     if (!DebugCounter::shouldExecute(VisitCounter))
       continue;
+    ++NumVisited;
 
     // See if we can trivially sink this instruction to its user if we can
     // prove that the successor is not executed more frequently than our block.
@@ -5588,10 +5593,12 @@ static bool combineInstructionsOverFunction(
 
   // Iterate while there is work to do.
   unsigned Iteration = 0;
+  bool HitIterationLimit = false;
   while (true) {
     ++Iteration;
 
     if (Iteration > Opts.MaxIterations && !VerifyFixpoint) {
+      HitIterationLimit = true;
       LLVM_DEBUG(dbgs() << "\n\n[IC] Iteration limit #" << Opts.MaxIterations
                         << " on " << F.getName()
                         << " reached; stopping without verifying fixpoint\n");
@@ -5631,6 +5638,27 @@ static bool combineInstructionsOverFunction(
   else
     ++NumFourOrMoreIterations;
 
+  // Report runs that didn't change anything, to help find the redundant
+  // instcombine invocations of a pipeline.
+  if (!MadeIRChange)
+    ++NumUnchangedFunctions;
+
+  // Only report the unusual runs: those that needed more than one iteration
+  // with changes or that stopped at the iteration limit. The statistics above
+  // cover the rest.
+  if (HitIterationLimit || Iteration > 2)
+    ORE.emit([&]() {
+      OptimizationRemarkAnalysis R(DEBUG_TYPE, "Iterations", &F);
+      if (HitIterationLimit)
+        R << "stopped at the limit of "
+          << ore::NV("Iterations", Opts.MaxIterations)
+          << " iterations without reaching a fixpoint";
+      else
+        R << "reached a fixpoint after " << ore::NV("Iterations", Iteration)
+          << " iterations";
+      return R;
+    });
+
   return MadeIRChange;
 }
 
@@ -311,6 +311,12 @@ static cl::opt<bool> LoopVectorizeWithBlockFrequency(
              "heuristics minimizing code growth in cold regions and being more "
              "aggressive in hot regions."));
 
+static cl::opt<bool> UseProfileTripCountForVF(
+    "vectorizer-use-profile-trip-count-for-vf", cl::init(true), cl::Hidden,
+    cl::desc("When the trip count has no constant bound, compare "
+             "vectorization factors using the trip count expected from "
+             "profile data"));
+
 // Runtime interleave loops for load/store throughput.
 static cl::opt<bool> EnableLoadStoreRuntimeInterleave(
     "enable-loadstore-runtime-interleave", cl::init(true), cl::Hidden,
@@ -4341,7 +4347,14 @@ bool LoopVectorizationPlanner::isMoreProfitable(
 
 bool LoopVectorizationPlanner::isMoreProfitable(
     const VectorizationFactor &A, const VectorizationFactor &B) const {
-  const unsigned MaxTripCount = PSE.getSmallConstantMaxTripCount();
+  unsigned MaxTripCount = PSE.getSmallConstantMaxTripCount();
+  // Without a bound, use the trip count the profile expects instead, so that
+  // a loop typically running a few iterations isn't vectorized with a width
+  // that leaves all of them to the scalar epilogue.
+  if (!MaxTripCount && UseProfileTripCountForVF &&
+      LoopVectorizeWithBlockFrequency)
+    if (auto EstimatedTC = getLoopEstimatedTripCount(OrigLoop))
+      MaxTripCount = *EstimatedTC;
   return LoopVectorizationPlanner::isMoreProfitable(A, B, MaxTripCount);
 }
 
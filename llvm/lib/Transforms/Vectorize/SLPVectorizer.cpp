@@ -110,6 +110,8 @@ using namespace std::placeholders;
 #define DEBUG_TYPE "SLP"
 
 STATISTIC(NumVectorInstructions, "Number of vector instructions generated");
+STATISTIC(NumTreesOverBudget,
+          "Number of trees not built past the per-function budget");
 
 DEBUG_COUNTER(VectorizedGraphs, "slp-vectorized",
               "Controls which SLP graphs should be vectorized.");
@@ -157,6 +159,14 @@ static cl::opt<int>
 ScheduleRegionSizeBudget("slp-schedule-budget", cl::init(100000), cl::Hidden,
     cl::desc("Limit the size of the SLP scheduling region per block"));
 
+/// Limits the number of tree nodes built for all the seeds of a function.
+/// It avoids long compile times for functions with many overlapping seeds,
+/// whose trees are built and costed over and over.
+/// This limit is way higher than needed by real-world functions.
+static cl::opt<unsigned> TreeNodesBudget(
+    "slp-tree-nodes-budget", cl::init(1000000), cl::Hidden,
+    cl::desc("Limit the number of SLP tree nodes built per function"));
+
 static cl::opt<int> MinVectorRegSizeOption(
     "slp-min-reg-size", cl::init(128), cl::Hidden,
     cl::desc("Attempt to vectorize for this register size in bits"));
@@ -1409,6 +1419,11 @@ public:
   /// Construct a vectorizable tree that starts at \p Roots.
   void buildTree(ArrayRef<Value *> Roots);
 
+  /// \returns true if the function has already built as many tree nodes as
+  /// allowed, in which case no tree is built for \p Roots. The first time,
+  /// this is reported with a remark.
+  bool isOverTreeNodesBudget(ArrayRef<Value *> Roots);
+
   /// Returns whether the root node has in-tree uses.
   bool doesRootHaveInTreeUses() const {
     return !VectorizableTree.empty() &&
@@ -3623,6 +3638,7 @@ private:
         !UserTreeIdx.UserTE)
       return nullptr;
     VectorizableTree.push_back(std::make_unique<TreeEntry>(VectorizableTree));
+    ++NumTreeNodesBuilt;
     TreeEntry *Last = VectorizableTree.back().get();
     Last->Idx = VectorizableTree.size() - 1;
     Last->State = EntryState;
@@ -4404,6 +4420,11 @@ private:
   const DataLayout *DL;
   OptimizationRemarkEmitter *ORE;
 
+  /// The number of tree nodes built so far in the function, and whether the
+  /// budget on it was reported.
+  unsigned NumTreeNodesBuilt = 0;
+  bool ReportedTreeNodesBudget = false;
+
   unsigned MaxVecRegSize; // This is set by TTI or overridden by cl::opt.
   unsigned MinVecRegSize; // Set by cl::opt (default: 128).
 
@@ -6784,18 +6805,38 @@ BoUpSLP::findExternalStoreUsersReorderIndices(TreeEntry *TE) const {
   return ExternalReorderIndices;
 }
 
+bool BoUpSLP::isOverTreeNodesBudget(ArrayRef<Value *> Roots) {
+  if (NumTreeNodesBuilt < TreeNodesBudget)
+    return false;
+  ++NumTreesOverBudget;
+  if (!ReportedTreeNodesBudget) {
+    ReportedTreeNodesBudget = true;
+    LLVM_DEBUG(dbgs() << "SLP: Tree nodes budget exhausted in "
+                      << F->getName() << ".\n");
+    auto *I = dyn_cast<Instruction>(Roots.front());
+    ORE->emit([&]() {
+      auto R = I ? OptimizationRemarkMissed(SV_NAME, "TreeNodesBudget", I)
+                 : OptimizationRemarkMissed(SV_NAME, "TreeNodesBudget", F);
+      return R << "Stopped vectorizing the function after building "
+               << ore::NV("TreeNodes", NumTreeNodesBuilt)
+               << " tree nodes (budget exhausted)";
+    });
+  }
+  return true;
+}
+
 void BoUpSLP::buildTree(ArrayRef<Value *> Roots,
                         const SmallDenseSet<Value *> &UserIgnoreLst) {
   deleteTree();
   UserIgnoreList = &UserIgnoreLst;
-  if (!allSameType(Roots))
+  if (!allSameType(Roots) || isOverTreeNodesBudget(Roots))
     return;
   buildTree_rec(Roots, 0, EdgeInfo());
 }
 
 void BoUpSLP::buildTree(ArrayRef<Value *> Roots) {
   deleteTree();
-  if (!allSameType(Roots))
+  if (!allSameType(Roots) || isOverTreeNodesBudget(Roots))
     return;
   buildTree_rec(Roots, 0, EdgeInfo());
 }
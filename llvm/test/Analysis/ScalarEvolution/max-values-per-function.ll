@@ -0,0 +1,32 @@
+; RUN: opt -disable-output -passes='print<scalar-evolution>' \
+; RUN:   -scalar-evolution-max-values-per-function=2 %s 2>&1 \
+; RUN:   | FileCheck %s --check-prefix=BUDGET
+; RUN: opt -disable-output -passes='print<scalar-evolution>' %s 2>&1 \
+; RUN:   | FileCheck %s --check-prefix=NOBUDGET
+
+; Once two instructions have been analyzed, the remaining ones are treated
+; as unknowns instead of being looked through.
+
+define i32 @chain(i32 %x) {
+; BUDGET-LABEL: 'chain'
+; BUDGET:       %a = add i32 %x, 1
+; BUDGET-NEXT:    -->  (1 + %x)
+; BUDGET:       %b = add i32 %a, 2
+; BUDGET-NEXT:    -->  (3 + %x)
+; BUDGET:       %c = add i32 %b, 3
+; BUDGET-NEXT:    -->  %c
+; BUDGET:       %d = add i32 %c, 4
+; BUDGET-NEXT:    -->  %d
+;
+; NOBUDGET-LABEL: 'chain'
+; NOBUDGET:       %c = add i32 %b, 3
+; NOBUDGET-NEXT:    -->  (6 + %x)
+; NOBUDGET:       %d = add i32 %c, 4
+; NOBUDGET-NEXT:    -->  (10 + %x)
+;
+  %a = add i32 %x, 1
+  %b = add i32 %a, 2
+  %c = add i32 %b, 3
+  %d = add i32 %c, 4
+  ret i32 %d
+}
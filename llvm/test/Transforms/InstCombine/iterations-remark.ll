@@ -0,0 +1,24 @@
+; RUN: opt -passes='instcombine<max-iterations=1;no-verify-fixpoint>' \
+; RUN:   -pass-remarks-analysis=instcombine -disable-output %s 2>&1 \
+; RUN:   | FileCheck %s --check-prefix=LIMIT
+; RUN: opt -passes=instcombine -pass-remarks-analysis=instcombine \
+; RUN:   -disable-output %s 2>&1 | FileCheck %s --check-prefix=DEFAULT \
+; RUN:   --allow-empty
+
+; Only runs that stop at the iteration limit or need several iterations
+; emit the "Iterations" remark. Ordinary runs, including the ones that make
+; no change, don't.
+
+; LIMIT:     remark: {{.*}} stopped at the limit of 1 iterations without reaching a fixpoint
+; LIMIT-NOT: remark:
+
+; DEFAULT-NOT: remark:
+
+define i32 @changed(i32 %x) {
+  %a = add i32 %x, 0
+  ret i32 %a
+}
+
+define i32 @unchanged(i32 %x) {
+  ret i32 %x
+}
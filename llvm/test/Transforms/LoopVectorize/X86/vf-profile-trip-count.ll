@@ -0,0 +1,45 @@
+; RUN: opt -passes=loop-vectorize -mtriple=x86_64-unknown-linux-gnu \
+; RUN:   -mattr=+avx2 -force-vector-interleave=1 \
+; RUN:   -enable-epilogue-vectorization=false -S %s | FileCheck %s
+; RUN: opt -passes=loop-vectorize -mtriple=x86_64-unknown-linux-gnu \
+; RUN:   -mattr=+avx2 -force-vector-interleave=1 \
+; RUN:   -enable-epilogue-vectorization=false \
+; RUN:   -vectorizer-use-profile-trip-count-for-vf=false -S %s \
+; RUN:   | FileCheck %s --check-prefix=NOPROFILE
+
+; The trip count of the loop has no constant bound, but its profile says it
+; typically runs 20 iterations. VF 32 would leave all of them to the scalar
+; epilogue, so VF 16 is picked instead. Without using the profile the
+; cheapest cost per lane wins.
+
+define void @add_one(ptr noalias %dst, ptr noalias %src, i64 %n) !prof !0 {
+; CHECK-LABEL: @add_one(
+; CHECK:       vector.body:
+; CHECK:         load <16 x i8>
+; CHECK:         store <16 x i8>
+;
+; NOPROFILE-LABEL: @add_one(
+; NOPROFILE:       vector.body:
+; NOPROFILE:         load <32 x i8>
+; NOPROFILE:         store <32 x i8>
+;
+entry:
+  br label %loop
+
+loop:
+  %iv = phi i64 [ 0, %entry ], [ %iv.next, %loop ]
+  %gep.src = getelementptr inbounds i8, ptr %src, i64 %iv
+  %l = load i8, ptr %gep.src, align 1
+  %add = add i8 %l, 1
+  %gep.dst = getelementptr inbounds i8, ptr %dst, i64 %iv
+  store i8 %add, ptr %gep.dst, align 1
+  %iv.next = add nuw nsw i64 %iv, 1
+  %ec = icmp eq i64 %iv.next, %n
+  br i1 %ec, label %exit, label %loop, !prof !1
+
+exit:
+  ret void
+}
+
+!0 = !{!"function_entry_count", i64 1000}
+!1 = !{!"branch_weights", i32 1, i32 19}
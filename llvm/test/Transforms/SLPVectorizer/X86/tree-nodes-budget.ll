@@ -0,0 +1,59 @@
+; RUN: opt -passes=slp-vectorizer -mtriple=x86_64-unknown-linux-gnu -S %s \
+; RUN:   | FileCheck %s --check-prefix=DEFAULT
+; RUN: opt -passes=slp-vectorizer -mtriple=x86_64-unknown-linux-gnu -S %s \
+; RUN:   -slp-tree-nodes-budget=1 | FileCheck %s --check-prefix=BUDGET1
+; RUN: opt -passes=slp-vectorizer -mtriple=x86_64-unknown-linux-gnu -S %s \
+; RUN:   -slp-tree-nodes-budget=0 | FileCheck %s --check-prefix=BUDGET0
+; RUN: opt -passes=slp-vectorizer -mtriple=x86_64-unknown-linux-gnu %s \
+; RUN:   -slp-tree-nodes-budget=1 -pass-remarks-missed=slp-vectorizer \
+; RUN:   -disable-output 2>&1 | FileCheck %s --check-prefix=REMARK
+
+;; Both store chains are vectorized by default.
+; DEFAULT-LABEL: entry:
+; DEFAULT:       store <2 x i64>
+; DEFAULT-LABEL: next:
+; DEFAULT:       store <2 x i64>
+
+;; Blocks are visited in post-order, so the tree of the chain in %next is
+;; built first and uses up the budget. The chain in %entry is left scalar.
+; BUDGET1-LABEL: entry:
+; BUDGET1-NOT:   <2 x i64>
+; BUDGET1:       br label %next
+; BUDGET1-LABEL: next:
+; BUDGET1:       store <2 x i64>
+
+; BUDGET0-NOT: <2 x i64>
+
+;; The budget is reported once per function.
+; REMARK:     remark: {{.*}}Stopped vectorizing the function after building {{[0-9]+}} tree nodes (budget exhausted)
+; REMARK-NOT: budget exhausted
+
+define void @two_chains(ptr %a, ptr %b, ptr %c, ptr %d, ptr %e, ptr %f) {
+entry:
+  %b1.addr = getelementptr inbounds i64, ptr %b, i64 1
+  %c1.addr = getelementptr inbounds i64, ptr %c, i64 1
+  %a1.addr = getelementptr inbounds i64, ptr %a, i64 1
+  %b0 = load i64, ptr %b, align 8
+  %b1 = load i64, ptr %b1.addr, align 8
+  %c0 = load i64, ptr %c, align 8
+  %c1 = load i64, ptr %c1.addr, align 8
+  %a0 = add i64 %b0, %c0
+  %a1 = add i64 %b1, %c1
+  store i64 %a0, ptr %a, align 8
+  store i64 %a1, ptr %a1.addr, align 8
+  br label %next
+
+next:
+  %e1.addr = getelementptr inbounds i64, ptr %e, i64 1
+  %f1.addr = getelementptr inbounds i64, ptr %f, i64 1
+  %d1.addr = getelementptr inbounds i64, ptr %d, i64 1
+  %e0 = load i64, ptr %e, align 8
+  %e1 = load i64, ptr %e1.addr, align 8
+  %f0 = load i64, ptr %f, align 8
+  %f1 = load i64, ptr %f1.addr, align 8
+  %d0 = add i64 %e0, %f0
+  %d1 = add i64 %e1, %f1
+  store i64 %d0, ptr %d, align 8
+  store i64 %d1, ptr %d1.addr, align 8
+  ret void
+}
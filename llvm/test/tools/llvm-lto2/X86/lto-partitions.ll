@@ -0,0 +1,39 @@
+; RUN: rm -rf %t && mkdir %t
+; RUN: llvm-as %s -o %t/in.bc
+
+;; By default the regular LTO module is code generated as a whole.
+; RUN: llvm-lto2 run %t/in.bc -o %t/single -r %t/in.bc,foo,px -r %t/in.bc,bar,px
+; RUN: llvm-nm %t/single.0 | FileCheck %s --check-prefix=SINGLE
+; RUN: not test -e %t/single.1
+; SINGLE: T bar
+; SINGLE: T foo
+
+;; With --lto-partitions=2 it is split, and each partition is written to its
+;; own output.
+; RUN: llvm-lto2 run %t/in.bc -o %t/split --lto-partitions=2 \
+; RUN:   -r %t/in.bc,foo,px -r %t/in.bc,bar,px
+; RUN: llvm-nm %t/split.0 | FileCheck %s --check-prefix=PART0
+; RUN: llvm-nm %t/split.1 | FileCheck %s --check-prefix=PART1
+; PART0-NOT: bar
+; PART0:     T foo
+; PART0-NOT: bar
+; PART1-NOT: foo
+; PART1:     T bar
+; PART1-NOT: foo
+
+; RUN: not llvm-lto2 run %t/in.bc -o %t/zero --lto-partitions=0 \
+; RUN:   -r %t/in.bc,foo,px -r %t/in.bc,bar,px 2>&1 | FileCheck %s --check-prefix=ZERO
+; ZERO: invalid number of LTO partitions
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+define void @foo() {
+  call void @bar()
+  ret void
+}
+
+define void @bar() {
+  call void @foo()
+  ret void
+}
@@ -186,6 +186,12 @@ static cl::opt<std::string>
                            "names match the given regular expression"),
                   cl::value_desc("regex"));
 
+static cl::opt<std::string>
+    RemarksNames("pass-remarks-name-filter",
+                 cl::desc("Only record optimization remarks whose names "
+                          "match the given regular expression"),
+                 cl::value_desc("regex"));
+
 static cl::opt<std::string> RemarksFormat(
     "pass-remarks-format",
     cl::desc("The format used for serializing remarks (default: YAML)"),
@@ -397,7 +403,7 @@ int main(int argc, char **argv) {
   Expected<std::unique_ptr<ToolOutputFile>> RemarksFileOrErr =
       setupLLVMOptimizationRemarks(Context, RemarksFilename, RemarksPasses,
                                    RemarksFormat, RemarksWithHotness,
-                                   RemarksHotnessThreshold);
+                                   RemarksHotnessThreshold, RemarksNames);
   if (Error E = RemarksFileOrErr.takeError())
     reportError(std::move(E), RemarksFilename);
   std::unique_ptr<ToolOutputFile> RemarksFile = std::move(*RemarksFileOrErr);
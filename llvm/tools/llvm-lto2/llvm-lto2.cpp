@@ -26,6 +26,7 @@
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/InitLLVM.h"
 #include "llvm/Support/PluginLoader.h"
+#include "llvm/Support/Process.h"
 #include "llvm/Support/TargetSelect.h"
 #include "llvm/Support/Threading.h"
 #include <atomic>
@@ -103,6 +104,11 @@ static cl::opt<bool>
 // to use all hardware threads or cores in the system.
 static cl::opt<std::string> Threads("thinlto-threads");
 
+static cl::opt<unsigned> Partitions(
+    "lto-partitions", cl::init(1),
+    cl::desc("Number of partitions the regular LTO module is split into for "
+             "parallel code generation"));
+
 static cl::list<std::string> SymbolResolutions(
     "r",
     cl::desc("Specify a symbol resolution: filename,symbolname,resolution\n"
@@ -174,6 +180,10 @@ static cl::opt<bool>
 static cl::opt<std::string>
     StatsFile("stats-file", cl::desc("Filename to write statistics to"));
 
+static cl::opt<bool> PrintMemoryUsage(
+    "print-memory-usage",
+    cl::desc("Print heap usage after adding the inputs and after running LTO"));
+
 static cl::list<std::string>
     PassPlugins("load-pass-plugin",
                 cl::desc("Load passes from plugin library"));
@@ -388,7 +398,12 @@ static int run(int argc, char **argv) {
     return 1;
   }
 
-  LTO Lto(std::move(Conf), std::move(Backend), 1, LTOMode);
+  if (Partitions == 0) {
+    llvm::errs() << "invalid number of LTO partitions\n";
+    return 1;
+  }
+
+  LTO Lto(std::move(Conf), std::move(Backend), Partitions, LTOMode);
 
   for (std::string F : InputFilenames) {
     std::unique_ptr<MemoryBuffer> MB = check(MemoryBuffer::getFile(F), F);
@@ -435,6 +450,10 @@ static int run(int argc, char **argv) {
   if (HasErrors)
     return 1;
 
+  if (PrintMemoryUsage)
+    llvm::errs() << "heap usage after adding inputs: "
+                 << sys::Process::GetMallocUsage() << " bytes\n";
+
   auto AddStream =
       [&](size_t Task,
           const Twine &ModuleName) -> std::unique_ptr<CachedFileStream> {
@@ -457,6 +476,9 @@ static int run(int argc, char **argv) {
                   "failed to create cache");
 
   check(Lto.run(AddStream, Cache), "LTO::run failed");
+  if (PrintMemoryUsage)
+    llvm::errs() << "heap usage after running LTO: "
+                 << sys::Process::GetMallocUsage() << " bytes\n";
   return static_cast<int>(HasErrors);
 }
 
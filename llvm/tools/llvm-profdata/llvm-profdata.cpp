@@ -13,6 +13,7 @@
 #include "llvm/ADT/SmallSet.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/StringRef.h"
+#include "llvm/ADT/StringSet.h"
 #include "llvm/Debuginfod/HTTPClient.h"
 #include "llvm/IR/LLVMContext.h"
 #include "llvm/Object/Binary.h"
@@ -33,6 +34,7 @@
 #include "llvm/Support/Format.h"
 #include "llvm/Support/FormattedStream.h"
 #include "llvm/Support/LLVMDriver.h"
+#include "llvm/Support/LineIterator.h"
 #include "llvm/Support/MD5.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
@@ -275,6 +277,11 @@ cl::opt<std::string> FuncNameNegativeFilter(
     "no-function", cl::init(""),
     cl::sub(MergeSubcommand),
     cl::desc("Exclude functions matching the filter from the output."));
+cl::opt<std::string> FuncNameListFile(
+    "function-list", cl::init(""), cl::sub(MergeSubcommand),
+    cl::desc("Only keep the functions named in the given file, one name per "
+             "line. Use it to extract the slice of a profile that a set of "
+             "translation units needs."));
 
 cl::opt<FailureMode>
     FailMode("failure-mode", cl::init(failIfAnyAreInvalid),
@@ -294,6 +301,11 @@ cl::opt<unsigned> NumThreads(
     cl::desc("Number of merge threads to use (default: autodetect)"));
 cl::alias NumThreadsA("j", cl::desc("Alias for --num-threads"),
                       cl::aliasopt(NumThreads));
+cl::opt<unsigned> NumWriterContexts(
+    "num-writer-contexts", cl::init(0), cl::sub(MergeSubcommand),
+    cl::desc("Number of in-memory profiles the inputs are merged into before "
+             "they are combined (default: one per merge thread). Fewer "
+             "contexts lower the peak memory use of parallel merges"));
 
 cl::opt<std::string> ProfileSymbolListFile(
     "prof-sym-list", cl::init(""), cl::sub(MergeSubcommand),
@@ -644,6 +656,8 @@ struct WriterContext {
   std::vector<std::pair<Error, std::string>> Errors;
   std::mutex &ErrLock;
   SmallSet<instrprof_error, 4> &WriterErrorCodes;
+  /// Whether several threads load inputs into this context concurrently.
+  bool Shared = false;
 
   WriterContext(bool IsSparse, std::mutex &ErrLock,
                 SmallSet<instrprof_error, 4> &WriterErrorCodes,
@@ -688,7 +702,15 @@ loadInput(const WeightedFile &Input, SymbolRemapper *Remapper,
           const InstrProfCorrelator *Correlator, const StringRef ProfiledBinary,
           WriterContext *WC, const object::BuildIDFetcher *BIDFetcher = nullptr,
           const ProfCorrelatorKind *BIDFetcherCorrelatorKind = nullptr) {
-  std::unique_lock<std::mutex> CtxGuard{WC->Lock};
+  // If the context is shared, its lock is only taken once the input has been
+  // parsed, so that several threads can read inputs merged into it.
+  std::unique_lock<std::mutex> CtxGuard{WC->Lock, std::defer_lock};
+  auto LockContext = [&]() {
+    if (!CtxGuard.owns_lock())
+      CtxGuard.lock();
+  };
+  if (!WC->Shared)
+    LockContext();
 
   // Copy the filename, because llvm::ThreadPool copied the input "const
   // WeightedFile &" by value, making a reference to the filename within it
@@ -697,6 +719,7 @@ loadInput(const WeightedFile &Input, SymbolRemapper *Remapper,
 
   using ::llvm::memprof::RawMemProfReader;
   if (RawMemProfReader::hasFormat(Input.Filename)) {
+    LockContext();
     auto ReaderOrErr = RawMemProfReader::create(Input.Filename, ProfiledBinary);
     if (!ReaderOrErr) {
       exitWithError(ReaderOrErr.takeError(), Input.Filename);
@@ -726,6 +749,7 @@ loadInput(const WeightedFile &Input, SymbolRemapper *Remapper,
 
   using ::llvm::memprof::YAMLMemProfReader;
   if (YAMLMemProfReader::hasFormat(Input.Filename)) {
+    LockContext();
     auto ReaderOrErr = YAMLMemProfReader::create(Input.Filename);
     if (!ReaderOrErr)
       exitWithError(ReaderOrErr.takeError(), Input.Filename);
@@ -785,13 +809,28 @@ loadInput(const WeightedFile &Input, SymbolRemapper *Remapper,
   if (Error E = ReaderOrErr.takeError()) {
     // Skip the empty profiles by returning silently.
     auto [ErrCode, Msg] = InstrProfError::take(std::move(E));
+    LockContext();
     if (ErrCode != instrprof_error::empty_raw_profile)
       WC->Errors.emplace_back(make_error<InstrProfError>(ErrCode, Msg),
                               Filename);
     return;
   }
 
+  // In a shared context, decode all records before taking the lock. Reading
+  // the input is most of the work, the records only need the writer context
+  // to be merged. Otherwise, merge the records as they are read so that they
+  // are never all held in memory at once.
   auto Reader = std::move(ReaderOrErr.get());
+  std::vector<NamedInstrProfRecord> Records;
+  if (WC->Shared) {
+    for (auto &I : *Reader) {
+      if (Remapper)
+        I.Name = (*Remapper)(I.Name);
+      Records.push_back(std::move(I));
+    }
+  }
+
+  LockContext();
   if (Error E = WC->Writer.mergeProfileKind(Reader->getProfileKind())) {
     consumeError(std::move(E));
     WC->Errors.emplace_back(
@@ -802,9 +841,7 @@ loadInput(const WeightedFile &Input, SymbolRemapper *Remapper,
     return;
   }
 
-  for (auto &I : *Reader) {
-    if (Remapper)
-      I.Name = (*Remapper)(I.Name);
+  auto AddRecord = [&](NamedInstrProfRecord &&I) {
     const StringRef FuncName = I.Name;
     bool Reported = false;
     WC->Writer.addRecord(std::move(I), Input.Weight, [&](Error E) {
@@ -820,6 +857,16 @@ loadInput(const WeightedFile &Input, SymbolRemapper *Remapper,
       handleMergeWriterError(make_error<InstrProfError>(ErrCode, Msg),
                              Input.Filename, FuncName, firstTime);
     });
+  };
+  if (WC->Shared) {
+    for (auto &I : Records)
+      AddRecord(std::move(I));
+  } else {
+    for (auto &I : *Reader) {
+      if (Remapper)
+        I.Name = (*Remapper)(I.Name);
+      AddRecord(std::move(I));
+    }
   }
 
   if (KeepVTableSymbols) {
@@ -888,9 +935,28 @@ template <typename T>
 static void filterFunctions(T &ProfileMap) {
   bool hasFilter = !FuncNameFilter.empty();
   bool hasNegativeFilter = !FuncNameNegativeFilter.empty();
-  if (!hasFilter && !hasNegativeFilter)
+  bool hasListFilter = !FuncNameListFile.empty();
+  if (!hasFilter && !hasNegativeFilter && !hasListFilter)
     return;
 
+  // Exact names are looked up in a set, a regex alternation of thousands of
+  // names would make filtering quadratic.
+  StringSet<> ListedNames;
+  if (hasListFilter) {
+    auto BufferOrErr = MemoryBuffer::getFile(FuncNameListFile, /*IsText=*/true);
+    if (!BufferOrErr)
+      exitWithErrorCode(BufferOrErr.getError(), FuncNameListFile);
+    for (line_iterator I(**BufferOrErr, /*SkipBlanks=*/true); !I.is_at_eof();
+         ++I) {
+      StringRef Name = I->trim();
+      ListedNames.insert(Name);
+      // Handle MD5 profile, so it is still able to match using the original
+      // name.
+      if (FunctionSamples::UseMD5)
+        ListedNames.insert(std::to_string(llvm::MD5Hash(Name)));
+    }
+  }
+
   // If filter starts with '?' it is MSVC mangled name, not a regex.
   llvm::Regex ProbablyMSVCMangledName("[?@$_0-9A-Za-z]+");
   if (hasFilter && FuncNameFilter[0] == '?' &&
@@ -922,7 +988,8 @@ static void filterFunctions(T &ProfileMap) {
          (NegativePattern.match(FuncName) ||
           (FunctionSamples::UseMD5 && NegativeMD5Name == FuncName))) ||
         (hasFilter && !(Pattern.match(FuncName) ||
-                        (FunctionSamples::UseMD5 && MD5Name == FuncName))))
+                        (FunctionSamples::UseMD5 && MD5Name == FuncName))) ||
+        (hasListFilter && !ListedNames.contains(FuncName)))
       ProfileMap.erase(Tmp);
   }
 
@@ -1020,12 +1087,21 @@ static void mergeInstrProfile(const WeightedFileVector &Inputs,
     NumThreads = std::min(hardware_concurrency().compute_thread_count(),
                           unsigned((Inputs.size() + 1) / 2));
 
+  // Each writer context holds the union of the profiles merged into it, so
+  // the peak memory use grows with the number of contexts. Inputs are still
+  // read by all threads when there are fewer contexts than threads.
+  unsigned NumContexts = NumThreads;
+  if (NumWriterContexts != 0)
+    NumContexts = std::min<unsigned>(NumWriterContexts, NumThreads);
+
   // Initialize the writer contexts.
   SmallVector<std::unique_ptr<WriterContext>, 4> Contexts;
-  for (unsigned I = 0; I < NumThreads; ++I)
+  for (unsigned I = 0; I < NumContexts; ++I) {
     Contexts.emplace_back(std::make_unique<WriterContext>(
         OutputSparse, ErrorLock, WriterErrorCodes, TraceReservoirSize,
         MaxTraceLength));
+    Contexts.back()->Shared = NumContexts < NumThreads;
+  }
 
   if (NumThreads == 1) {
     for (const auto &Input : Inputs)
@@ -1040,15 +1116,14 @@ static void mergeInstrProfile(const WeightedFileVector &Inputs,
       Pool.async(loadInput, Input, Remapper, Correlator.get(), ProfiledBinary,
                  Contexts[Ctx].get(), BIDFetcher.get(),
                  &BIDFetcherCorrelateKind);
-      Ctx = (Ctx + 1) % NumThreads;
+      Ctx = (Ctx + 1) % NumContexts;
     }
     Pool.wait();
 
-    // Merge the writer contexts together (~ lg(NumThreads) serial steps).
+    // Merge the writer contexts together (~ lg(NumContexts) serial steps).
     unsigned Mid = Contexts.size() / 2;
     unsigned End = Contexts.size();
-    assert(Mid > 0 && "Expected more than one context");
-    do {
+    while (Mid > 0) {
       for (unsigned I = 0; I < Mid; ++I)
         Pool.async(mergeWriterContexts, Contexts[I].get(),
                    Contexts[I + Mid].get());
@@ -1060,7 +1135,7 @@ static void mergeInstrProfile(const WeightedFileVector &Inputs,
       }
       End = Mid;
       Mid /= 2;
-    } while (Mid > 0);
+    }
   }
 
   // Handle deferred errors encountered during merging. If the number of errors
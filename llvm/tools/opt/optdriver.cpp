@@ -271,6 +271,12 @@ static cl::opt<std::string>
                            "names match the given regular expression"),
                   cl::value_desc("regex"));
 
+static cl::opt<std::string>
+    RemarksNames("pass-remarks-name-filter",
+                 cl::desc("Only record optimization remarks whose names "
+                          "match the given regular expression"),
+                 cl::value_desc("regex"));
+
 static cl::opt<std::string> RemarksFormat(
     "pass-remarks-format",
     cl::desc("The format used for serializing remarks (default: YAML)"),
@@ -510,7 +516,7 @@ extern "C" int optMain(
   Expected<std::unique_ptr<ToolOutputFile>> RemarksFileOrErr =
       setupLLVMOptimizationRemarks(Context, RemarksFilename, RemarksPasses,
                                    RemarksFormat, RemarksWithHotness,
-                                   RemarksHotnessThreshold);
+                                   RemarksHotnessThreshold, RemarksNames);
   if (Error E = RemarksFileOrErr.takeError()) {
     errs() << toString(std::move(E)) << '\n';
     return 1;
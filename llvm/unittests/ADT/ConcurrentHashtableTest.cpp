@@ -310,4 +310,26 @@ TEST(ConcurrentHashTableTest, AddStringEntriesParallelWithResize) {
               std::string::npos);
 }
 
+TEST(ConcurrentHashTableTest, ClearEntries) {
+  PerThreadBumpPtrAllocator Allocator;
+  ConcurrentHashTableByPtr<std::string, String, PerThreadBumpPtrAllocator,
+                           ConcurrentHashTableInfoByPtr<
+                               std::string, String, PerThreadBumpPtrAllocator>>
+      HashTable(Allocator, 10);
+
+  parallel::TaskGroup tg;
+
+  tg.spawn([&]() {
+    EXPECT_TRUE(HashTable.insert("1").second);
+    EXPECT_FALSE(HashTable.insert("1").second);
+
+    HashTable.clear();
+
+    // Check the entry is inserted again after clearing the table.
+    std::pair<String *, bool> res = HashTable.insert("1");
+    EXPECT_TRUE(res.first->getKey() == "1");
+    EXPECT_TRUE(res.second);
+  });
+}
+
 } // namespace
@@ -15,6 +15,7 @@
 #include "llvm/DebugInfo/GSYM/FileWriter.h"
 #include "llvm/DebugInfo/GSYM/FunctionInfo.h"
 #include "llvm/DebugInfo/GSYM/GsymCreator.h"
+#include "llvm/DebugInfo/GSYM/GsymDIContext.h"
 #include "llvm/DebugInfo/GSYM/GsymReader.h"
 #include "llvm/DebugInfo/GSYM/Header.h"
 #include "llvm/DebugInfo/GSYM/InlineInfo.h"
@@ -4899,3 +4900,68 @@ TEST(GSYMTest, TestLookupsOfOverlappingAndUnequalRanges) {
   for (const auto &Line : ExpectedDumpLines)
     EXPECT_TRUE(DumpStr.find(Line) != std::string::npos);
 }
+
+TEST(GSYMTest, TestGsymDIContext) {
+  // Test that a GsymDIContext answers the DIContext queries the symbolizer
+  // makes from the lookups of the underlying GSYM file.
+  GsymCreator GC;
+  FunctionInfo FI(0x1000, 0x100, GC.insertString("main"));
+  FI.OptLineTable = LineTable();
+  const uint32_t MainFileIndex = GC.insertFile("/tmp/main.c");
+  const uint32_t FooFileIndex = GC.insertFile("/tmp/foo.h");
+  FI.OptLineTable->push(LineEntry(0x1000, MainFileIndex, 5));
+  FI.OptLineTable->push(LineEntry(0x1010, FooFileIndex, 10));
+  FI.OptLineTable->push(LineEntry(0x1020, MainFileIndex, 8));
+  FI.Inline = InlineInfo();
+  FI.Inline->Name = GC.insertString("inline1");
+  FI.Inline->CallFile = MainFileIndex;
+  FI.Inline->CallLine = 6;
+  FI.Inline->Ranges.insert(AddressRange(0x1010, 0x1020));
+  GC.addFunctionInfo(std::move(FI));
+  OutputAggregator Null(nullptr);
+  Error FinalizeErr = GC.finalize(Null);
+  ASSERT_FALSE(FinalizeErr);
+  SmallString<512> Str;
+  raw_svector_ostream OutStrm(Str);
+  FileWriter FW(OutStrm, llvm::endianness::native);
+  llvm::Error Err = GC.encode(FW);
+  ASSERT_FALSE((bool)Err);
+  Expected<GsymReader> GR = GsymReader::copyBuffer(OutStrm.str());
+  ASSERT_THAT_EXPECTED(GR, Succeeded());
+  GsymDIContext DICtx(std::make_unique<GsymReader>(std::move(*GR)));
+
+  DILineInfoSpecifier Spec(
+      DILineInfoSpecifier::FileLineInfoKind::AbsoluteFilePath,
+      DILineInfoSpecifier::FunctionNameKind::LinkageName);
+  DILineInfo LineInfo = DICtx.getLineInfoForAddress({0x1004}, Spec);
+  EXPECT_EQ(LineInfo.FunctionName, "main");
+  EXPECT_EQ(LineInfo.FileName, "/tmp/main.c");
+  EXPECT_EQ(LineInfo.Line, 5u);
+  EXPECT_EQ(LineInfo.StartAddress, 0x1000u);
+
+  // The symbolizer passes addresses with the index of their section. GSYM
+  // addresses are file addresses, so the section doesn't matter.
+  DILineInfo SectionLineInfo =
+      DICtx.getLineInfoForAddress({0x1004, /*SectionIndex=*/1}, Spec);
+  EXPECT_EQ(SectionLineInfo.FunctionName, "main");
+  EXPECT_EQ(SectionLineInfo.Line, 5u);
+
+  DIInliningInfo InliningInfo = DICtx.getInliningInfoForAddress({0x1010}, Spec);
+  ASSERT_EQ(InliningInfo.getNumberOfFrames(), 2u);
+  EXPECT_EQ(InliningInfo.getFrame(0).FunctionName, "inline1");
+  EXPECT_EQ(InliningInfo.getFrame(0).FileName, "/tmp/foo.h");
+  EXPECT_EQ(InliningInfo.getFrame(0).Line, 10u);
+  EXPECT_EQ(InliningInfo.getFrame(1).FunctionName, "main");
+  EXPECT_EQ(InliningInfo.getFrame(1).Line, 6u);
+
+  DILineInfoTable Table =
+      DICtx.getLineInfoForAddressRange({0x1000}, 0x20, Spec);
+  ASSERT_EQ(Table.size(), 2u);
+  EXPECT_EQ(Table[0].first, 0x1000u);
+  EXPECT_EQ(Table[1].first, 0x1010u);
+  EXPECT_EQ(Table[1].second.FileName, "/tmp/foo.h");
+
+  // Addresses outside of any function have no information.
+  EXPECT_EQ(DICtx.getLineInfoForAddress({0x2000}, Spec).FunctionName,
+            DILineInfo::BadString);
+}
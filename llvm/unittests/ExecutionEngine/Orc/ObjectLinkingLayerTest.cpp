@@ -16,6 +16,7 @@
 #include "llvm/ExecutionEngine/Orc/Shared/ExecutorSymbolDef.h"
 #include "llvm/ExecutionEngine/Orc/Shared/TargetProcessControlTypes.h"
 #include "llvm/ExecutionEngine/Orc/SymbolStringPool.h"
+#include "llvm/Support/Endian.h"
 #include "llvm/Testing/Support/Error.h"
 #include "gtest/gtest.h"
 
@@ -154,6 +155,44 @@ TEST_F(ObjectLinkingLayerTest, ClaimLateDefinedWeakSymbols) {
   EXPECT_THAT_EXPECTED(ES.lookup(&JD, "_anchor"), Succeeded());
 }
 
+TEST_F(ObjectLinkingLayerTest, ApplyFixupsConcurrently) {
+  // Check that fixups applied in parallel write the same content as serial
+  // ones would.
+  ObjLinkingLayer.setApplyFixupsConcurrently(true);
+
+  auto G = std::make_unique<LinkGraph>(
+      "foo", ES.getSymbolStringPool(), Triple("x86_64-apple-darwin"),
+      SubtargetFeatures(), x86_64::getEdgeKindName);
+
+  auto &DataSec = G->createSection("__data", MemProt::Read | MemProt::Write);
+  auto &TargetBlock = G->createContentBlock(DataSec, BlockContent,
+                                            orc::ExecutorAddr(0x1000), 8, 0);
+  auto &Target = G->addDefinedSymbol(TargetBlock, 0, "_target", 8,
+                                     Linkage::Strong, Scope::Default, false,
+                                     false);
+
+  constexpr unsigned NumPointers = 64;
+  for (unsigned I = 0; I != NumPointers; ++I) {
+    auto &B = G->createContentBlock(DataSec, BlockContent,
+                                    orc::ExecutorAddr(0x2000 + I * 8), 8, 0);
+    B.addEdge(x86_64::Pointer64, 0, Target, I);
+    G->addDefinedSymbol(B, 0, "_ptr" + std::to_string(I), 8, Linkage::Strong,
+                        Scope::Default, false, false);
+  }
+
+  EXPECT_THAT_ERROR(ObjLinkingLayer.add(JD, std::move(G)), Succeeded());
+
+  auto TargetSym = ES.lookup(&JD, "_target");
+  ASSERT_THAT_EXPECTED(TargetSym, Succeeded());
+  for (unsigned I = 0; I != NumPointers; ++I) {
+    auto PtrSym = ES.lookup(&JD, "_ptr" + std::to_string(I));
+    ASSERT_THAT_EXPECTED(PtrSym, Succeeded());
+    EXPECT_EQ(support::endian::read64le(
+                  PtrSym->getAddress().toPtr<const char *>()),
+              TargetSym->getAddress().getValue() + I);
+  }
+}
+
 TEST_F(ObjectLinkingLayerTest, HandleErrorDuringPostAllocationPass) {
   // We want to confirm that Errors in post allocation passes correctly
   // abandon the in-flight allocation and report an error.
@@ -0,0 +1,123 @@
+//===- PersistentObjectCacheTest.cpp - Unit tests for the object cache ----===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ExecutionEngine/Orc/PersistentObjectCache.h"
+#include "OrcTestCommon.h"
+#include "llvm/ExecutionEngine/Orc/JITTargetMachineBuilder.h"
+#include "llvm/IR/DerivedTypes.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Testing/Support/SupportHelpers.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+using namespace llvm::orc;
+using llvm::unittest::TempDir;
+
+namespace {
+
+std::unique_ptr<Module> createModule(LLVMContext &Ctx, StringRef FnName) {
+  auto M = std::make_unique<Module>("cached", Ctx);
+  Function::Create(FunctionType::get(Type::getVoidTy(Ctx), false),
+                   GlobalValue::ExternalLinkage, FnName, *M);
+  return M;
+}
+
+TEST(PersistentObjectCacheTest, StoresAndReloadsObjects) {
+  TempDir Dir("PersistentObjectCacheTest", /*Unique=*/true);
+  LLVMContext Ctx;
+  std::unique_ptr<Module> M = createModule(Ctx, "foo");
+
+  {
+    PersistentObjectCache Cache(Dir.path("cache"), "target");
+    EXPECT_EQ(Cache.getObject(M.get()), nullptr);
+    Cache.notifyObjectCompiled(M.get(),
+                               MemoryBufferRef("object bytes", "obj"));
+    EXPECT_TRUE(sys::fs::exists(Cache.getEntryPath(*M)));
+  }
+
+  // A later cache instance, as in a restarted process, hits on an identical
+  // module.
+  LLVMContext OtherCtx;
+  std::unique_ptr<Module> Same = createModule(OtherCtx, "foo");
+  PersistentObjectCache Cache(Dir.path("cache"), "target");
+  std::unique_ptr<MemoryBuffer> Obj = Cache.getObject(Same.get());
+  ASSERT_NE(Obj, nullptr);
+  EXPECT_EQ(Obj->getBuffer(), "object bytes");
+}
+
+TEST(PersistentObjectCacheTest, KeyCoversModuleAndTarget) {
+  TempDir Dir("PersistentObjectCacheTest", /*Unique=*/true);
+  LLVMContext Ctx;
+  std::unique_ptr<Module> M = createModule(Ctx, "foo");
+  PersistentObjectCache Cache(Dir.path(), "target");
+  EXPECT_EQ(Cache.getObject(M.get()), nullptr);
+  Cache.notifyObjectCompiled(M.get(), MemoryBufferRef("object bytes", "obj"));
+
+  std::unique_ptr<Module> Other = createModule(Ctx, "bar");
+  EXPECT_EQ(Cache.getObject(Other.get()), nullptr);
+
+  PersistentObjectCache OtherTarget(Dir.path(), "other target");
+  EXPECT_EQ(OtherTarget.getObject(M.get()), nullptr);
+}
+
+TEST(PersistentObjectCacheTest, IgnoresUnqueriedModules) {
+  // Objects of modules whose key was not computed before compilation are not
+  // stored, the module may have been changed by code generation.
+  TempDir Dir("PersistentObjectCacheTest", /*Unique=*/true);
+  LLVMContext Ctx;
+  std::unique_ptr<Module> M = createModule(Ctx, "foo");
+  PersistentObjectCache Cache(Dir.path(), "target");
+  Cache.notifyObjectCompiled(M.get(), MemoryBufferRef("object bytes", "obj"));
+  EXPECT_FALSE(sys::fs::exists(Cache.getEntryPath(*M)));
+}
+
+TEST(PersistentObjectCacheTest, ForgetsFailedCompiles) {
+  // A failed compile must not leave the key of its module behind, another
+  // module may later be allocated at the same address.
+  TempDir Dir("PersistentObjectCacheTest", /*Unique=*/true);
+  LLVMContext Ctx;
+  std::unique_ptr<Module> M = createModule(Ctx, "foo");
+  PersistentObjectCache Cache(Dir.path(), "target");
+  EXPECT_EQ(Cache.getObject(M.get()), nullptr);
+  Cache.notifyObjectCompileFailed(M.get());
+  Cache.notifyObjectCompiled(M.get(), MemoryBufferRef("object bytes", "obj"));
+  EXPECT_FALSE(sys::fs::exists(Cache.getEntryPath(*M)));
+}
+
+TEST(PersistentObjectCacheTest, TargetKeyCoversOptions) {
+  // Bails out on error, as it is valid to run this test without any targets
+  // built.
+  OrcNativeTarget::initialize();
+  auto JTMB = JITTargetMachineBuilder::detectHost();
+  if (!JTMB) {
+    consumeError(JTMB.takeError());
+    GTEST_SKIP();
+  }
+  auto TM = JTMB->createTargetMachine();
+  if (!TM) {
+    consumeError(TM.takeError());
+    GTEST_SKIP();
+  }
+
+  std::string Key = PersistentObjectCache::getTargetKey(**TM);
+  EXPECT_EQ(Key, PersistentObjectCache::getTargetKey(**TM));
+
+  (*TM)->Options.TrapUnreachable = !(*TM)->Options.TrapUnreachable;
+  std::string TrapKey = PersistentObjectCache::getTargetKey(**TM);
+  EXPECT_NE(Key, TrapKey);
+
+  (*TM)->Options.MCOptions.X86RelaxRelocations =
+      !(*TM)->Options.MCOptions.X86RelaxRelocations;
+  EXPECT_NE(TrapKey, PersistentObjectCache::getTargetKey(**TM));
+}
+
+} // namespace
@@ -91,10 +91,57 @@ protected:
     return ROLayer->add(std::move(RT), std::move(TSM));
   }
 
+  // Creates ROLayer with a reoptimization function that makes every function
+  // return 53.
+  void setUpReOptimizeLayer(MangleAndInterner &Mangle) {
+    auto &EPC = ES->getExecutorProcessControl();
+    EXPECT_THAT_ERROR(JD->define(absoluteSymbols(
+                          {{Mangle("__orc_rt_jit_dispatch"),
+                            {EPC.getJITDispatchInfo().JITDispatchFunction,
+                             JITSymbolFlags::Exported}},
+                           {Mangle("__orc_rt_jit_dispatch_ctx"),
+                            {EPC.getJITDispatchInfo().JITDispatchContext,
+                             JITSymbolFlags::Exported}},
+                           {Mangle("__orc_rt_reoptimize_tag"),
+                            {ExecutorAddr(), JITSymbolFlags::Exported}}})),
+                      Succeeded());
+
+    auto RM = JITLinkRedirectableSymbolManager::Create(*ObjLinkingLayer);
+    ASSERT_THAT_ERROR(RM.takeError(), Succeeded());
+    RSManager = std::move(*RM);
+
+    ROLayer =
+        std::make_unique<ReOptimizeLayer>(*ES, *DL, *CompileLayer, *RSManager);
+    ROLayer->setReoptimizeFunc(
+        [&](ReOptimizeLayer &Parent,
+            ReOptimizeLayer::ReOptMaterializationUnitID MUID,
+            unsigned CurVerison, ResourceTrackerSP OldRT,
+            ThreadSafeModule &TSM) {
+          TSM.withModuleDo([&](Module &M) {
+            for (auto &F : M) {
+              if (F.isDeclaration())
+                continue;
+              for (auto &B : F) {
+                for (auto &I : B) {
+                  if (ReturnInst *Ret = dyn_cast<ReturnInst>(&I)) {
+                    Value *RetValue =
+                        ConstantInt::get(M.getContext(), APInt(32, 53));
+                    Ret->setOperand(0, RetValue);
+                  }
+                }
+              }
+            }
+          });
+          return Error::success();
+        });
+    EXPECT_THAT_ERROR(ROLayer->reigsterRuntimeFunctions(*JD), Succeeded());
+  }
+
   JITDylib *JD{nullptr};
   std::unique_ptr<ExecutionSession> ES;
   std::unique_ptr<ObjectLinkingLayer> ObjLinkingLayer;
   std::unique_ptr<IRCompileLayer> CompileLayer;
+  std::unique_ptr<RedirectableSymbolManager> RSManager;
   std::unique_ptr<ReOptimizeLayer> ROLayer;
   std::unique_ptr<DataLayout> DL;
 };
@@ -116,45 +163,37 @@ static Function *createRetFunction(Module *M, StringRef Name,
 
 TEST_F(ReOptimizeLayerTest, BasicReOptimization) {
   MangleAndInterner Mangle(*ES, *DL);
+  setUpReOptimizeLayer(Mangle);
+
+  ThreadSafeContext Ctx(std::make_unique<LLVMContext>());
+  auto M = std::make_unique<Module>("<main>", *Ctx.getContext());
+  M->setTargetTriple(sys::getProcessTriple());
 
-  auto &EPC = ES->getExecutorProcessControl();
-  EXPECT_THAT_ERROR(JD->define(absoluteSymbols(
-                        {{Mangle("__orc_rt_jit_dispatch"),
-                          {EPC.getJITDispatchInfo().JITDispatchFunction,
-                           JITSymbolFlags::Exported}},
-                         {Mangle("__orc_rt_jit_dispatch_ctx"),
-                          {EPC.getJITDispatchInfo().JITDispatchContext,
-                           JITSymbolFlags::Exported}},
-                         {Mangle("__orc_rt_reoptimize_tag"),
-                          {ExecutorAddr(), JITSymbolFlags::Exported}}})),
+  (void)createRetFunction(M.get(), "main", 42);
+
+  EXPECT_THAT_ERROR(addIRModule(JD->getDefaultResourceTracker(),
+                                ThreadSafeModule(std::move(M), std::move(Ctx))),
                     Succeeded());
 
-  auto RM = JITLinkRedirectableSymbolManager::Create(*ObjLinkingLayer);
-  EXPECT_THAT_ERROR(RM.takeError(), Succeeded());
-
-  ROLayer = std::make_unique<ReOptimizeLayer>(*ES, *DL, *CompileLayer, **RM);
-  ROLayer->setReoptimizeFunc(
-      [&](ReOptimizeLayer &Parent,
-          ReOptimizeLayer::ReOptMaterializationUnitID MUID, unsigned CurVerison,
-          ResourceTrackerSP OldRT, ThreadSafeModule &TSM) {
-        TSM.withModuleDo([&](Module &M) {
-          for (auto &F : M) {
-            if (F.isDeclaration())
-              continue;
-            for (auto &B : F) {
-              for (auto &I : B) {
-                if (ReturnInst *Ret = dyn_cast<ReturnInst>(&I)) {
-                  Value *RetValue =
-                      ConstantInt::get(M.getContext(), APInt(32, 53));
-                  Ret->setOperand(0, RetValue);
-                }
-              }
-            }
-          }
-        });
-        return Error::success();
-      });
-  EXPECT_THAT_ERROR(ROLayer->reigsterRuntimeFunctions(*JD), Succeeded());
+  auto Result = cantFail(ES->lookup({JD}, Mangle("main")));
+  auto FuncPtr = Result.getAddress().toPtr<int (*)()>();
+  for (size_t I = 0; I <= ReOptimizeLayer::CallCountThreshold; I++)
+    EXPECT_EQ(FuncPtr(), 42);
+  EXPECT_EQ(FuncPtr(), 53);
+
+  std::vector<ReOptimizeLayer::VersionStats> Stats = ROLayer->getVersionStats();
+  ASSERT_EQ(Stats.size(), 2u);
+  EXPECT_EQ(Stats[1].NumReoptimized, 1u);
+  EXPECT_EQ(Stats[1].NumFailed, 0u);
+  EXPECT_LE(Stats[1].MaxLatency, Stats[1].TotalLatency);
+}
+
+TEST_F(ReOptimizeLayerTest, CallCountThreshold) {
+  MangleAndInterner Mangle(*ES, *DL);
+  setUpReOptimizeLayer(Mangle);
+  constexpr uint64_t Threshold = 3;
+  ROLayer->setCallCountThreshold(Threshold);
+  EXPECT_EQ(ROLayer->getCallCountThreshold(), Threshold);
 
   ThreadSafeContext Ctx(std::make_unique<LLVMContext>());
   auto M = std::make_unique<Module>("<main>", *Ctx.getContext());
@@ -168,7 +207,7 @@ TEST_F(ReOptimizeLayerTest, BasicReOptimization) {
 
   auto Result = cantFail(ES->lookup({JD}, Mangle("main")));
   auto FuncPtr = Result.getAddress().toPtr<int (*)()>();
-  for (size_t I = 0; I <= ReOptimizeLayer::CallCountThreshold; I++)
+  for (size_t I = 0; I <= Threshold; I++)
     EXPECT_EQ(FuncPtr(), 42);
   EXPECT_EQ(FuncPtr(), 53);
 }
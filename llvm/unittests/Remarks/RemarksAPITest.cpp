@@ -7,7 +7,9 @@
 //===----------------------------------------------------------------------===//
 
 #include "llvm/Remarks/Remark.h"
+#include "llvm/Remarks/RemarkStreamer.h"
 #include "llvm/Remarks/RemarkStringTable.h"
+#include "llvm/Support/raw_ostream.h"
 #include "gtest/gtest.h"
 
 using namespace llvm;
@@ -121,3 +123,25 @@ TEST(RemarksAPI, StringTableInternalize) {
   EXPECT_EQ(StrTab.add(R.Args.back().Loc->SourceFilePath).second.data(),
             R2.Args.back().Loc->SourceFilePath.data());
 }
+
+TEST(RemarksAPI, StreamerFilters) {
+  Expected<std::unique_ptr<remarks::RemarkSerializer>> Serializer =
+      remarks::createRemarkSerializer(remarks::Format::YAML,
+                                      remarks::SerializerMode::Separate,
+                                      nulls());
+  ASSERT_FALSE(errorToBool(Serializer.takeError()));
+  remarks::RemarkStreamer RS(std::move(*Serializer));
+
+  // Without filters, everything matches.
+  EXPECT_TRUE(RS.matchesFilter("inline"));
+  EXPECT_TRUE(RS.matchesNameFilter("NotInlined"));
+
+  EXPECT_FALSE(errorToBool(RS.setFilter("inline|licm")));
+  EXPECT_FALSE(errorToBool(RS.setNameFilter("^(Inlined|Hoisted)$")));
+  EXPECT_TRUE(RS.matchesFilter("inline"));
+  EXPECT_FALSE(RS.matchesFilter("gvn"));
+  EXPECT_TRUE(RS.matchesNameFilter("Inlined"));
+  EXPECT_FALSE(RS.matchesNameFilter("NotInlined"));
+
+  EXPECT_TRUE(errorToBool(RS.setNameFilter("(")));
+}
@@ -0,0 +1,97 @@
+//===- CachingTest.cpp ----------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Support/Caching.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Testing/Support/Error.h"
+#include "llvm/Testing/Support/SupportHelpers.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+using llvm::unittest::TempDir;
+
+namespace {
+
+struct FakeRemoteCache {
+  StringMap<std::string> Objects;
+  unsigned NumFetches = 0;
+
+  RemoteFileCache get() {
+    RemoteFileCache Remote;
+    Remote.Fetch = [this](StringRef Key) -> std::unique_ptr<MemoryBuffer> {
+      ++NumFetches;
+      auto It = Objects.find(Key);
+      if (It == Objects.end())
+        return nullptr;
+      return MemoryBuffer::getMemBufferCopy(It->second);
+    };
+    Remote.Store = [this](StringRef Key, MemoryBufferRef Object) {
+      Objects[Key] = Object.getBuffer().str();
+    };
+    return Remote;
+  }
+};
+
+std::string lookup(FileCache &Cache, StringRef Key, const std::string &Added,
+                   StringRef Produce) {
+  Expected<AddStreamFn> AddStream = Cache(0, Key, "module");
+  EXPECT_THAT_EXPECTED(AddStream, Succeeded());
+  if (AddStream && *AddStream) {
+    Expected<std::unique_ptr<CachedFileStream>> Stream = (*AddStream)(0, "");
+    EXPECT_THAT_EXPECTED(Stream, Succeeded());
+    if (Stream)
+      *(*Stream)->OS << Produce;
+  }
+  return Added;
+}
+
+TEST(Caching, StoresProducedObjectsRemotely) {
+  TempDir Dir("CachingTest", /*Unique=*/true);
+  FakeRemoteCache Remote;
+  std::string Added;
+  Expected<FileCache> Cache = localCache(
+      "Test", "Test", Dir.path(),
+      [&](unsigned, const Twine &, std::unique_ptr<MemoryBuffer> MB) {
+        Added = MB->getBuffer().str();
+      },
+      Remote.get());
+  ASSERT_THAT_EXPECTED(Cache, Succeeded());
+
+  EXPECT_EQ("object", lookup(*Cache, "key", Added, "object"));
+  EXPECT_EQ(1u, Remote.NumFetches);
+  EXPECT_EQ("object", Remote.Objects.lookup("key"));
+
+  // The second lookup is a local hit.
+  Added.clear();
+  EXPECT_EQ("object", lookup(*Cache, "key", Added, "unexpected"));
+  EXPECT_EQ(1u, Remote.NumFetches);
+}
+
+TEST(Caching, CopiesRemoteHitsLocally) {
+  TempDir Dir("CachingTest", /*Unique=*/true);
+  FakeRemoteCache Remote;
+  Remote.Objects["key"] = "remote object";
+  std::string Added;
+  Expected<FileCache> Cache = localCache(
+      "Test", "Test", Dir.path(),
+      [&](unsigned, const Twine &, std::unique_ptr<MemoryBuffer> MB) {
+        Added = MB->getBuffer().str();
+      },
+      Remote.get());
+  ASSERT_THAT_EXPECTED(Cache, Succeeded());
+
+  EXPECT_EQ("remote object", lookup(*Cache, "key", Added, "unexpected"));
+  EXPECT_EQ(1u, Remote.NumFetches);
+  EXPECT_TRUE(sys::fs::exists(Dir.path("llvmcache-key")));
+}
+
+} // namespace
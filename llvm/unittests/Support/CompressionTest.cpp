@@ -16,6 +16,7 @@
 #include "llvm/Config/config.h"
 #include "llvm/Support/Error.h"
 #include "gtest/gtest.h"
+#include <string>
 
 using namespace llvm;
 using namespace llvm::compression;
@@ -110,5 +111,21 @@ TEST(CompressionTest, Zstd) {
   testZstdCompression(BinaryDataStr, zstd::BestSpeedCompression);
   testZstdCompression(BinaryDataStr, zstd::DefaultCompression);
 }
+
+TEST(CompressionTest, ZstdThreads) {
+  // Large enough to be split into several jobs.
+  std::string Input;
+  for (size_t i = 0; Input.size() < (8u << 20); ++i)
+    Input += std::to_string(i * 2654435761u);
+
+  SmallVector<uint8_t, 0> Compressed;
+  SmallVector<uint8_t, 0> Uncompressed;
+  compression::Params P(compression::Format::Zstd);
+  P.zstdNumThreads = 4;
+  compression::compress(P, arrayRefFromStringRef(Input), Compressed);
+  Error E = zstd::decompress(Compressed, Uncompressed, Input.size());
+  EXPECT_FALSE(std::move(E));
+  EXPECT_EQ(Input, toStringRef(Uncompressed));
+}
 #endif
 }
@@ -0,0 +1,79 @@
+//===- ConcurrentStringPoolTest.cpp ---------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Support/ConcurrentStringPool.h"
+#include "llvm/ADT/Twine.h"
+#include "llvm/Support/Parallel.h"
+#include "gtest/gtest.h"
+#include <string>
+#include <vector>
+
+using namespace llvm;
+
+namespace {
+
+TEST(ConcurrentStringPoolTest, InternReturnsUniqueCopy) {
+  ConcurrentStringPool Pool;
+
+  // PerThreadBumpPtrAllocator should be accessed from threads created by
+  // ThreadPoolExecutor. Use TaskGroup to run on ThreadPoolExecutor threads.
+  parallel::TaskGroup TG;
+  TG.spawn([&]() {
+    std::string Str = "symbol";
+    StringRef A = Pool.intern(Str);
+    StringRef B = Pool.intern("symbol");
+    EXPECT_EQ(A, "symbol");
+    EXPECT_EQ(A.data(), B.data());
+    EXPECT_NE(A.data(), Str.data());
+    EXPECT_NE(Pool.intern("other").data(), A.data());
+  });
+}
+
+TEST(ConcurrentStringPoolTest, ConcurrentIntern) {
+  ConcurrentStringPool Pool(10);
+  constexpr size_t NumStrings = 10000;
+  std::vector<std::string> Strings;
+  for (size_t I = 0; I < NumStrings; ++I)
+    Strings.push_back(("string" + Twine(I)).str());
+
+  // Every string is interned from several threads, all of them must get the
+  // same copy.
+  std::vector<const char *> First(NumStrings);
+  parallelFor(0, NumStrings, [&](size_t I) {
+    First[I] = Pool.intern(Strings[I]).data();
+  });
+  parallelFor(0, NumStrings * 4, [&](size_t I) {
+    StringRef Interned = Pool.intern(Strings[I % NumStrings]);
+    EXPECT_EQ(Interned, Strings[I % NumStrings]);
+    EXPECT_EQ(Interned.data(), First[I % NumStrings]);
+  });
+}
+
+TEST(ConcurrentStringPoolTest, InternAfterClear) {
+  ConcurrentStringPool Pool(10);
+  constexpr size_t NumStrings = 1000;
+  std::vector<std::string> Strings;
+  for (size_t I = 0; I < NumStrings; ++I)
+    Strings.push_back(("string" + Twine(I)).str());
+
+  parallelFor(0, NumStrings, [&](size_t I) { Pool.intern(Strings[I]); });
+  Pool.clear();
+
+  // The table must not hand out entries from the released arena.
+  std::vector<const char *> First(NumStrings);
+  parallelFor(0, NumStrings, [&](size_t I) {
+    StringRef Interned = Pool.intern(Strings[I]);
+    EXPECT_EQ(Interned, Strings[I]);
+    First[I] = Interned.data();
+  });
+  parallelFor(0, NumStrings, [&](size_t I) {
+    EXPECT_EQ(Pool.intern(Strings[I]).data(), First[I]);
+  });
+}
+
+} // namespace
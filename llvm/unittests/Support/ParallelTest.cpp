@@ -96,9 +96,8 @@ TEST(Parallel, ForEachError) {
 
 #if LLVM_ENABLE_THREADS
 TEST(Parallel, NestedTaskGroup) {
-  // This test checks:
-  // 1. Root TaskGroup is in Parallel mode.
-  // 2. Nested TaskGroup is not in Parallel mode.
+  // This test checks that both the root and the nested TaskGroup are in
+  // Parallel mode.
   parallel::TaskGroup tg;
 
   tg.spawn([&]() {
@@ -107,15 +106,17 @@ TEST(Parallel, NestedTaskGroup) {
 
   tg.spawn([&]() {
     parallel::TaskGroup nestedTG;
-    EXPECT_FALSE(nestedTG.isParallel());
+    EXPECT_TRUE(nestedTG.isParallel() ||
+                (parallel::strategy.ThreadsRequested == 1));
 
     nestedTG.spawn([&]() {
       // Check that root TaskGroup is in Parallel mode.
       EXPECT_TRUE(tg.isParallel() ||
                   (parallel::strategy.ThreadsRequested == 1));
 
-      // Check that nested TaskGroup is not in Parallel mode.
-      EXPECT_FALSE(nestedTG.isParallel());
+      // Check that nested TaskGroup is in Parallel mode.
+      EXPECT_TRUE(nestedTG.isParallel() ||
+                  (parallel::strategy.ThreadsRequested == 1));
     });
   });
 }
@@ -134,9 +135,10 @@ TEST(Parallel, ParallelNestedTaskGroup) {
         EXPECT_TRUE(tg.isParallel() ||
                     (parallel::strategy.ThreadsRequested == 1));
 
-        // Check that nested TaskGroup is not in Parallel mode.
+        // Check that nested TaskGroup is in Parallel mode.
         parallel::TaskGroup nestedTG;
-        EXPECT_FALSE(nestedTG.isParallel());
+        EXPECT_TRUE(nestedTG.isParallel() ||
+                    (parallel::strategy.ThreadsRequested == 1));
         ++Count;
 
         nestedTG.spawn([&]() {
@@ -144,8 +146,9 @@ TEST(Parallel, ParallelNestedTaskGroup) {
           EXPECT_TRUE(tg.isParallel() ||
                       (parallel::strategy.ThreadsRequested == 1));
 
-          // Check that nested TaskGroup is not in Parallel mode.
-          EXPECT_FALSE(nestedTG.isParallel());
+          // Check that nested TaskGroup is in Parallel mode.
+          EXPECT_TRUE(nestedTG.isParallel() ||
+                      (parallel::strategy.ThreadsRequested == 1));
           ++Count;
         });
       });
@@ -164,6 +167,21 @@ TEST(Parallel, ParallelNestedTaskGroup) {
   }
   EXPECT_EQ(Count, 12ul);
 }
+
+TEST(Parallel, DeeplyNestedParallelFor) {
+  // Nest more parallel loops than there are threads, waiting threads must
+  // run the nested tasks themselves rather than block the executor.
+  std::atomic<size_t> Count{0};
+  std::function<void(unsigned)> Nest = [&](unsigned Depth) {
+    if (Depth == 0) {
+      ++Count;
+      return;
+    }
+    parallelFor(0, 4, [&](size_t) { Nest(Depth - 1); });
+  };
+  Nest(5);
+  EXPECT_EQ(Count, 1024ul);
+}
 #endif
 
 #endif
@@ -15,6 +15,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "llvm/Support/TimeProfiler.h"
+#include "llvm/Support/JSON.h"
 #include "gtest/gtest.h"
 
 using namespace llvm;
@@ -96,4 +97,54 @@ TEST(TimeProfiler, Instant_Not_Added_Smoke) {
   ASSERT_TRUE(json.find(R"("detail":"instant detail")") == std::string::npos);
 }
 
+TEST(TimeProfiler, Group_Summary) {
+  setupProfiler();
+
+  auto Grouped = [](StringRef Group) {
+    TimeTraceMetadata M;
+    M.Group = Group.str();
+    M.GroupFile = "a.h";
+    return M;
+  };
+  {
+    TimeTraceScope Outer("event", [&] { return Grouped("outer"); });
+    for (int I = 0; I < 2; ++I)
+      TimeTraceScope Inner("event", [&] { return Grouped("inner"); });
+  }
+
+  std::string json = teardownProfiler();
+  Expected<json::Value> Root = json::parse(json);
+  ASSERT_TRUE(bool(Root));
+  json::Array *Groups = Root->getAsObject()->getArray("groupSummary");
+  ASSERT_TRUE(Groups);
+  ASSERT_EQ(Groups->size(), 2u);
+  for (json::Value &Group : *Groups) {
+    json::Object *G = Group.getAsObject();
+    EXPECT_EQ(G->getString("name"), "event");
+    EXPECT_EQ(G->getString("file"), "a.h");
+    EXPECT_EQ(G->getInteger("count"), G->getString("group") == "inner" ? 2 : 1);
+    EXPECT_LE(*G->getInteger("exclusive us"), *G->getInteger("inclusive us"));
+  }
+  json::Array *Files = Root->getAsObject()->getArray("fileSummary");
+  ASSERT_TRUE(Files);
+  ASSERT_EQ(Files->size(), 1u);
+  EXPECT_EQ((*Files)[0].getAsObject()->getInteger("count"), 3);
+}
+
+TEST(TimeProfiler, Max_Events) {
+  setupProfiler();
+  timeTraceProfilerSetMaxEvents(2);
+
+  for (int I = 0; I < 5; ++I)
+    TimeTraceScope Scope("event");
+
+  std::string json = teardownProfiler();
+  timeTraceProfilerSetMaxEvents(0);
+  Expected<json::Value> Root = json::parse(json);
+  ASSERT_TRUE(bool(Root));
+  EXPECT_EQ(Root->getAsObject()->getInteger("droppedEvents"), 3);
+  ASSERT_TRUE(json.find(R"("name":"Total event")") != std::string::npos);
+  ASSERT_TRUE(json.find(R"("count":5)") != std::string::npos);
+}
+
 } // namespace
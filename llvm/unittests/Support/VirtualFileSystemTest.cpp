@@ -3675,3 +3675,67 @@ TEST(TracingFileSystemTest, PrintOutput) {
             "  InMemoryFileSystem\n",
             Output);
 }
+
+TEST(StatusCachingFileSystemTest, CachesStatus) {
+  auto InMemoryFS = makeIntrusiveRefCnt<vfs::InMemoryFileSystem>();
+  InMemoryFS->setCurrentWorkingDirectory("/dir");
+  InMemoryFS->addFile("/dir/a", 0, MemoryBuffer::getMemBuffer("a"));
+  auto TracingFS = makeIntrusiveRefCnt<vfs::TracingFileSystem>(InMemoryFS);
+  auto CachingFS = makeIntrusiveRefCnt<vfs::StatusCachingFileSystem>(TracingFS);
+
+  ErrorOr<vfs::Status> Stat = CachingFS->status("/dir/a");
+  ASSERT_TRUE(Stat);
+  EXPECT_EQ(TracingFS->NumStatusCalls, 1u);
+
+  // Relative paths share the entry of the absolute path, but keep their name.
+  Stat = CachingFS->status("a");
+  ASSERT_TRUE(Stat);
+  EXPECT_EQ(Stat->getName(), "a");
+  EXPECT_EQ(TracingFS->NumStatusCalls, 1u);
+
+  // Failed lookups are cached too.
+  EXPECT_FALSE(CachingFS->exists("/dir/b"));
+  EXPECT_FALSE(CachingFS->status("/dir/b"));
+  EXPECT_EQ(TracingFS->NumStatusCalls, 2u);
+}
+
+TEST(StatusCachingFileSystemTest, PrefetchStatus) {
+  auto InMemoryFS = makeIntrusiveRefCnt<vfs::InMemoryFileSystem>();
+  std::vector<std::string> Paths;
+  for (unsigned I = 0; I < 100; ++I) {
+    Paths.push_back("/dir/" + std::to_string(I));
+    if (I % 2)
+      InMemoryFS->addFile(Paths.back(), 0, MemoryBuffer::getMemBuffer("x"));
+  }
+  auto CachingFS =
+      makeIntrusiveRefCnt<vfs::StatusCachingFileSystem>(InMemoryFS);
+  CachingFS->prefetchStatus(Paths);
+
+  // The cached results don't depend on the underlying file system anymore.
+  InMemoryFS->addFile("/dir/0", 0, MemoryBuffer::getMemBuffer("x"));
+  for (unsigned I = 0; I < 100; ++I)
+    EXPECT_EQ(CachingFS->exists(Paths[I]), bool(I % 2)) << Paths[I];
+}
+
+TEST(StatusCachingFileSystemTest, KeepsExternalNames) {
+  IntrusiveRefCntPtr<vfs::InMemoryFileSystem> BaseFS =
+      new vfs::InMemoryFileSystem;
+  BaseFS->addFile("//root/b", 0, MemoryBuffer::getMemBuffer("contents of b"));
+  std::vector<std::pair<std::string, std::string>> RemappedFiles = {
+      {"//root/a", "//root/b"}};
+  IntrusiveRefCntPtr<vfs::FileSystem> RemappedFS(
+      vfs::RedirectingFileSystem::create(RemappedFiles,
+                                         /*UseExternalNames=*/true, *BaseFS)
+          .release());
+  auto CachingFS =
+      makeIntrusiveRefCnt<vfs::StatusCachingFileSystem>(RemappedFS);
+
+  // The external name exposed by the redirecting file system is kept, both
+  // on a miss and on a hit.
+  for (int I = 0; I < 2; ++I) {
+    ErrorOr<vfs::Status> Stat = CachingFS->status("//root/a");
+    ASSERT_TRUE(Stat);
+    EXPECT_EQ("//root/b", Stat->getName());
+    EXPECT_TRUE(Stat->ExposesExternalVFSPath);
+  }
+}
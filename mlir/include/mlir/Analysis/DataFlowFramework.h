@@ -332,11 +332,9 @@ public:
   /// does not exist.
   template <typename StateT, typename AnchorT>
   const StateT *lookupState(AnchorT anchor) const {
-    const auto &mapIt = analysisStates.find(LatticeAnchor(anchor));
-    if (mapIt == analysisStates.end())
-      return nullptr;
-    auto it = mapIt->second.find(TypeID::get<StateT>());
-    if (it == mapIt->second.end())
+    auto it =
+        analysisStates.find({LatticeAnchor(anchor), TypeID::get<StateT>()});
+    if (it == analysisStates.end())
       return nullptr;
     return static_cast<const StateT *>(it->second.get());
   }
@@ -345,11 +343,15 @@ public:
   template <typename AnchorT>
   void eraseState(AnchorT anchor) {
     LatticeAnchor la(anchor);
-    analysisStates.erase(LatticeAnchor(anchor));
+    for (TypeID stateType : stateTypes)
+      analysisStates.erase({la, stateType});
   }
 
   // Erase all analysis states
-  void eraseAllStates() { analysisStates.clear(); }
+  void eraseAllStates() {
+    analysisStates.clear();
+    stateTypes.clear();
+  }
 
   /// Get a uniqued lattice anchor instance. If one is not present, it is
   /// created with the provided arguments.
@@ -427,12 +429,17 @@ private:
   /// anchors
   StorageUniquer uniquer;
 
-  /// A type-erased map of lattice anchors to associated analysis states for
-  /// first-class lattice anchors.
-  DenseMap<LatticeAnchor, DenseMap<TypeID, std::unique_ptr<AnalysisState>>,
-           DenseMapInfo<LatticeAnchor::ParentTy>>
+  /// A type-erased map of lattice anchors and state kinds to the associated
+  /// analysis states for first-class lattice anchors. A single flat map avoids
+  /// allocating a nested map for every anchor.
+  DenseMap<std::pair<LatticeAnchor::ParentTy, TypeID>,
+           std::unique_ptr<AnalysisState>>
       analysisStates;
 
+  /// The kinds of the analysis states created so far, to erase the states of
+  /// an anchor without scanning all of them.
+  SmallVector<TypeID, 4> stateTypes;
+
   /// Allow the base child analysis class to access the internals of the solver.
   friend class DataFlowAnalysis;
 };
@@ -646,9 +653,12 @@ AnalysisT *DataFlowSolver::load(Args &&...args) {
 
 template <typename StateT, typename AnchorT>
 StateT *DataFlowSolver::getOrCreateState(AnchorT anchor) {
+  TypeID stateType = TypeID::get<StateT>();
   std::unique_ptr<AnalysisState> &state =
-      analysisStates[LatticeAnchor(anchor)][TypeID::get<StateT>()];
+      analysisStates[{LatticeAnchor(anchor), stateType}];
   if (!state) {
+    if (!llvm::is_contained(stateTypes, stateType))
+      stateTypes.push_back(stateType);
     state = std::unique_ptr<StateT>(new StateT(anchor));
 #if LLVM_ENABLE_ABI_BREAKING_CHECKS
     state->debugName = llvm::getTypeName<StateT>();
@@ -87,6 +87,8 @@ LogicalResult readBytecodeFile(llvm::MemoryBufferRef buffer, Block *block,
 /// An overload with a source manager whose main file buffer is used for
 /// parsing. The lifetime of the source manager may be freely extended during
 /// parsing such that the source manager is not destroyed before the parsed IR.
+/// Resource blobs then reference the buffer directly instead of being copied,
+/// so a memory mapped file is only paged in when the blobs are accessed.
 LogicalResult
 readBytecodeFile(const std::shared_ptr<llvm::SourceMgr> &sourceMgr,
                  Block *block, const ParserConfig &config);
@@ -390,20 +390,30 @@ public:
       }
     };
 
+    const uint64_t lvlRank = getLvlRank();
+    auto lessThan = [this, lvlRank](uint64_t lhs, uint64_t rhs) {
+      for (uint64_t l = 0; l < lvlRank; l++) {
+        if (coordinates[l][lhs] == coordinates[l][rhs])
+          continue;
+        return coordinates[l][lhs] < coordinates[l][rhs];
+      }
+      assert(lhs == rhs && "duplicate coordinates");
+      return false;
+    };
+
+    // Unordered COO tensors are often built from already sorted input, in
+    // which case a single linear scan avoids the sort and the permutation.
+    bool isSorted = true;
+    for (uint64_t i = 1; i < nnz && isSorted; i++)
+      isSorted = lessThan(i - 1, i);
+    if (isSorted)
+      return;
+
     std::vector<uint64_t> sortedIdx(nnz, 0);
     for (uint64_t i = 0; i < nnz; i++)
       sortedIdx[i] = i;
 
-    std::sort(sortedIdx.begin(), sortedIdx.end(),
-              [this](uint64_t lhs, uint64_t rhs) {
-                for (uint64_t l = 0; l < getLvlRank(); l++) {
-                  if (coordinates[l][lhs] == coordinates[l][rhs])
-                    continue;
-                  return coordinates[l][lhs] < coordinates[l][rhs];
-                }
-                assert(lhs == rhs && "duplicate coordinates");
-                return false;
-              });
+    std::sort(sortedIdx.begin(), sortedIdx.end(), lessThan);
 
     applyPerm(sortedIdx);
   }
@@ -57,10 +57,12 @@ Location Lexer::getEncodedSourceLocation(SMLoc loc) {
   unsigned lineNo = bufferInfo.getLineNumber(loc.getPointer());
   unsigned column =
       (loc.getPointer() - bufferInfo.getPointerForLineNumber(lineNo)) + 1;
-  auto *buffer = sourceMgr.getMemoryBuffer(mainFileID);
+  if (!bufferName) {
+    auto *buffer = sourceMgr.getMemoryBuffer(mainFileID);
+    bufferName = StringAttr::get(context, buffer->getBufferIdentifier());
+  }
 
-  return FileLineColLoc::get(context, buffer->getBufferIdentifier(), lineNo,
-                             column);
+  return FileLineColLoc::get(bufferName, lineNo, column);
 }
 
 /// emitError - Emit an error message and return an Token::error token.
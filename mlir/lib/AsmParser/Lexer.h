@@ -15,6 +15,7 @@
 
 #include "Token.h"
 #include "mlir/AsmParser/AsmParser.h"
+#include "mlir/IR/BuiltinAttributes.h"
 
 namespace mlir {
 class Location;
@@ -69,6 +70,10 @@ private:
   StringRef curBuffer;
   const char *curPtr;
 
+  /// The identifier of the main buffer, uniqued on the first encoded location
+  /// instead of once per location.
+  StringAttr bufferName;
+
   /// An optional code completion point within the input file, used to indicate
   /// the position of a code completion token.
   const char *codeCompleteLoc;
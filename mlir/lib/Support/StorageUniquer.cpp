@@ -11,7 +11,10 @@
 #include "mlir/Support/LLVM.h"
 #include "mlir/Support/ThreadLocalCache.h"
 #include "mlir/Support/TypeID.h"
+#include "llvm/Support/MathExtras.h"
 #include "llvm/Support/RWMutex.h"
+#include "llvm/Support/Threading.h"
+#include <algorithm>
 
 using namespace mlir;
 using namespace mlir::detail;
@@ -256,6 +259,16 @@ struct StorageUniquerImpl {
   // Parametric Storage
   //===--------------------------------------------------------------------===//
 
+  /// Return the number of shards used by each parametric storage uniquer. The
+  /// lock contention on a shard grows with the number of threads creating
+  /// instances, so scale the shards with the available hardware threads.
+  static size_t getNumParametricShards() {
+    static const size_t numShards = std::clamp<size_t>(
+        llvm::PowerOf2Ceil(llvm::hardware_concurrency().compute_thread_count()),
+        8, 64);
+    return numShards;
+  }
+
   /// Check if an instance of a parametric storage class exists.
   bool hasParametricStorage(TypeID id) { return parametricUniquers.count(id); }
 
@@ -380,7 +393,8 @@ auto StorageUniquer::getParametricStorageTypeImpl(
 void StorageUniquer::registerParametricStorageTypeImpl(
     TypeID id, function_ref<void(BaseStorage *)> destructorFn) {
   impl->parametricUniquers.try_emplace(
-      id, std::make_unique<ParametricStorageUniquer>(destructorFn));
+      id, std::make_unique<ParametricStorageUniquer>(
+              destructorFn, StorageUniquerImpl::getNumParametricShards()));
 }
 
 /// Implementation for getting an instance of a derived type with default
@@ -25,6 +25,26 @@ namespace mlir {
 using namespace mlir;
 
 namespace {
+/// Counts the outcome of the patterns tried by the driver, and forwards all
+/// notifications to the listener of the config, if any.
+struct PatternCounter : public RewriterBase::ForwardingListener {
+  PatternCounter(RewriterBase::Listener *listener, Pass::Statistic &numApplied,
+                 Pass::Statistic &numFailed)
+      : ForwardingListener(listener), numApplied(numApplied),
+        numFailed(numFailed) {}
+
+  void notifyPatternEnd(const Pattern &pattern, LogicalResult status) override {
+    if (succeeded(status))
+      ++numApplied;
+    else
+      ++numFailed;
+    ForwardingListener::notifyPatternEnd(pattern, status);
+  }
+
+  Pass::Statistic &numApplied;
+  Pass::Statistic &numFailed;
+};
+
 /// Canonicalize operations in nested regions.
 struct Canonicalizer : public impl::CanonicalizerBase<Canonicalizer> {
   Canonicalizer() = default;
@@ -60,8 +80,16 @@ struct Canonicalizer : public impl::CanonicalizerBase<Canonicalizer> {
     return success();
   }
   void runOnOperation() override {
+    GreedyRewriteConfig runConfig = config;
+#if LLVM_ENABLE_STATS
+    // Only count the patterns when statistics are compiled in, the listener
+    // callbacks are not free.
+    PatternCounter counter(config.listener, numPatternsApplied,
+                           numPatternsFailed);
+    runConfig.listener = &counter;
+#endif
     LogicalResult converged =
-        applyPatternsGreedily(getOperation(), *patterns, config);
+        applyPatternsGreedily(getOperation(), *patterns, runConfig);
     // Canonicalization is best-effort. Non-convergence is not a pass failure.
     if (testConvergence && failed(converged))
       signalPassFailure();
@@ -13,6 +13,7 @@
 #ifndef LLVM_OPENMP_LIBOMPTARGET_PLUGINS_COMMON_MEMORYMANAGER_H
 #define LLVM_OPENMP_LIBOMPTARGET_PLUGINS_COMMON_MEMORYMANAGER_H
 
+#include <atomic>
 #include <cassert>
 #include <functional>
 #include <list>
@@ -22,6 +23,7 @@
 #include <vector>
 
 #include "Shared/Debug.h"
+#include "Shared/EnvironmentVar.h"
 #include "Shared/Utils.h"
 #include "omptarget.h"
 
@@ -133,6 +135,11 @@ class MemoryManagerTy {
   /// memory manager.
   size_t SizeThreshold = 1U << 13;
 
+  /// Number of managed allocations served from the free lists and from the
+  /// device respectively.
+  std::atomic<size_t> NumHits = 0;
+  std::atomic<size_t> NumMisses = 0;
+
   /// Request memory from target device
   void *allocateOnDevice(size_t Size, void *HstPtr) const {
     return DeviceAllocator.allocate(Size, HstPtr, TARGET_ALLOC_DEVICE);
@@ -145,27 +152,7 @@ class MemoryManagerTy {
   /// device returns out of memory. It will first free all memory in the
   /// FreeList and try to allocate again.
   void *freeAndAllocate(size_t Size, void *HstPtr) {
-    std::vector<void *> RemoveList;
-
-    // Deallocate all memory in FreeList
-    for (int I = 0; I < NumBuckets; ++I) {
-      FreeListTy &List = FreeLists[I];
-      std::lock_guard<std::mutex> Lock(FreeListLocks[I]);
-      if (List.empty())
-        continue;
-      for (const NodeTy &N : List) {
-        deleteOnDevice(N.Ptr);
-        RemoveList.push_back(N.Ptr);
-      }
-      FreeLists[I].clear();
-    }
-
-    // Remove all nodes in the map table which have been released
-    if (!RemoveList.empty()) {
-      std::lock_guard<std::mutex> LG(MapTableLock);
-      for (void *P : RemoveList)
-        PtrToNodeTable.erase(P);
-    }
+    trim();
 
     // Try allocate memory again
     return allocateOnDevice(Size, HstPtr);
@@ -204,6 +191,9 @@ public:
 
   /// Destructor
   ~MemoryManagerTy() {
+    DP("MemoryManagerTy: %zu allocations reused cached memory, %zu went to the "
+       "device.\n",
+       NumHits.load(), NumMisses.load());
     for (auto Itr = PtrToNodeTable.begin(); Itr != PtrToNodeTable.end();
          ++Itr) {
       assert(Itr->second.Ptr && "nullptr in map table");
@@ -252,13 +242,16 @@ public:
       }
     }
 
-    if (NodePtr != nullptr)
+    if (NodePtr != nullptr) {
       DP("Find one node " DPxMOD " in the bucket.\n", DPxPTR(NodePtr));
+      NumHits.fetch_add(1, std::memory_order_relaxed);
+    }
 
     // We cannot find a valid node in FreeLists. Let's allocate on device and
     // create a node for it.
     if (NodePtr == nullptr) {
       DP("Cannot find a node in the FreeLists. Allocate on device.\n");
+      NumMisses.fetch_add(1, std::memory_order_relaxed);
       // Allocate one on device
       void *TgtPtr = allocateOrFreeAndAllocateOnDevice(Size, HstPtr);
 
@@ -317,6 +310,48 @@ public:
     return OFFLOAD_SUCCESS;
   }
 
+  /// Release all memory held in the free lists back to the device. Memory that
+  /// is currently allocated is not affected. Returns the number of bytes
+  /// released.
+  size_t trim() {
+    std::vector<void *> RemoveList;
+    size_t Released = 0;
+
+    // Deallocate all memory in FreeList
+    for (int I = 0; I < NumBuckets; ++I) {
+      FreeListTy &List = FreeLists[I];
+      std::lock_guard<std::mutex> Lock(FreeListLocks[I]);
+      if (List.empty())
+        continue;
+      for (const NodeTy &N : List) {
+        deleteOnDevice(N.Ptr);
+        RemoveList.push_back(N.Ptr);
+        Released += N.Size;
+      }
+      FreeLists[I].clear();
+    }
+
+    // Remove all nodes in the map table which have been released
+    if (!RemoveList.empty()) {
+      std::lock_guard<std::mutex> LG(MapTableLock);
+      for (void *P : RemoveList)
+        PtrToNodeTable.erase(P);
+    }
+
+    DP("MemoryManagerTy::trim: released %zu bytes in %zu nodes.\n", Released,
+       RemoveList.size());
+
+    return Released;
+  }
+
+  /// Number of managed allocations that were served from the free lists.
+  size_t getNumHits() const { return NumHits.load(std::memory_order_relaxed); }
+
+  /// Number of managed allocations that had to go to the device.
+  size_t getNumMisses() const {
+    return NumMisses.load(std::memory_order_relaxed);
+  }
+
   /// Get the size threshold from the environment variable
   /// \p LIBOMPTARGET_MEMORY_MANAGER_THRESHOLD . Returns a <tt>
   /// std::pair<size_t, bool> </tt> where the first element represents the
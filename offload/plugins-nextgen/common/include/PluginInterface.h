@@ -767,6 +767,21 @@ struct GenericDeviceTy : public DeviceAllocatorTy {
   /// Deallocate data from the device or involving the device.
   Error dataDelete(void *TgtPtr, TargetAllocTy Kind);
 
+  /// Release the device memory cached by the memory manager that is not
+  /// currently in use. Returns the number of bytes released, or zero if the
+  /// device does not use a memory manager.
+  size_t trimMemoryManager() {
+    return MemoryManager ? MemoryManager->trim() : 0;
+  }
+
+  /// Get the number of managed allocations that reused cached memory and the
+  /// number that went to the device, in that order.
+  std::pair<size_t, size_t> getMemoryManagerStats() const {
+    if (!MemoryManager)
+      return {0, 0};
+    return {MemoryManager->getNumHits(), MemoryManager->getNumMisses()};
+  }
+
   /// Pin host memory to optimize transfers and return the device accessible
   /// pointer that devices should use for memory transfers involving the host
   /// pinned allocation.
@@ -0,0 +1,100 @@
+//===------- Offload MemoryManagerTy unit tests ---------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "MemoryManager.h"
+#include "gtest/gtest.h"
+
+#include <cstdlib>
+
+namespace {
+
+/// Allocator backed by host memory that tracks how many bytes are live.
+class CountingAllocatorTy : public DeviceAllocatorTy {
+public:
+  void *allocate(size_t Size, void *HstPtr, TargetAllocTy Kind) override {
+    void *Ptr = std::malloc(Size);
+    Sizes.emplace(Ptr, Size);
+    LiveBytes += Size;
+    return Ptr;
+  }
+
+  int free(void *TgtPtr, TargetAllocTy Kind) override {
+    auto It = Sizes.find(TgtPtr);
+    if (It == Sizes.end())
+      return OFFLOAD_FAIL;
+    LiveBytes -= It->second;
+    Sizes.erase(It);
+    std::free(TgtPtr);
+    return OFFLOAD_SUCCESS;
+  }
+
+  std::unordered_map<void *, size_t> Sizes;
+  size_t LiveBytes = 0;
+};
+
+TEST(MemoryManagerTest, CountsHitsAndMisses) {
+  CountingAllocatorTy Allocator;
+  MemoryManagerTy MemoryManager(Allocator);
+
+  void *First = MemoryManager.allocate(64, nullptr);
+  ASSERT_NE(First, nullptr);
+  EXPECT_EQ(MemoryManager.getNumHits(), 0U);
+  EXPECT_EQ(MemoryManager.getNumMisses(), 1U);
+
+  // Freeing keeps the memory cached, so the next request is served from it.
+  EXPECT_EQ(MemoryManager.free(First), OFFLOAD_SUCCESS);
+  void *Second = MemoryManager.allocate(64, nullptr);
+  EXPECT_EQ(Second, First);
+  EXPECT_EQ(MemoryManager.getNumHits(), 1U);
+  EXPECT_EQ(MemoryManager.getNumMisses(), 1U);
+
+  // Allocations above the threshold bypass the manager and are not counted.
+  void *Large = MemoryManager.allocate(1U << 20, nullptr);
+  ASSERT_NE(Large, nullptr);
+  EXPECT_EQ(MemoryManager.getNumHits(), 1U);
+  EXPECT_EQ(MemoryManager.getNumMisses(), 1U);
+
+  EXPECT_EQ(MemoryManager.free(Second), OFFLOAD_SUCCESS);
+  EXPECT_EQ(MemoryManager.free(Large), OFFLOAD_SUCCESS);
+}
+
+TEST(MemoryManagerTest, TrimReleasesFreeLists) {
+  CountingAllocatorTy Allocator;
+  {
+    MemoryManagerTy MemoryManager(Allocator);
+
+    void *A = MemoryManager.allocate(64, nullptr);
+    void *B = MemoryManager.allocate(100, nullptr);
+    void *C = MemoryManager.allocate(300, nullptr);
+    ASSERT_NE(A, nullptr);
+    ASSERT_NE(B, nullptr);
+    ASSERT_NE(C, nullptr);
+    EXPECT_EQ(Allocator.LiveBytes, 464U);
+
+    // Nothing is cached yet.
+    EXPECT_EQ(MemoryManager.trim(), 0U);
+    EXPECT_EQ(Allocator.LiveBytes, 464U);
+
+    // Only the freed blocks go back to the device; C stays allocated.
+    EXPECT_EQ(MemoryManager.free(A), OFFLOAD_SUCCESS);
+    EXPECT_EQ(MemoryManager.free(B), OFFLOAD_SUCCESS);
+    EXPECT_EQ(MemoryManager.trim(), 164U);
+    EXPECT_EQ(Allocator.LiveBytes, 300U);
+    EXPECT_EQ(MemoryManager.trim(), 0U);
+
+    // A trimmed block is no longer reused.
+    void *D = MemoryManager.allocate(64, nullptr);
+    ASSERT_NE(D, nullptr);
+    EXPECT_EQ(MemoryManager.getNumHits(), 0U);
+    EXPECT_EQ(MemoryManager.getNumMisses(), 4U);
+  }
+  // The destructor releases everything that is still managed.
+  EXPECT_EQ(Allocator.LiveBytes, 0U);
+}
+
+} // namespace
@@ -2091,6 +2091,9 @@ public:
   /// Return the function this SCoP is in.
   Function &getFunction() const { return *R.getEntry()->getParent(); }
 
+  /// Return the emitter for remarks about this SCoP.
+  OptimizationRemarkEmitter &getORE() const { return ORE; }
+
   /// Check if @p L is contained in the SCoP.
   bool contains(const Loop *L) const { return R.contains(L); }
 
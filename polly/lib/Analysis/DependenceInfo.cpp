@@ -26,6 +26,8 @@
 #include "polly/Support/GICHelper.h"
 #include "polly/Support/ISLTools.h"
 #include "llvm/ADT/Sequence.h"
+#include "llvm/ADT/Statistic.h"
+#include "llvm/Analysis/OptimizationRemarkEmitter.h"
 #include "llvm/Support/Debug.h"
 #include "isl/aff.h"
 #include "isl/ctx.h"
@@ -42,6 +44,9 @@ using namespace llvm;
 #include "polly/Support/PollyDebug.h"
 #define DEBUG_TYPE "polly-dependence"
 
+STATISTIC(NumComputeOut,
+          "Number of SCoPs whose dependence analysis ran out of budget");
+
 static cl::opt<int> OptComputeOut(
     "polly-dependences-computeout",
     cl::desc("Bound the dependence analysis by a maximal amount of "
@@ -479,6 +484,18 @@ void Dependences::calculateDependences(Scop &S) {
   }
 
   if (isl_ctx_last_error(IslCtx.get()) == isl_error_quota) {
+    POLLY_DEBUG(dbgs() << "Dependence analysis exceeded " << OptComputeOut
+                       << " operations, giving up\n");
+    NumComputeOut++;
+    BasicBlock *Entry = S.getEntry();
+    S.getORE().emit(
+        OptimizationRemarkAnalysis(DEBUG_TYPE, "DependenceComputeOut",
+                                   Entry->getTerminator()->getDebugLoc(), Entry)
+        << "Dependence analysis of " << S.getNameStr()
+        << " exceeded the limit of "
+        << ore::NV("ComputeOut", OptComputeOut.getValue())
+        << " operations (-polly-dependences-computeout); no dependences are "
+           "available for this SCoP");
     isl_union_map_free(RAW);
     isl_union_map_free(WAW);
     isl_union_map_free(WAR);